@@ -49,7 +49,7 @@ protected slots:
 
 private slots:
 	void componentStateHandler(hyperhdr::Components comp, bool state);
-	void priorityUpdateHandler();
+	void priorityUpdateHandler(bool prioritiesChanged);
 	void imageToLedsMappingChangeHandler(int mappingType);
 	void signalAdjustmentUpdatedHandler(QJsonArray newConfig);
 	void videoModeHdrChangeHandler(hyperhdr::Components component, bool enable);
@@ -69,5 +69,5 @@ public slots:
 private:
 	QStringList _availableCommands;
 	QStringList _subscribedCommands;
-	void doCallback(const QString cmd, const QVariant data);	
+	void doCallback(const QString cmd, const QVariant data, quint64 revision = 0);	
 };
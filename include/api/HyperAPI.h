@@ -64,6 +64,9 @@ private:
 	/// flag to determine state of log streaming
 	bool _streaming_logging_activated;
 
+	/// instance of the last serverinfo reply, an incremental reply requires the same instance
+	int _lastServerInfoInstance;
+
 	/// timer for led color refresh
 	QTimer* _ledStreamTimer;
 
@@ -108,6 +111,7 @@ private:
 	void handleSaveDB(const QJsonObject& message, const QString& command, int tan);
 	void handleLoadDB(const QJsonObject& message, const QString& command, int tan);
 	void handleLoadSignalCalibration(const QJsonObject& message, const QString& command, int tan);
+	void handleVideoRecordingCommand(const QJsonObject& message, const QString& command, int tan);
 	void handlePerformanceCounters(const QJsonObject& message, const QString& command, int tan);
 
 	void sendSuccessReply(const QString& command = "", int tan = 0);
@@ -29,6 +29,8 @@
 
 #include <utils/Logger.h>
 
+class FrameStatistics;
+
 class AutomaticToneMapping
 {	
 public:
@@ -41,9 +43,7 @@ public:
 	void setConfig(bool enabled, const ToneMappingThresholds& newConfig, int timeInSec, int timeToDisableInMSec);
 	void setToneMapping(bool enabled);
 
-	void scan_YUYV(int width, uint8_t* currentSource);
-	void scan_Y_UV_8(int width, uint8_t* currentSourceY, uint8_t* currentSourceUV);
-	void scan_Y_UV_16(int width, uint8_t* currentSourceY, uint8_t* currentSourceUV);
+	void scan(const FrameStatistics& statistics);
 
 	constexpr uint8_t checkY(uint8_t y)
 	{
@@ -0,0 +1,111 @@
+#pragma once
+
+#ifndef PCH_ENABLED
+	#include <array>
+	#include <atomic>
+	#include <map>
+	#include <memory>
+	#include <mutex>
+	#include <vector>
+	#include <cstdint>
+#endif
+
+#include <image/Image.h>
+#include <image/ColorRgb.h>
+#include <linalg.h>
+
+namespace hyperhdr
+{
+	///
+	/// Summed-area tables of the linearised frame, one for each pixel parity (x % 2, y % 2), so a rectangle can be summed
+	/// in full or with the step of 2 of the sparse processing and give exactly the sum of visiting its pixels.
+	/// The sums wrap around modulo 2^32, the difference of the corners is still exact as long as the band
+	/// has no more than MAX_EXACT_AREA pixels (65535 * 65537 < 2^32), so larger rectangles are split into bands.
+	///
+	class LinearAreaTable
+	{
+	public:
+		static constexpr uint32_t MAX_EXACT_AREA = 65537;
+		static constexpr uint32_t MAX_FRAME_AREA = 1920 * 1080;
+
+		void build(const Image<ColorRgb>& image);
+
+		unsigned width() const;
+
+		unsigned height() const;
+
+		///
+		/// Sum of the pixels x1 <= x < x2, y1 <= y < y2 visited from the top-left corner with the step of 1 or 2
+		///
+		linalg::vec<uint_fast64_t, 3> sum(unsigned x1, unsigned y1, unsigned x2, unsigned y2, unsigned step = 1) const;
+
+	private:
+		linalg::vec<uint_fast64_t, 3> sumParity(unsigned px, unsigned py, unsigned x1, unsigned y1, unsigned x2, unsigned y2) const;
+
+		unsigned _width = 0;
+		unsigned _height = 0;
+		std::array<unsigned, 2> _parityWidth{};
+		std::array<std::vector<linalg::vec<uint32_t, 3>>, 4> _tables;
+	};
+
+	///
+	/// Per-frame analysis shared by all instances that receive the same frame. The frame is identified by the sequence
+	/// of its capture timing, so a recycled image buffer is never mistaken for the frame it held before.
+	/// The consumers announce how many pixels they sample per frame: the table is built only when their
+	/// sampling, at the measured cost per pixel, costs more than building it once. The first consumer of the frame
+	/// builds the table, the others do not wait for it and sample the frame themselves until it is ready.
+	///
+	class FrameAnalysisCache
+	{
+	public:
+		static void updateConsumer(const void* consumer, unsigned width, unsigned height, uint64_t samples);
+
+		static void removeConsumer(const void* consumer);
+
+		static bool isWorthSharing(unsigned width, unsigned height);
+
+		static void reportSamplingTime(uint64_t samples, int64_t timeUs);
+
+		static std::shared_ptr<const LinearAreaTable> getLinearAreaTable(const Image<ColorRgb>& image);
+
+	private:
+		struct Consumer
+		{
+			unsigned width;
+			unsigned height;
+			uint64_t samples;
+		};
+
+		struct Cost
+		{
+			uint64_t units = 0;
+			int64_t timeUs = 0;
+
+			void add(uint64_t newUnits, int64_t newTimeUs);
+			double perUnit() const;
+		};
+
+		struct Slot
+		{
+			std::atomic<bool> ready{ false };
+			std::shared_ptr<LinearAreaTable> table;
+		};
+
+		struct Entry
+		{
+			uint64_t sequence = 0;
+			unsigned width = 0;
+			unsigned height = 0;
+			std::shared_ptr<Slot> slot;
+		};
+
+		static constexpr int CACHE_SIZE = 3;
+
+		static std::mutex _mutex;
+		static std::map<const void*, Consumer> _consumers;
+		static Cost _samplingCost;
+		static Cost _buildCost;
+		static std::array<Entry, CACHE_SIZE> _entries;
+		static int _nextEntry;
+	};
+}
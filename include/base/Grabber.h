@@ -9,6 +9,8 @@
 	#include <QMultiMap>
 	#include <QSemaphore>
 	#include <atomic>
+	#include <memory>
+	#include <mutex>
 #endif
 
 #include <image/ColorRgb.h>
@@ -18,6 +20,7 @@
 #include <image/MemoryBuffer.h>
 #include <utils/FrameDecoder.h>
 #include <utils/LutLoader.h>
+#include <utils/FrameRecording.h>
 #include <base/DetectionManual.h>
 #include <base/DetectionAutomatic.h>
 #include <base/AutomaticToneMapping.h>
@@ -104,6 +107,8 @@ public:
 
 	void setQFrameDecimation(int setQframe);
 
+	void setMjpegDecimation(int decimation);
+
 	void unblockAndRestart(bool running);
 
 	void setBlocked();
@@ -131,6 +136,12 @@ public:
 	void setAutomaticToneMappingConfig(bool enabled, const AutomaticToneMapping::ToneMappingThresholds& newConfig, int timeInSec, int timeToDisableInMSec);
 	void setAutoToneMappingCurrentStateEnabled(bool enabled);
 
+	QJsonObject startRecording(const QString& fileName, bool compress, quint64 frameLimit);
+
+	QJsonObject stopRecording();
+
+	QJsonObject getRecordingInfo();
+
 	struct DevicePropertiesItem
 	{
 		int		x, y, fps, fps_a, fps_b, input;
@@ -198,6 +209,8 @@ protected:
 
 	void handleNewFrame(unsigned int workerIndex, Image<ColorRgb> image, quint64 sourceCount, qint64 _frameBegin);
 
+	void recordFrame(const void* frameImageBuffer, int size);
+
 	struct DeviceControlCapability
 	{
 		bool enabled;
@@ -261,6 +274,7 @@ protected:
 	PixelFormat	_enc;
 	int			_brightness, _contrast, _saturation, _hue;
 	bool		_qframe;
+	int			_mjpegDecimation;
 	bool		_blocked;
 	bool		_restartNeeded;
 	bool		_initialized;
@@ -280,6 +294,12 @@ protected:
 	bool		_signalAutoDetectionEnabled;
 	QSemaphore  _synchro;
 	AutomaticToneMapping _automaticToneMapping;
+
+	// the capture callback records from its own thread while the wrapper thread starts and stops the recording
+	std::mutex _recorderMutex;
+	std::shared_ptr<FrameRecorder> _frameRecorder;
+	bool _recordingStopPending = false;
+	QJsonObject _lastRecordingInfo;
 };
 
 bool sortDevicePropertiesItem(const Grabber::DevicePropertiesItem& v1, const Grabber::DevicePropertiesItem& v2);
@@ -14,6 +14,7 @@
 #include <utils/Logger.h>
 #include <utils/settings.h>
 #include <utils/Components.h>
+#include <utils/InfoSnapshot.h>
 #include <base/Grabber.h>
 #include <base/DetectionAutomatic.h>
 
@@ -31,6 +32,7 @@ public:
 
 	bool isCEC();	
 	bool getAutoResume();
+	bool getPublishedJsonInfo(QJsonObject& info, quint64* revision = nullptr);
 
 public slots:
 	void capturingExceptionHandler(const char* err);	
@@ -40,11 +42,16 @@ public slots:
 	void revive();
 
 	QJsonObject getJsonInfo();
+	void publishJsonInfo();
 
 	QJsonDocument startCalibration();
 	QJsonDocument stopCalibration();
 	QJsonDocument getCalibrationInfo();
 
+	QJsonDocument startRecording(QString fileName, bool compress, int frameLimit);
+	QJsonDocument stopRecording();
+	QJsonDocument getRecordingInfo();
+
 private slots:
 	void signalRequestSourceHandler(hyperhdr::Components component, int instanceIndex, bool listen);
 
@@ -97,4 +104,5 @@ protected:
 
 	QList<int>	_running_clients;
 	QList<int>	_paused_clients;
+	InfoSnapshot<QJsonObject> _jsonInfo;
 };
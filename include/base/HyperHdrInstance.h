@@ -15,12 +15,14 @@
 	#include <list>
 	#include <memory>
 	#include <atomic>
+	#include <map>
 #endif
 
 #include <image/ColorRgb.h>
 #include <image/Image.h>
 #include <utils/settings.h>
 #include <utils/Components.h>
+#include <utils/InfoSnapshot.h>
 #include <base/LedString.h>
 #include <effects/EffectDefinition.h>
 #include <effects/ActiveEffectDefinition.h>
@@ -55,6 +57,7 @@ public:
 	
 	quint8 getInstanceIndex() const { return _instIndex; }
 	QSize getLedGridSize() const { return _ledGridSize; }
+	const LedString& getLedString() const { return _ledString; }
 	bool getScanParameters(size_t led, double& hscanBegin, double& hscanEnd, double& vscanBegin, double& vscanEnd) const;
 	unsigned addEffectConfig(unsigned id, int settlingTime_ms = 200, double ledUpdateFrequency_hz = 25.0, bool pause = false);
 
@@ -62,6 +65,10 @@ public:
 	static bool isTerminated();
 	static int getTotalRunningCount();
 
+	// thread-safe: getJsonInfo() published after the last change, no call into the instance thread
+	// 'revisions' receives the revision of every returned section (InfoRevision)
+	bool getPublishedJsonInfo(bool full, QJsonObject& info, QJsonObject* revisions = nullptr) const;
+
 public slots:
 	bool clear(int priority, bool forceClearAll = false);
 	QJsonObject getAverageColor();
@@ -74,6 +81,7 @@ public slots:
 	bool getReadOnlyMode() const;
 	QJsonDocument getSetting(settings::type type) const;
 	int hasLedClock();
+	QJsonObject getLedPacingInfo();
 	void identifyLed(const QJsonObject& params);
 	int isComponentEnabled(hyperhdr::Components comp) const;
 	QJsonObject getJsonConfig() const;
@@ -115,20 +123,37 @@ signals:
 	void SignalForwardJsonMessage(QJsonObject);
 	void SignalInstanceSettingsChanged(settings::type type, QJsonDocument data);
 	void SignalAdjustmentUpdated(QJsonArray newConfig);
-	void SignalFinalOutputColorsReady(SharedOutputColors nonlinearRgbColors);
+	void SignalFinalOutputColorsReady(SharedOutputColors nonlinearRgbColors, FrameTiming timing);
 	void SignalSmoothingClockTick();
 	void SignalSmoothingRestarted(int suggestedInterval, bool antiflickeringfilter);
 	void SignalRawColorsChanged(QVector<ColorRgb> ledValues);
 	void SignalInstanceJustStarted();
 	void SignalColorIsSet(ColorRgb color, int duration);
+	void SignalJsonInfoPublished(bool prioritiesChanged);
 
 private slots:
 	void handleVisibleComponentChanged(hyperhdr::Components comp);
 	void handleSettingsUpdate(settings::type type, const QJsonDocument& config);
 	void handlePriorityChangedLedDevice(const quint8& priority);
+	void publishJsonInfo();
+	void updateEffectImageRequirement();
+
+protected:
+	void connectNotify(const QMetaMethod& signal) override;
+	void disconnectNotify(const QMetaMethod& signal) override;
 
 private:
-	void updateResult(std::vector<linalg::aliases::float3>&& _ledBuffer);
+	void updateResult(std::vector<linalg::aliases::float3>&& _ledBuffer, const FrameTiming& timing = FrameTiming());
+	void scheduleJsonInfo(bool prioritiesChanged);
+
+	struct PublishedJsonInfo
+	{
+		QJsonObject info;
+		// position in the priorities array and the absolute timeout: 'duration_ms' is computed when it's read
+		std::vector<std::pair<int, int64_t>> timeouts;
+		// revision of the sections that didn't change in this snapshot, the others take the snapshot version
+		std::map<QString, uint64_t> revisions;
+	};
 
 	const quint8	_instIndex;
 	QTime			_bootEffect;
@@ -162,4 +187,8 @@ private:
 		qint64		statBegin = 0;
 		uint32_t	total = 0;
 	} _computeStats;
+
+	InfoSnapshot<PublishedJsonInfo> _jsonInfo;
+	bool _jsonInfoScheduled;
+	bool _jsonInfoPrioritiesChanged;
 };
@@ -10,6 +10,7 @@
 #include <utils/Logger.h>
 #include <utils/settings.h>
 #include <utils/Components.h>
+#include <utils/InfoSnapshot.h>
 #include <effects/EffectDefinition.h>
 
 class HyperHdrInstance;
@@ -43,6 +44,9 @@ public:
 	QString getRootPath();
 	bool areInstancesReady();
 
+	// thread-safe: the list published after the last change, no call into the manager thread
+	bool getPublishedInstanceData(QVector<QVariantMap>& data, quint64* revision = nullptr) const;
+
 public slots:
 	void handleRequestComponent(hyperhdr::Components component, int hyperHdrInd, bool listen);
 
@@ -123,6 +127,8 @@ private:
 
 	bool isInstAllowed(quint8 inst) const { return (inst > 0); }
 
+	void publishInstanceData();
+
 private:
 	
 	LoggerName		_log;
@@ -135,4 +141,6 @@ private:
 
 	QMap<quint8, PendingRequests> _pendingRequests;
 	VideoBenchmark	_videoBenchmark;
+
+	InfoSnapshot<QVector<QVariantMap>> _instanceData;
 };
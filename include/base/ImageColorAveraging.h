@@ -12,6 +12,7 @@
 #include <image/Image.h>
 #include <utils/Logger.h>
 #include <base/LedString.h>
+#include <base/FrameAnalysisCache.h>
 
 #include <linalg.h>
 
@@ -31,6 +32,10 @@ namespace hyperhdr
 			const quint8 instanceIndex,
 			const std::vector<LedString::Led>& leds);
 
+		ImageColorAveraging(const ImageColorAveraging&) = delete;
+		ImageColorAveraging& operator=(const ImageColorAveraging&) = delete;
+		~ImageColorAveraging();
+
 		unsigned width() const;
 		unsigned height() const;
 
@@ -40,8 +45,15 @@ namespace hyperhdr
 		void process(std::vector<linalg::aliases::float3>& ledColors, const Image<ColorRgb>& image);
 
 	private:
-		void getUnicolorForLeds(std::vector<linalg::aliases::float3>& ledColors, const Image<ColorRgb>& image) const;
-		void getMulticolorForLeds(std::vector<linalg::aliases::float3>& ledColors, const Image<ColorRgb>& image) const;
+		struct Area
+		{
+			unsigned x1, y1, x2, y2, step;
+
+			uint64_t samples() const;
+		};
+
+		void getUnicolorForLeds(std::vector<linalg::aliases::float3>& ledColors, const Image<ColorRgb>& image, const LinearAreaTable* table) const;
+		void getMulticolorForLeds(std::vector<linalg::aliases::float3>& ledColors, const Image<ColorRgb>& image, const LinearAreaTable* table) const;
 
 		const unsigned _width;
 		const unsigned _height;
@@ -49,11 +61,14 @@ namespace hyperhdr
 		const unsigned _horizontalBorder;
 		const unsigned _verticalBorder;
 		int _mappingType;
+		uint64_t _samples;
 
 		std::vector<std::vector<uint32_t>> _colorsMap;
+		std::vector<std::vector<Area>> _areasMap;
 		std::map<int, std::vector<uint32_t>> _colorGroups;
 
 		linalg::aliases::float3 calcMulticolorForLeds(const Image<ColorRgb>& image, const std::vector<uint32_t>& colors) const;
+		linalg::aliases::float3 calcMulticolorForLeds(const LinearAreaTable& table, const std::vector<Area>& areas) const;
 		linalg::aliases::float3 calcUnicolorForLeds(const Image<ColorRgb>& image) const;
 	};
 }
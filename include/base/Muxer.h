@@ -7,6 +7,9 @@
 	#include <QVector>
 	#include <QTime>
 
+	#include <array>
+	#include <atomic>
+	#include <bitset>
 	#include <vector>
 	#include <cstdint>
 #endif
@@ -46,12 +49,12 @@ public:
 	bool setSourceAutoSelectEnabled(bool enable, bool update = true);
 	bool isSourceAutoSelectEnabled() const { return _sourceAutoSelectEnabled; }
 	bool setPriority(int priority);
-	int getCurrentPriority() const { return _currentPriority; }
+	int getCurrentPriority() const { return _currentPriority.load(std::memory_order_relaxed); }
 	int getPreviousPriority() const { return _previousPriority; }
 	bool hasPriority(int priority) const;
 	QList<int> getPriorities() const;
 	const InputInfo& getInputInfo(int priority) const;
-	const QMap<int, InputInfo>& getInputInfoTable() const;
+	QList<InputInfo> getInputInfoTable() const;
 	void registerInput(int priority, hyperhdr::Components component, const QString& origin = "System", const ColorRgb& staticColor = ColorRgb::BLACK, unsigned smooth_cfg = SMOOTHING_DEFAULT_CONFIG, const QString& owner = "");
 	bool setInput(int priority, int64_t timeout_ms);
 	bool setInputInactive(int priority);
@@ -68,16 +71,29 @@ signals:
 private slots:
 	void timeTrigger();
 	void setCurrentTime();
+	void checkTimeouts();
 
 private:
+	static constexpr int PRIORITY_SLOTS = 256;
+
+	static bool isValidPriority(int priority) { return priority >= 0 && priority < PRIORITY_SLOTS; }
+	bool isRegistered(int priority) const { return isValidPriority(priority) && _registered.test(priority); }
+	static bool isTimedInput(const InputInfo& input);
 	hyperhdr::Components getComponentOfPriority(int priority) const;
 
 	LoggerName _log;
-	int _currentPriority;
+	std::atomic<int> _currentPriority;
 	int _previousPriority;
 	int _manualSelectedPriority;
 	hyperhdr::Components _prevVisComp = hyperhdr::COMP_INVALID;
-	QMap<int, InputInfo> _activeInputs;
+
+	// the priority is the index: lookups on the frame path never walk or allocate,
+	// the timeouts are checked against the single earliest deadline instead of visiting every input
+	std::array<InputInfo, PRIORITY_SLOTS> _inputs;
+	std::bitset<PRIORITY_SLOTS> _registered;
+	int64_t _nextDeadline;
+	bool _hasTimedInputs;
+	bool _evaluationPending;
 	InputInfo _lowestPriorityInfo;
 	bool _sourceAutoSelectEnabled;
 
@@ -0,0 +1,90 @@
+#pragma once
+
+/* SoundAnalyzer.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <atomic>
+	#include <cstdint>
+	#include <vector>
+#endif
+
+#include <base/SoundCaptureResult.h>
+#include <utils/TripleBuffer.h>
+
+///
+/// Spectrum analyzer of the captured sound: Hann window, real input FFT (computed as a half size complex FFT)
+/// and band mapping precomputed for the selected size. The captured samples go to a ring buffer and a new frame
+/// is analysed every 'hop' samples, so the frames overlap by the configured percentage.
+/// process() belongs to the capture thread, the results are published to any number of readers without locks.
+///
+class SoundAnalyzer
+{
+public:
+	static constexpr int SAMPLE_RATE = 22050;
+	static constexpr int DEFAULT_SIZE = 1024;
+
+	SoundAnalyzer();
+
+	void configure(int fftSize, int overlap);
+	void reset();
+
+	int process(const int16_t* samples, int count, int64_t captureTime);
+	bool isLastFrameSilent() const;
+
+	uint32_t getResultIndex() const;
+	bool getResult(SoundCaptureResult& target) const;
+
+	int getSize() const;
+	int getHop() const;
+
+private:
+	void analyzeFrame(const int16_t* frame, int64_t captureTime);
+
+	int		_size;
+	int		_hop;
+	float	_scale;
+	bool	_lastFrameSilent;
+
+	std::vector<int16_t>	_ring;
+	uint64_t				_written;
+	uint64_t				_nextFrameEnd;
+	std::vector<int16_t>	_frame;
+	std::vector<float>		_window;
+	std::vector<uint32_t>	_bitReverse;
+	std::vector<float>		_twiddleRe;
+	std::vector<float>		_twiddleIm;
+	std::vector<float>		_splitRe;
+	std::vector<float>		_splitIm;
+	std::vector<float>		_re;
+	std::vector<float>		_im;
+	std::vector<int>		_bandEdges;
+
+	SoundCaptureResult			_result;
+	TripleBuffer<SoundCaptureResult> _published;
+	std::atomic<uint32_t>		_resultIndex;
+};
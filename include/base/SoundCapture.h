@@ -5,11 +5,15 @@
 	#include <QMutex>
 	#include <QJsonObject>
 	#include <QJsonArray>
+
+	#include <atomic>
 #endif
 
 #include <utils/Logger.h>
 #include <utils/settings.h>
 #include <base/SoundCaptureResult.h>
+#include <base/SoundAnalyzer.h>
+#include <utils/InfoSnapshot.h>
 
 class AnimationBaseMusic;
 
@@ -30,16 +34,24 @@ protected:
 	QString			_normalizedName;
 	bool			_isRunning;
 	QList<uint32_t>	_instances;
+	int				_fftSize;
+	int				_fftOverlap;
+	bool			_lowLatency;
+	SoundAnalyzer	_analyzer;
+	int64_t			_latencyReportInterval;
 
 public:
 	bool analyzeSpectrum(int16_t soundBuffer[], int sizeP);
+	bool analyzeSamples(const int16_t* samples, int count, int64_t captureTime);
 
 	SoundCaptureResult* hasResult(AnimationBaseMusic* effect, uint32_t& lastIndex, bool* newAverage, bool* newSlow, bool* newFast, int* isMulti);
 	virtual void		start() = 0;
 	virtual void		stop() = 0;
+	bool				getPublishedJsonInfo(QJsonObject& info, quint64* revision = nullptr);
 
 public slots:
 	QJsonObject getJsonInfo();
+	void		publishJsonInfo();
 	uint32_t	open();
 	void		close(uint32_t instance);
 	void		settingsChangedHandler(settings::type type, const QJsonDocument& config);
@@ -50,10 +62,30 @@ private:
 	QString				getSelectedDevice() const;
 	uint32_t            _maxInstance;
 
+	struct LatencyCounter
+	{
+		std::atomic<int64_t> sum{ 0 };
+		std::atomic<int64_t> max{ 0 };
+		std::atomic<int64_t> count{ 0 };
+		std::atomic<int64_t> lastAverage{ -1 };
+		std::atomic<int64_t> lastMax{ -1 };
+
+		void add(int64_t latency);
+		void report();
+	};
+
+	void reportLatency();
+
+	///
+	/// Both stages start at the capture time of the analysed frame. The render stage ends when a music effect takes
+	/// the new result to draw its next frame: the smoothing and the LED write that follow are not part of it.
+	///
+	LatencyCounter		_analysisLatency;
+	LatencyCounter		_renderLatency;
+	int64_t				_lastLatencyReport;
+	InfoSnapshot<QJsonObject> _jsonInfo;
+
 	static uint32_t	    _noSoundCounter;
 	static bool			_noSoundWarning;
 	static bool			_soundDetectedInfo;
-
-	static inline int16_t  FIX_MPY(int16_t  a, int16_t  b);
-	static int32_t fix_fft(int16_t fr[], int16_t fi[], int16_t exp, bool inverse);
 };
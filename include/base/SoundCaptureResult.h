@@ -51,6 +51,7 @@ class SoundCaptureResult
 	int32_t  _currentMax;
 
 	MovingTarget mtWorking, mtInternal;
+	int64_t  _captureTime;
 
 
 public:
@@ -60,6 +61,8 @@ public:
 	void AddResult(int samplerIndex, uint32_t val);
 	void Smooth();
 	uint32_t getResultIndex();
+	int64_t getCaptureTime() const;
+	void setCaptureTime(int64_t captureTime);
 	void ResetData();
 	void GetBufResult(uint8_t* dest, size_t size);
 	ColorRgb getRangeColor(uint8_t index) const;
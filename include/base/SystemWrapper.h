@@ -15,6 +15,7 @@
 #include <utils/Logger.h>
 #include <utils/settings.h>
 #include <utils/Components.h>
+#include <utils/InfoSnapshot.h>
 
 #include <base/Grabber.h>
 
@@ -30,9 +31,11 @@ public:
 	~SystemWrapper() override;
 
 	virtual bool isActivated(bool forced);
+	bool getPublishedJsonInfo(QJsonObject& info, quint64* revision = nullptr);
 
 public slots:
 	QJsonObject getJsonInfo();
+	void publishJsonInfo();
 
 	void newCapturedFrameHandler(const Image<ColorRgb>& image);
 	void capturingExceptionHandler(const char* err);
@@ -59,6 +62,7 @@ protected:
 	LoggerName	_log;
 	bool		_configLoaded;
 	Grabber*	_grabber;
+	InfoSnapshot<QJsonObject> _jsonInfo;
 
 	static inline std::list<int> GRABBER_SYSTEM_CLIENTS;
 };
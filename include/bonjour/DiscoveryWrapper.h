@@ -35,6 +35,7 @@
 #include <bonjour/DiscoveryRecord.h>
 #include <utils/Logger.h>
 #include <led-drivers/LedDevice.h>
+#include <utils/InfoSnapshot.h>
 
 class DiscoveryWrapper : public QObject
 {
@@ -48,6 +49,8 @@ public:
 	DiscoveryWrapper(QObject* parent = nullptr);
 	~DiscoveryWrapper();
 
+	bool getPublishedServices(QList<DiscoveryRecord>& services, quint64* revision = nullptr);
+
 public slots:
 	QList<DiscoveryRecord> getPhilipsHUE();
 	QList<DiscoveryRecord> getHomeAssistant();
@@ -55,6 +58,7 @@ public slots:
 	QList<DiscoveryRecord> getHyperk();
 	QList<DiscoveryRecord> getHyperHDRServices();
 	QList<DiscoveryRecord> getAllServices();	
+	void publishServices();
 
 	void signalDiscoveryEventHandler(const DiscoveryRecord& message);
 	void signalDiscoveryRequestToScanHandler(DiscoveryRecord::Service type);
@@ -69,4 +73,5 @@ private:
 
 	// contains all current active service sessions
 	QList<DiscoveryRecord> _hyperhdrSessions, _wledDevices, _hyperkDevices, _hueDevices, _homeAssistantDevices, _espDevices, _picoDevices, _esp32s2Devices;
+	InfoSnapshot<QList<DiscoveryRecord>> _services;
 };
@@ -10,6 +10,7 @@
 #include <image/Image.h>
 #include <effects/EffectDefinition.h>
 #include <effects/EffectManufactory.h>
+#include <effects/EffectLedSampler.h>
 
 template <typename T>
 AnimationBase* EffectFactory()
@@ -31,6 +32,8 @@ public:
 	virtual bool isSoundEffect();
 	virtual bool hasOwnImage();
 	virtual bool getImage(Image<ColorRgb>& image);
+	virtual bool hasPointRenderer();
+	virtual void PlayPoints(const std::vector<EffectLedSampler::Point>& points, std::vector<ColorRgb>& colors);
 
 private:
 	int     _sleepTime;
@@ -17,8 +17,7 @@ public:
 
 	bool isSoundEffect() override;
 
-	void store(MovingTarget* source);
-	void restore(MovingTarget* target);
+	SoundCaptureResult* soundResult();
 
 	void Init(
 		HyperImage& hyperImage,
@@ -26,6 +25,6 @@ public:
 
 	std::function<SoundCaptureResult* (AnimationBaseMusic* effect, uint32_t& lastIndex, bool* newAverage, bool* newSlow, bool* newFast, int* isMulti)> hasResult;
 private:
-	MovingTarget _myTarget;
+	SoundCaptureResult _soundResult;
 };
 
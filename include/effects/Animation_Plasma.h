@@ -18,6 +18,10 @@ public:
 
 	bool Play(HyperImage& painter) override;
 
+	bool hasPointRenderer() override;
+
+	void PlayPoints(const std::vector<EffectLedSampler::Point>& points, std::vector<ColorRgb>& colors) override;
+
 	static EffectDefinition getDefinition();
 
 private:
@@ -3,10 +3,11 @@
 #ifndef PCH_ENABLED
 	#include <QThread>
 	#include <QJsonObject>
-	#include <QTimer>
 	#include <QVector>
 
-	#include <atomic>	
+	#include <atomic>
+	#include <mutex>
+	#include <vector>
 #endif
 
 #include <hyperimage/HyperImage.h>
@@ -14,10 +15,13 @@
 #include <utils/Components.h>
 #include <image/Image.h>
 #include <effects/AnimationBase.h>
+#include <effects/EffectLedSampler.h>
+#include <base/LedString.h>
 #include <utils/Logger.h>
 
 class HyperHdrInstance;
 class SoundCapture;
+class EffectScheduler;
 
 class Effect : public QObject
 {
@@ -29,9 +33,11 @@ public slots:
 	void stop();
 
 	void visiblePriorityChanged(quint8 priority);
+	void moveToScheduler(EffectScheduler* scheduler);
 
 public:
 	Effect(HyperHdrInstance* hyperhdr,
+			EffectScheduler* scheduler,
 			int visiblePriority,
 			int priority,
 			int timeout,
@@ -44,7 +50,10 @@ public:
 
 	int  getPriority() const;
 	void requestInterruption();
+	void requestIsolation();
 	void setLedCount(int newCount);
+	void setLedLayout(const std::vector<LedString::Led>& leds);
+	void setImageRequired(bool required);
 
 	QString getName()     const;
 	int getTimeout()      const;
@@ -55,10 +64,12 @@ signals:
 	void SignalSetLeds(int priority, const QVector<ColorRgb>& ledColors, int timeout_ms, bool clearEffect);
 	void SignalSetImage(int priority, const Image<ColorRgb>& image, int timeout_ms, bool clearEffect);
 	void SignalEffectFinished(int priority, QString name, bool forced);
+	void SignalIsolationRequested();
 
 private:
 	void imageShow(int left);
 	void ledShow(int left);
+	bool prepareSampler();
 
 	int					_visiblePriority;
 	const int			_priority;
@@ -76,8 +87,17 @@ private:
 	std::atomic<bool>	_interrupt;
 
 	HyperImage			_image;
-	
-	QTimer				_timer;
+
+	EffectScheduler*	_scheduler;
+	std::mutex			_schedulerMutex;
+	int					_period;
 	QVector<ColorRgb>	_ledBuffer;	
 	std::atomic<int>	_ledCount;
+
+	EffectLedSampler		_sampler;
+	std::vector<ColorRgb>	_pointColors;
+	std::mutex				_layoutMutex;
+	std::vector<LedString::Led>	_ledLayout;
+	std::atomic<bool>		_layoutChanged;
+	std::atomic<bool>		_imageRequired;
 };
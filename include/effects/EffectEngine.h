@@ -17,6 +17,7 @@
 
 class Effect;
 class EffectDBHandler;
+class EffectScheduler;
 
 class EffectEngine : public QObject
 {
@@ -34,9 +35,12 @@ public slots:
 	std::list<ActiveEffectDefinition> getActiveEffects() const;
 	void visiblePriorityChanged(quint8 priority);
 	void handlerSetLeds(int priority, const QVector<ColorRgb>& ledColors, int timeout_ms = -1, bool clearEffect = true);
+	void setLedLayout(const std::vector<LedString::Led>& leds);
+	void setImageRequired(bool required);
 
 private slots:
 	void handlerEffectFinished(int priority, QString name, bool forced);
+	void handlerIsolationRequested();
 
 
 private:
@@ -45,8 +49,11 @@ private:
 
 	HyperHdrInstance* _hyperInstance;
 	std::list<EffectDefinition> _availableEffects;
+	std::shared_ptr<EffectScheduler> _scheduler;
+	std::shared_ptr<EffectScheduler> _dedicatedScheduler;
 	std::list<std::unique_ptr<Effect, void(*)(Effect*)>> _activeEffects;
 
 	LoggerName _log;
 	EffectDBHandler* _effectDBHandler;
+	bool _imageRequired;
 };
@@ -0,0 +1,80 @@
+#pragma once
+
+/* EffectLedSampler.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QVector>
+
+	#include <cstdint>
+	#include <vector>
+#endif
+
+#include <image/ColorRgb.h>
+#include <image/Image.h>
+#include <base/LedString.h>
+
+///
+/// Maps the effect surface directly to the LEDs: each LED area is represented by a few sample points
+/// (up to 3x3) instead of every pixel, so the effects don't have to go through the image-to-LED averaging.
+/// Effects that can evaluate their function at an arbitrary point render only these points.
+///
+class EffectLedSampler
+{
+public:
+	static constexpr int SAMPLES_PER_AXIS = 3;
+
+	struct Point
+	{
+		int x;
+		int y;
+	};
+
+	EffectLedSampler();
+
+	void build(const std::vector<LedString::Led>& leds, int width, int height);
+
+	bool matches(int width, int height) const;
+
+	int ledCount() const;
+
+	const std::vector<Point>& points() const;
+
+	void sample(const Image<ColorRgb>& image, QVector<ColorRgb>& ledColors);
+
+	void reduce(const std::vector<ColorRgb>& pointColors, QVector<ColorRgb>& ledColors) const;
+
+private:
+	int _width;
+	int _height;
+	int _ledCount;
+
+	std::vector<Point>		_points;
+	std::vector<uint32_t>	_ledFirstPoint;
+	std::vector<int>		_ledSource;
+	std::vector<ColorRgb>	_pointColors;
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+/* EffectScheduler.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QObject>
+	#include <QThread>
+	#include <QTimer>
+
+	#include <cstdint>
+	#include <functional>
+	#include <memory>
+	#include <mutex>
+	#include <queue>
+	#include <unordered_map>
+	#include <vector>
+#endif
+
+#include <utils/Logger.h>
+
+class Effect;
+
+///
+/// One thread and one precise timer that tick every running effect of every instance in deadline order.
+/// Deadlines are aligned to the grid of their period, so effects with the same sleep time share a single wakeup.
+/// An effect whose ticks keep exceeding HEAVY_TICK on the shared scheduler asks its engine to move the instance's effects
+/// to a dedicated scheduler, so one heavy effect can't delay the other instances.
+/// All methods except getInstance() and createDedicated() must be called from the scheduler thread (effects are moved there).
+///
+class EffectScheduler : public QObject
+{
+	Q_OBJECT
+
+public:
+	struct TickStatistics
+	{
+		uint64_t	ticks = 0;
+		uint64_t	overruns = 0;
+		int64_t		jitterSum = 0;
+		int64_t		jitterMax = 0;
+		int64_t		busyMax = 0;
+	};
+
+	static std::shared_ptr<EffectScheduler> getInstance();
+	static std::shared_ptr<EffectScheduler> createDedicated(const QString& name);
+
+	~EffectScheduler() override;
+
+	void schedule(Effect* effect, int periodMs);
+	void setPeriod(Effect* effect, int periodMs);
+	void unschedule(Effect* effect);
+	bool isScheduled(Effect* effect) const;
+	TickStatistics getStatistics(Effect* effect) const;
+	bool isShared() const;
+
+private slots:
+	void handleTimer();
+
+private:
+	EffectScheduler(const QString& name, bool shared);
+
+	static std::shared_ptr<EffectScheduler> create(const QString& name, bool shared);
+
+	struct Slot
+	{
+		int64_t			period;
+		uint64_t		generation;
+		TickStatistics	stats;
+		uint64_t		reportedOverruns;
+		int				heavyTicks;
+	};
+
+	struct Deadline
+	{
+		int64_t		time;
+		Effect*		effect;
+		uint64_t	generation;
+
+		bool operator>(const Deadline& other) const
+		{
+			return time > other.time;
+		}
+	};
+
+	static int64_t alignToPeriod(int64_t time, int64_t period);
+	void armTimer();
+	void report(int64_t now);
+
+	LoggerName	_log;
+	const bool	_shared;
+	QTimer*		_timer;
+	uint64_t	_generation;
+	int64_t		_lastReport;
+
+	std::unordered_map<Effect*, Slot> _slots;
+	std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> _queue;
+
+	static std::mutex _instanceMutex;
+	static std::weak_ptr<EffectScheduler> _instance;
+};
@@ -36,7 +36,7 @@ public:
 		unsigned	__cropBottom, unsigned __cropRight,
 		quint64		__currentFrame, qint64 __frameBegin,
 		int			__hdrToneMappingEnabled, uint8_t* __lutBuffer,
-		bool		__qframe, bool __directAccess, QString __deviceName, AutomaticToneMapping* __automaticToneMapping);
+		bool		__qframe, int __mjpegDecimation, bool __directAccess, QString __deviceName, AutomaticToneMapping* __automaticToneMapping);
 
 	v4l2_buffer* GetV4L2Buffer();
 	struct v4l2_buffer  _v4l2Buf;
@@ -49,7 +49,7 @@ public:
 		unsigned	__cropLeft, unsigned  __cropTop,
 		unsigned	__cropBottom, unsigned __cropRight,
 		quint64		__currentFrame, qint64 __frameBegin,
-		int			__hdrToneMappingEnabled, uint8_t* __lutBuffer, bool __qframe,
+		int			__hdrToneMappingEnabled, uint8_t* __lutBuffer, bool __qframe, int __mjpegDecimation,
 		bool		__directAccess, QString __deviceName, AutomaticToneMapping* __automaticToneMapping);
 #endif
 
@@ -70,10 +70,16 @@ signals:
 
 private:
 	void runMe();
-	void process_image_jpg_mt();
+	bool process_image(Image<ColorRgb>& image);
+	bool process_image_jpg_mt(Image<ColorRgb>& image);
+	void sendFrame(Image<ColorRgb>& image);
+	FrameTiming getFrameTiming() const;
 
 	#ifndef __APPLE__
+		tjscalingfactor selectJpegScaling(bool yuvOutput) const;
+
 		tjhandle 	_decompress;
+		MemoryBuffer<uint8_t> _decodeBuffer;
 	#endif
 
 	static inline std::atomic<bool> _isActive;
@@ -99,6 +105,7 @@ private:
 	uint8_t	    _hdrToneMappingEnabled;
 	uint8_t*	_lutBuffer;
 	bool		_qframe;
+	int			_mjpegDecimation;
 	bool		_directAccess;
 	QString		_deviceName;
 	AutomaticToneMapping* _automaticToneMapping;
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef PCH_ENABLED
+	#include <vector>
+#endif
+
+#include <utils/PixelFormat.h>
+#include <utils/FrameRecording.h>
+#include <base/Grabber.h>
+#include <grabber/GrabberWorker.h>
+
+class QTimer;
+
+///
+/// Replays a raw capture recording (see FrameRecorder) through the regular grabber workers.
+/// Selected with the video device name "file:<path>" (original frame timing) or "file-max:<path>"
+/// (as fast as the workers can decode). The recording is looped.
+///
+class FileGrabber final : public Grabber
+{
+	Q_OBJECT
+
+public:
+	FileGrabber(const QString& device, const QString& configurationPath);
+
+	~FileGrabber();
+
+	static bool isFileDevice(const QString& device);
+
+	void setHdrToneMappingEnabled(int mode) override;
+
+public slots:
+
+	bool start() override;
+
+	void stop() override;
+
+	void newWorkerFrameHandler(unsigned int workerIndex, Image<ColorRgb> image, quint64 sourceCount, qint64 _frameBegin) override;
+
+	void newWorkerFrameErrorHandler(unsigned int workerIndex, QString error, quint64 sourceCount) override;
+
+private slots:
+	void replayFrame();
+
+private:
+	bool init() override;
+
+	void uninit() override;
+
+	void loadLutFile(PixelFormat color = PixelFormat::NO_CHANGE, bool silent = false);
+
+	bool readNextFrame();
+
+	bool isLutRequired() const;
+
+	void releaseWorker(unsigned int workerIndex, quint64 sourceCount);
+
+	QString				_fileName;
+	bool				_maximumSpeed;
+	FrameRecordingReader _reader;
+	QTimer*				_timer;
+	GrabberManager		_fileWorkerManager;
+
+	std::vector<std::vector<uint8_t>> _workerFrames;
+	std::vector<uint8_t> _pendingFrame;
+	size_t				_pendingSize;
+	int64_t				_pendingTimestamp;
+	bool				_hasPending;
+
+	int64_t				_loopStart;
+	quint64				_loopFrames;
+	quint64				_loopDropped;
+};
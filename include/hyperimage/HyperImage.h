@@ -21,6 +21,7 @@ public:
 	int height() const;
 
 	Image<ColorRgb> renderImage() const;
+	const Image<ColorRgb>& surface() const;
 
 	void resize(int sizeX, int sizeY);
 	void setPen(const ColorRgb& color);
@@ -0,0 +1,105 @@
+#pragma once
+
+/* FrameAllocator.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <array>
+	#include <atomic>
+	#include <cstdint>
+	#include <cstddef>
+	#include <mutex>
+	#include <string>
+	#include <vector>
+#endif
+
+///
+/// Frame buffer allocator shared by all images.
+/// Requests are rounded up to one of the size classes (four classes per power of two, so the waste stays below 25%),
+/// every class has its own depot, so grabbers, effects and network sources running at different resolutions
+/// do not evict each other's buffers. The most recently released buffers stay in a small per-thread magazine
+/// and are reused without locking. Buffers are 64-byte aligned, the large ones are 2MB aligned and marked
+/// as transparent hugepage candidates on Linux.
+///
+class FrameAllocator
+{
+public:
+	static constexpr int MIN_CLASS_SHIFT = 14;
+	static constexpr int MAX_CLASS_SHIFT = 27;
+	static constexpr int CLASSES_PER_POWER = 4;
+	static constexpr int CLASS_COUNT = (MAX_CLASS_SHIFT - MIN_CLASS_SHIFT) * CLASSES_PER_POWER;
+	static constexpr int NO_CLASS = -1;
+	static constexpr int MAGAZINE_SIZE = 2;
+	static constexpr size_t DEPOT_LIMIT = 8;
+
+	struct Block
+	{
+		uint8_t* data = nullptr;
+		size_t size = 0;
+		int sizeClass = NO_CLASS;
+	};
+
+	FrameAllocator();
+	~FrameAllocator();
+
+	Block request(size_t size);
+	void release(Block& block);
+
+	bool setFrameSize(size_t size);
+	std::string adjustCache();
+
+	static int classIndex(size_t size);
+	static size_t classSize(int sizeClass);
+
+	static FrameAllocator frameCache;
+
+private:
+	struct SizeClass
+	{
+		std::mutex locker;
+		std::vector<Block> depot;
+		std::atomic<uint32_t> hits{ 0 };
+		std::atomic<uint32_t> misses{ 0 };
+		std::atomic<uint32_t> dropped{ 0 };
+		std::atomic<bool> needed{ false };
+		bool prevNeeded = true;
+		size_t prevCached = 0;
+	};
+
+	struct ThreadCache;
+
+	ThreadCache& threadCache();
+	void flushThreadCache(ThreadCache& cache);
+	bool pushToDepot(Block& block);
+
+	static Block allocate(size_t size, int sizeClass);
+	static void deallocate(Block& block);
+
+	std::array<SizeClass, CLASS_COUNT> _classes;
+	std::atomic<int> _frameClass;
+	std::atomic<uint32_t> _epoch;
+};
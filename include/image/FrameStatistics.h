@@ -0,0 +1,94 @@
+#pragma once
+
+/* FrameStatistics.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <array>
+	#include <cstdint>
+#endif
+
+#include <image/ColorRgb.h>
+
+template <typename ColorSpace>
+class Image;
+
+///
+/// Per-frame statistics filled by the FrameDecoder kernels while the output rows are still hot in the cache:
+/// per-channel maxima of a tile grid for the manual signal detection and the source YUV range for the automatic tone mapping.
+/// The grabbers only collect them when one of these consumers is active.
+///
+class FrameStatistics
+{
+public:
+	static constexpr int REGION_GRID = 16;
+
+	struct SourceRange
+	{
+		uint8_t y;
+		uint8_t u;
+		uint8_t v;
+	};
+
+	FrameStatistics(bool collectSourceRange = false);
+
+	void prepare(int width, int height);
+
+	bool collectSourceRange() const;
+
+	void scanRow(int y, const uint8_t* rgbRow);
+
+	void scanImage(const Image<ColorRgb>& image);
+
+	void scanSource_YUYV(int width, const uint8_t* currentSource);
+
+	void scanSource_Y_UV_8(int width, const uint8_t* currentSourceY, const uint8_t* currentSourceUV);
+
+	void scanSource_Y_UV_16(int width, const uint8_t* currentSourceY, const uint8_t* currentSourceUV);
+
+	bool matches(unsigned width, unsigned height) const;
+
+	int width() const;
+
+	int height() const;
+
+	bool regionMax(double xMin, double yMin, double xMax, double yMax, ColorRgb& result) const;
+
+	bool hasSourceRange() const;
+
+	SourceRange sourceRange() const;
+
+private:
+	int _width;
+	int _height;
+	bool _collectSourceRange;
+	bool _hasSourceRange;
+
+	std::array<int, REGION_GRID + 1> _tileStart;
+	std::array<ColorRgb, REGION_GRID * REGION_GRID> _tiles;
+	SourceRange _sourceRange;
+};
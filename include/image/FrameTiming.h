@@ -0,0 +1,55 @@
+#pragma once
+
+/* FrameTiming.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <atomic>
+	#include <cstdint>
+#endif
+
+///
+/// Capture time (InternalClock::nowMicro) and sequence number of a frame. It follows the frame through the
+/// instance and the smoothing up to the LED device, so the latency can be measured where the colors are written.
+/// Colors that don't come from a captured frame (effects, static colors) carry an empty timing.
+///
+struct FrameTiming
+{
+	int64_t		captureTime = 0;
+	uint64_t	sequence = 0;
+
+	bool isValid() const
+	{
+		return captureTime > 0;
+	}
+
+	static FrameTiming capture(int64_t captureTime)
+	{
+		static std::atomic<uint64_t> sequenceCounter{ 0 };
+		return FrameTiming{ captureTime, sequenceCounter.fetch_add(1, std::memory_order_relaxed) + 1 };
+	}
+};
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <image/ImageData.h>
+#include <image/FrameTiming.h>
 
 enum class PixelFormat;
+class FrameStatistics;
 
 template <typename ColorSpace>
 class Image
@@ -44,6 +46,14 @@ public:
 
 	PixelFormat getOriginFormat() const;
 
+	void setStatistics(std::shared_ptr<const FrameStatistics> statistics);
+
+	const FrameStatistics* getStatistics() const;
+
+	void setFrameTiming(const FrameTiming& timing);
+
+	const FrameTiming& getFrameTiming() const;
+
 	void resize(unsigned width, unsigned height);
 
 	uint8_t* rawMem();
@@ -57,6 +67,12 @@ public:
 	bool save(const char* filename) const;
 
 private:
+	static const std::shared_ptr<ImageData<ColorSpace>>& sharedEmptyData();
+
+	void makeWritable();
+
 	std::shared_ptr<ImageData<ColorSpace>> _sharedData;
+	std::shared_ptr<const FrameStatistics> _statistics;
 	PixelFormat	_pixelFormat;
+	FrameTiming	_frameTiming;
 };
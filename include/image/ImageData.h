@@ -5,6 +5,7 @@
 #endif
 
 #include <image/MemoryBuffer.h>
+#include <image/FrameAllocator.h>
 #include <image/ColorRgb.h>
 
 template <typename ColorSpace>
@@ -13,6 +14,10 @@ class ImageData
 public:
 	ImageData(unsigned width, unsigned height);
 
+	ImageData(const ImageData& other) = delete;
+
+	ImageData& operator=(const ImageData& other) = delete;
+
 	bool setBufferCacheSize();
 
 	~ImageData();
@@ -58,7 +63,7 @@ private:
 	unsigned _width;
 	unsigned _height;
 
-	std::unique_ptr<MemoryBuffer<uint8_t>> _memoryBuffer;
+	FrameAllocator::Block _block;
 
 	uint8_t* _pixels;
 };
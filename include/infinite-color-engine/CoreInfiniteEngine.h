@@ -32,7 +32,7 @@ public:
 	bool getAntiFlickeringFilterState();
 	unsigned addCustomSmoothingConfig(unsigned cfgID, int settlingTime_ms, double ledUpdateFrequency_hz, bool pause);
 	void setCurrentSmoothingConfigParams(unsigned cfgID);
-	void incomingColors(std::vector<linalg::aliases::float3>&& _ledBuffer);
+	void incomingColors(std::vector<linalg::aliases::float3>&& _ledBuffer, const FrameTiming& timing);
 	void setProcessingEnabled(bool enabled);
 	void updateCurrentProcessingConfig(const QJsonObject& config);
 	QJsonArray getCurrentProcessingConfig();
@@ -35,7 +35,7 @@ public:
 	void setEnable(bool enable);
 	bool isEnabled() const;
 
-	void incomingColors(std::vector<linalg::aliases::float3>&& nonlinearRgbColors, std::optional<float> minimalBacklight);
+	void incomingColors(std::vector<linalg::aliases::float3>&& nonlinearRgbColors, std::optional<float> minimalBacklight, const FrameTiming& timing = FrameTiming());
 	unsigned addCustomSmoothingConfig(unsigned cfgID, int settlingTime_ms, double ledUpdateFrequency_hz, bool pause);
 	void setCurrentSmoothingConfigParams(unsigned cfgID);
 	bool selectConfig(unsigned cfgId);
@@ -46,7 +46,7 @@ public:
 
 signals:
 	void SignalMasterClockTick();
-	void SignalProcessedColors(SharedOutputColors nonlinearRgbColors);
+	void SignalProcessedColors(SharedOutputColors nonlinearRgbColors, FrameTiming timing);
 
 public slots:
 	void handleSignalInstanceSettingsChanged(settings::type type, const QJsonDocument& config);
@@ -56,7 +56,7 @@ private slots:
 	void updateLeds();
 	
 private:
-	void queueColors(SharedOutputColors&& nonlinearRgbLedColors);
+	void queueColors(SharedOutputColors&& nonlinearRgbLedColors, const FrameTiming& timing);
 	void clearQueuedColors(bool deviceEnabled = false, bool restarting = false);
 
 	unsigned addConfig(int settlingTime_ms, double ledUpdateFrequency_hz = 25.0, bool pause = false);
@@ -95,4 +95,5 @@ private:
 	long long		_lastSentFrame;
 	bool			_antiFlickeringFilter;
 	float			_minimalBacklight;
+	FrameTiming		_targetTiming;
 };
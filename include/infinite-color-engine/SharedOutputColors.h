@@ -36,6 +36,7 @@
 #pragma once
 
 #include <QMetaType>
+#include <image/FrameTiming.h>
 
 namespace linalg {
 	template<class T, int M, int N> struct mat;
@@ -49,3 +50,4 @@ namespace linalg {
 using SharedOutputColors = std::shared_ptr<std::vector<linalg::aliases::float3>>;
 
 Q_DECLARE_METATYPE(SharedOutputColors)
+Q_DECLARE_METATYPE(FrameTiming)
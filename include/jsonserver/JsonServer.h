@@ -13,6 +13,7 @@ class QTcpSocket;
 class JsonClientConnection;
 class BonjourServiceRegister;
 class NetOrigin;
+class NetIoPool;
 class HyperHdrManager;
 
 class JsonServer : public QObject
@@ -32,6 +33,7 @@ public:
 private slots:
 	void newConnection();
 	void signalClientConnectionClosedHandler(JsonClientConnection* client);
+	void signalClientConnectionOpenedHandler(JsonClientConnection* client);
 
 public slots:
 	void handleSettingsUpdate(settings::type type, const QJsonDocument& config);
@@ -42,6 +44,7 @@ private:
 	LoggerName _log;
 
 	std::shared_ptr<NetOrigin> _netOrigin;
+	std::shared_ptr<NetIoPool> _ioPool;
 
 	uint16_t _port;
 
@@ -13,12 +13,30 @@ class InfiniteColorEngineRgbw
 		int8_t flow_control = 0;
 	};
 
+	// white channel split compiled once per configuration: indexed by the common (white) part of the input in 1/16 of an 8-bit step
+	struct OutputTables {
+		static constexpr int WHITE_TABLE_SCALE = 16;
+		static constexpr int WHITE_TABLE_SIZE = 255 * WHITE_TABLE_SCALE + 1;
+
+		float whiteMixerThreshold = -1.0f;
+		float whiteLedIntensity = -1.0f;
+		linalg::aliases::float3 whitePointRgb = linalg::aliases::float3{ -1.0f };
+
+		bool whiteEnabled = false;
+		bool customWhite = false;
+		linalg::aliases::float3 whiteStep = linalg::aliases::float3{ 0.0f };
+		std::vector<float> whiteLevel;
+	};
+
 public:
 	void renderRgbwFrame(const std::vector<linalg::aliases::float3>& infiniteColors, const int currentInterval, const float whiteMixerThreshold, const float whiteLedIntensity, const linalg::aliases::float3& whitePointRgb, std::vector<uint8_t>& output, size_t writeIndex, LedString::ColorOrder colorOrder);
 
 private:
+	void compileOutputTables(const float whiteMixerThreshold, const float whiteLedIntensity, const linalg::aliases::float3& whitePointRgb);
+
 	template<bool CustomWhiteTemp>
-	linalg::aliases::byte4 encodeRgbwFrame(const linalg::aliases::float3& rgbCalibrated, LEDState& state, const float motionThreshold, const float invWhiteMixerMian255, const float whiteMixerThreshold255, const float whiteLedIntensity, const linalg::aliases::float3& whitePointRgb, LedString::ColorOrder colorOrder);
+	linalg::aliases::byte4 encodeRgbwFrame(const linalg::aliases::float3& rgbCalibrated, LEDState& state, const float motionThreshold, LedString::ColorOrder colorOrder);
 
 	std::vector<LEDState> states;
+	OutputTables tables;
 };
@@ -23,6 +23,7 @@
 #include <utils/Logger.h>
 #include <utils/Components.h>
 #include <led-drivers/ColorRgbw.h>
+#include <led-drivers/PacketWriter.h>
 #include <performance-counters/PerformanceCounters.h>
 #include <infinite-color-engine/SharedOutputColors.h>
 #include <base/LedString.h>
@@ -53,7 +54,7 @@ public:
 	bool isInitialised() const;
 	bool isReady() const;
 	bool isInError() const;
-	void setInstanceIndex(int instanceIndex);
+	void setInstanceIndex(int instanceIndex, int outputIndex = 0);
 
 	static void printLedValues(const std::vector<ColorRgb>& ledValues);
 	static void signalTerminateTriggered();
@@ -61,7 +62,7 @@ public:
 public slots:
 	virtual void start();
 	virtual void stop();
-	void handleSignalFinalOutputColorsReady(SharedOutputColors nonlinearRgbColors);
+	void handleSignalFinalOutputColorsReady(SharedOutputColors nonlinearRgbColors, FrameTiming timing);
 	int getRefreshTime() const;
 	int getLedCount() const;
 	QString getActiveDeviceType() const;
@@ -73,6 +74,7 @@ public slots:
 	void blinking(QJsonObject params);
 	void smoothingRestarted(int newSmoothingInterval, bool antiflickeringfilter);
 	int hasLedClock();
+	QJsonObject getPacingInfo();
 	void pauseRetryTimer(bool mode);
 
 signals:
@@ -88,6 +90,8 @@ protected:
 	int write(SharedOutputColors nonlinearRgbColors);
 	virtual std::pair<bool, int> writeInfiniteColors(SharedOutputColors nonlinearRgbColors);
 	virtual int writeFiniteColors(const std::vector<ColorRgb>& ledValues);
+	virtual void preparePacket();
+	virtual int writePacket();
 	virtual int writeBlack(int numberOfBlack = 2);
 	virtual bool powerOn();
 	virtual bool powerOff();
@@ -99,6 +103,14 @@ protected:
 	void startRefreshTimer();
 	void setupRetry(int interval);
 
+	///
+	/// The adaptive pacing measures how long write() takes. Drivers whose transport only queues the data
+	/// report the completion time seen by the transport instead (us), the pacer uses the longer of both:
+	/// the serial drivers with the async writer, Yeelight, WiZ and LIFX (the sending time of the bulb reactor, without its quota waits),
+	/// Home Assistant and Philips Hue without the entertainment API (REST round-trip).
+	///
+	void reportTransportWriteTime(qint64 writeTimeUs);
+
 	QString uint8_t_to_hex_string(const uint8_t* data, const int size, int number = -1) const;
 	QString toHex(const QByteArray& data, int number = -1) const;
 
@@ -107,6 +119,7 @@ protected:
 	LoggerName _log;
 
 	std::vector<uint8_t> _ledBuffer;
+	PacketWriter _packetWriter;
 	QTimer* _refreshTimer;
 
 	LedString::ColorOrder _colorOrder;
@@ -144,11 +157,24 @@ protected slots:
 private:
 	void stopRefreshTimer();
 	void stopRetryTimer();
+	int writeFinitePacket(const SharedOutputColors& nonlinearRgbColors);
+	SharedOutputColors sliceOutputColors(const SharedOutputColors& nonlinearRgbColors) const;
+	void updatePacer(qint64 writeTimeUs);
+	int pacedInterval() const;
+	bool isClockedByMainDevice() const;
+	void scheduleOutputWrite();
+	void writePendingOutputFrame();
 
 	std::atomic_bool	_isRefreshEnabled;
 	std::atomic_bool	_newFrame2Send;
 	SharedOutputColors	_lastLedValues;
 	SharedOutputColors	_lastFinityLedValues;
+	FrameTiming			_lastLedTiming;
+	int					_outputSliceOffset;
+	int					_outputSliceCount;
+	bool				_isAdditionalOutput;
+	uint64_t			_lastWrittenSequence;
+	bool				_outputWritePending;
 
 	struct LedStats
 	{
@@ -161,8 +187,22 @@ private:
 		void reset(int64_t now);
 	} _computeStats;
 
+	struct Pacer
+	{
+		bool		enabled = false;
+		int			interval = 0;
+		double		writeTime = 0;
+		qint64		transportWriteTime = 0;
+		qint64		samples = 0;
+		qint64		lastUpdate = 0;
+		qint64		lastWrite = 0;
+
+		void reset();
+	} _pacer;
+
 	int _blinkIndex;
 	qint64 _blinkTime;
 	int _instanceIndex;
+	int _outputIndex;
 	int _pauseRetryTimer;
 };
@@ -45,10 +45,16 @@ namespace hyperhdr::leds
 		QString name;
 		QString group;
 		LedDeviceConstructor constructor;
-		LedDeviceDefinition(QString _name, QString _group, LedDeviceConstructor _constructor);
+		bool blocking;
+		LedDeviceDefinition(QString _name, QString _group, LedDeviceConstructor _constructor, bool _blocking);
 	};
 
 	const std::list<LedDeviceDefinition>& GET_ALL_LED_DEVICE(const LedDeviceDefinition* ed);
-	bool REGISTER_LED_DEVICE(QString name, QString group, LedDeviceConstructor constructor);
+	///
+	/// Drivers that wait on their sockets or sleep (handshakes, discovery, synchronous replies) must register as blocking:
+	/// they always get a dedicated thread, also when the shared executor is enabled, so they can not stall other strands.
+	///
+	bool REGISTER_LED_DEVICE(QString name, QString group, LedDeviceConstructor constructor, bool blocking = false);
 	LedDevice* CONSTRUCT_LED_DEVICE(const QJsonObject& deviceConfig);
+	bool IS_BLOCKING_LED_DEVICE(const QJsonObject& deviceConfig);
 };
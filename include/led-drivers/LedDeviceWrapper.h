@@ -2,6 +2,9 @@
 
 #ifndef PCH_ENABLED
 	#include <QMutex>
+
+	#include <memory>
+	#include <vector>
 #endif
 
 // util
@@ -11,6 +14,7 @@
 
 class LedDevice;
 class HyperHdrInstance;
+class SharedExecutor;
 
 typedef LedDevice* (*LedDeviceCreateFuncType) (const QJsonObject&);
 typedef std::map<QString, LedDeviceCreateFuncType> LedDeviceRegistry;
@@ -29,13 +33,24 @@ public:
 	unsigned int getLedCount() const;
 	void identifyLed(const QJsonObject& params);
 	int hasLedClock();
+	QJsonObject getPacingInfo();
 
 public slots:
 	void handleComponentState(hyperhdr::Components component, bool state);
 	void handleInternalEnableState(bool newState);
 
 private:
+	using LedDevicePtr = std::unique_ptr<LedDevice, void(*)(LedDevice*)>;
+
+	void launchLedDevice(const QJsonObject& config, int instanceIndex, bool disableOnStartup, int outputIndex);
+	LedDevice* setupLedDevice(const QJsonObject& config, int instanceIndex, bool disableOnStartup, int outputIndex, bool shared);
+	void handleOutputEnableState(LedDevice* device, bool newState);
+	std::vector<LedDevice*> allDevices() const;
+
 	HyperHdrInstance* _ownerInstance;
-	std::unique_ptr<LedDevice, void(*)(LedDevice*)> _ledDevice;
+	LoggerName        _log;
+	std::shared_ptr<SharedExecutor> _executor;
+	LedDevicePtr      _ledDevice;
+	std::vector<LedDevicePtr> _outputDevices;
 	bool              _enabled;
 };
@@ -0,0 +1,51 @@
+#pragma once
+
+#ifndef PCH_ENABLED
+	#include <vector>
+	#include <cstdint>
+	#include <cstddef>
+#endif
+
+#include <infinite-color-engine/SharedOutputColors.h>
+
+///
+/// Wire layout of a driver that sends plain 8-bit RGB. The LED stream is split into segments (UDP packets, DMX universes)
+/// of up to payloadSize bytes, each one preceded by headerSize bytes owned by the driver. Every LED takes stride bytes
+/// of the stream and its color starts at colorOffset. The float output of the smoothing is quantised straight into
+/// the preallocated wire buffer, so there is no intermediate ColorRgb vector and no second copy into the packet.
+/// Bytes of the stream not covered by the colors keep the fill value, trailing frames may be appended by the driver.
+///
+class PacketWriter
+{
+public:
+	struct Layout
+	{
+		size_t headerSize = 0;
+		size_t payloadSize = 0;		// 0 = the whole stream fits in one segment
+		size_t stride = 3;
+		size_t colorOffset = 0;
+		uint8_t fill = 0x00;
+	};
+
+	void setLayout(const Layout& layout);
+	void disable();
+	bool isEnabled() const;
+	const Layout& layout() const;
+
+	bool resize(size_t ledCount);
+	size_t ledCount() const;
+	size_t segmentCount() const;
+	size_t segmentPayload(size_t index) const;
+	uint8_t* segment(size_t index);
+	std::vector<uint8_t>& buffer();
+
+	void encode(const std::vector<linalg::aliases::float3>& colors);
+
+private:
+	bool _enabled = false;
+	Layout _layout;
+	size_t _ledCount = 0;
+	size_t _streamSize = 0;
+	size_t _segmentCount = 0;
+	std::vector<uint8_t> _buffer;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#ifndef PCH_ENABLED
+	#include <QString>
+	#include <QStringList>
+	#include <QTimer>
+
+	#include <functional>
+	#include <memory>
+	#include <vector>
+#endif
+
+#include <utils/Logger.h>
+
+///
+/// Event-driven writer shared by the drivers that control a set of independent bulbs.
+/// The driver keeps the latest state of every bulb and calls submit(); the reactor decides when
+/// the state is actually sent: at most once per the vendor quota interval of that bulb and never
+/// while the bulb reports it is still busy. Newer states overwrite the pending one, so a slow bulb
+/// only delays itself and never stalls the update of the other bulbs.
+///
+class BulbReactor
+{
+public:
+	enum class SendResult { Sent, Busy, Failed };
+
+	using SendFunction = std::function<SendResult(int bulb)>;
+
+	BulbReactor(const LoggerName& log, SendFunction send);
+	~BulbReactor();
+
+	void setBulbs(const QStringList& names, int minInterval);
+	void submit(int bulb);
+	void kick(int bulb);
+	void flush();
+	void report();
+	///
+	/// Time (us) spent sending the states since the previous call, the quota and busy waits are not included
+	///
+	qint64 takeSendTime();
+
+private:
+	struct Bulb
+	{
+		QString name;
+		int minInterval = 0;
+		bool pending = false;
+		qint64 pendingSince = 0;
+		qint64 lastSent = 0;
+
+		qint64 submitted = 0;
+		qint64 sent = 0;
+		qint64 coalesced = 0;
+		qint64 failed = 0;
+		qint64 latencySum = 0;
+		qint64 latencyMax = 0;
+	};
+
+	void dispatch(int bulb, qint64 now, bool force);
+	void dispatchAll();
+	void schedule(qint64 now);
+
+	LoggerName _log;
+	SendFunction _send;
+	std::vector<Bulb> _bulbs;
+	std::unique_ptr<QTimer> _timer;
+	qint64 _lastReport;
+	qint64 _sendTime;
+};
@@ -14,6 +14,8 @@ protected:
 	int writeFiniteColors(const std::vector<ColorRgb>& ledValues) override;
 	int writeFiniteColors(bool isRgbw, const int ledsNumber, const std::vector<ColorRgb>& ledValues);
 	std::pair<bool, int> writeInfiniteColors(SharedOutputColors nonlinearRgbColors) override;
+	void preparePacket() override;
+	int writePacket() override;
 
 	InfiniteColorEngineRgbw _infiniteColorEngineRgbw;
 	bool _enable_ice_rgbw;
@@ -32,6 +34,7 @@ protected:
 
 	std::vector<uint8_t> _rgbwBuffer;
 	std::vector<uint8_t> _ddpFrame;
+	uint8_t _sequenceNum;
 
 	static bool isRegistered;
 };
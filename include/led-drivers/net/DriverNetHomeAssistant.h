@@ -60,11 +60,13 @@ private:
 	bool powerOnOff(bool isOn);
 	bool saveStates();
 	void restoreStates();
+	void reportRoundTrip();
 
 	HomeAssistantInstance _haInstance;
 
 	std::unique_ptr<ProviderRestApi> _restApi;
 	long long						_lastUpdate;
+	long long						_lastStatsReport;
 
 	static bool isRegistered;
 };
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "ProviderUdp.h"
+#include "BulbReactor.h"
 #include <array>
+#include <memory>
 #include <vector>
 #include <utility>
 #include <tuple>
@@ -24,8 +26,12 @@ protected:
 	bool powerOn() override;
 	bool powerOff() override;
 	void setPower(uint16_t power);
+	BulbReactor::SendResult sendLamp(int index);
 
 	std::vector<IpMacAddress> lamps;
+	std::vector<linalg::vec<float, 3>> lampColors;
+	std::unique_ptr<BulbReactor> reactor;
+	int bytesWritten;
 	int transition;
 	static bool isRegistered;
 };
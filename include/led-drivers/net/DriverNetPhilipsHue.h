@@ -88,9 +88,11 @@ public:
 	bool initRestAPI(const QString& hostname, int port, const QString& token);
 	QJsonDocument get(const QString& route);
 	QJsonDocument post(const QString& route, const QString& content, bool supressError = false);
+	void putAsync(const QString& route, const QString& content);
 
 	QJsonDocument getLightState(unsigned int lightId);
 	void setLightState(unsigned int lightId = 0, const QString& state = "");
+	void setLightStateAsync(unsigned int lightId, const QString& state);
 
 	QMap<quint16, QJsonObject> getLightMap() const;
 
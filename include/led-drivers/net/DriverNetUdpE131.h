@@ -29,7 +29,8 @@ public:
 
 private:
 	bool init(QJsonObject deviceConfig) override;
-	int writeFiniteColors(const std::vector<ColorRgb>& ledValues) override;
+	void preparePacket() override;
+	int writePacket() override;
 	void prepare(unsigned this_universe, unsigned this_dmxChannelCount);
 
 	std::unique_ptr<e131_packet_t> e131_packet;
@@ -5,9 +5,11 @@
 	#include <QJsonObject>
 	#include <QString>
 	#include <vector>
+	#include <memory>
 #endif
 
 #include <led-drivers/net/ProviderUdp.h>
+#include <led-drivers/net/BulbReactor.h>
 
 class DriverNetWiz : public ProviderUdp
 {
@@ -32,13 +34,17 @@ private:
 		QString name;
 		QHostAddress ipAddress;
 		QString macAddress;
+		ColorRgb color;
 	};
 
 	QByteArray buildSetPilotPacket(int r, int g, int b) const;
 	QByteArray buildPowerPacket(bool on) const;
+	BulbReactor::SendResult sendLamp(int index);
 
 	int _dimming;
 	std::vector<WizLamp> _lamps;
+	std::unique_ptr<BulbReactor> _reactor;
+	int _bytesWritten;
 
 	static bool isRegistered;
 };
@@ -6,6 +6,7 @@
 #endif
 
 #include <led-drivers/LedDevice.h>
+#include <led-drivers/net/BulbReactor.h>
 
 class QTcpSocket;
 class QTcpServer;
@@ -94,6 +95,8 @@ public:
 	int writeCommand(const QJsonDocument& command, QJsonArray& result);
 	bool streamCommand(const QJsonDocument& command);
 	void setStreamSocket(QTcpSocket* socket);
+	bool isStreamBusy() const;
+	QString getHost() const { return _host; }
 	bool setPower(bool on);
 	bool setPower(bool on, API_EFFECT effect, int duration, API_MODE mode = API_RGB_MODE);
 	bool setColorRGB(const ColorRgb& color);
@@ -101,6 +104,12 @@ public:
 	void setTransitionEffect(API_EFFECT effect, int duration = API_PARAM_DURATION.count());
 	void setBrightnessConfig(int min = 1, int max = 100, bool switchoff = false, int extraTime = 0, double factor = 1);
 	bool setMusicMode(bool on, const QHostAddress& hostAddress = {}, int port = -1);
+	///
+	/// Sends the music mode request without waiting for the reply, so it can be used from the write path.
+	/// pollReply() checks the reply without blocking: 1 still pending, 0 accepted, -1 error, -2 quota exceeded.
+	///
+	bool requestMusicMode(const QHostAddress& hostAddress, int port);
+	int pollReply();
 	void setQuotaWaitTime(int waitTime) { _waitTimeQuota = waitTime; }
 	QJsonObject getProperties();
 	void storeState();
@@ -127,6 +136,7 @@ private:
 	QTcpSocket* _tcpSocket;
 	QTcpSocket* _tcpStreamSocket;
 	int _correlationID;
+	int _pendingReplyId;
 	qint64	_lastWriteTime;
 	ColorRgb _color;
 	int _lastColorRgbValue;
@@ -192,13 +202,24 @@ private:
 		MODEL_RGB
 	};
 
+	struct LightState
+	{
+		ColorRgb color;
+		qint64 streamRequested = 0;
+		qint64 nextStreamAttempt = 0;
+	};
+
 	bool startMusicModeServer();
 	bool stopMusicModeServer();
+	void handleStreamConnection();
+	BulbReactor::SendResult sendLight(int index);
 	bool updateLights(const QVector<yeelightAddress>& list);
 	void setLightsCount(unsigned int lightsCount) { _lightsCount = lightsCount; }
 	uint getLightsCount() const { return _lightsCount; }
 	QVector<yeelightAddress> _lightsAddressList;
 	std::vector<YeelightLight> _lights;
+	std::vector<LightState> _lightStates;
+	std::unique_ptr<BulbReactor> _reactor;
 	unsigned int _lightsCount;
 	int _outputColorModel;
 	YeelightLight::API_EFFECT _transitionEffect;
@@ -6,8 +6,11 @@
 	#include <QThread>
 	#include <QJsonDocument>
 	#include <QNetworkReply>
+	#include <QMap>
 
-	#include <memory>	
+	#include <atomic>
+	#include <functional>
+	#include <memory>
 #endif
 
 #include <utils/Logger.h>
@@ -20,11 +23,20 @@ class QNetworkReply;
 class ProviderRestApi
 {
 public:
+	struct RoundTripStats
+	{
+		qint64 requests = 0;
+		qint64 coalesced = 0;
+		qint64 failed = 0;
+		double averageMs = 0;
+		double maxMs = 0;
+	};
+
 	ProviderRestApi();
 	ProviderRestApi(const QString& host, int port);
 	ProviderRestApi(const QString& host, int port, const QString& basePath);
 	ProviderRestApi(QString scheme, QString host, int port, QString basePath = "");
-	virtual ~ProviderRestApi() = default;
+	virtual ~ProviderRestApi();
 
 	void  updateHost(const QString& host, int port);
 	QUrl getUrl() const;
@@ -41,11 +53,19 @@ public:
 	httpResponse get(const QUrl& url);
 	httpResponse put(const QUrl& url, const QString& body = "");
 	httpResponse post(const QUrl& url, const QString& body);
+
+	void putAsync(const QString& key, const QString& body);
+	void postAsync(const QString& key, const QString& body);
+	void setAsyncErrorHandler(QObject* context, std::function<void(const QString&)> handler);
+	RoundTripStats getRoundTripStats(bool reset = false);
+	qint64 getLastRoundTrip() const;
+
 	void releaseResultLock();
 
 private:
 	void appendPath(QString& path, const QString& appendPath) const;
 	httpResponse executeOperation(QNetworkAccessManager::Operation op, const QUrl& url, const QString& body = "");
+	void executeAsync(QNetworkAccessManager::Operation op, const QString& key, const QString& body);
 
 	LoggerName _log;
 
@@ -64,17 +84,40 @@ private:
 	QMutex    _resultLocker;
 
 	std::shared_ptr<QThread> _workerThread;
+	NetworkHelper* _networkHelper;
 };
 
 class NetworkHelper : public QObject
 {
 	Q_OBJECT
 
+	struct AsyncSlot
+	{
+		bool inFlight = false;
+		bool hasPending = false;
+		QNetworkAccessManager::Operation op = QNetworkAccessManager::PutOperation;
+		QUrl url;
+		QString body;
+		QMap<QString, QString> headers;
+	};
+
 	QNetworkAccessManager* _networkManager;
 	QNetworkReply* _networkReply;
 	bool _timeout;
+	QMap<QString, AsyncSlot> _asyncSlots;
 
-	void getResponse(httpResponse* response);
+	std::atomic<qint64> _requests;
+	std::atomic<qint64> _coalesced;
+	std::atomic<qint64> _failed;
+	std::atomic<qint64> _roundTripSum;
+	std::atomic<qint64> _roundTripMax;
+	std::atomic<qint64> _lastRoundTrip;
+
+	void getResponse(QNetworkReply* reply, bool timeout, httpResponse* response);
+	QNetworkAccessManager* getNetworkManager();
+	QNetworkReply* sendRequest(QNetworkAccessManager::Operation op, const QUrl& url, const QString& body, const QMap<QString, QString>& headers);
+	void sendAsync(const QString& key);
+	void registerRoundTrip(qint64 begin);
 
 public:
 	NetworkHelper();
@@ -82,8 +125,15 @@ public:
 
 	static std::shared_ptr<QThread> threadFactory();
 
+	ProviderRestApi::RoundTripStats getRoundTripStats(bool reset);
+	qint64 getLastRoundTrip() const;
+
+signals:
+	void SignalAsyncError(QString reason);
+
 public slots:
 	void executeOperation(ProviderRestApi* parent, QNetworkAccessManager::Operation op, QUrl url, QString body, std::shared_ptr<httpResponse> response);
+	void executeAsync(QNetworkAccessManager::Operation op, QString key, QUrl url, QString body, QMap<QString, QString> headers);
 	void abortOperation();
 };
 
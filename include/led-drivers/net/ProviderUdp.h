@@ -22,8 +22,8 @@ protected:
 	bool init(QJsonObject deviceConfig) override;
 	int open() override;
 	int close() override;
-	int writeBytes(const unsigned size, const uint8_t* data);
-	int writeBytes(const QByteArray& bytes);
+	virtual int writeBytes(const unsigned size, const uint8_t* data);
+	virtual int writeBytes(const QByteArray& bytes);
 	void setPort(int port);
 
 	QUdpSocket* _udpSocket;
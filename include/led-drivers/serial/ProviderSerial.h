@@ -1,8 +1,13 @@
 #pragma once
 
+#ifndef PCH_ENABLED
+	#include <memory>
+#endif
+
 #include <led-drivers/LedDevice.h>
 
 class QSerialPort;
+class SerialAsyncWriter;
 
 class ProviderSerial : public LedDevice
 {
@@ -34,9 +39,15 @@ public slots:
 
 private:
 	bool tryOpen(int delayAfterConnect_ms);
+	void startAsyncWriter();
+	void stopAsyncWriter();
+
 	bool _isAutoDeviceName;
 	int _delayAfterConnect_ms;
 	int _frameDropCounter;
 	bool _espHandshake;
 	bool _forceSerialDetection;
+	bool _asyncWrite;
+	bool _asyncBackpressure;
+	std::unique_ptr<SerialAsyncWriter> _asyncWriter;
 };
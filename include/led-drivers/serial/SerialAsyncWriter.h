@@ -0,0 +1,76 @@
+#pragma once
+
+#ifndef PCH_ENABLED
+	#include <QString>
+
+	#include <atomic>
+	#include <condition_variable>
+	#include <cstdint>
+	#include <mutex>
+	#include <thread>
+	#include <vector>
+#endif
+
+#include <utils/Logger.h>
+
+///
+/// Dedicated writer thread for the serial LED drivers (POSIX only).
+/// The device thread only copies the frame: the newest frame replaces the pending one and the writer pushes
+/// it to the already opened, non-blocking tty with write(2) and poll(2). With the backpressure enabled the
+/// writer waits until the kernel output queue (TIOCOUTQ) is almost empty, so the frame that finally goes out
+/// is the freshest one instead of piling up in the driver buffers.
+///
+class SerialAsyncWriter
+{
+public:
+	struct Stats
+	{
+		qint64 frames = 0;
+		qint64 replaced = 0;
+		qint64 bytes = 0;
+		double averageWriteMs = 0;
+	};
+
+	SerialAsyncWriter(const LoggerName& log);
+	~SerialAsyncWriter();
+
+	static bool isSupported();
+
+	bool start(qintptr handle, bool backpressure, int baudRate);
+	void stop();
+	bool isRunning() const;
+	void submit(const uint8_t* data, size_t size);
+	bool hasError(QString& errorMessage);
+	Stats getStats(bool reset);
+	///
+	/// Time (us) the last frame needed to reach the line: the wait for the kernel queue plus the write itself
+	///
+	qint64 getCompletionTime() const;
+
+private:
+	void run();
+	bool waitForQueue(size_t frameSize);
+	bool writeFrame(const std::vector<uint8_t>& frame);
+
+	LoggerName _log;
+	int _fd;
+	bool _backpressure;
+	int _baudRate;
+
+	std::thread _thread;
+	std::mutex _lock;
+	std::condition_variable _signal;
+	std::vector<uint8_t> _pending;
+	std::vector<uint8_t> _sending;
+	bool _hasPending;
+	bool _running;
+
+	std::atomic<bool> _error;
+	QString _errorMessage;
+
+	std::atomic<qint64> _frames;
+	std::atomic<qint64> _replaced;
+	std::atomic<qint64> _bytes;
+	std::atomic<qint64> _writeTime;
+	std::atomic<qint64> _completionTime;
+};
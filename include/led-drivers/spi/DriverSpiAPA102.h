@@ -11,9 +11,8 @@ public:
 
 private:
 	bool init(QJsonObject deviceConfig) override;
-	int writeFiniteColors(const std::vector<ColorRgb>& ledValues) override;
-
-	void createHeader();
+	void preparePacket() override;
+	int writePacket() override;
 
 	static bool isRegistered;
 };
@@ -19,7 +19,7 @@ public slots:
 	int close() override;
 
 protected:
-	int writeBytes(unsigned size, const uint8_t* data);
+	virtual int writeBytes(unsigned size, const uint8_t* data);
 	int writeBytesEsp8266(unsigned size, const uint8_t* data);
 	int writeBytesEsp32(unsigned size, const uint8_t* data);
 	int writeBytesRp2040(unsigned size, const uint8_t* data);
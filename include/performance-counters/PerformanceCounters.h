@@ -13,7 +13,7 @@
 
 namespace hyperhdr
 {
-	enum PerformanceReportType { VIDEO_GRABBER = 1, INSTANCE = 2, LED = 3, CPU_USAGE = 4, RAM_USAGE = 5, CPU_TEMPERATURE = 6, SYSTEM_UNDERVOLTAGE = 7, UNKNOWN = 8 };
+	enum PerformanceReportType { VIDEO_GRABBER = 1, INSTANCE = 2, LED = 3, CPU_USAGE = 4, RAM_USAGE = 5, CPU_TEMPERATURE = 6, SYSTEM_UNDERVOLTAGE = 7, NETWORK_IO = 8, EXECUTOR = 9, UNKNOWN = 10 };
 }
 
 struct PerformanceReport
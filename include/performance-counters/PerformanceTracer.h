@@ -0,0 +1,88 @@
+#pragma once
+
+/* PerformanceTracer.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QJsonObject>
+
+	#include <cstdint>
+#endif
+
+#include <utils/InternalClock.h>
+
+///
+/// Scoped timers for the pipeline stages. Every thread records into its own ring of the latest samples:
+/// the writer never blocks and never allocates after the first sample, readers copy the rings on demand
+/// to build the percentiles or a Chrome trace (chrome://tracing, ui.perfetto.dev).
+///
+class PerformanceTracer
+{
+public:
+	// the latency stages span from the capture of the frame (FrameTiming) to the instance result and the device write
+	enum class Stage : uint8_t { DECODE = 0, BORDER_DETECTION, AVERAGING, PROCESSING, SMOOTHING, DEVICE_WRITE, INSTANCE_LATENCY, DEVICE_LATENCY, COUNT };
+
+	static constexpr int RING_SIZE = 4096;
+	static constexpr int OUTPUTS_PER_INSTANCE = 100;
+
+	class Scope
+	{
+	public:
+		Scope(Stage stage, int id = -1)
+			: _stage(stage)
+			, _id(id)
+			, _begin(InternalClock::nowMicro())
+		{
+		}
+
+		~Scope()
+		{
+			PerformanceTracer::record(_stage, _id, _begin, InternalClock::nowMicro());
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		Stage	_stage;
+		int		_id;
+		int64_t	_begin;
+	};
+
+	static void record(Stage stage, int id, int64_t begin, int64_t end);
+
+	static const char* stageToString(Stage stage);
+
+	// the device stages are recorded per LED output: the reports split the id into the instance and the output
+	static int deviceId(int instance, int output);
+
+	// thread-safe: p50/p95/p99 per stage and id of the samples that are still in the rings
+	static QJsonObject getStatistics();
+
+	// thread-safe: Trace Event Format of the samples that are still in the rings
+	static QJsonObject getChromeTrace();
+};
@@ -34,6 +34,8 @@ typedef char* (*snd_device_name_get_hint_fun)(const void* hint, const char* id);
 typedef int (*snd_config_update_free_global_fun)(void);
 typedef const char* (*snd_strerror_fun)(int errnum);
 typedef snd_pcm_sframes_t (*snd_pcm_avail_update_fun)(snd_pcm_t* pcm);
+typedef int (*snd_pcm_mmap_begin_fun)(snd_pcm_t* pcm, const snd_pcm_channel_area_t** areas, snd_pcm_uframes_t* offset, snd_pcm_uframes_t* frames);
+typedef snd_pcm_sframes_t (*snd_pcm_mmap_commit_fun)(snd_pcm_t* pcm, snd_pcm_uframes_t offset, snd_pcm_uframes_t frames);
 
 class AlsaWorkerThread : public QThread
 {
@@ -42,17 +44,19 @@ class AlsaWorkerThread : public QThread
 		std::atomic<bool> _exitNow{ false };
 		LoggerName _logger;
 		QString _device;
+		bool _lowLatency;
 		SoundCapture* _parent;
 
 		void run() override;
 
 	public:
-		AlsaWorkerThread(const LoggerName& logger, QString device, SoundCapture* parent);
+		AlsaWorkerThread(const LoggerName& logger, QString device, bool lowLatency, SoundCapture* parent);
 		void exitNow();
 
 	private:
 		bool initAlsaLib();
 		void closeAlsaLib();
+		snd_pcm_sframes_t readMmap(snd_pcm_t* handle);
 
 		void* _library = nullptr;
 		snd_pcm_open_fun							snd_pcm_open = nullptr;
@@ -77,6 +81,8 @@ class AlsaWorkerThread : public QThread
 		snd_config_update_free_global_fun			snd_config_update_free_global = nullptr;
 		snd_strerror_fun							snd_strerror = nullptr;
 		snd_pcm_avail_update_fun					snd_pcm_avail_update = nullptr;
+		snd_pcm_mmap_begin_fun						snd_pcm_mmap_begin = nullptr;
+		snd_pcm_mmap_commit_fun						snd_pcm_mmap_commit = nullptr;
 };
 
 class SoundCaptureLinux : public SoundCapture
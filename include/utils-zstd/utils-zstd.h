@@ -8,3 +8,5 @@
 
 _ZSTD_SHARED_API const char* DecompressZSTD(size_t downloadedDataSize, const uint8_t* downloadedData, const char* fileNameUtf8);
 _ZSTD_SHARED_API const char* DecompressZSTD(size_t downloadedDataSize, const uint8_t* downloadedData, uint8_t* dest, int destSeek, int destSize);
+_ZSTD_SHARED_API size_t CompressBoundZSTD(size_t sourceSize);
+_ZSTD_SHARED_API size_t CompressZSTD(const uint8_t* source, size_t sourceSize, uint8_t* dest, size_t destCapacity, int level);
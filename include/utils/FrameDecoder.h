@@ -8,16 +8,16 @@
 // some stuff for HDR tone mapping
 #define LUT_INDEX(y,u,v) ((y + (u<<8) + (v<<16))*3)
 
-class AutomaticToneMapping;
+class FrameStatistics;
 
 namespace FrameDecoder
 {
-	template<bool Quarter, bool UseToneMapping, bool UseAutomaticToneMapping>
+	template<bool Quarter, bool UseToneMapping, bool CollectStatistics>
 	void processImageVector(
 		int _cropLeft, int _cropRight, int _cropTop, int _cropBottom,
 		const uint8_t* data, const uint8_t* dataUV, int width, int height, int lineLength,
 		const PixelFormat pixelFormat, const uint8_t* lutBuffer,
-		Image<ColorRgb>& outputImage, AutomaticToneMapping* automaticToneMapping);
+		Image<ColorRgb>& outputImage, FrameStatistics* statistics);
 
 	constexpr void (*dispatchProcessImageVector[2][2][2])(
 		int cropLeft, int cropRight, int cropTop, int cropBottom,
@@ -25,7 +25,7 @@ namespace FrameDecoder
 		int width, int height, int lineLength,
 		PixelFormat pixelFormat, const uint8_t* lutBuffer,
 		Image<ColorRgb>& outputImage,
-		AutomaticToneMapping* automaticToneMapping) =
+		FrameStatistics* statistics) =
 	{
 		{   // Quarter = false
 			{   // UseToneMapping = false
@@ -52,27 +52,27 @@ namespace FrameDecoder
 	void processSystemImageBGRA(Image<ColorRgb>& image, int targetSizeX, int targetSizeY,
 									   int startX, int startY,
 									   uint8_t* source, int _actualWidth, int _actualHeight,
-									   int division, uint8_t* _lutBuffer, int lineSize = 0);
+									   int division, uint8_t* _lutBuffer, int lineSize = 0, FrameStatistics* statistics = nullptr);
 
 	void processSystemImageBGR(Image<ColorRgb>& image, int targetSizeX, int targetSizeY,
 										int startX, int startY,
 										uint8_t* source, int _actualWidth, int _actualHeight,
-										int division, uint8_t* _lutBuffer, int lineSize = 0);
+										int division, uint8_t* _lutBuffer, int lineSize = 0, FrameStatistics* statistics = nullptr);
 
 	void processSystemImageBGR16(Image<ColorRgb>& image, int targetSizeX, int targetSizeY,
 										int startX, int startY,
 										uint8_t* source, int _actualWidth, int _actualHeight,
-										int division, uint8_t* _lutBuffer, int lineSize = 0);
+										int division, uint8_t* _lutBuffer, int lineSize = 0, FrameStatistics* statistics = nullptr);
 
 	void processSystemImageRGBA(Image<ColorRgb>& image, int targetSizeX, int targetSizeY,
 									   int startX, int startY,
 									   uint8_t* source, int _actualWidth, int _actualHeight,
-									   int division, uint8_t* _lutBuffer, int lineSize = 0);
+									   int division, uint8_t* _lutBuffer, int lineSize = 0, FrameStatistics* statistics = nullptr);
 
 	void processSystemImagePQ10(Image<ColorRgb>& image, int targetSizeX, int targetSizeY,
 									   int startX, int startY,
 									   uint8_t* source, int _actualWidth, int _actualHeight,
-									   int division, uint8_t* _lutBuffer, int lineSize = 0);
+									   int division, uint8_t* _lutBuffer, int lineSize = 0, FrameStatistics* statistics = nullptr);
 
 	void applyLUT(uint8_t* _source, unsigned int width, unsigned int height, const uint8_t* lutBuffer, const int _hdrToneMappingEnabled);
 };
@@ -0,0 +1,163 @@
+#pragma once
+
+/* FrameRecording.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QFile>
+	#include <QJsonObject>
+	#include <QString>
+	#include <atomic>
+	#include <condition_variable>
+	#include <cstdint>
+	#include <deque>
+	#include <mutex>
+	#include <thread>
+	#include <vector>
+#endif
+
+#include <utils/PixelFormat.h>
+
+///
+/// Container for the raw buffers delivered by a video capture device.
+///
+/// Layout (little endian):
+///   header: magic "HHDRREC1", uint32 version, char[8] pixel format name, uint32 width, uint32 height,
+///           uint32 line length, uint32 flags (bit 0: zstd), 4 reserved bytes written as zero (HEADER_SIZE = 40)
+///   frame:  int64 timestamp [us] relative to the first frame, uint32 raw size, uint32 stored size, payload
+///
+/// A frame is stored uncompressed when the stored size equals the raw size (zstd did not help or is disabled).
+///
+namespace FrameRecording
+{
+	constexpr uint32_t VERSION = 1;
+	constexpr uint32_t FLAG_ZSTD = 1;
+	constexpr int HEADER_SIZE = 40;
+	constexpr int FRAME_HEADER_SIZE = 16;
+
+	bool isRecording(const QString& fileName);
+};
+
+///
+/// Writes the raw frames on its own thread so the capture thread only pays for a memcpy.
+/// When the disk can not keep up the frames are dropped and counted rather than stalling the grabber.
+/// The recorder stops by itself once the frame limit is reached: the last frames are flushed and isRecording() returns false.
+///
+class FrameRecorder
+{
+public:
+	FrameRecorder();
+	~FrameRecorder();
+
+	bool start(const QString& fileName, PixelFormat format, int width, int height, int lineLength, bool compress, quint64 frameLimit);
+
+	void record(const uint8_t* data, size_t size);
+
+	void stop();
+
+	bool isRecording() const;
+
+	bool matches(PixelFormat format, int width, int height) const;
+
+	QJsonObject getInfo() const;
+
+	QString getLastError() const;
+
+private:
+	struct Frame
+	{
+		int64_t timestamp;
+		std::vector<uint8_t> data;
+	};
+
+	void writerLoop();
+	bool writeFrame(const Frame& frame);
+
+	static constexpr size_t MAX_QUEUED_FRAMES = 8;
+
+	QFile _file;
+	QString _fileName;
+	QString _lastError;
+	PixelFormat _format;
+	int _width;
+	int _height;
+	bool _compress;
+	quint64 _frameLimit;
+	int64_t _firstTimestamp;
+
+	mutable std::mutex _locker;
+	std::condition_variable _signal;
+	std::deque<Frame> _queue;
+	std::vector<std::vector<uint8_t>> _pool;
+	std::vector<uint8_t> _compressed;
+	std::thread _writer;
+	bool _running;
+
+	std::atomic<quint64> _accepted;
+	std::atomic<quint64> _written;
+	std::atomic<quint64> _dropped;
+	std::atomic<quint64> _rawBytes;
+	std::atomic<quint64> _storedBytes;
+};
+
+class FrameRecordingReader
+{
+public:
+	FrameRecordingReader();
+
+	bool open(const QString& fileName);
+
+	void close();
+
+	bool rewind();
+
+	bool atEnd() const;
+
+	bool readFrame(std::vector<uint8_t>& frame, size_t& size, int64_t& timestamp);
+
+	PixelFormat format() const;
+
+	int width() const;
+
+	int height() const;
+
+	int lineLength() const;
+
+	bool isCompressed() const;
+
+	QString getLastError() const;
+
+private:
+	QFile _file;
+	QString _lastError;
+	PixelFormat _format;
+	int _width;
+	int _height;
+	int _lineLength;
+	uint32_t _flags;
+	std::vector<uint8_t> _compressed;
+};
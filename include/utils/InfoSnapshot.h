@@ -0,0 +1,169 @@
+#pragma once
+
+/* InfoSnapshot.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <atomic>
+	#include <chrono>
+	#include <concepts>
+	#include <cstdint>
+	#include <memory>
+	#include <mutex>
+#endif
+
+#include <utils/InternalClock.h>
+
+///
+/// Process-wide revision counter shared by all the snapshots, so revisions of different owners can be compared.
+/// It starts at the wall clock time in microseconds: revisions handed out by a previous run are always older.
+///
+class InfoRevision
+{
+public:
+	static uint64_t initial()
+	{
+		static const uint64_t value = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count());
+		return value;
+	}
+
+	///
+	/// Every snapshot with a revision up to the returned value is already published
+	///
+	static uint64_t current()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _counter;
+	}
+
+private:
+	template <typename T>
+	friend class InfoSnapshot;
+
+	static inline std::mutex	_mutex;
+	static inline uint64_t		_counter = initial();
+};
+
+///
+/// Immutable, versioned state published by the thread that owns it. Readers in any thread take a reference
+/// to the latest snapshot without a blocking call into the owner; published data is never modified.
+/// Owners publish when their state changes. Data that also changes on its own (statistics, files) is read with read():
+/// a snapshot older than maxAge asks the owner to publish again, the reader gets the latest snapshot without waiting.
+/// Publishing equal data keeps the version, so it only moves when the content really changes.
+///
+template <typename T>
+class InfoSnapshot
+{
+public:
+	static constexpr int64_t DEFAULT_MAX_AGE = 1000;
+
+	struct Snapshot
+	{
+		uint64_t	version;
+		int64_t		timestamp;
+		T			data;
+	};
+
+	InfoSnapshot() = default;
+
+	void publish(T data)
+	{
+		auto previous = load();
+		bool unchanged = false;
+
+		if constexpr (std::equality_comparable<T>)
+			unchanged = (previous != nullptr && previous->data == data);
+
+		{
+			std::lock_guard<std::mutex> lock(InfoRevision::_mutex);
+			uint64_t version = (unchanged) ? previous->version : ++InfoRevision::_counter;
+			store(std::make_shared<const Snapshot>(Snapshot{ version, InternalClock::now(), std::move(data) }));
+		}
+
+		_refreshPending.store(false, std::memory_order_release);
+	}
+
+	std::shared_ptr<const Snapshot> load() const
+	{
+#if defined(__cpp_lib_atomic_shared_ptr)
+		return _current.load(std::memory_order_acquire);
+#else
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _current;
+#endif
+	}
+
+	uint64_t version() const
+	{
+		auto snapshot = load();
+		return (snapshot != nullptr) ? snapshot->version : 0;
+	}
+
+	///
+	/// Copies the latest data and never waits for the owner. When the snapshot is older than maxAge, refresh() must queue
+	/// publishing in the owner's thread: only one request is pending at a time, the next reader gets the new data.
+	///
+	template <typename Revision, typename Refresh>
+	bool read(T& data, Revision* revision, Refresh&& refresh, int64_t maxAge = DEFAULT_MAX_AGE)
+	{
+		auto snapshot = load();
+		if ((snapshot == nullptr || InternalClock::now() - snapshot->timestamp > maxAge) &&
+			!_refreshPending.exchange(true, std::memory_order_acq_rel))
+		{
+			refresh();
+		}
+
+		if (snapshot == nullptr)
+			return false;
+
+		data = snapshot->data;
+		if (revision != nullptr)
+			*revision = static_cast<Revision>(snapshot->version);
+		return true;
+	}
+
+private:
+	void store(std::shared_ptr<const Snapshot> snapshot)
+	{
+#if defined(__cpp_lib_atomic_shared_ptr)
+		_current.store(std::move(snapshot), std::memory_order_release);
+#else
+		std::lock_guard<std::mutex> lock(_mutex);
+		_current = std::move(snapshot);
+#endif
+	}
+
+	std::atomic<bool> _refreshPending{ false };
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+	std::atomic<std::shared_ptr<const Snapshot>> _current;
+#else
+	mutable std::mutex _mutex;
+	std::shared_ptr<const Snapshot> _current;
+#endif
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+/* NetIoPool.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QObject>
+	#include <QThread>
+
+	#include <atomic>
+	#include <cstdint>
+	#include <functional>
+	#include <memory>
+	#include <mutex>
+	#include <vector>
+#endif
+
+#include <utils/Logger.h>
+
+class QTcpSocket;
+
+///
+/// A small pool of network I/O threads shared by the JSON server and the HTTP/HTTPS servers.
+/// The listening sockets stay on the daemon network thread, every accepted client socket is moved
+/// to the least loaded I/O thread together with its API handler, so a busy client cannot delay the others or SSDP.
+/// Each thread reports its load (time spent in the socket handlers) to the performance counters once a minute.
+///
+class NetIoPool
+{
+public:
+	static constexpr int MAX_THREADS = 4;
+
+	///
+	/// Measures the time spent in a socket handler. Does nothing outside of the I/O threads.
+	///
+	class BusyScope
+	{
+	public:
+		BusyScope();
+		~BusyScope();
+
+	private:
+		int64_t _start;
+	};
+
+	static std::shared_ptr<NetIoPool> getInstance();
+
+	~NetIoPool();
+
+	int threadCount() const;
+
+	///
+	/// Moves the accepted socket (it must be owned by the calling thread) to the least loaded I/O thread
+	/// and runs the setup function there. The setup must take ownership of the socket.
+	///
+	void adopt(QTcpSocket* socket, std::function<void()> setup);
+
+	///
+	/// Returns after every function already queued by adopt() has finished.
+	///
+	void synchronize();
+
+	///
+	/// Runs the function in the thread of the target object and waits for it.
+	///
+	static void execute(QObject* target, const std::function<void()>& function);
+
+private:
+	NetIoPool();
+
+	// except 'connections' the statistics are only touched by the owning I/O thread
+	struct Slot
+	{
+		int					index = 0;
+		QThread*			thread = nullptr;
+		QObject*			context = nullptr;
+		std::atomic<int>	connections{ 0 };
+		int64_t				busyTime = 0;
+		int64_t				busyMax = 0;
+		int64_t				events = 0;
+		int64_t				token = 0;
+		int64_t				statBegin = 0;
+	};
+
+	static void report(Slot* slot);
+
+	LoggerName _log;
+	std::vector<std::shared_ptr<Slot>> _slots;
+
+	static thread_local Slot* _currentSlot;
+	static std::mutex _instanceMutex;
+	static std::weak_ptr<NetIoPool> _instance;
+};
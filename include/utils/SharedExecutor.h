@@ -0,0 +1,130 @@
+#pragma once
+
+/* SharedExecutor.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QObject>
+	#include <QPointer>
+	#include <QThread>
+
+	#include <atomic>
+	#include <cstdint>
+	#include <functional>
+	#include <memory>
+	#include <mutex>
+	#include <vector>
+#endif
+
+#include <utils/Logger.h>
+
+///
+/// Optional execution mode (--shared-executor) where the HyperHDR instances and the LED devices do not get
+/// a thread each, but are served by a fixed pool of threads sized to the core count.
+/// Every object placed on the pool is a strand: Qt delivers its queued calls and timers in order on the
+/// single pool thread it lives on, so the per-instance ordering is the same as with a dedicated thread.
+/// The scheduling delay of each strand (time from posting a call until it runs) is probed continuously
+/// and reported to the performance counters once a minute.
+/// A strand must never block: LED drivers that wait on their sockets or sleep are registered as blocking
+/// (see REGISTER_LED_DEVICE) and keep a dedicated thread even in this mode.
+///
+class SharedExecutor
+{
+public:
+	static constexpr int MAX_THREADS = 16;
+
+	static void setEnabled(bool enabled);
+
+	static bool isEnabled();
+
+	static std::shared_ptr<SharedExecutor> getInstance();
+
+	~SharedExecutor();
+
+	int threadCount() const;
+
+	///
+	/// Runs the setup on the least loaded pool thread and waits for it. The objects created there are served
+	/// by that thread. The returned object (it may be null) is registered as a strand under the given name.
+	///
+	void run(const QString& strandName, const std::function<QObject*()>& setup);
+
+	///
+	/// Moves the object (it must be owned by the calling thread and have no parent) to the least loaded pool thread.
+	///
+	void attach(QObject* object, const QString& strandName);
+
+	///
+	/// Deletes the object on its pool thread after its pending calls and waits for it. The pool thread keeps running.
+	///
+	void release(QObject* object);
+
+private:
+	SharedExecutor();
+
+	// 'strands' and 'delay' are updated from any thread, the rest is owned by the worker thread
+	struct Worker
+	{
+		int					index = 0;
+		QThread*			thread = nullptr;
+		QObject*			context = nullptr;
+		std::atomic<int>	strands{ 0 };
+		std::atomic<int64_t> delay{ 0 };
+	};
+
+	// the statistics are only touched by the thread serving the strand
+	struct Strand
+	{
+		int					id = 0;
+		QString				name;
+		QPointer<QObject>	object;
+		Worker*				worker = nullptr;
+		std::atomic<bool>	probePending{ false };
+		int64_t				delaySum = 0;
+		int64_t				delayMax = 0;
+		int64_t				samples = 0;
+		int64_t				token = 0;
+		int64_t				statBegin = 0;
+	};
+
+	std::shared_ptr<Worker> selectWorker() const;
+	void addStrand(QObject* object, const QString& strandName, const std::shared_ptr<Worker>& worker);
+	void probe();
+
+	static void report(Strand* strand);
+
+	LoggerName _log;
+	std::vector<std::shared_ptr<Worker>> _workers;
+
+	std::mutex _strandsMutex;
+	std::vector<std::shared_ptr<Strand>> _strands;
+	int _nextStrandId;
+
+	static std::atomic<bool> _enabled;
+	static std::mutex _instanceMutex;
+	static std::weak_ptr<SharedExecutor> _instance;
+};
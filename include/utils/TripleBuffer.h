@@ -0,0 +1,109 @@
+#pragma once
+
+/* TripleBuffer.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <array>
+	#include <atomic>
+	#include <cstdint>
+	#include <cstring>
+	#include <type_traits>
+#endif
+
+///
+/// Single producer, many consumers. The producer never waits: it rotates through three slots and always
+/// writes the oldest one. A consumer copies the latest slot and validates the copy with the slot's sequence,
+/// so it only has to retry if the producer lapped it twice during the copy.
+///
+template <typename T>
+class TripleBuffer
+{
+	static_assert(std::is_trivially_copyable_v<T>, "TripleBuffer requires a trivially copyable type");
+
+public:
+	TripleBuffer()
+		: _latest(0)
+		, _published(0)
+	{
+		for (auto& slot : _slots)
+			slot.sequence.store(0, std::memory_order_relaxed);
+	}
+
+	void publish(const T& value)
+	{
+		const int target = (_latest.load(std::memory_order_relaxed) + 1) % 3;
+		Slot& slot = _slots[target];
+		const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+
+		slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		std::memcpy(&slot.value, &value, sizeof(T));
+
+		slot.sequence.store(sequence + 2, std::memory_order_release);
+		_latest.store(target, std::memory_order_release);
+		_published.fetch_add(1, std::memory_order_release);
+	}
+
+	bool read(T& target) const
+	{
+		if (_published.load(std::memory_order_acquire) == 0)
+			return false;
+
+		for (;;)
+		{
+			const Slot& slot = _slots[_latest.load(std::memory_order_acquire)];
+			const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+
+			if (before & 1)
+				continue;
+
+			std::memcpy(&target, &slot.value, sizeof(T));
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (slot.sequence.load(std::memory_order_relaxed) == before)
+				return true;
+		}
+	}
+
+	uint64_t published() const
+	{
+		return _published.load(std::memory_order_acquire);
+	}
+
+private:
+	struct alignas(64) Slot
+	{
+		std::atomic<uint32_t> sequence;
+		T value;
+	};
+
+	std::array<Slot, 3>		_slots;
+	std::atomic<int>		_latest;
+	std::atomic<uint64_t>	_published;
+};
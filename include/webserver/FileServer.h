@@ -1,6 +1,11 @@
 #pragma once
 
+#ifndef PCH_ENABLED
+	#include <mutex>
+#endif
+
 #include "QtHttpReply.h"
+#include <webserver/StaticFileCache.h>
 
 class CgiHandler;
 class QtHttpRequest;
@@ -16,12 +21,12 @@ public:
 	void onRequestNeedsReply(QtHttpRequest* request, QtHttpReply* reply);
 
 private:
+	static std::mutex		_staticMutex;
 	static QString			_ssdpXmlDesc;
 	static QString			_baseUrl;
-	QHash<QString, QString> _mimeDb;
 	LoggerName				_log;	
 	QString					_resourcePath;
+	StaticFileCache			_cache;
 
 	void printErrorToReply(QtHttpReply* reply, QtHttpReply::StatusCode code, QString errorMessage);
-	QString getMimeName(QString filename);
 };
@@ -18,7 +18,7 @@ class QtHttpClientWrapper : public QObject {
 	Q_OBJECT
 
 public:
-	explicit QtHttpClientWrapper(QTcpSocket* sock, const bool& localConnection, QtHttpServer* parent);
+	explicit QtHttpClientWrapper(QTcpSocket* sock, const bool& localConnection, QtHttpServer* server);
 
 	static const char SPACE = ' ';
 	static const char COLON = ':';
@@ -33,6 +33,10 @@ public:
 	static const QByteArray& TransferEncoding;
 	static const QByteArray& ContentDisposition;
 	static const QByteArray& AccessControlAllow;
+	static const QByteArray& ETag;
+	static const QByteArray& IfNoneMatch;
+	static const QByteArray& IfModifiedSince;
+	static const QByteArray& Vary;
 	// Websocket specific headers
 	static const QByteArray& Upgrade;
 	static const QByteArray& SecWebSocketKey;
@@ -5,6 +5,7 @@
 	#include <QString>
 	#include <QHash>
 	#include <QHostAddress>
+	#include <QMutex>
 #endif
 
 #include <QSslKey>
@@ -17,6 +18,7 @@ class QtHttpRequest;
 class QtHttpReply;
 class QtHttpClientWrapper;
 class NetOrigin;
+class NetIoPool;
 class HyperHdrManager;
 
 class QtHttpServerWrapper : public QTcpServer
@@ -42,6 +44,7 @@ class QtHttpServer : public QObject
 
 public:
 	explicit QtHttpServer(std::shared_ptr<NetOrigin> netOrigin, QObject* parent = Q_NULLPTR);
+	~QtHttpServer() override;
 
 	static const QString& HTTP_VERSION;
 
@@ -71,18 +74,18 @@ signals:
 
 private slots:
 	void onClientConnected(void);
-	void onClientDisconnected(void);
-	void onClientSslEncrypted(void);
-	void onClientSslPeerVerifyError(const QSslError& err);
-	void onClientSslErrors(const QList<QSslError>& errors);
-	void onClientSslModeChanged(QSslSocket::SslMode mode);
 
 private:
+	void setupClient(QTcpSocket* sock, bool localConnection, const QList<QSslCertificate>& certs, const QSslKey& key);
+	void onClientDisconnected(QTcpSocket* sock, QtHttpClientWrapper* wrapper);
+
 	bool										m_useSsl;
 	QSslKey										m_sslKey;
 	QList<QSslCertificate>						m_sslCerts;
 	QString										m_serverName;
 	std::shared_ptr<NetOrigin>					m_netOrigin;
 	QtHttpServerWrapper*						m_sockServer;
+	std::shared_ptr<NetIoPool>					m_ioPool;
+	QMutex										m_clientsMutex;
 	QHash<QTcpSocket*, QtHttpClientWrapper*>	m_socksClientsHash;
 };
@@ -0,0 +1,97 @@
+#pragma once
+
+/* StaticFileCache.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QByteArray>
+	#include <QDateTime>
+	#include <QHash>
+	#include <QString>
+	#include <atomic>
+	#include <memory>
+	#include <mutex>
+	#include <thread>
+#endif
+
+#include <utils/Logger.h>
+
+///
+/// In-memory cache of the web UI files, served by FileServer.
+/// Every entry keeps the file content together with its gzip (and zstd if available) form, its MIME type,
+/// a strong ETag and the Last-Modified date, so the net thread only has to pick one of the prepared
+/// representations. The embedded resources are immutable and are prepared once on a background thread;
+/// a custom document root is loaded on demand and revalidated against the file date and size.
+///
+class StaticFileCache
+{
+public:
+	enum class Encoding { Identity, Gzip, Zstd };
+
+	struct Entry
+	{
+		QByteArray mimeName;
+		QByteArray identity;
+		QByteArray gzip;
+		QByteArray zstd;
+		QByteArray hash;
+		QByteArray lastModified;
+		QDateTime modified;
+		qint64 fileSize = 0;
+
+		const QByteArray& body(Encoding encoding) const;
+		QByteArray etag(Encoding encoding) const;
+		bool isCompressed() const;
+	};
+
+	StaticFileCache();
+	~StaticFileCache();
+
+	void buildInBackground(const QString& root);
+	void clear();
+
+	std::shared_ptr<const Entry> get(const QString& requestedFile);
+
+	static Encoding selectEncoding(const QByteArray& acceptEncoding, const Entry& entry);
+	static bool isNotModified(const QByteArray& ifNoneMatch, const QByteArray& ifModifiedSince, const Entry& entry);
+	static const char* encodingName(Encoding encoding);
+
+private:
+	std::shared_ptr<Entry> load(const QString& fileName, bool compress) const;
+	void compress(Entry& entry) const;
+	QByteArray getMimeName(const QString& fileName) const;
+
+	static bool isImmutable(const QString& fileName);
+
+	LoggerName _log;
+	QHash<QString, QByteArray> _mimeDb;
+	QHash<QString, std::shared_ptr<const Entry>> _entries;
+	std::mutex _locker;
+	std::thread _builder;
+	std::atomic<bool> _building;
+	std::atomic<bool> _cancelled;
+};
@@ -377,7 +377,8 @@ QVector<QVariantMap> BaseAPI::getAllInstanceData()
 {
 	QVector<QVariantMap> vec;
 
-	SAFE_CALL_0_RET(_instanceManager.get(), getInstanceData, QVector<QVariantMap>, vec);
+	if (!_instanceManager->getPublishedInstanceData(vec))
+		SAFE_CALL_0_RET(_instanceManager.get(), getInstanceData, QVector<QVariantMap>, vec);
 
 	return vec;
 }
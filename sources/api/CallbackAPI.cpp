@@ -89,9 +89,9 @@ bool CallbackAPI::subscribeFor(const QString& type, bool unsubscribe)
 	if (type == "priorities-update" && _hyperhdr != nullptr)
 	{
 		if (unsubscribe)
-			disconnect(_hyperhdr.get(), &HyperHdrInstance::SignalPrioritiesChanged, this, &CallbackAPI::priorityUpdateHandler);
+			disconnect(_hyperhdr.get(), &HyperHdrInstance::SignalJsonInfoPublished, this, &CallbackAPI::priorityUpdateHandler);
 		else
-			connect(_hyperhdr.get(), &HyperHdrInstance::SignalPrioritiesChanged, this, &CallbackAPI::priorityUpdateHandler, Qt::UniqueConnection);
+			connect(_hyperhdr.get(), &HyperHdrInstance::SignalJsonInfoPublished, this, &CallbackAPI::priorityUpdateHandler, Qt::UniqueConnection);
 	}
 
 	if (type == "imageToLedMapping-update" && _hyperhdr != nullptr)
@@ -224,11 +224,15 @@ void CallbackAPI::removeSubscriptions()
 	}
 }
 
-void CallbackAPI::doCallback(const QString cmd, const QVariant data)
+void CallbackAPI::doCallback(const QString cmd, const QVariant data, quint64 revision)
 {
 	QJsonObject obj;
 	obj["command"] = cmd;
 
+	// the same revision as the matching serverinfo section
+	if (revision > 0)
+		obj["revision"] = static_cast<qint64>(revision);
+
 	if (data.userType() == QMetaType::QJsonArray)
 		obj["data"] = data.toJsonArray();
 	else
@@ -268,16 +272,17 @@ void CallbackAPI::componentStateHandler(hyperhdr::Components comp, bool state)
 	}
 #endif
 
-void CallbackAPI::priorityUpdateHandler()
+void CallbackAPI::priorityUpdateHandler(bool prioritiesChanged)
 {
-	QJsonObject info;	
+	QJsonObject info, revisions;
 
-	if (_hyperhdr == nullptr)
+	if (_hyperhdr == nullptr || !prioritiesChanged)
 		return;
 
-	SAFE_CALL_1_RET(_hyperhdr.get(), getJsonInfo, QJsonObject, info, bool, false);
+	if (!_hyperhdr->getPublishedJsonInfo(false, info, &revisions))
+		SAFE_CALL_1_RET(_hyperhdr.get(), getJsonInfo, QJsonObject, info, bool, false);
 
-	doCallback("priorities-update", QVariant(info));
+	doCallback("priorities-update", QVariant(info), static_cast<quint64>(revisions["priorities"].toDouble()));
 }
 
 void CallbackAPI::imageToLedsMappingChangeHandler(int mappingType)
@@ -335,11 +340,13 @@ void CallbackAPI::ledsConfigChangeHandler(settings::type type, const QJsonDocume
 void CallbackAPI::instancesListChangedHandler()
 {
 	QJsonArray arr;
-	QVector<QVariantMap> entries;
+	QVector<QVariantMap> instanceData;
+	quint64 revision = 0;
 
-	SAFE_CALL_0_RET(_instanceManager.get(), getInstanceData, QVector<QVariantMap>, entries);
+	if (!_instanceManager->getPublishedInstanceData(instanceData, &revision))
+		instanceData = BaseAPI::getAllInstanceData();
 
-	for (const auto& entry : entries)
+	for (const auto& entry : instanceData)
 	{
 		QJsonObject obj;
 		obj.insert("friendly_name", entry["friendly_name"].toString());
@@ -348,7 +355,7 @@ void CallbackAPI::instancesListChangedHandler()
 		obj.insert("running", entry["running"].toBool());
 		arr.append(obj);
 	}
-	doCallback("instance-update", QVariant(arr));
+	doCallback("instance-update", QVariant(arr), revision);
 }
 
 void CallbackAPI::tokenChangeHandler(const QVector<AccessManager::AuthDefinition>& def)
@@ -7,6 +7,7 @@
 	#include <QHostAddress>
 	#include <QMultiMap>
 	#include <QDir>
+	#include <QFileInfo>
 	#include <QNetworkReply>
 
 	#include <chrono>
@@ -32,6 +33,7 @@
 #include <json-utils/jsonschema/QJsonSchemaChecker.h>
 #include <json-utils/JsonUtils.h>
 #include <performance-counters/PerformanceCounters.h>
+#include <performance-counters/PerformanceTracer.h>
 
 // bonjour wrapper
 #ifdef ENABLE_BONJOUR
@@ -46,6 +48,7 @@ HyperAPI::HyperAPI(QString peerAddress, const LoggerName& log, bool localConnect
 	_noListener = noListener;
 	_peerAddress = peerAddress;
 	_streaming_logging_activated = false;
+	_lastServerInfoInstance = -1;
 	_ledStreamTimer = new QTimer(this);
 	_colorsStreamingInterval = 50;
 	_lastSentImage = 0;
@@ -170,6 +173,8 @@ void HyperAPI::handleMessage(const QString& messageString, const QString& httpAu
 				handleTunnel(message, command, tan);
 			else if (command == "signal-calibration")
 				handleLoadSignalCalibration(message, command, tan);
+			else if (command == "video-recording")
+				handleVideoRecordingCommand(message, command, tan);
 			else if (command == "performance-counters")
 				handlePerformanceCounters(message, command, tan);
 			else if (command == "clearall")
@@ -317,14 +322,26 @@ void HyperAPI::handleServerInfoCommand(const QJsonObject& message, const QString
 
 		if (!subscribeOnly)
 		{
+			// sections that have a revision are skipped when they didn't change after 'sinceRevision'
+			const quint64 revision = InfoRevision::current();
+			quint64 sinceRevision = 0;
+
+			if (message.contains("sinceRevision") && _lastServerInfoInstance == getCurrentInstanceIndex())
+				sinceRevision = static_cast<quint64>(message["sinceRevision"].toDouble());
+			if (sinceRevision > revision)
+				sinceRevision = 0;
+			_lastServerInfoInstance = getCurrentInstanceIndex();
+
 			QJsonObject info;
+			QJsonObject revisions;
 
 
 			/////////////////////
 			// Instance report //
 			/////////////////////
 
-			SAFE_CALL_1_RET(_hyperhdr.get(), getJsonInfo, QJsonObject, info, bool, true);
+			if (!_hyperhdr->getPublishedJsonInfo(true, info, &revisions))
+				SAFE_CALL_1_RET(_hyperhdr.get(), getJsonInfo, QJsonObject, info, bool, true);
 
 			///////////////////////////
 			// Available LED devices //
@@ -342,6 +359,7 @@ void HyperAPI::handleServerInfoCommand(const QJsonObject& message, const QString
 
 			ledDevices["available"] = availableLedDevices;
 			info["ledDevices"] = ledDevices;
+			revisions["ledDevices"] = static_cast<qint64>(InfoRevision::initial());
 
 			///////////////////////
 			// Sound Device Info //
@@ -350,12 +368,17 @@ void HyperAPI::handleServerInfoCommand(const QJsonObject& message, const QString
 #if defined(ENABLE_SOUNDCAPLINUX) || defined(ENABLE_SOUNDCAPWINDOWS) || defined(ENABLE_SOUNDCAPMACOS)
 
 			QJsonObject resultSound;
+			quint64 soundRevision = 0;
 
+			// the owners publish their snapshots, the reader never waits for their threads
 			if (_soundCapture != nullptr)
-				SAFE_CALL_0_RET(_soundCapture.get(), getJsonInfo, QJsonObject, resultSound);
+				_soundCapture->getPublishedJsonInfo(resultSound, &soundRevision);
 
 			if (!resultSound.isEmpty())
+			{
 				info["sound"] = resultSound;
+				revisions["sound"] = static_cast<qint64>(soundRevision);
+			}
 
 #endif
 
@@ -366,12 +389,16 @@ void HyperAPI::handleServerInfoCommand(const QJsonObject& message, const QString
 #if defined(ENABLE_DX) || defined(ENABLE_MAC_SYSTEM) || defined(ENABLE_X11) || defined(ENABLE_FRAMEBUFFER) || defined(ENABLE_AMLOGIC)
 
 			QJsonObject resultSGrabber;
+			quint64 systemGrabberRevision = 0;
 
 			if (_systemGrabber != nullptr && _systemGrabber->systemWrapper() != nullptr)
-				SAFE_CALL_0_RET(_systemGrabber->systemWrapper(), getJsonInfo, QJsonObject, resultSGrabber);
+				_systemGrabber->systemWrapper()->getPublishedJsonInfo(resultSGrabber, &systemGrabberRevision);
 
 			if (!resultSGrabber.isEmpty())
+			{
 				info["systemGrabbers"] = resultSGrabber;
+				revisions["systemGrabbers"] = static_cast<qint64>(systemGrabberRevision);
+			}
 
 #endif
 
@@ -381,14 +408,16 @@ void HyperAPI::handleServerInfoCommand(const QJsonObject& message, const QString
 			//////////////////////
 
 			QJsonObject grabbers;
+			quint64 grabbersRevision = 0;
 			[[maybe_unused]] GrabberWrapper* grabberWrapper = (_videoGrabber != nullptr) ? _videoGrabber->grabberWrapper() : nullptr;
 
 #if defined(ENABLE_V4L2) || defined(ENABLE_MF) || defined(ENABLE_AVF)
 			if (grabberWrapper != nullptr)
-				SAFE_CALL_0_RET(grabberWrapper, getJsonInfo, QJsonObject, grabbers);
+				grabberWrapper->getPublishedJsonInfo(grabbers, &grabbersRevision);
 #endif
 
 			info["grabbers"] = grabbers;
+			revisions["grabbers"] = static_cast<qint64>(grabbersRevision);
 
 			//////////////////////////////////
 			//  Instances found by Bonjour  //
@@ -398,8 +427,9 @@ void HyperAPI::handleServerInfoCommand(const QJsonObject& message, const QString
 
 #ifdef ENABLE_BONJOUR					
 			QList<DiscoveryRecord> services;
+			quint64 servicesRevision = 0;
 			if (_discoveryWrapper != nullptr)
-				SAFE_CALL_0_RET(_discoveryWrapper.get(), getAllServices, QList<DiscoveryRecord>, services);
+				_discoveryWrapper->getPublishedServices(services, &servicesRevision);
 
 			for (const auto& session : services)
 			{
@@ -411,6 +441,7 @@ void HyperAPI::handleServerInfoCommand(const QJsonObject& message, const QString
 				sessions.append(item);
 			}
 			info["sessions"] = sessions;
+			revisions["sessions"] = static_cast<qint64>(servicesRevision);
 #endif
 
 
@@ -419,7 +450,13 @@ void HyperAPI::handleServerInfoCommand(const QJsonObject& message, const QString
 			///////////////////////////
 
 			QJsonArray instanceInfo;
-			for (const auto& entry : BaseAPI::getAllInstanceData())
+			QVector<QVariantMap> instanceData;
+			quint64 instanceRevision = 0;
+
+			if (!_instanceManager->getPublishedInstanceData(instanceData, &instanceRevision))
+				instanceData = BaseAPI::getAllInstanceData();
+
+			for (const auto& entry : instanceData)
 			{
 				QJsonObject obj;
 				obj.insert("friendly_name", entry["friendly_name"].toString());
@@ -428,6 +465,7 @@ void HyperAPI::handleServerInfoCommand(const QJsonObject& message, const QString
 				instanceInfo.append(obj);
 			}
 			info["instance"] = instanceInfo;
+			revisions["instance"] = static_cast<qint64>(instanceRevision);
 			info["currentInstance"] = getCurrentInstanceIndex();
 
 
@@ -451,6 +489,25 @@ void HyperAPI::handleServerInfoCommand(const QJsonObject& message, const QString
 			info["lastError"] = Logger::getInstance()->getLastError();
 
 
+			/////////////////////
+			//    REVISIONS    //
+			/////////////////////
+
+			if (sinceRevision > 0)
+			{
+				for (auto it = revisions.constBegin(); it != revisions.constEnd(); ++it)
+				{
+					quint64 sectionRevision = static_cast<quint64>(it.value().toDouble());
+					if (sectionRevision > 0 && sectionRevision <= sinceRevision)
+						info.remove(it.key());
+				}
+			}
+
+			info["revision"] = static_cast<qint64>(revision);
+			info["revisions"] = revisions;
+			info["incremental"] = (sinceRevision > 0);
+
+
 			////////////////
 			//     END    //
 			////////////////
@@ -717,6 +774,14 @@ void HyperAPI::handlePerformanceCounters(const QJsonObject& message, const QStri
 		QUEUE_CALL_1(_performanceCounters.get(), performanceInfoRequest, bool, false);
 		sendSuccessReply(command, tan);
 	}
+	else if (subcommand == "stages")
+	{
+		sendSuccessDataReply(QJsonDocument(PerformanceTracer::getStatistics()), command + "-" + subcommand, tan);
+	}
+	else if (subcommand == "trace")
+	{
+		sendSuccessDataReply(QJsonDocument(PerformanceTracer::getChromeTrace()), command + "-" + subcommand, tan);
+	}
 	else
 		sendErrorReply("Unknown subcommand", command, tan);
 }
@@ -758,6 +823,53 @@ void HyperAPI::handleLoadSignalCalibration(const QJsonObject& message, const QSt
 		sendErrorReply("Unknown subcommand", command, tan);
 }
 
+void HyperAPI::handleVideoRecordingCommand(const QJsonObject& message, const QString& command, int tan)
+{
+	QJsonDocument retVal;
+	QString subcommand = message["subcommand"].toString("");
+	QString full_command = command + "-" + subcommand;
+	GrabberWrapper* grabberWrapper = (_videoGrabber != nullptr) ? _videoGrabber->grabberWrapper() : nullptr;
+
+	if (grabberWrapper == nullptr)
+	{
+		sendErrorReply("No grabbers available", command, tan);
+		return;
+	}
+
+	if (subcommand == "start")
+	{
+		if (_adminAuthorized)
+		{
+			QString fileName = message["file"].toString("");
+			bool compress = message["compress"].toBool(true);
+			int frameLimit = message["frames"].toInt(0);
+
+			if (QDir::isAbsolutePath(fileName) || fileName.contains("..") || QFileInfo(fileName).fileName() != fileName)
+			{
+				sendErrorReply("The recording file name must not contain a path", command, tan);
+				return;
+			}
+
+			SAFE_CALL_3_RET(grabberWrapper, startRecording, QJsonDocument, retVal, QString, fileName, bool, compress, int, frameLimit);
+			sendSuccessDataReply(retVal, full_command, tan);
+		}
+		else
+			sendErrorReply("No Authorization", command, tan);
+	}
+	else if (subcommand == "stop")
+	{
+		SAFE_CALL_0_RET(grabberWrapper, stopRecording, QJsonDocument, retVal);
+		sendSuccessDataReply(retVal, full_command, tan);
+	}
+	else if (subcommand == "get-info")
+	{
+		SAFE_CALL_0_RET(grabberWrapper, getRecordingInfo, QJsonDocument, retVal);
+		sendSuccessDataReply(retVal, full_command, tan);
+	}
+	else
+		sendErrorReply("Unknown subcommand", command, tan);
+}
+
 void HyperAPI::handleConfigCommand(const QJsonObject& message, const QString& command, int tan)
 {
 	QString subcommand = message["subcommand"].toString("");
@@ -1153,6 +1265,12 @@ void HyperAPI::handleLedDeviceCommand(const QJsonObject& message, const QString&
 			ret["hasLedClock"] = hasLedClock;
 			sendSuccessDataReply(QJsonDocument(ret), "hasLedClock-update", tan);
 		}
+		else if (subc == "getPacing")
+		{
+			QJsonObject pacing;
+			SAFE_CALL_0_RET(_hyperhdr.get(), getLedPacingInfo, QJsonObject, pacing);
+			sendSuccessDataReply(QJsonDocument(pacing), full_command, tan);
+		}
 		else
 		{
 			sendErrorReply("Unknown or missing subcommand", full_command, tan);
@@ -31,6 +31,7 @@
 #include <utils/GlobalSignals.h>
 #include <utils/InternalClock.h>
 #include <base/AutomaticToneMapping.h>
+#include <image/FrameStatistics.h>
 #include <utils/Logger.h>
 
 #define DEFAULT_GRACEFUL_TIMEOUT 10
@@ -61,86 +62,18 @@ AutomaticToneMapping* AutomaticToneMapping::prepare()
 	}
 }
 
-void AutomaticToneMapping::scan_YUYV(int width, uint8_t* currentSourceY)
+void AutomaticToneMapping::scan(const FrameStatistics& statistics)
 {
-	auto checkRange = [&]() -> bool {
-		const uint32_t limYlo = _running.y;       // 0x00'00'00'FF
-		const uint32_t limYhi = _running.y << 16; // 0x00'FF'00'00
-		const uint32_t limU = _running.u << 8;    // 0x00'00'FF'00
-		const uint32_t limV = _running.v << 24;   // 0xFF'00'00'00
-		for (const uint8_t* end = currentSourceY + width * 2; currentSourceY < end; currentSourceY += 4) {
-			if (uint32_t yuyv = *reinterpret_cast<uint32_t*>(currentSourceY); (yuyv & 0x00'00'00'FF) > limYlo || (yuyv & 0x00'FF'00'00) > limYhi ||
-																			  (yuyv & 0x00'00'FF'00) > limU   || (yuyv & 0xFF'00'00'00) > limV)
-			{
-				_running.y = std::max(std::max(currentSourceY[0], currentSourceY[2]), _running.y);
-				_running.u = std::max(currentSourceY[1], _running.u);
-				_running.v = std::max(currentSourceY[3], _running.v);
-				return true;
-			}
-		}
-		return false;
-	};
-
-	_triggered = _triggered || checkRange();
-};
-
-void AutomaticToneMapping::scan_Y_UV_8(int width, uint8_t* currentSourceY, uint8_t* currentSourceUV)
-{
-	auto checkRange = [&]() -> bool {
-		const uint32_t limYlo = _running.y;       // 0x00'00'00'FF
-		const uint32_t limYhi = _running.y << 16; // 0x00'FF'00'00
-		const uint32_t limUlo = _running.u;       // 0x00'00'00'FF
-		const uint32_t limUhi = _running.u << 16; // 0x00'FF'00'00
-		const uint32_t limVlo = _running.v << 8;  // 0x00'00'FF'00
-		const uint32_t limVhi = _running.v << 24; // 0xFF'00'00'00
-
-		for (const uint8_t* end = currentSourceY + width;   currentSourceY < end; currentSourceY += 4)
-			if (uint32_t y = *reinterpret_cast<uint32_t*>(currentSourceY); (y & 0x00'00'00'FF) > limYlo || (y & 0x00'FF'00'00) > limYhi)
-			{
-				_running.y = std::max(currentSourceY[0], currentSourceY[2]);
-				return true;
-			}
-
-		for (const uint8_t* end = currentSourceUV + width / 2; currentSourceUV < end; currentSourceUV += 4)
-			if (uint32_t uv = *reinterpret_cast<uint32_t*>(currentSourceUV); (uv & 0x00'00'00'FF) > limUlo || (uv & 0x00'FF'00'00) > limUhi ||
-																			 (uv & 0x00'00'FF'00) > limVlo || (uv & 0xFF'00'00'00) > limVhi)
-			{
-				_running.u = std::max(std::max(currentSourceUV[0], currentSourceUV[2]), _running.u);
-				_running.v = std::max(std::max(currentSourceUV[1], currentSourceUV[3]), _running.v);
-				return true;
-			}
-		return false;
-	};
+	// the source YUV range is collected by the FrameDecoder kernels (every 4th row) as a part of the frame statistics
+	const FrameStatistics::SourceRange range = statistics.sourceRange();
 
-	_triggered = _triggered || checkRange();
-}
-
-void AutomaticToneMapping::scan_Y_UV_16(int width, uint8_t* currentSourceY, uint8_t* currentSourceUV)
-{
-	auto checkRange = [&]() -> bool {
-		const uint32_t limYlo = _running.y << 8;  // 0x00'00'FF'00
-		const uint32_t limYhi = _running.y << 24; // 0xFF'00'00'00
-		const uint32_t limU = _running.u << 8;    // 0x00'00'FF'00
-		const uint32_t limV = _running.v << 24;   // 0xFF'00'00'00
-
-		for (const uint8_t* end = currentSourceY + 2 * width; currentSourceY < end; currentSourceY += 4)
-			if (uint32_t y = *reinterpret_cast<uint32_t*>(currentSourceY); (y & 0x00'00'FF'00) > limYlo || (y & 0xFF'00'00'00) > limYhi)
-			{
-				_running.y = std::max(currentSourceY[1], currentSourceY[3]);
-				return true;
-			}
-
-		for (const uint8_t* end = currentSourceUV + width; currentSourceUV < end; currentSourceUV += 4)
-			if (uint32_t uv = *reinterpret_cast<uint32_t*>(currentSourceUV); (uv & 0x00'00'FF'00) > limU || (uv & 0xFF'00'00'00) > limV)
-			{
-				_running.u = std::max(currentSourceUV[1], _running.u);
-				_running.v = std::max(currentSourceUV[3], _running.v);
-				return true;
-			}
-		return false;
-	};
-
-	_triggered = _triggered || checkRange();
+	if (range.y > _running.y || range.u > _running.u || range.v > _running.v)
+	{
+		_running.y = std::max(range.y, _running.y);
+		_running.u = std::max(range.u, _running.u);
+		_running.v = std::max(range.v, _running.v);
+		_triggered = true;
+	}
 }
 
 void AutomaticToneMapping::finilize()
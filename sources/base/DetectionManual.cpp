@@ -1,4 +1,5 @@
 #include <base/Grabber.h>
+#include <image/FrameStatistics.h>
 
 DetectionManual::DetectionManual() :
 	_log("SIGNAL_OLD")
@@ -27,12 +28,23 @@ bool DetectionManual::checkSignalDetectionManual(Image<ColorRgb>& image)
 	unsigned xMax = image.width() * _x_frac_max;
 	unsigned yMax = image.height() * _y_frac_max;
 
+	// use the region maximum collected by the frame decoder if the detection area matches its grid
+	ColorRgb regionMax;
+	const FrameStatistics* statistics = image.getStatistics();
 
-	for (unsigned x = xOffset; noSignal && x < xMax; ++x)
+	if (statistics != nullptr && statistics->regionMax(_x_frac_min, _y_frac_min, _x_frac_max, _y_frac_max, regionMax))
+	{
+		noSignal = regionMax <= _noSignalThresholdColor;
+	}
+	else
 	{
 		for (unsigned y = yOffset; noSignal && y < yMax; ++y)
 		{
-			noSignal &= (ColorRgb&)image(x, y) <= _noSignalThresholdColor;
+			const ColorRgb* pixel = &image(xOffset, y);
+			for (unsigned x = xOffset; noSignal && x < xMax; ++x, ++pixel)
+			{
+				noSignal &= *pixel <= _noSignalThresholdColor;
+			}
 		}
 	}
 
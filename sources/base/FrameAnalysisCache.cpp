@@ -0,0 +1,275 @@
+/* FrameAnalysisCache.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <algorithm>
+#endif
+
+#include <base/FrameAnalysisCache.h>
+#include <infinite-color-engine/InfiniteProcessing.h>
+#include <utils/InternalClock.h>
+
+using namespace hyperhdr;
+using namespace linalg::aliases;
+
+namespace
+{
+	// the cost is averaged over this many pixels, then the history is halved so it follows the load of the system
+	constexpr uint64_t COST_HISTORY = 1ull << 26;
+
+	// until a table has been built, its cost per pixel is assumed to be twice the cost of sampling a pixel
+	constexpr double DEFAULT_BUILD_RATIO = 2.0;
+}
+
+std::mutex FrameAnalysisCache::_mutex;
+std::map<const void*, FrameAnalysisCache::Consumer> FrameAnalysisCache::_consumers;
+FrameAnalysisCache::Cost FrameAnalysisCache::_samplingCost;
+FrameAnalysisCache::Cost FrameAnalysisCache::_buildCost;
+std::array<FrameAnalysisCache::Entry, FrameAnalysisCache::CACHE_SIZE> FrameAnalysisCache::_entries;
+int FrameAnalysisCache::_nextEntry = 0;
+
+void LinearAreaTable::build(const Image<ColorRgb>& image)
+{
+	_width = image.width();
+	_height = image.height();
+
+	const std::array<unsigned, 2> parityHeight = { (_height + 1) / 2, _height / 2 };
+	_parityWidth = { (_width + 1) / 2, _width / 2 };
+
+	for (unsigned py = 0; py < 2; py++)
+		for (unsigned px = 0; px < 2; px++)
+		{
+			auto& table = _tables[py * 2 + px];
+			const size_t stride = static_cast<size_t>(_parityWidth[px]) + 1;
+
+			table.resize(stride * (static_cast<size_t>(parityHeight[py]) + 1));
+			std::fill_n(table.begin(), stride, linalg::vec<uint32_t, 3>(0, 0, 0));
+		}
+
+	const uint8_t* imgData = image.rawMem();
+	for (unsigned y = 0; y < _height; y++)
+	{
+		const unsigned py = y & 1;
+		const size_t row = y >> 1;
+		std::array<const linalg::vec<uint32_t, 3>*, 2> above;
+		std::array<linalg::vec<uint32_t, 3>*, 2> current;
+		std::array<linalg::vec<uint32_t, 3>, 2> rowSum = { linalg::vec<uint32_t, 3>(0, 0, 0), linalg::vec<uint32_t, 3>(0, 0, 0) };
+
+		for (unsigned px = 0; px < 2; px++)
+		{
+			auto& table = _tables[py * 2 + px];
+			const size_t stride = static_cast<size_t>(_parityWidth[px]) + 1;
+
+			above[px] = &table[row * stride];
+			current[px] = &table[(row + 1) * stride];
+			current[px][0] = rowSum[px];
+		}
+
+		for (unsigned x = 0; x < _width; x++, imgData += 3)
+		{
+			const unsigned px = x & 1;
+			const unsigned column = (x >> 1) + 1;
+
+			rowSum[px] += linalg::vec<uint32_t, 3>(InfiniteProcessing::srgbNonlinearToLinear(byte3(imgData[0], imgData[1], imgData[2])));
+			current[px][column] = above[px][column] + rowSum[px];
+		}
+	}
+}
+
+unsigned LinearAreaTable::width() const
+{
+	return _width;
+}
+
+unsigned LinearAreaTable::height() const
+{
+	return _height;
+}
+
+linalg::vec<uint_fast64_t, 3> LinearAreaTable::sum(unsigned x1, unsigned y1, unsigned x2, unsigned y2, unsigned step) const
+{
+	x2 = std::min(x2, _width);
+	y2 = std::min(y2, _height);
+	if (x1 >= x2 || y1 >= y2)
+		return linalg::vec<uint_fast64_t, 3>(0, 0, 0);
+
+	// the sparse processing visits only the pixels with the parity of the top-left corner
+	if (step > 1)
+		return sumParity(x1 & 1, y1 & 1, x1, y1, x2, y2);
+
+	return sumParity(0, 0, x1, y1, x2, y2) + sumParity(1, 0, x1, y1, x2, y2) +
+		sumParity(0, 1, x1, y1, x2, y2) + sumParity(1, 1, x1, y1, x2, y2);
+}
+
+linalg::vec<uint_fast64_t, 3> LinearAreaTable::sumParity(unsigned px, unsigned py, unsigned x1, unsigned y1, unsigned x2, unsigned y2) const
+{
+	linalg::vec<uint_fast64_t, 3> result(0, 0, 0);
+
+	// the columns and rows of the parity table that cover the rectangle
+	const unsigned left = (x1 + 1 - px) / 2;
+	const unsigned right = (x2 + 1 - px) / 2;
+	const unsigned first = (y1 + 1 - py) / 2;
+	const unsigned last = (y2 + 1 - py) / 2;
+
+	if (left >= right || first >= last)
+		return result;
+
+	const auto& table = _tables[py * 2 + px];
+	const size_t stride = static_cast<size_t>(_parityWidth[px]) + 1;
+	const unsigned bandHeight = std::max(MAX_EXACT_AREA / (right - left), 1u);
+
+	for (unsigned top = first; top < last; top += bandHeight)
+	{
+		const unsigned bottom = std::min(top + bandHeight, last);
+		const auto& a = table[top * stride + left];
+		const auto& b = table[top * stride + right];
+		const auto& c = table[bottom * stride + left];
+		const auto& d = table[bottom * stride + right];
+
+		// unsigned wrap-around cancels out, the band sum itself always fits in 32 bits
+		result += linalg::vec<uint_fast64_t, 3>(d - b - c + a);
+	}
+
+	return result;
+}
+
+void FrameAnalysisCache::Cost::add(uint64_t newUnits, int64_t newTimeUs)
+{
+	units += newUnits;
+	timeUs += std::max(newTimeUs, int64_t(0));
+
+	if (units > COST_HISTORY)
+	{
+		units /= 2;
+		timeUs /= 2;
+	}
+}
+
+double FrameAnalysisCache::Cost::perUnit() const
+{
+	return (units > 0) ? static_cast<double>(timeUs) / units : 0.0;
+}
+
+void FrameAnalysisCache::updateConsumer(const void* consumer, unsigned width, unsigned height, uint64_t samples)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_consumers[consumer] = Consumer{ width, height, samples };
+}
+
+void FrameAnalysisCache::removeConsumer(const void* consumer)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_consumers.erase(consumer);
+}
+
+bool FrameAnalysisCache::isWorthSharing(unsigned width, unsigned height)
+{
+	const uint64_t frameArea = static_cast<uint64_t>(width) * height;
+
+	if (frameArea == 0 || frameArea > LinearAreaTable::MAX_FRAME_AREA)
+		return false;
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	// nothing is known about the sampling yet: the instances sample the frame themselves and measure it
+	if (_samplingCost.units == 0)
+		return false;
+
+	uint64_t samples = 0;
+	for (const auto& [owner, consumer] : _consumers)
+		if (consumer.width == width && consumer.height == height)
+			samples += consumer.samples;
+
+	const double samplingTime = samples * _samplingCost.perUnit();
+	const double buildTime = frameArea * ((_buildCost.units > 0) ? _buildCost.perUnit() : DEFAULT_BUILD_RATIO * _samplingCost.perUnit());
+
+	return samplingTime > buildTime;
+}
+
+void FrameAnalysisCache::reportSamplingTime(uint64_t samples, int64_t timeUs)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_samplingCost.add(samples, timeUs);
+}
+
+std::shared_ptr<const LinearAreaTable> FrameAnalysisCache::getLinearAreaTable(const Image<ColorRgb>& image)
+{
+	const FrameTiming& timing = image.getFrameTiming();
+
+	// only captured frames carry a sequence that identifies them
+	if (!timing.isValid() || static_cast<uint64_t>(image.width()) * image.height() > LinearAreaTable::MAX_FRAME_AREA)
+		return nullptr;
+
+	std::shared_ptr<Slot> slot;
+	bool builder = false;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		for (const Entry& entry : _entries)
+		{
+			if (entry.slot != nullptr && entry.sequence == timing.sequence && entry.width == image.width() && entry.height == image.height())
+			{
+				slot = entry.slot;
+				break;
+			}
+		}
+
+		if (slot == nullptr)
+		{
+			Entry& victim = _entries[_nextEntry];
+			_nextEntry = (_nextEntry + 1) % CACHE_SIZE;
+
+			// the table of an older frame that nobody reads anymore is rebuilt in place
+			slot = std::make_shared<Slot>();
+			if (victim.slot != nullptr && victim.slot.use_count() == 1 && victim.slot->table.use_count() == 1)
+				slot->table = std::move(victim.slot->table);
+			else
+				slot->table = std::make_shared<LinearAreaTable>();
+
+			victim = Entry{ timing.sequence, image.width(), image.height(), slot };
+			builder = true;
+		}
+	}
+
+	if (builder)
+	{
+		const int64_t begin = InternalClock::nowMicro();
+		slot->table->build(image);
+		const int64_t buildTime = InternalClock::nowMicro() - begin;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_buildCost.add(static_cast<uint64_t>(image.width()) * image.height(), buildTime);
+		}
+
+		slot->ready.store(true, std::memory_order_release);
+		return slot->table;
+	}
+
+	// another instance is still building the table: the caller samples the frame itself instead of waiting
+	return (slot->ready.load(std::memory_order_acquire)) ? slot->table : nullptr;
+}
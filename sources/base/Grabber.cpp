@@ -26,12 +26,17 @@
  */
 
 #ifndef PCH_ENABLED
+	#include <QDateTime>
+	#include <QDir>
 	#include <QFile>
+	#include <QFileInfo>
 	#include <QJsonArray>
 #endif
 
 #include <base/Grabber.h>
+#include <image/FrameStatistics.h>
 #include <utils/GlobalSignals.h>
+#include <performance-counters/PerformanceTracer.h>
 
 const QString Grabber::AUTO_SETTING = QString("auto");
 const int	  Grabber::AUTO_INPUT = -1;
@@ -63,6 +68,7 @@ Grabber::Grabber(const QString& configurationPath, const QString& grabberName)
 	, _saturation(0)
 	, _hue(0)
 	, _qframe(false)
+	, _mjpegDecimation(1)
 	, _blocked(false)
 	, _restartNeeded(false)
 	, _initialized(false)
@@ -86,6 +92,7 @@ Grabber::Grabber(const QString& configurationPath, const QString& grabberName)
 
 Grabber::~Grabber()
 {
+	_frameRecorder = nullptr;
 	disconnect(GlobalSignals::getInstance(), &GlobalSignals::SignalSetLut, this, &Grabber::signalSetLutHandler);
 }
 
@@ -396,6 +403,12 @@ void Grabber::setQFrameDecimation(int setQframe)
 	Info(_log, "{:s}", (QString("setQFrameDecimation is now: %1").arg(_qframe ? "enabled" : "disabled")));
 }
 
+void Grabber::setMjpegDecimation(int decimation)
+{
+	_mjpegDecimation = (decimation == 4 || decimation == 8) ? decimation : 1;
+	Info(_log, "MJPEG decoding scale is now: 1/{:d}{:s}", _mjpegDecimation, (_mjpegDecimation == 8) ? " (DC coefficients only)" : "");
+}
+
 void Grabber::unblockAndRestart(bool running)
 {
 	if (_restartNeeded && running)
@@ -666,11 +679,18 @@ int Grabber::getTargetSystemFrameDimension(int actualWidth, int actualHeight, in
 
 void Grabber::processSystemFrameBGRA(uint8_t* source, int lineSize, bool useLut)
 {
+	const int64_t captureTime = InternalClock::nowMicro();
 	int targetSizeX, targetSizeY;
 	int divide = getTargetSystemFrameDimension(targetSizeX, targetSizeY);
 	Image<ColorRgb> image(targetSizeX, targetSizeY);
+	auto statistics = (_signalDetectionEnabled) ? std::make_shared<FrameStatistics>() : nullptr;
 
-	FrameDecoder::processSystemImageBGRA(image, targetSizeX, targetSizeY, _cropLeft, _cropTop, source, _actualWidth, _actualHeight, divide, (_hdrToneMappingEnabled == 0 || !_lutBufferInit || !useLut) ? nullptr : _lut.data(), lineSize);
+	{
+		PerformanceTracer::Scope trace(PerformanceTracer::Stage::DECODE);
+		FrameDecoder::processSystemImageBGRA(image, targetSizeX, targetSizeY, _cropLeft, _cropTop, source, _actualWidth, _actualHeight, divide, (_hdrToneMappingEnabled == 0 || !_lutBufferInit || !useLut) ? nullptr : _lut.data(), lineSize, statistics.get());
+	}
+	image.setStatistics(statistics);
+	image.setFrameTiming(FrameTiming::capture(captureTime));
 
 	if (_signalDetectionEnabled)
 	{
@@ -683,11 +703,18 @@ void Grabber::processSystemFrameBGRA(uint8_t* source, int lineSize, bool useLut)
 
 void Grabber::processSystemFrameBGR(uint8_t* source, int lineSize)
 {
+	const int64_t captureTime = InternalClock::nowMicro();
 	int targetSizeX, targetSizeY;
 	int divide = getTargetSystemFrameDimension(targetSizeX, targetSizeY);
 	Image<ColorRgb> image(targetSizeX, targetSizeY);
+	auto statistics = (_signalDetectionEnabled) ? std::make_shared<FrameStatistics>() : nullptr;
 
-	FrameDecoder::processSystemImageBGR(image, targetSizeX, targetSizeY, _cropLeft, _cropTop, source, _actualWidth, _actualHeight, divide, (_hdrToneMappingEnabled == 0 || !_lutBufferInit) ? nullptr : _lut.data(), lineSize);
+	{
+		PerformanceTracer::Scope trace(PerformanceTracer::Stage::DECODE);
+		FrameDecoder::processSystemImageBGR(image, targetSizeX, targetSizeY, _cropLeft, _cropTop, source, _actualWidth, _actualHeight, divide, (_hdrToneMappingEnabled == 0 || !_lutBufferInit) ? nullptr : _lut.data(), lineSize, statistics.get());
+	}
+	image.setStatistics(statistics);
+	image.setFrameTiming(FrameTiming::capture(captureTime));
 
 	if (_signalDetectionEnabled)
 	{
@@ -700,11 +727,18 @@ void Grabber::processSystemFrameBGR(uint8_t* source, int lineSize)
 
 void Grabber::processSystemFrameBGR16(uint8_t* source, int lineSize)
 {
+	const int64_t captureTime = InternalClock::nowMicro();
 	int targetSizeX, targetSizeY;
 	int divide = getTargetSystemFrameDimension(targetSizeX, targetSizeY);
 	Image<ColorRgb> image(targetSizeX, targetSizeY);
+	auto statistics = (_signalDetectionEnabled) ? std::make_shared<FrameStatistics>() : nullptr;
 
-	FrameDecoder::processSystemImageBGR16(image, targetSizeX, targetSizeY, _cropLeft, _cropTop, source, _actualWidth, _actualHeight, divide, (_hdrToneMappingEnabled == 0 || !_lutBufferInit) ? nullptr : _lut.data(), lineSize);
+	{
+		PerformanceTracer::Scope trace(PerformanceTracer::Stage::DECODE);
+		FrameDecoder::processSystemImageBGR16(image, targetSizeX, targetSizeY, _cropLeft, _cropTop, source, _actualWidth, _actualHeight, divide, (_hdrToneMappingEnabled == 0 || !_lutBufferInit) ? nullptr : _lut.data(), lineSize, statistics.get());
+	}
+	image.setStatistics(statistics);
+	image.setFrameTiming(FrameTiming::capture(captureTime));
 
 	if (_signalDetectionEnabled)
 	{
@@ -717,11 +751,18 @@ void Grabber::processSystemFrameBGR16(uint8_t* source, int lineSize)
 
 void Grabber::processSystemFrameRGBA(uint8_t* source, int lineSize)
 {
+	const int64_t captureTime = InternalClock::nowMicro();
 	int targetSizeX, targetSizeY;
 	int divide = getTargetSystemFrameDimension(targetSizeX, targetSizeY);
 	Image<ColorRgb> image(targetSizeX, targetSizeY);
+	auto statistics = (_signalDetectionEnabled) ? std::make_shared<FrameStatistics>() : nullptr;
 
-	FrameDecoder::processSystemImageRGBA(image, targetSizeX, targetSizeY, _cropLeft, _cropTop, source, _actualWidth, _actualHeight, divide, (_hdrToneMappingEnabled == 0 || !_lutBufferInit) ? nullptr : _lut.data(), lineSize);
+	{
+		PerformanceTracer::Scope trace(PerformanceTracer::Stage::DECODE);
+		FrameDecoder::processSystemImageRGBA(image, targetSizeX, targetSizeY, _cropLeft, _cropTop, source, _actualWidth, _actualHeight, divide, (_hdrToneMappingEnabled == 0 || !_lutBufferInit) ? nullptr : _lut.data(), lineSize, statistics.get());
+	}
+	image.setStatistics(statistics);
+	image.setFrameTiming(FrameTiming::capture(captureTime));
 
 	if (_signalDetectionEnabled)
 	{
@@ -734,11 +775,18 @@ void Grabber::processSystemFrameRGBA(uint8_t* source, int lineSize)
 
 void Grabber::processSystemFramePQ10(uint8_t* source, int lineSize)
 {
+	const int64_t captureTime = InternalClock::nowMicro();
 	int targetSizeX, targetSizeY;
 	int divide = getTargetSystemFrameDimension(targetSizeX, targetSizeY);
 	Image<ColorRgb> image(targetSizeX, targetSizeY);
+	auto statistics = (_signalDetectionEnabled) ? std::make_shared<FrameStatistics>() : nullptr;
 
-	FrameDecoder::processSystemImagePQ10(image, targetSizeX, targetSizeY, _cropLeft, _cropTop, source, _actualWidth, _actualHeight, divide, (_hdrToneMappingEnabled == 0 || !_lutBufferInit) ? nullptr : _lut.data(), lineSize);
+	{
+		PerformanceTracer::Scope trace(PerformanceTracer::Stage::DECODE);
+		FrameDecoder::processSystemImagePQ10(image, targetSizeX, targetSizeY, _cropLeft, _cropTop, source, _actualWidth, _actualHeight, divide, (_hdrToneMappingEnabled == 0 || !_lutBufferInit) ? nullptr : _lut.data(), lineSize, statistics.get());
+	}
+	image.setStatistics(statistics);
+	image.setFrameTiming(FrameTiming::capture(captureTime));
 
 	if (_signalDetectionEnabled)
 	{
@@ -1004,3 +1052,122 @@ void Grabber::setAutoToneMappingCurrentStateEnabled(bool enabled)
 {
 	_automaticToneMapping.setToneMapping(enabled);
 }
+
+QJsonObject Grabber::startRecording(const QString& fileName, bool compress, quint64 frameLimit)
+{
+	stopRecording();
+
+	if (!_initialized || _actualVideoFormat == PixelFormat::NO_CHANGE || _actualWidth <= 0 || _actualHeight <= 0)
+	{
+		QJsonObject info;
+		info["running"] = false;
+		info["error"] = "The grabber is not capturing";
+		return info;
+	}
+
+	// only a bare file name is accepted and it always lands in the recordings folder of the configuration directory
+	QString name = QFileInfo(fileName).fileName();
+	if (!fileName.isEmpty() && (QDir::isAbsolutePath(fileName) || fileName.contains("..") || name != fileName || name.isEmpty()))
+	{
+		QJsonObject info;
+		info["running"] = false;
+		info["error"] = "The recording file name must not contain a path";
+		return info;
+	}
+
+	QDir folder(QString("%1/recordings").arg(_configurationPath));
+	QString target = folder.absoluteFilePath((name.isEmpty()) ?
+		QString("capture_%1_%2x%3_%4.hrec").arg(pixelFormatToString(_actualVideoFormat)).arg(_actualWidth).arg(_actualHeight)
+		.arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss")) : name);
+
+	folder.mkpath(".");
+
+	auto recorder = std::make_shared<FrameRecorder>();
+
+	if (!recorder->start(target, _actualVideoFormat, _actualWidth, _actualHeight, _lineLength, compress, frameLimit))
+	{
+		Error(_log, "{:s}", recorder->getLastError());
+		_lastRecordingInfo = recorder->getInfo();
+		_lastRecordingInfo["error"] = recorder->getLastError();
+		return _lastRecordingInfo;
+	}
+
+	{
+		std::lock_guard<std::mutex> locker(_recorderMutex);
+		_frameRecorder = recorder;
+		_recordingStopPending = false;
+	}
+
+	Info(_log, "Recording {:s} {:d}x{:d} frames to: {:s} ({:s})", pixelFormatToString(_actualVideoFormat), _actualWidth, _actualHeight,
+		target, (compress) ? "zstd" : "uncompressed");
+
+	return getRecordingInfo();
+}
+
+QJsonObject Grabber::stopRecording()
+{
+	std::shared_ptr<FrameRecorder> recorder;
+
+	{
+		std::lock_guard<std::mutex> locker(_recorderMutex);
+		recorder = std::move(_frameRecorder);
+		_frameRecorder = nullptr;
+		_recordingStopPending = false;
+	}
+
+	if (recorder != nullptr)
+	{
+		recorder->stop();
+		_lastRecordingInfo = recorder->getInfo();
+
+		Info(_log, "Recording finished: {:d} frames, {:d} dropped, {:d} bytes written",
+			_lastRecordingInfo["frames"].toInt(), _lastRecordingInfo["dropped"].toInt(), static_cast<qint64>(_lastRecordingInfo["fileBytes"].toDouble()));
+	}
+
+	return _lastRecordingInfo;
+}
+
+QJsonObject Grabber::getRecordingInfo()
+{
+	std::shared_ptr<FrameRecorder> recorder;
+
+	{
+		std::lock_guard<std::mutex> locker(_recorderMutex);
+		recorder = _frameRecorder;
+	}
+
+	return (recorder != nullptr) ? recorder->getInfo() : _lastRecordingInfo;
+}
+
+void Grabber::recordFrame(const void* frameImageBuffer, int size)
+{
+	std::shared_ptr<FrameRecorder> recorder;
+
+	{
+		std::lock_guard<std::mutex> locker(_recorderMutex);
+
+		if (_frameRecorder == nullptr || _recordingStopPending)
+			return;
+
+		if (!_frameRecorder->matches(_actualVideoFormat, _actualWidth, _actualHeight))
+		{
+			// called from the capture thread: the recorder is owned and stopped by the grabber's thread
+			Warning(_log, "The video mode has changed. Stopping the recording.");
+			_recordingStopPending = true;
+			QMetaObject::invokeMethod(this, [this]() { stopRecording(); }, Qt::QueuedConnection);
+			return;
+		}
+
+		// the frame limit is reached or the file could not be written: release the recorder the same way
+		if (!_frameRecorder->isRecording())
+		{
+			_recordingStopPending = true;
+			QMetaObject::invokeMethod(this, [this]() { stopRecording(); }, Qt::QueuedConnection);
+			return;
+		}
+
+		recorder = _frameRecorder;
+	}
+
+	recorder->record(static_cast<const uint8_t*>(frameImageBuffer), static_cast<size_t>(size));
+}
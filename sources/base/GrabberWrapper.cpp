@@ -27,6 +27,7 @@
 
 #ifndef PCH_ENABLED
 	#include <QTimer>
+	#include <algorithm>
 	#include <QThread>
 	#include <QDir>
 	#include <QFileInfo>
@@ -57,6 +58,10 @@ GrabberWrapper::GrabberWrapper(const QString& grabberName)
 	connect(GlobalSignals::getInstance(), &GlobalSignals::SignalRequestComponent, this, &GrabberWrapper::signalRequestSourceHandler);
 	connect(this, &GrabberWrapper::SignalCecKeyPressed, this, &GrabberWrapper::signalCecKeyPressedHandler);
 	connect(this, &GrabberWrapper::SignalInstancePauseChanged, this, &GrabberWrapper::signalInstancePauseChangedHandler);
+
+	// the serverinfo snapshot is published in the grabber thread: first when the grabber is set up, then on every device or mode change
+	connect(this, &GrabberWrapper::SignalVideoStreamChanged, this, &GrabberWrapper::publishJsonInfo, Qt::QueuedConnection);
+	QTimer::singleShot(0, this, &GrabberWrapper::publishJsonInfo);
 }
 
 void GrabberWrapper::signalRequestSourceHandler(hyperhdr::Components component, int instanceIndex, bool listen)
@@ -206,6 +211,30 @@ QJsonDocument GrabberWrapper::getCalibrationInfo()
 	return _grabber->getCalibrationInfo();
 }
 
+QJsonDocument GrabberWrapper::startRecording(QString fileName, bool compress, int frameLimit)
+{
+	if (_grabber == nullptr)
+		return QJsonDocument();
+
+	return QJsonDocument(_grabber->startRecording(fileName, compress, static_cast<quint64>(std::max(frameLimit, 0))));
+}
+
+QJsonDocument GrabberWrapper::stopRecording()
+{
+	if (_grabber == nullptr)
+		return QJsonDocument();
+
+	return QJsonDocument(_grabber->stopRecording());
+}
+
+QJsonDocument GrabberWrapper::getRecordingInfo()
+{
+	if (_grabber == nullptr)
+		return QJsonDocument();
+
+	return QJsonDocument(_grabber->getRecordingInfo());
+}
+
 void GrabberWrapper::signalCecKeyPressedHandler(int key)
 {
 	if (_grabber != nullptr)
@@ -280,6 +309,16 @@ QJsonObject GrabberWrapper::getJsonInfo()
 	return grabbers;
 }
 
+void GrabberWrapper::publishJsonInfo()
+{
+	_jsonInfo.publish(getJsonInfo());
+}
+
+bool GrabberWrapper::getPublishedJsonInfo(QJsonObject& info, quint64* revision)
+{
+	return _jsonInfo.read(info, revision, [this]() { QUEUE_CALL_0(this, publishJsonInfo); });
+}
+
 QMap<Grabber::currentVideoModeInfo, QString> GrabberWrapper::getVideoCurrentMode() const
 {
 	if (_grabber != nullptr)
@@ -305,6 +344,9 @@ void GrabberWrapper::stop()
 {
 	emit GlobalSignals::getInstance()->SignalPerformanceStateChanged(false, PerformanceReportType::VIDEO_GRABBER, -1);
 
+	if (_grabber != nullptr)
+		_grabber->stopRecording();
+
 	if (_grabber != nullptr && _grabber->isInitialized())
 		_grabber->stop();
 }
@@ -548,6 +590,8 @@ void GrabberWrapper::handleSettingsUpdate(settings::type type, const QJsonDocume
 
 			_grabber->setQFrameDecimation(obj["qFrame"].toBool(false));
 
+			_grabber->setMjpegDecimation(obj["mjpegDecimation"].toInt(1));
+
 			_grabber->unblockAndRestart(_configLoaded);
 		}
 		catch (...)
@@ -30,6 +30,7 @@
 	#include <QStringList>
 	#include <QThread>
 	#include <QPair>
+	#include <QTimer>
 
 	#include <exception>
 	#include <sstream>	
@@ -57,6 +58,7 @@
 #include <infinite-color-engine/InfiniteProcessing.h>
 #include <infinite-color-engine/CoreInfiniteEngine.h>
 #include <infinite-color-engine/ColorSpace.h>
+#include <performance-counters/PerformanceTracer.h>
 
 std::atomic<bool> HyperHdrInstance::_signalTerminate(false);
 std::atomic<int>  HyperHdrInstance::_totalRunningCount(0);
@@ -82,6 +84,8 @@ HyperHdrInstance::HyperHdrInstance(quint8 instance, bool disableOnStartup, QStri
 	, _currentLedColors()
 	, _name((name.isEmpty()) ? QString("INSTANCE%1").arg(instance) : name)
 	, _disableOnStartup(disableOnStartup)
+	, _jsonInfoScheduled(false)
+	, _jsonInfoPrioritiesChanged(false)
 {
 	_totalRunningCount++;
 }
@@ -170,6 +174,8 @@ void HyperHdrInstance::start()
 	// create the effect engine; needs to be initialized after smoothing!
 	_effectEngine = std::make_unique<EffectEngine>(this);
 	connect(this, &HyperHdrInstance::SignalVisiblePriorityChanged, _effectEngine.get(), &EffectEngine::visiblePriorityChanged);
+	connect(this, &HyperHdrInstance::SignalImageToLedsMappingChanged, this, &HyperHdrInstance::updateEffectImageRequirement);
+	updateEffectImageRequirement();
 
 	// create the Daemon capture interface
 	_videoControl = std::make_unique<VideoControl>(this);
@@ -194,6 +200,14 @@ void HyperHdrInstance::start()
 
 	emit GlobalSignals::getInstance()->SignalRequestComponent(hyperhdr::Components::COMP_HDR, _instIndex, true);
 
+	// publish the serverinfo snapshot whenever its content may have changed
+	connect(this, &HyperHdrInstance::SignalPrioritiesChanged, this, [this]() { scheduleJsonInfo(true); });
+	connect(this, &HyperHdrInstance::SignalComponentStateChanged, this, [this]() { scheduleJsonInfo(false); });
+	connect(this, &HyperHdrInstance::SignalAdjustmentUpdated, this, [this]() { scheduleJsonInfo(false); });
+	connect(this, &HyperHdrInstance::SignalImageToLedsMappingChanged, this, [this]() { scheduleJsonInfo(false); });
+	connect(this, &HyperHdrInstance::SignalInstanceSettingsChanged, this, [this]() { scheduleJsonInfo(false); });
+	publishJsonInfo();
+
 	// instance initiated, enter thread event loop
 	emit SignalInstanceJustStarted();
 
@@ -208,6 +222,32 @@ void HyperHdrInstance::start()
 }
 
 
+void HyperHdrInstance::updateEffectImageRequirement()
+{
+	if (_effectEngine == nullptr)
+		return;
+
+	// the effects can skip the image only when nothing but the LED colors is taken from it
+	const bool imageRequired = _imageProcessor->getLedMappingType() == ImageToLedManager::mappingTypeToInt("unicolor_mean") ||
+		isSignalConnected(QMetaMethod::fromSignal(&HyperHdrInstance::SignalInstanceImageUpdated));
+
+	_effectEngine->setImageRequired(imageRequired);
+}
+
+void HyperHdrInstance::connectNotify(const QMetaMethod& signal)
+{
+	// the listeners of the image stream can connect from any thread
+	if (signal == QMetaMethod::fromSignal(&HyperHdrInstance::SignalInstanceImageUpdated))
+		QUEUE_CALL_0(this, updateEffectImageRequirement);
+}
+
+void HyperHdrInstance::disconnectNotify(const QMetaMethod& signal)
+{
+	// an invalid method: a disconnection of all signals
+	if (!signal.isValid() || signal == QMetaMethod::fromSignal(&HyperHdrInstance::SignalInstanceImageUpdated))
+		QUEUE_CALL_0(this, updateEffectImageRequirement);
+}
+
 void HyperHdrInstance::handleSettingsUpdate(settings::type type, const QJsonDocument& config)
 {
 
@@ -221,6 +261,7 @@ void HyperHdrInstance::handleSettingsUpdate(settings::type type, const QJsonDocu
 		_ledString = LedString::createLedString(leds, LedString::createColorOrder(getSetting(settings::type::DEVICE).object()));
 		_imageProcessor->setLedString(_ledString);
 		_ledGridSize = LedString::getLedLayoutGridSize(leds);
+		_effectEngine->setLedLayout(_ledString.leds());
 
 		QVector<ColorRgb> color(_ledString.leds().size(), ColorRgb{ 0,0,0 });
 		_currentLedColors = color;
@@ -392,6 +433,7 @@ bool HyperHdrInstance::getReadOnlyMode() const
 void HyperHdrInstance::setSourceAutoSelect(bool state)
 {
 	_muxer->setSourceAutoSelectEnabled(state);
+	scheduleJsonInfo(true);
 }
 
 bool HyperHdrInstance::setVisiblePriority(int priority)
@@ -499,7 +541,7 @@ void HyperHdrInstance::setInputImage(int priority, const Image<ColorRgb>& image,
 
 				if (!colors.empty())
 				{
-					updateResult(std::move(colors));
+					updateResult(std::move(colors), image.getFrameTiming());
 					emit SignalInstanceImageUpdated(image);
 				}
 			}
@@ -701,7 +743,7 @@ void HyperHdrInstance::update()
 	updateResult(std::move(linear255Color));
 }
 
-void HyperHdrInstance::updateResult(std::vector<linalg::aliases::float3>&& _ledBuffer)
+void HyperHdrInstance::updateResult(std::vector<linalg::aliases::float3>&& _ledBuffer, const FrameTiming& timing)
 {
 	// stats
 	int64_t now = InternalClock::now();
@@ -746,9 +788,12 @@ void HyperHdrInstance::updateResult(std::vector<linalg::aliases::float3>&& _ledB
 		emit SignalRawColorsChanged(_currentLedColors);
 	}
 
+	if (timing.isValid())
+		PerformanceTracer::record(PerformanceTracer::Stage::INSTANCE_LATENCY, getInstanceIndex(), timing.captureTime, InternalClock::nowMicro());
+
 	if (_ledDeviceWrapper->enabled())
 	{		
-		_infinite->incomingColors(std::move(_ledBuffer));		
+		_infinite->incomingColors(std::move(_ledBuffer), timing);
 	}
 }
 
@@ -939,6 +984,104 @@ QJsonObject HyperHdrInstance::getJsonInfo(bool full)
 	return info;
 }
 
+void HyperHdrInstance::scheduleJsonInfo(bool prioritiesChanged)
+{
+	_jsonInfoPrioritiesChanged |= prioritiesChanged;
+
+	// coalesce a burst of changes into one snapshot
+	if (!_jsonInfoScheduled)
+	{
+		_jsonInfoScheduled = true;
+		QTimer::singleShot(0, this, &HyperHdrInstance::publishJsonInfo);
+	}
+}
+
+void HyperHdrInstance::publishJsonInfo()
+{
+	bool prioritiesChanged = _jsonInfoPrioritiesChanged;
+
+	_jsonInfoScheduled = false;
+	_jsonInfoPrioritiesChanged = false;
+
+	if (_muxer == nullptr)
+		return;
+
+	PublishedJsonInfo published;
+	int64_t now = InternalClock::now();
+	auto previous = _jsonInfo.load();
+
+	published.info = getJsonInfo(true);
+
+	if (previous != nullptr)
+	{
+		const QJsonObject& previousInfo = previous->data.info;
+		for (auto it = published.info.constBegin(); it != published.info.constEnd(); ++it)
+		{
+			auto previousSection = previousInfo.constFind(it.key());
+			if (previousSection == previousInfo.constEnd() || previousSection.value() != it.value())
+				continue;
+
+			auto revision = previous->data.revisions.find(it.key());
+			published.revisions[it.key()] = (revision != previous->data.revisions.end()) ? revision->second : previous->version;
+		}
+	}
+
+	const QJsonArray priorities = published.info["priorities"].toArray();
+	for (int i = 0; i < priorities.size(); i++)
+	{
+		const QJsonObject item = priorities[i].toObject();
+		if (item.contains("duration_ms"))
+			published.timeouts.emplace_back(i, now + item["duration_ms"].toInt());
+	}
+
+	_jsonInfo.publish(std::move(published));
+
+	emit SignalJsonInfoPublished(prioritiesChanged);
+}
+
+bool HyperHdrInstance::getPublishedJsonInfo(bool full, QJsonObject& info, QJsonObject* revisions) const
+{
+	auto snapshot = _jsonInfo.load();
+	if (snapshot == nullptr)
+		return false;
+
+	const QJsonObject& published = snapshot->data.info;
+	QJsonArray priorities = published["priorities"].toArray();
+
+	if (!snapshot->data.timeouts.empty())
+	{
+		int64_t now = InternalClock::now();
+		for (const auto& [index, timeout] : snapshot->data.timeouts)
+		{
+			QJsonObject item = priorities[index].toObject();
+			item["duration_ms"] = int(timeout - now);
+			priorities[index] = item;
+		}
+	}
+
+	if (full)
+	{
+		info = published;
+	}
+	else
+	{
+		info = QJsonObject();
+		info["priorities_autoselect"] = published["priorities_autoselect"];
+	}
+	info["priorities"] = priorities;
+
+	if (revisions != nullptr)
+	{
+		for (auto it = info.constBegin(); it != info.constEnd(); ++it)
+		{
+			auto revision = snapshot->data.revisions.find(it.key());
+			(*revisions)[it.key()] = static_cast<qint64>((revision != snapshot->data.revisions.end()) ? revision->second : snapshot->version);
+		}
+	}
+
+	return true;
+}
+
 void HyperHdrInstance::setSignalStateByCEC(bool enable)
 {
 	if (_systemControl != nullptr && _systemControl->isCEC())
@@ -956,6 +1099,11 @@ int HyperHdrInstance::hasLedClock()
 	return _ledDeviceWrapper->hasLedClock();
 }
 
+QJsonObject HyperHdrInstance::getLedPacingInfo()
+{
+	return _ledDeviceWrapper->getPacingInfo();
+}
+
 bool HyperHdrInstance::getScanParameters(size_t led, double& hscanBegin, double& hscanEnd, double& vscanBegin, double& vscanEnd) const
 {
 	return _imageProcessor->getScanParameters(led, hscanBegin, hscanEnd, vscanBegin, vscanEnd);
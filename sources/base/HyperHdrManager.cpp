@@ -39,6 +39,7 @@
 #include <base/AccessManager.h>
 #include <base/Muxer.h>
 #include <utils/GlobalSignals.h>
+#include <utils/SharedExecutor.h>
 #include <lut-calibrator/LutCalibrator.h>
 
 QString HyperHdrManager::getRootPath()
@@ -56,6 +57,10 @@ HyperHdrManager::HyperHdrManager(const QString& rootPath)
 	qRegisterMetaType<InstanceState>("InstanceState");
 	connect(this, &HyperHdrManager::SignalInstanceStateChanged, this, &HyperHdrManager::handleInstanceStateChange);
 
+	// must be the first receiver: the API clients read the published list when they get the signal
+	connect(this, &HyperHdrManager::SignalInstancesListChanged, this, &HyperHdrManager::publishInstanceData);
+	publishInstanceData();
+
 	connect(&_videoBenchmark, &VideoBenchmark::SignalBenchmarkUpdate, this, &HyperHdrManager::SignalBenchmarkUpdate);
 	connect(this, &HyperHdrManager::SignalBenchmarkCapture, &_videoBenchmark, &VideoBenchmark::benchmarkCapture);
 
@@ -214,6 +219,23 @@ QVector<QVariantMap> HyperHdrManager::getInstanceData() const
 	return instances;
 }
 
+void HyperHdrManager::publishInstanceData()
+{
+	_instanceData.publish(getInstanceData());
+}
+
+bool HyperHdrManager::getPublishedInstanceData(QVector<QVariantMap>& data, quint64* revision) const
+{
+	auto snapshot = _instanceData.load();
+	if (snapshot == nullptr)
+		return false;
+
+	data = snapshot->data;
+	if (revision != nullptr)
+		*revision = snapshot->version;
+	return true;
+}
+
 bool HyperHdrManager::areInstancesReady()
 {
 	if (_fireStarter <= 0)
@@ -294,22 +316,44 @@ bool HyperHdrManager::startInstance(quint8 inst, QObject* caller, int tan, bool
 	{
 		if (!_runningInstances.contains(inst) && !_startingInstances.contains(inst))
 		{
-			QThread* hyperhdrThread = new QThread();
-			hyperhdrThread->setObjectName("HyperHdrThread");
-
-			auto hyperhdr = std::shared_ptr<HyperHdrInstance>(
-				new HyperHdrInstance(inst,
-					disableOnStartup,
-					_instanceTable->getNamebyIndex(inst)),
-				[](HyperHdrInstance* oldInstance) {
-					THREAD_REMOVER(QString("HyperHDR instance at index = %1").arg(oldInstance->getInstanceIndex()),
-						oldInstance->thread(), oldInstance);
-				}
-			);
-
-			hyperhdr->moveToThread(hyperhdrThread);
-
-			connect(hyperhdrThread, &QThread::started, hyperhdr.get(), &HyperHdrInstance::start);
+			QThread* hyperhdrThread = nullptr;
+			std::shared_ptr<HyperHdrInstance> hyperhdr;
+
+			if (SharedExecutor::isEnabled())
+			{
+				auto executor = SharedExecutor::getInstance();
+
+				hyperhdr = std::shared_ptr<HyperHdrInstance>(
+					new HyperHdrInstance(inst,
+						disableOnStartup,
+						_instanceTable->getNamebyIndex(inst)),
+					[executor](HyperHdrInstance* oldInstance) {
+						SMARTPOINTER_MESSAGE(QString("HyperHDR instance at index = %1").arg(oldInstance->getInstanceIndex()));
+						executor->release(oldInstance);
+					}
+				);
+
+				executor->attach(hyperhdr.get(), QString("Instance%1").arg(inst));
+			}
+			else
+			{
+				hyperhdrThread = new QThread();
+				hyperhdrThread->setObjectName("HyperHdrThread");
+
+				hyperhdr = std::shared_ptr<HyperHdrInstance>(
+					new HyperHdrInstance(inst,
+						disableOnStartup,
+						_instanceTable->getNamebyIndex(inst)),
+					[](HyperHdrInstance* oldInstance) {
+						THREAD_REMOVER(QString("HyperHDR instance at index = %1").arg(oldInstance->getInstanceIndex()),
+							oldInstance->thread(), oldInstance);
+					}
+				);
+
+				hyperhdr->moveToThread(hyperhdrThread);
+
+				connect(hyperhdrThread, &QThread::started, hyperhdr.get(), &HyperHdrInstance::start);
+			}
 			connect(hyperhdr.get(), &HyperHdrInstance::SignalInstanceJustStarted, this, &HyperHdrManager::handleInstanceJustStarted);
 			connect(hyperhdr.get(), &HyperHdrInstance::SignalInstancePauseChanged, this, &HyperHdrManager::SignalInstancePauseChanged);
 			connect(hyperhdr.get(), &HyperHdrInstance::SignalInstanceSettingsChanged, this, &HyperHdrManager::SignalSettingsChanged);
@@ -318,7 +362,10 @@ bool HyperHdrManager::startInstance(quint8 inst, QObject* caller, int tan, bool
 
 			_startingInstances.insert(inst, hyperhdr);
 
-			hyperhdrThread->start();
+			if (hyperhdrThread != nullptr)
+				hyperhdrThread->start();
+			else
+				QUEUE_CALL_0(hyperhdr.get(), start);
 
 			_instanceTable->setLastUse(inst);
 			_instanceTable->setEnable(inst, true);
@@ -28,6 +28,7 @@
 #include <base/ImageColorAveraging.h>
 #include <base/ImageToLedManager.h>
 #include <infinite-color-engine/InfiniteProcessing.h>
+#include <utils/InternalClock.h>
 
 #include <algorithm>
 #include <ranges>
@@ -53,7 +54,9 @@ ImageColorAveraging::ImageColorAveraging(
 	, _sparseProcessing(sparseProcessing)
 	, _horizontalBorder(horizontalBorder)
 	, _verticalBorder(verticalBorder)
+	, _samples(0)
 	, _colorsMap()
+	, _areasMap()
 	, _colorGroups()
 {
 	Q_ASSERT(_width > 2 * _verticalBorder);
@@ -64,6 +67,7 @@ ImageColorAveraging::ImageColorAveraging(
 	_mappingType = mappingType;
 
 	_colorsMap.reserve(leds.size());
+	_areasMap.reserve(leds.size());
 
 	const int32_t xOffset = _verticalBorder;
 	const int32_t actualWidth = _width - 2 * _verticalBorder;
@@ -80,6 +84,7 @@ ImageColorAveraging::ImageColorAveraging(
 		if ((led.maxX_frac - led.minX_frac) < 1e-6 || (led.maxY_frac - led.minY_frac) < 1e-6)
 		{
 			_colorsMap.emplace_back();
+			_areasMap.emplace_back();
 			continue;
 		}
 
@@ -133,6 +138,11 @@ ImageColorAveraging::ImageColorAveraging(
 		}()).size();
 		totalCapasity += _colorsMap.back().capacity();
 
+		// the same area and step for the shared summed-area table, it gives exactly the sum of the indexes above
+		auto& area = _areasMap.emplace_back();
+		if (!led.disabled && minX_idx < maxXLedCount && minY_idx < maxYLedCount)
+			area.push_back({ static_cast<unsigned>(minX_idx), static_cast<unsigned>(minY_idx), static_cast<unsigned>(maxXLedCount), static_cast<unsigned>(maxYLedCount), static_cast<unsigned>(increment) });
+
 		if (led.group > 0)
 		{
 			if (_colorGroups.contains(led.group))
@@ -148,12 +158,28 @@ ImageColorAveraging::ImageColorAveraging(
 				);
 
 				source_vec.clear();
+
+				_areasMap[master].insert(_areasMap[master].end(), area.begin(), area.end());
+				area.clear();
 			}
 			_colorGroups[led.group].push_back(ledIndex);
 		}
 	}
 	Info(_log, "Total index number is: {:d} (memory: {:d}). User sparse processing is: {:s}, image size: {:d} x {:d}, area number: {:d}",
 		totalCount, totalCapasity, (sparseProcessing) ? "enabled" : "disabled", width, height, leds.size());
+
+	_samples = (_mappingType == 1) ? Area{ 0, 0, _width, _height, (_sparseProcessing) ? 2u : 1u }.samples() : totalCount;
+	FrameAnalysisCache::updateConsumer(this, _width, _height, _samples);
+}
+
+ImageColorAveraging::~ImageColorAveraging()
+{
+	FrameAnalysisCache::removeConsumer(this);
+}
+
+uint64_t ImageColorAveraging::Area::samples() const
+{
+	return static_cast<uint64_t>((x2 - x1 + step - 1) / step) * ((y2 - y1 + step - 1) / step);
 }
 
 unsigned ImageColorAveraging::width() const
@@ -180,12 +206,20 @@ void ImageColorAveraging::process(std::vector<float3>& ledColors, const Image<Co
 	ledColors.clear();
 	ledColors.reserve(_colorsMap.size());
 
+	// the instances sum their areas on the table built once per frame when sampling the frame would cost them more,
+	// a table that is not ready yet is not waited for: the own sampling gives exactly the same colors
+	std::shared_ptr<const LinearAreaTable> table = (FrameAnalysisCache::isWorthSharing(_width, _height)) ? FrameAnalysisCache::getLinearAreaTable(image) : nullptr;
+	const int64_t samplingBegin = (table == nullptr) ? InternalClock::nowMicro() : 0;
+
 	switch (_mappingType)
 	{
-		case 1: getUnicolorForLeds(ledColors, image); break;
-		default: getMulticolorForLeds(ledColors, image);
+		case 1: getUnicolorForLeds(ledColors, image, table.get()); break;
+		default: getMulticolorForLeds(ledColors, image, table.get());
 	}
 
+	if (table == nullptr)
+		FrameAnalysisCache::reportSamplingTime(_samples, InternalClock::nowMicro() - samplingBegin);
+
 	if (!_colorGroups.empty() && _mappingType != 1)
 	{
 		for (auto& group : _colorGroups)
@@ -199,20 +233,51 @@ void ImageColorAveraging::process(std::vector<float3>& ledColors, const Image<Co
 	}
 }
 
-void  ImageColorAveraging::getUnicolorForLeds(std::vector<float3>& ledColors, const Image<ColorRgb>& image) const
+void  ImageColorAveraging::getUnicolorForLeds(std::vector<float3>& ledColors, const Image<ColorRgb>& image, const LinearAreaTable* table) const
 {
-	ledColors.resize(_colorsMap.size(), calcUnicolorForLeds(image));
+	if (table != nullptr)
+		ledColors.resize(_colorsMap.size(), calcMulticolorForLeds(*table, { { 0, 0, _width, _height, (_sparseProcessing) ? 2u : 1u } }));
+	else
+		ledColors.resize(_colorsMap.size(), calcUnicolorForLeds(image));
 }
 
 
-void ImageColorAveraging::getMulticolorForLeds(std::vector<float3>& ledColors, const Image<ColorRgb>& image) const
+void ImageColorAveraging::getMulticolorForLeds(std::vector<float3>& ledColors, const Image<ColorRgb>& image, const LinearAreaTable* table) const
 {
+	if (table != nullptr)
+	{
+		for (const auto& areas : _areasMap)
+		{
+			ledColors.push_back(calcMulticolorForLeds(*table, areas));
+		}
+		return;
+	}
+
 	for (auto colors = _colorsMap.begin(); colors != _colorsMap.end(); ++colors)
 	{
 		ledColors.push_back(calcMulticolorForLeds(image, *colors));
 	}
 }
 
+float3 ImageColorAveraging::calcMulticolorForLeds(const LinearAreaTable& table, const std::vector<Area>& areas) const
+{
+	linalg::vec<uint_fast64_t, 3> sumLinear(0, 0, 0);
+	uint_fast64_t count = 0;
+
+	for (const Area& area : areas)
+	{
+		sumLinear += table.sum(area.x1, area.y1, area.x2, area.y2, area.step);
+		count += area.samples();
+	}
+
+	if (count == 0)
+	{
+		return float3{ 0, 0, 0 };
+	}
+
+	return (static_cast<float3>(sumLinear) / static_cast<float>(count)) / 65535.0f;
+}
+
 float3 ImageColorAveraging::calcMulticolorForLeds(const Image<ColorRgb>& image, const std::vector<uint32_t>& colors) const
 {
 	if (colors.empty())
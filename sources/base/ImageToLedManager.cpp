@@ -29,6 +29,7 @@
 #include <base/ImageToLedManager.h>
 #include <base/ImageColorAveraging.h>
 #include <blackborder/BlackBorderProcessor.h>
+#include <performance-counters/PerformanceTracer.h>
 
 using namespace hyperhdr;
 using namespace linalg::aliases;
@@ -144,11 +145,16 @@ bool ImageToLedManager::blackBorderDetectorEnabled() const
 
 void ImageToLedManager::processFrame(std::vector<float3>& ledColors, const Image<ColorRgb>& frameBuffer)
 {
-	setSize(frameBuffer);;
-	verifyBorder(frameBuffer);
+	setSize(frameBuffer);
+
+	{
+		PerformanceTracer::Scope trace(PerformanceTracer::Stage::BORDER_DETECTION, _instanceIndex);
+		verifyBorder(frameBuffer);
+	}
 
 	if (_colorAveraging != nullptr && _colorAveraging->width() == frameBuffer.width() && _colorAveraging->height() == frameBuffer.height())
 	{
+		PerformanceTracer::Scope trace(PerformanceTracer::Stage::AVERAGING, _instanceIndex);
 		_colorAveraging->process(ledColors, frameBuffer);
 	}
 }
@@ -21,7 +21,11 @@ Muxer::Muxer(int instanceIndex, int /*ledCount*/, QObject* parent)
 	, _currentPriority(Muxer::LOWEST_PRIORITY)
 	, _previousPriority(_currentPriority)
 	, _manualSelectedPriority(256)
-	, _activeInputs()
+	, _inputs{}
+	, _registered()
+	, _nextDeadline(std::numeric_limits<int64_t>::max())
+	, _hasTimedInputs(false)
+	, _evaluationPending(false)
 	, _lowestPriorityInfo()
 	, _sourceAutoSelectEnabled(true)
 	, _updateTimer(new QTimer(this))
@@ -36,7 +40,8 @@ Muxer::Muxer(int instanceIndex, int /*ledCount*/, QObject* parent)
 	_lowestPriorityInfo.origin = "System";
 	_lowestPriorityInfo.owner = "";
 
-	_activeInputs[Muxer::LOWEST_PRIORITY] = _lowestPriorityInfo;
+	_inputs[Muxer::LOWEST_PRIORITY] = _lowestPriorityInfo;
+	_registered.set(Muxer::LOWEST_PRIORITY);
 
 	// adapt to 1s interval for COLOR and EFFECT timeouts > -1
 	connect(_timer, &QTimer::timeout, this, &Muxer::timeTrigger);
@@ -47,7 +52,7 @@ Muxer::Muxer(int instanceIndex, int /*ledCount*/, QObject* parent)
 	connect(this, &Muxer::SignalTimeTrigger_Internal, this, &Muxer::timeTrigger);
 
 	// start muxer timer
-	connect(_updateTimer, &QTimer::timeout, this, &Muxer::setCurrentTime);
+	connect(_updateTimer, &QTimer::timeout, this, &Muxer::checkTimeouts);
 	_updateTimer->setInterval(250);
 	_updateTimer->start();
 
@@ -59,32 +64,37 @@ Muxer::~Muxer()
 
 QList<int> Muxer::getPriorities() const
 {
-	return _activeInputs.keys();
+	QList<int> priorities;
+	for (int priority = 0; priority < PRIORITY_SLOTS; priority++)
+		if (_registered.test(priority))
+			priorities.append(priority);
+	return priorities;
 }
 
 const Muxer::InputInfo& Muxer::getInputInfo(int priority) const
 {
-	auto elemIt = _activeInputs.find(priority);
-	if (elemIt == _activeInputs.end())
-	{
-		elemIt = _activeInputs.find(Muxer::LOWEST_PRIORITY);
-		if (elemIt == _activeInputs.end())
-		{
-			// fallback
-			return _lowestPriorityInfo;
-		}
-	}
-	return elemIt.value();
+	if (isRegistered(priority))
+		return _inputs[priority];
+
+	if (isRegistered(Muxer::LOWEST_PRIORITY))
+		return _inputs[Muxer::LOWEST_PRIORITY];
+
+	// fallback
+	return _lowestPriorityInfo;
 }
 
-const QMap<int, Muxer::InputInfo>& Muxer::getInputInfoTable() const
+QList<Muxer::InputInfo> Muxer::getInputInfoTable() const
 {
-	return _activeInputs;
+	QList<InputInfo> table;
+	for (int priority = 0; priority < PRIORITY_SLOTS; priority++)
+		if (_registered.test(priority))
+			table.append(_inputs[priority]);
+	return table;
 }
 
 hyperhdr::Components Muxer::getComponentOfPriority(int priority) const
 {
-	return _activeInputs[priority].componentId;
+	return isRegistered(priority) ? _inputs[priority].componentId : hyperhdr::COMP_INVALID;
 }
 
 void Muxer::setEnable(bool enable)
@@ -94,7 +104,7 @@ void Muxer::setEnable(bool enable)
 
 bool Muxer::setInput(int priority, int64_t timeout_ms)
 {
-	if (!_activeInputs.contains(priority))
+	if (!isRegistered(priority))
 	{
 		Error(_log, "setInput() used without registerInput() for priority '{:d}', probably the priority reached timeout", priority);
 		return false;
@@ -104,7 +114,7 @@ bool Muxer::setInput(int priority, int64_t timeout_ms)
 	if (timeout_ms > 0)
 		timeout_ms = InternalClock::now() + timeout_ms;
 
-	InputInfo& input = _activeInputs[priority];
+	InputInfo& input = _inputs[priority];
 
 	// detect active <-> inactive changes
 	bool activeChange = false, active = true;
@@ -121,6 +131,13 @@ bool Muxer::setInput(int priority, int64_t timeout_ms)
 	// update input
 	input.timeout = timeout_ms;
 
+	// only the earliest deadline is tracked, an input that keeps extending its timeout is verified when it's reached
+	if (timeout_ms > 0)
+	{
+		_nextDeadline = std::min(_nextDeadline, timeout_ms);
+		_hasTimedInputs = _hasTimedInputs || isTimedInput(input);
+	}
+
 	// emit active change
 	if (activeChange)
 	{
@@ -138,7 +155,7 @@ bool Muxer::setSourceAutoSelectEnabled(bool enable, bool update)
 	if (_sourceAutoSelectEnabled != enable)
 	{
 		// on disable we need to make sure the last priority call to setPriority is still valid
-		if (!enable && !_activeInputs.contains(_manualSelectedPriority))
+		if (!enable && !isRegistered(_manualSelectedPriority))
 		{
 			Warning(_log, "Can't disable auto selection, as the last manual selected priority ({:d}) is no longer available", _manualSelectedPriority);
 			return false;
@@ -158,7 +175,7 @@ bool Muxer::setSourceAutoSelectEnabled(bool enable, bool update)
 
 bool Muxer::setPriority(int priority)
 {
-	if (_activeInputs.contains(priority))
+	if (isRegistered(priority))
 	{
 		_manualSelectedPriority = priority;
 		// update auto select state -> update _currentPriority
@@ -170,26 +187,40 @@ bool Muxer::setPriority(int priority)
 
 bool Muxer::hasPriority(int priority) const
 {
-	return (priority == Muxer::LOWEST_PRIORITY) ? true : _activeInputs.contains(priority);
+	return (priority == Muxer::LOWEST_PRIORITY) ? true : isRegistered(priority);
 }
 
 void Muxer::registerInput(int priority, hyperhdr::Components component, const QString& origin, const ColorRgb& staticColor, unsigned smooth_cfg, const QString& owner)
 {
+	if (!isValidPriority(priority))
+	{
+		Error(_log, "Priority {:d} is out of range", priority);
+		return;
+	}
+
 	// detect new registers
 	bool newInput = false;
 	bool reusedInput = false;
-	if (!_activeInputs.contains(priority))
+	InputInfo& input = _inputs[priority];
+
+	if (!_registered.test(priority))
 		newInput = true;
-	else if (_prevVisComp == component || _activeInputs[priority].componentId == component)
+	else if (_prevVisComp == component || input.componentId == component)
 		reusedInput = true;
 
-	InputInfo& input = _activeInputs[priority];
+	// a registered input that changes its component may change the visible component: let the next tick re-evaluate
+	if (!newInput && input.componentId != component)
+		_evaluationPending = true;
+
+	_registered.set(priority);
 	input.priority = priority;
 	input.timeout = newInput ? TIMEOUT_INACTIVE : input.timeout;
 	input.componentId = component;
-	input.origin = origin;
+	if (input.origin != origin)
+		input.origin = origin;
 	input.smooth_cfg = smooth_cfg;
-	input.owner = owner;
+	if (input.owner != owner)
+		input.owner = owner;
 	input.staticColor = staticColor;
 
 	if (newInput)
@@ -216,8 +247,10 @@ bool Muxer::clearInput(int priority)
 {
 	if (priority < Muxer::LOWEST_PRIORITY)
 	{
-		if (_activeInputs.remove(priority))
+		if (isRegistered(priority))
 		{
+			_registered.reset(priority);
+			_inputs[priority] = InputInfo{};
 			Info(_log, "Removed source priority {:d}", priority);
 			// on clear success update _currentPriority
 			setCurrentTime();
@@ -234,13 +267,18 @@ void Muxer::clearAll(bool forceClearAll)
 	if (forceClearAll)
 	{
 		_previousPriority = _currentPriority;
-		_activeInputs.clear();
+		_inputs.fill(InputInfo{});
+		_registered.reset();
 		_currentPriority = Muxer::LOWEST_PRIORITY;
-		_activeInputs[_currentPriority] = _lowestPriorityInfo;
+		_inputs[Muxer::LOWEST_PRIORITY] = _lowestPriorityInfo;
+		_registered.set(Muxer::LOWEST_PRIORITY);
+		_nextDeadline = std::numeric_limits<int64_t>::max();
+		_hasTimedInputs = false;
+		_evaluationPending = false;
 	}
 	else
 	{
-		const auto keys = _activeInputs.keys();
+		const auto keys = getPriorities();
 		for (const auto& key : keys)
 		{
 			const InputInfo& info = getInputInfo(key);
@@ -252,20 +290,42 @@ void Muxer::clearAll(bool forceClearAll)
 	}
 }
 
+bool Muxer::isTimedInput(const InputInfo& input)
+{
+	// effect or color running with timeout > 0, blacklist prio 255
+	return input.priority < Muxer::LOWEST_EFFECT_PRIORITY &&
+		input.timeout > 0 &&
+		(input.componentId == hyperhdr::COMP_EFFECT || input.componentId == hyperhdr::COMP_COLOR || input.componentId == hyperhdr::COMP_IMAGE);
+}
+
+void Muxer::checkTimeouts()
+{
+	if (_evaluationPending || InternalClock::now() >= _nextDeadline)
+		setCurrentTime();
+	else if (_hasTimedInputs)
+		emit SignalTimeTrigger_Internal(); // as signal to prevent Threading issues
+}
+
 void Muxer::setCurrentTime()
 {
 	const int64_t now = InternalClock::now();
 	int newPriority = Muxer::LOWEST_PRIORITY;
 
-	for (QMutableMapIterator<int, InputInfo> infoIter(_activeInputs); infoIter.hasNext(); )
+	_nextDeadline = std::numeric_limits<int64_t>::max();
+	_hasTimedInputs = false;
+	_evaluationPending = false;
+
+	for (int priority = 0; priority < PRIORITY_SLOTS; priority++)
 	{
-		infoIter.next();
-		InputInfo& infoIt = infoIter.value();
+		if (!_registered.test(priority))
+			continue;
+
+		InputInfo& infoIt = _inputs[priority];
 		if (infoIt.timeout > 0 && infoIt.timeout <= now)
 		{
-			int tPrio = infoIt.priority;
-			infoIter.remove();
-			Info(_log, "Timeout clear for priority {:d}", tPrio);
+			_registered.reset(priority);
+			infoIt = InputInfo{};
+			Info(_log, "Timeout clear for priority {:d}", priority);
 			emit SignalPrioritiesChanged();
 		}
 		else
@@ -274,17 +334,21 @@ void Muxer::setCurrentTime()
 			if (infoIt.timeout > TIMEOUT_INACTIVE)
 				newPriority = qMin(newPriority, infoIt.priority);
 
-			// call timeTrigger when effect or color is running with timeout > 0, blacklist prio 255
-			if (infoIt.priority < Muxer::LOWEST_EFFECT_PRIORITY &&
-				infoIt.timeout > 0 &&
-				(infoIt.componentId == hyperhdr::COMP_EFFECT || infoIt.componentId == hyperhdr::COMP_COLOR || infoIt.componentId == hyperhdr::COMP_IMAGE))
-				emit SignalTimeTrigger_Internal(); // as signal to prevent Threading issues
+			if (infoIt.timeout > 0)
+				_nextDeadline = std::min(_nextDeadline, infoIt.timeout);
+
+			_hasTimedInputs = _hasTimedInputs || isTimedInput(infoIt);
 		}
 	}
+
+	// call timeTrigger when effect or color is running with timeout > 0
+	if (_hasTimedInputs)
+		emit SignalTimeTrigger_Internal(); // as signal to prevent Threading issues
+
 	// evaluate, if manual selected priority is still available
 	if (!_sourceAutoSelectEnabled)
 	{
-		if (_activeInputs.contains(_manualSelectedPriority))
+		if (isRegistered(_manualSelectedPriority))
 		{
 			newPriority = _manualSelectedPriority;
 		}
@@ -0,0 +1,271 @@
+/* SoundAnalyzer.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <algorithm>
+	#include <cmath>
+	#include <cstring>
+#endif
+
+#include <base/SoundAnalyzer.h>
+
+namespace
+{
+	// band boundaries expressed in the bins of the 1024 point transform at 22050Hz:
+	// 0-86, 86-258, 258-516, 516-1032, 1032-2064, 2064-4128, 4128-6192, 6192-11025 Hz
+	constexpr int BAND_EDGES_1024[SOUNDCAP_RESULT_RES + 1] = { 0, 4, 12, 24, 48, 96, 192, 288, 512 };
+	constexpr int MIN_SIZE = 256;
+	constexpr int MAX_SIZE = 8192;
+	constexpr double PI = 3.14159265358979323846;
+}
+
+SoundAnalyzer::SoundAnalyzer() :
+	_size(0),
+	_hop(0),
+	_scale(0),
+	_lastFrameSilent(true),
+	_written(0),
+	_nextFrameEnd(0),
+	_resultIndex(0)
+{
+	configure(DEFAULT_SIZE, 0);
+}
+
+void SoundAnalyzer::configure(int fftSize, int overlap)
+{
+	int size = MIN_SIZE;
+	while (size < fftSize && size < MAX_SIZE)
+		size <<= 1;
+
+	const int half = size / 2;
+
+	_size = size;
+	_hop = std::max((size * (100 - std::clamp(overlap, 0, 90))) / 100, 1);
+
+	// periodic Hann window, normalized so a full scale sine gives the same magnitude as the former fixed-point FFT
+	double windowSum = 0;
+	_window.resize(size);
+	for (int n = 0; n < size; n++)
+	{
+		_window[n] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * PI * n / size));
+		windowSum += _window[n];
+	}
+	_scale = static_cast<float>(1.0 / windowSum);
+
+	int bits = 0;
+	while ((1 << bits) < half)
+		bits++;
+
+	_bitReverse.resize(half);
+	for (int n = 0; n < half; n++)
+	{
+		uint32_t reversed = 0;
+		for (int b = 0; b < bits; b++)
+			if (n & (1 << b))
+				reversed |= 1u << (bits - 1 - b);
+		_bitReverse[n] = reversed;
+	}
+
+	// the twiddles of the stage with the butterfly span 'len' are stored contiguously at [len, 2 * len)
+	_twiddleRe.assign(half, 0.0f);
+	_twiddleIm.assign(half, 0.0f);
+	for (int len = 1; len < half; len <<= 1)
+		for (int j = 0; j < len; j++)
+		{
+			_twiddleRe[len + j] = static_cast<float>(std::cos(-PI * j / len));
+			_twiddleIm[len + j] = static_cast<float>(std::sin(-PI * j / len));
+		}
+
+	_splitRe.resize(half);
+	_splitIm.resize(half);
+	for (int k = 0; k < half; k++)
+	{
+		_splitRe[k] = static_cast<float>(std::cos(-2.0 * PI * k / size));
+		_splitIm[k] = static_cast<float>(std::sin(-2.0 * PI * k / size));
+	}
+
+	_re.assign(half, 0.0f);
+	_im.assign(half, 0.0f);
+
+	_bandEdges.resize(SOUNDCAP_RESULT_RES + 1);
+	for (int band = 0; band <= SOUNDCAP_RESULT_RES; band++)
+		_bandEdges[band] = (BAND_EDGES_1024[band] * size + DEFAULT_SIZE / 2) / DEFAULT_SIZE;
+
+	reset();
+}
+
+void SoundAnalyzer::reset()
+{
+	_ring.assign(static_cast<size_t>(_size) * 2, 0);
+	_frame.assign(_size, 0);
+	_written = 0;
+	_nextFrameEnd = _size;
+	_lastFrameSilent = true;
+
+	_result.ResetData();
+	_published.publish(_result);
+	_resultIndex.store(_result.getResultIndex(), std::memory_order_release);
+}
+
+int SoundAnalyzer::process(const int16_t* samples, int count, int64_t captureTime)
+{
+	const size_t capacity = _ring.size();
+	const size_t mask = capacity - 1;
+	const uint64_t blockEnd = _written + std::max(count, 0);
+	int frames = 0;
+
+	// 'captureTime' belongs to the last sample of the block. The ring holds two frames: writing at most one frame
+	// before analysing keeps every pending frame in the ring
+	while (_written < blockEnd)
+	{
+		const size_t chunk = static_cast<size_t>(std::min<uint64_t>(blockEnd - _written, _size));
+		const size_t position = static_cast<size_t>(_written & mask);
+		const size_t first = std::min(chunk, capacity - position);
+
+		memcpy(&_ring[position], samples, first * sizeof(int16_t));
+		memcpy(&_ring[0], samples + first, (chunk - first) * sizeof(int16_t));
+		samples += chunk;
+		_written += chunk;
+
+		for (; _nextFrameEnd <= _written; _nextFrameEnd += _hop, frames++)
+		{
+			const size_t start = static_cast<size_t>((_nextFrameEnd - _size) & mask);
+			const size_t head = std::min(static_cast<size_t>(_size), capacity - start);
+
+			memcpy(_frame.data(), &_ring[start], head * sizeof(int16_t));
+			memcpy(_frame.data() + head, &_ring[0], (_size - head) * sizeof(int16_t));
+
+			analyzeFrame(_frame.data(), captureTime - static_cast<int64_t>(((blockEnd - _nextFrameEnd) * 1000000) / SAMPLE_RATE));
+		}
+	}
+
+	return frames;
+}
+
+void SoundAnalyzer::analyzeFrame(const int16_t* frame, int64_t captureTime)
+{
+	const int half = _size / 2;
+
+	_lastFrameSilent = std::all_of(frame, frame + _size, [](int16_t sample) { return sample >= -8 && sample <= 8; });
+
+	_result.ClearResult();
+
+	if (!_lastFrameSilent)
+	{
+		float* re = _re.data();
+		float* im = _im.data();
+
+		// windowed real input packed as half size complex sequence (even samples: real part, odd samples: imaginary part)
+		for (int n = 0; n < half; n++)
+		{
+			const uint32_t target = _bitReverse[n];
+			re[target] = frame[2 * n] * _window[2 * n];
+			im[target] = frame[2 * n + 1] * _window[2 * n + 1];
+		}
+
+		// radix-2 butterflies, the inner loops are contiguous so the compiler can vectorize them
+		for (int len = 1; len < half; len <<= 1)
+		{
+			const float* wRe = _twiddleRe.data() + len;
+			const float* wIm = _twiddleIm.data() + len;
+
+			for (int base = 0; base < half; base += 2 * len)
+			{
+				float* aRe = re + base;
+				float* aIm = im + base;
+				float* bRe = aRe + len;
+				float* bIm = aIm + len;
+
+				for (int j = 0; j < len; j++)
+				{
+					const float tr = wRe[j] * bRe[j] - wIm[j] * bIm[j];
+					const float ti = wRe[j] * bIm[j] + wIm[j] * bRe[j];
+					bRe[j] = aRe[j] - tr;
+					bIm[j] = aIm[j] - ti;
+					aRe[j] += tr;
+					aIm[j] += ti;
+				}
+			}
+		}
+
+		// split the half size spectrum into the spectrum of the real input and sum the magnitudes per band
+		float bandSum[SOUNDCAP_RESULT_RES] = {};
+
+		for (int k = 0, band = 0; k < half; k++)
+		{
+			const int mirror = (half - k) & (half - 1);
+			const float evenRe = 0.5f * (re[k] + re[mirror]);
+			const float evenIm = 0.5f * (im[k] - im[mirror]);
+			const float oddRe = 0.5f * (im[k] + im[mirror]);
+			const float oddIm = -0.5f * (re[k] - re[mirror]);
+			const float xRe = evenRe + _splitRe[k] * oddRe - _splitIm[k] * oddIm;
+			const float xIm = evenIm + _splitRe[k] * oddIm + _splitIm[k] * oddRe;
+
+			while (band < SOUNDCAP_RESULT_RES - 1 && k >= _bandEdges[band + 1])
+				band++;
+
+			bandSum[band] += std::sqrt(xRe * xRe + xIm * xIm);
+		}
+
+		// keep the band levels in the range of the 1024 point transform whatever the selected size is
+		const float bandScale = _scale * static_cast<float>(DEFAULT_SIZE) / _size;
+
+		for (int band = 0; band < SOUNDCAP_RESULT_RES; band++)
+			_result.AddResult(band, static_cast<uint32_t>(bandSum[band] * bandScale));
+	}
+
+	_result.Smooth();
+	_result.setCaptureTime(captureTime);
+
+	_published.publish(_result);
+	_resultIndex.store(_result.getResultIndex(), std::memory_order_release);
+}
+
+bool SoundAnalyzer::isLastFrameSilent() const
+{
+	return _lastFrameSilent;
+}
+
+uint32_t SoundAnalyzer::getResultIndex() const
+{
+	return _resultIndex.load(std::memory_order_acquire);
+}
+
+bool SoundAnalyzer::getResult(SoundCaptureResult& target) const
+{
+	return _published.read(target);
+}
+
+int SoundAnalyzer::getSize() const
+{
+	return _size;
+}
+
+int SoundAnalyzer::getHop() const
+{
+	return _hop;
+}
@@ -366,6 +366,16 @@ uint32_t SoundCaptureResult::getResultIndex()
 	return _resultIndex;
 }
 
+int64_t SoundCaptureResult::getCaptureTime() const
+{
+	return _captureTime;
+}
+
+void SoundCaptureResult::setCaptureTime(int64_t captureTime)
+{
+	_captureTime = captureTime;
+}
+
 void SoundCaptureResult::ResetData()
 {
 	_validData = false;
@@ -373,6 +383,7 @@ void SoundCaptureResult::ResetData()
 	_scaledAverage = 0;
 	_oldScaledAverage = 0;
 	_resultIndex = 0;
+	_captureTime = 0;
 
 	memset(pureResult, 0, sizeof(pureResult));
 	memset(lastResult, 0, sizeof(lastResult));
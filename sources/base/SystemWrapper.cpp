@@ -48,6 +48,9 @@ SystemWrapper::SystemWrapper(const QString& grabberName, Grabber* ggrabber)
 
 	// listen for source requests
 	connect(GlobalSignals::getInstance(), &GlobalSignals::SignalRequestComponent, this, &SystemWrapper::signalRequestSourceHandler);
+
+	// the serverinfo snapshot is published in the grabber thread once the grabber is set up
+	QTimer::singleShot(0, this, &SystemWrapper::publishJsonInfo);
 }
 
 void SystemWrapper::newCapturedFrameHandler(const Image<ColorRgb>& image)
@@ -186,6 +189,8 @@ void SystemWrapper::handleSettingsUpdate(settings::type type, const QJsonDocumen
 			_grabber->unblockAndRestart(_configLoaded);
 		}
 		_configLoaded = true;
+
+		publishJsonInfo();
 	}
 }
 
@@ -225,3 +230,13 @@ QJsonObject SystemWrapper::getJsonInfo()
 
 	return systemDevice;
 }
+
+void SystemWrapper::publishJsonInfo()
+{
+	_jsonInfo.publish(getJsonInfo());
+}
+
+bool SystemWrapper::getPublishedJsonInfo(QJsonObject& info, quint64* revision)
+{
+	return _jsonInfo.read(info, revision, [this]() { QUEUE_CALL_0(this, publishJsonInfo); });
+}
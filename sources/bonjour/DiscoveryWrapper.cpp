@@ -50,6 +50,10 @@ DiscoveryWrapper::DiscoveryWrapper(QObject* parent)
 
 	connect(GlobalSignals::getInstance(), &GlobalSignals::SignalDiscoveryEvent, this, &DiscoveryWrapper::signalDiscoveryEventHandler);
 	connect(GlobalSignals::getInstance(), &GlobalSignals::SignalDiscoveryRequestToScan, this, &DiscoveryWrapper::signalDiscoveryRequestToScanHandler);
+
+	// the serverinfo snapshot follows every discovery update
+	connect(this, &DiscoveryWrapper::SignalDiscoveryFoundService, this, &DiscoveryWrapper::publishServices);
+	publishServices();
 }
 
 DiscoveryWrapper::~DiscoveryWrapper()
@@ -125,6 +129,16 @@ QList<DiscoveryRecord> DiscoveryWrapper::getAllServices()
 	return _hyperhdrSessions + _esp32s2Devices + _espDevices + _hueDevices + _homeAssistantDevices + _picoDevices + _wledDevices;
 }
 
+void DiscoveryWrapper::publishServices()
+{
+	_services.publish(getAllServices());
+}
+
+bool DiscoveryWrapper::getPublishedServices(QList<DiscoveryRecord>& services, quint64* revision)
+{
+	return _services.read(services, revision, [this]() { QUEUE_CALL_0(this, publishServices); });
+}
+
 void DiscoveryWrapper::requestServicesScan()
 {
 	cleanUp(_hyperkDevices);
@@ -58,6 +58,15 @@ bool AnimationBase::getImage(Image<ColorRgb>& /*image*/)
 	return false;
 };
 
+bool AnimationBase::hasPointRenderer()
+{
+	return false;
+};
+
+void AnimationBase::PlayPoints(const std::vector<EffectLedSampler::Point>& /*points*/, std::vector<ColorRgb>& /*colors*/)
+{
+};
+
 void AnimationBase::SetSleepTime(int sleepTime)
 {
 	_sleepTime = sleepTime;
@@ -30,7 +30,6 @@
 AnimationBaseMusic::AnimationBaseMusic() :
 	AnimationBase()
 {
-	_myTarget.Clear();	
 };
 
 AnimationBaseMusic::~AnimationBaseMusic()
@@ -41,12 +40,8 @@ bool AnimationBaseMusic::isSoundEffect()
 	return true;
 };
 
-void AnimationBaseMusic::store(MovingTarget* source) {
-	_myTarget.CopyFrom(source);
-};
-
-void AnimationBaseMusic::restore(MovingTarget* target) {
-	target->CopyFrom(&_myTarget);
+SoundCaptureResult* AnimationBaseMusic::soundResult() {
+	return &_soundResult;
 };
 
 void AnimationBaseMusic::Init(HyperImage& /*hyperImage*/, int /*hyperLatchTime*/)
@@ -110,5 +110,25 @@ bool Animation_Plasma::Play(HyperImage& painter)
 	return ret;
 }
 
+bool Animation_Plasma::hasPointRenderer()
+{
+	return true;
+}
+
+void Animation_Plasma::PlayPoints(const std::vector<EffectLedSampler::Point>& points, std::vector<ColorRgb>& colors)
+{
+	auto mod = start++;
+
+	colors.resize(points.size());
+	for (size_t i = 0; i < points.size(); i++)
+	{
+		int x = std::min(points[i].x, PLASMA_WIDTH - 1);
+		int y = std::min(points[i].y, PLASMA_HEIGHT - 1);
+		int palIndex = int((plasma[y * PLASMA_WIDTH + x] + mod) % PAL_LEN) * 3;
+
+		colors[i] = ColorRgb(pal[palIndex], pal[palIndex + 1], pal[palIndex + 2]);
+	}
+}
+
 
 bool Animation_Plasma::isRegistered = hyperhdr::effects::REGISTER_EFFECT(Animation_Plasma::getDefinition());
@@ -33,13 +33,14 @@
 // effect engin eincludes
 #include <effects/Effect.h>
 #include <effects/EffectManufactory.h>
+#include <effects/EffectScheduler.h>
 #include <utils/Logger.h>
 #include <base/HyperHdrInstance.h>
 #include <base/SoundCapture.h>
 #include <utils/GlobalSignals.h>
 #include <effects/AnimationBaseMusic.h>
 
-Effect::Effect(HyperHdrInstance* hyperhdr, int visiblePriority, int priority, int timeout, const EffectDefinition& effect)
+Effect::Effect(HyperHdrInstance* hyperhdr, EffectScheduler* scheduler, int visiblePriority, int priority, int timeout, const EffectDefinition& effect)
 	: QObject()
 	, _visiblePriority(visiblePriority)
 	, _priority(priority)
@@ -52,17 +53,18 @@ Effect::Effect(HyperHdrInstance* hyperhdr, int visiblePriority, int priority, in
 	, _endTime(-1)
 	, _interrupt(false)
 	, _image(hyperhdr->getLedGridSize().width(), hyperhdr->getLedGridSize().height())
-	, _timer(this)
+	, _scheduler(scheduler)
+	, _period(0)
 	, _ledCount(hyperhdr->getLedCount())
+	, _ledLayout(hyperhdr->getLedString().leds())
+	, _layoutChanged(true)
+	, _imageRequired(false)
 {
 	_log = QString("EFFECT%1(%2)").arg(_instanceIndex).arg((_name.length() > 9) ? _name.left(6) + "..." : _name);
 
 	_colors.resize(_ledCount);
 	_colors.fill(ColorRgb::BLACK);	
 
-	_timer.setTimerType(Qt::PreciseTimer);
-	connect(&_timer, &QTimer::timeout, this, &Effect::run);
-
 	_isSoundEffect = _effect->isSoundEffect();
 
 	if (_isSoundEffect)
@@ -93,7 +95,9 @@ Effect::Effect(HyperHdrInstance* hyperhdr, int visiblePriority, int priority, in
 }
 
 Effect::~Effect()
-{	
+{
+	_scheduler->unschedule(this);
+
 	delete _effect;
 
 	if (_isSoundEffect && _soundCapture != nullptr)
@@ -115,12 +119,13 @@ void Effect::start()
 	else
 		_endTime = -1;	
 
-	_timer.setInterval(_effect->GetSleepTime());
+	_period = std::min(_effect->GetSleepTime(), 100);
 
 	Info(_log, "Begin playing the {:s} with priority: {:d}", (_isSoundEffect) ? "music effect" : "effect", _priority);
 
+	_scheduler->schedule(this, _period);
+
 	run();
-	_timer.start();	
 }
 
 void Effect::run()
@@ -140,9 +145,28 @@ void Effect::run()
 
 	if (!_effect->hasOwnImage())
 	{
-		_effect->Play(_image);
+		// render the LED colors directly: only at the LED sample points or by sampling the surface, without the image-to-LED averaging.
+		// The image is still rendered when the instance needs it: the unicolor mapping or a listener of the image stream.
+		const bool imageRequired = _imageRequired;
+
+		if (_effect->hasPointRenderer() && !imageRequired && prepareSampler())
+		{
+			_effect->PlayPoints(_sampler.points(), _pointColors);
+			_sampler.reduce(_pointColors, _ledBuffer);
+			hasLedData = true;
+		}
+		else
+		{
+			_effect->Play(_image);
+
+			hasLedData = _effect->hasLedData(_ledBuffer);
 
-		hasLedData = _effect->hasLedData(_ledBuffer);
+			if (!hasLedData && !imageRequired && prepareSampler())
+			{
+				_sampler.sample(_image.surface(), _ledBuffer);
+				hasLedData = true;
+			}
+		}
 	}
 
 	if (_effect->hasOwnImage())
@@ -162,17 +186,21 @@ void Effect::run()
 	}
 
 	int sleepTime = std::min(_effect->GetSleepTime(), 100);
-	if (sleepTime != _timer.interval())
+	if (sleepTime != _period)
 	{
-		_timer.setInterval(sleepTime);
+		_period = sleepTime;
+		_scheduler->setPeriod(this, _period);
 	}
 }
 
 void Effect::stop()
 {
-	Info(_log, "The effect quits with priority: {:d}", _priority);
+	auto stats = _scheduler->getStatistics(this);
 
-	_timer.stop();
+	Info(_log, "The effect quits with priority: {:d}. Ticks: {:d}, overruns: {:d}, average jitter: {:d}us, max jitter: {:d}us, longest tick: {:d}us",
+		_priority, stats.ticks, stats.overruns, (stats.ticks > 0) ? stats.jitterSum / static_cast<int64_t>(stats.ticks) : 0, stats.jitterMax, stats.busyMax);
+
+	_scheduler->unschedule(this);
 
 	emit SignalEffectFinished(_priority, _name, _interrupt);
 }
@@ -204,9 +232,32 @@ void Effect::visiblePriorityChanged(quint8 priority)
 	if (_timeout <= 0)
 	{
 		if (_visiblePriority < _priority)
-			_timer.stop();
-		else if (!_timer.isActive())
-			_timer.start();
+			_scheduler->unschedule(this);
+		else if (!_scheduler->isScheduled(this) && _period > 0)
+			_scheduler->schedule(this, _period);
+	}
+}
+
+void Effect::moveToScheduler(EffectScheduler* scheduler)
+{
+	// the lock keeps the engine from releasing the target scheduler while the effect is moving there
+	std::lock_guard<std::mutex> lockGuard(_schedulerMutex);
+
+	if (_interrupt || scheduler == _scheduler)
+		return;
+
+	const bool wasScheduled = _scheduler->isScheduled(this);
+
+	_scheduler->unschedule(this);
+	_scheduler = scheduler;
+	moveToThread(_scheduler->thread());
+
+	if (wasScheduled)
+	{
+		QMetaObject::invokeMethod(this, [this]() {
+			if (!_scheduler->isScheduled(this) && _period > 0)
+				_scheduler->schedule(this, _period);
+		}, Qt::QueuedConnection);
 	}
 }
 
@@ -215,14 +266,45 @@ void Effect::setLedCount(int newCount)
 	_ledCount = newCount;
 }
 
+void Effect::setLedLayout(const std::vector<LedString::Led>& leds)
+{
+	std::lock_guard<std::mutex> lockGuard(_layoutMutex);
+
+	_ledLayout = leds;
+	_layoutChanged = true;
+}
+
+void Effect::setImageRequired(bool required)
+{
+	_imageRequired = required;
+}
+
+bool Effect::prepareSampler()
+{
+	if (_layoutChanged.exchange(false) || !_sampler.matches(_image.width(), _image.height()))
+	{
+		std::lock_guard<std::mutex> lockGuard(_layoutMutex);
+
+		_sampler.build(_ledLayout, _image.width(), _image.height());
+	}
+
+	// the new layout has not arrived yet: fall back to the image
+	return _sampler.ledCount() == _ledCount;
+}
+
 int Effect::getPriority() const {
 	return _priority;
 }
 
 void Effect::requestInterruption() {
+	std::lock_guard<std::mutex> lockGuard(_schedulerMutex);
 	_interrupt = true;
 }
 
+void Effect::requestIsolation() {
+	emit SignalIsolationRequested();
+}
+
 QString Effect::getName()     const {
 	return _name;
 }
@@ -37,11 +37,14 @@
 
 #include <effects/EffectEngine.h>
 #include <effects/Effect.h>
+#include <effects/EffectScheduler.h>
 
 EffectEngine::EffectEngine(HyperHdrInstance* hyperhdr)
 	: _hyperInstance(hyperhdr)
 	, _availableEffects(Effect::getAvailableEffects())
+	, _scheduler(EffectScheduler::getInstance())
 	, _log(QString("EFFECTENGINE%1").arg(hyperhdr->getInstanceIndex()))
+	, _imageRequired(false)
 {
 	qRegisterMetaType<hyperhdr::Components>("hyperhdr::Components");
 
@@ -76,26 +79,29 @@ int EffectEngine::runEffectScript(const QString& name, int priority, int timeout
 	// clear current effect on the channel
 	channelCleared(priority);
 
-	// create the effect
+	// create the effect: once an effect of this instance was too heavy for the shared thread, all of them use the instance's own
+	EffectScheduler* scheduler = (_dedicatedScheduler != nullptr) ? _dedicatedScheduler.get() : _scheduler.get();
 	auto effect = std::unique_ptr<Effect, void(*)(Effect*)>(
-		new Effect(_hyperInstance, _hyperInstance->getCurrentPriority(), priority, timeout, *it),
+		new Effect(_hyperInstance, scheduler, _hyperInstance->getCurrentPriority(), priority, timeout, *it),
 		[](Effect* oldEffect) {
+			// the effect lives in the scheduler thread: it's removed there, before the scheduler itself
 			oldEffect->requestInterruption();
-			hyperhdr::THREAD_REMOVER(oldEffect->getDescription(), oldEffect->thread(), oldEffect);
+			hyperhdr::SMARTPOINTER_MESSAGE(oldEffect->getDescription());
+			oldEffect->deleteLater();
 		}
 	);
 	connect(effect.get(), &Effect::SignalSetLeds, this, &EffectEngine::handlerSetLeds);
 	connect(effect.get(), &Effect::SignalSetImage, _hyperInstance, &HyperHdrInstance::setInputImage);
 	connect(effect.get(), &Effect::SignalEffectFinished, this, &EffectEngine::handlerEffectFinished);
+	connect(effect.get(), &Effect::SignalIsolationRequested, this, &EffectEngine::handlerIsolationRequested);
+	effect->setImageRequired(_imageRequired);
 
 	// start the effect
 	Debug(_log, "Start the effect: name [{:s}]", (name));
 	_hyperInstance->registerInput(priority, hyperhdr::COMP_EFFECT, origin, name, (*it).smoothingConfig);
 
 	// start the effect
-	QThread* newThread = new QThread();
-	effect->moveToThread(newThread);
-	newThread->start();
+	effect->moveToThread(scheduler->thread());
 	QUEUE_CALL_0(effect.get(), start);
 
 	// enlist & move control
@@ -122,6 +128,22 @@ void EffectEngine::handlerEffectFinished(int priority, QString name, bool forced
 	}
 }
 
+void EffectEngine::handlerIsolationRequested()
+{
+	if (_dedicatedScheduler == nullptr)
+	{
+		_dedicatedScheduler = EffectScheduler::createDedicated(QString("EffectScheduler%1").arg(_hyperInstance->getInstanceIndex()));
+		Warning(_log, "The effects of this instance are moved from the shared effect thread to their own thread");
+	}
+
+	EffectScheduler* scheduler = _dedicatedScheduler.get();
+	for (auto&& effect : _activeEffects)
+	{
+		Effect* current = effect.get();
+		QMetaObject::invokeMethod(current, [current, scheduler]() { current->moveToScheduler(scheduler); }, Qt::QueuedConnection);
+	}
+}
+
 void EffectEngine::visiblePriorityChanged(quint8 priority)
 {
 	for (auto&& effect : _activeEffects)
@@ -164,6 +186,28 @@ void EffectEngine::handlerSetLeds(int priority, const QVector<ColorRgb>& ledColo
 	}
 }
 
+void EffectEngine::setLedLayout(const std::vector<LedString::Led>& leds)
+{
+	for (auto&& effect : _activeEffects)
+	{
+		effect->setLedLayout(leds);
+	}
+}
+
+void EffectEngine::setImageRequired(bool required)
+{
+	if (_imageRequired == required)
+		return;
+
+	_imageRequired = required;
+	Debug(_log, "The effects render {:s}", (required) ? "the image (unicolor mapping or image stream)" : "the LED colors directly when they can");
+
+	for (auto&& effect : _activeEffects)
+	{
+		effect->setImageRequired(required);
+	}
+}
+
 void EffectEngine::createSmoothingConfigs()
 {
 	unsigned defaultEffectConfig = InfiniteSmoothing::SMOOTHING_EFFECT_CONFIGS_START;
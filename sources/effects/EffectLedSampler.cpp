@@ -0,0 +1,174 @@
+/* EffectLedSampler.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <algorithm>
+	#include <cmath>
+	#include <map>
+#endif
+
+#include <effects/EffectLedSampler.h>
+#include <infinite-color-engine/InfiniteProcessing.h>
+#include <infinite-color-engine/ColorSpace.h>
+
+EffectLedSampler::EffectLedSampler() :
+	_width(0),
+	_height(0),
+	_ledCount(-1)
+{
+}
+
+void EffectLedSampler::build(const std::vector<LedString::Led>& leds, int width, int height)
+{
+	_width = width;
+	_height = height;
+	_ledCount = static_cast<int>(leds.size());
+
+	_points.clear();
+	_ledFirstPoint.assign(1, 0);
+	_ledSource.assign(leds.size(), -1);
+
+	// grouped LEDs share the sample points of the whole group, the first LED of the group owns them
+	std::map<int, std::vector<int>> groups;
+	for (int ledIndex = 0; ledIndex < _ledCount; ledIndex++)
+		if (leds[ledIndex].group > 0)
+			groups[leds[ledIndex].group].push_back(ledIndex);
+
+	auto addPoints = [&](const LedString::Led& led) {
+		if (led.disabled || (led.maxX_frac - led.minX_frac) < 1e-6 || (led.maxY_frac - led.minY_frac) < 1e-6 || width <= 0 || height <= 0)
+			return;
+
+		// the same area boundaries as the image averaging uses
+		const int minX = std::min(static_cast<int>(std::lround(width * led.minX_frac)), width - 1);
+		const int maxX = std::min(std::max(static_cast<int>(std::lround(width * led.maxX_frac)), minX + 1), width);
+		const int minY = std::min(static_cast<int>(std::lround(height * led.minY_frac)), height - 1);
+		const int maxY = std::min(std::max(static_cast<int>(std::lround(height * led.maxY_frac)), minY + 1), height);
+
+		const int stepsX = std::min(maxX - minX, SAMPLES_PER_AXIS);
+		const int stepsY = std::min(maxY - minY, SAMPLES_PER_AXIS);
+
+		for (int sy = 0; sy < stepsY; sy++)
+			for (int sx = 0; sx < stepsX; sx++)
+				_points.push_back(Point{ minX + ((maxX - minX) * (2 * sx + 1)) / (2 * stepsX),
+										 minY + ((maxY - minY) * (2 * sy + 1)) / (2 * stepsY) });
+	};
+
+	for (int ledIndex = 0; ledIndex < _ledCount; ledIndex++)
+	{
+		const LedString::Led& led = leds[ledIndex];
+
+		if (led.group > 0)
+		{
+			const std::vector<int>& members = groups[led.group];
+			if (members.front() != ledIndex)
+			{
+				_ledSource[ledIndex] = members.front();
+			}
+			else for (int member : members)
+			{
+				addPoints(leds[member]);
+			}
+		}
+		else
+		{
+			addPoints(led);
+		}
+
+		_ledFirstPoint.push_back(static_cast<uint32_t>(_points.size()));
+	}
+}
+
+bool EffectLedSampler::matches(int width, int height) const
+{
+	return _width == width && _height == height;
+}
+
+int EffectLedSampler::ledCount() const
+{
+	return _ledCount;
+}
+
+const std::vector<EffectLedSampler::Point>& EffectLedSampler::points() const
+{
+	return _points;
+}
+
+void EffectLedSampler::sample(const Image<ColorRgb>& image, QVector<ColorRgb>& ledColors)
+{
+	_pointColors.resize(_points.size());
+
+	const ColorRgb* surface = reinterpret_cast<const ColorRgb*>(image.rawMem());
+	const int width = static_cast<int>(image.width());
+
+	for (size_t i = 0; i < _points.size(); i++)
+		_pointColors[i] = surface[_points[i].y * width + _points[i].x];
+
+	reduce(_pointColors, ledColors);
+}
+
+void EffectLedSampler::reduce(const std::vector<ColorRgb>& pointColors, QVector<ColorRgb>& ledColors) const
+{
+	ledColors.resize(_ledCount);
+
+	if (pointColors.size() < _points.size())
+		return;
+
+	for (int ledIndex = 0; ledIndex < _ledCount; ledIndex++)
+	{
+		const uint32_t first = _ledFirstPoint[ledIndex];
+		const uint32_t last = _ledFirstPoint[ledIndex + 1];
+
+		if (_ledSource[ledIndex] >= 0)
+		{
+			ledColors[ledIndex] = ledColors[_ledSource[ledIndex]];
+		}
+		else if (first == last)
+		{
+			ledColors[ledIndex] = ColorRgb::BLACK;
+		}
+		else if (last - first == 1)
+		{
+			ledColors[ledIndex] = pointColors[first];
+		}
+		else
+		{
+			// average in the linear space like the image averaging does
+			linalg::vec<uint32_t, 3> sumLinear(0, 0, 0);
+
+			for (uint32_t i = first; i < last; i++)
+			{
+				const ColorRgb& c = pointColors[i];
+				sumLinear += linalg::vec<uint32_t, 3>(InfiniteProcessing::srgbNonlinearToLinear(linalg::vec<uint8_t, 3>{ c.red, c.green, c.blue }));
+			}
+
+			auto averageLinear = (static_cast<linalg::aliases::float3>(sumLinear) / static_cast<float>(last - first)) / 65535.0f;
+			auto nonlinear = ColorSpaceMath::round_to_0_255<linalg::aliases::byte3>(InfiniteProcessing::srgbLinearToNonlinear(averageLinear) * 255.0f);
+
+			ledColors[ledIndex] = ColorRgb(nonlinear.x, nonlinear.y, nonlinear.z);
+		}
+	}
+}
@@ -0,0 +1,271 @@
+/* EffectScheduler.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <algorithm>
+#endif
+
+#include <effects/EffectScheduler.h>
+#include <effects/Effect.h>
+#include <utils/InternalClock.h>
+#include <utils/Macros.h>
+
+namespace
+{
+	constexpr int64_t REPORT_INTERVAL = 10000000;
+	// a tick longer than this, repeated HEAVY_TICK_LIMIT times in a row, moves the effect's instance off the shared thread
+	constexpr int64_t HEAVY_TICK = 10000;
+	constexpr int HEAVY_TICK_LIMIT = 3;
+	// longest run of ticks in one timer event, then the queued calls (start, stop, priority changes) get their turn
+	constexpr int64_t DISPATCH_BUDGET = 20000;
+}
+
+std::mutex EffectScheduler::_instanceMutex;
+std::weak_ptr<EffectScheduler> EffectScheduler::_instance;
+
+std::shared_ptr<EffectScheduler> EffectScheduler::getInstance()
+{
+	std::lock_guard<std::mutex> lockGuard(_instanceMutex);
+
+	auto scheduler = _instance.lock();
+	if (scheduler == nullptr)
+	{
+		scheduler = create("EffectScheduler", true);
+		_instance = scheduler;
+	}
+
+	return scheduler;
+}
+
+std::shared_ptr<EffectScheduler> EffectScheduler::createDedicated(const QString& name)
+{
+	return create(name, false);
+}
+
+std::shared_ptr<EffectScheduler> EffectScheduler::create(const QString& name, bool shared)
+{
+	QThread* newThread = new QThread();
+	newThread->setObjectName(name);
+
+	EffectScheduler* newScheduler = new EffectScheduler(name, shared);
+	newScheduler->moveToThread(newThread);
+	newThread->start();
+
+	return std::shared_ptr<EffectScheduler>(newScheduler,
+		[name](EffectScheduler* oldScheduler) {
+			hyperhdr::THREAD_REMOVER(name, oldScheduler->thread(), oldScheduler);
+		});
+}
+
+EffectScheduler::EffectScheduler(const QString& name, bool shared)
+	: QObject()
+	, _log((shared) ? QString("EFFECT_SCHEDULER") : name.toUpper())
+	, _shared(shared)
+	, _timer(new QTimer(this))
+	, _generation(0)
+	, _lastReport(InternalClock::nowMicro())
+{
+	_timer->setTimerType(Qt::PreciseTimer);
+	_timer->setSingleShot(true);
+	connect(_timer, &QTimer::timeout, this, &EffectScheduler::handleTimer);
+
+	Debug(_log, "Effect scheduler is created");
+}
+
+EffectScheduler::~EffectScheduler()
+{
+	_timer->stop();
+
+	Debug(_log, "Effect scheduler is released");
+}
+
+int64_t EffectScheduler::alignToPeriod(int64_t time, int64_t period)
+{
+	return (time / period + 1) * period;
+}
+
+void EffectScheduler::schedule(Effect* effect, int periodMs)
+{
+	const int64_t period = static_cast<int64_t>(std::max(periodMs, 1)) * 1000;
+	auto slot = _slots.find(effect);
+
+	if (slot == _slots.end())
+	{
+		slot = _slots.emplace(effect, Slot{ period, 0, {}, 0, 0 }).first;
+	}
+
+	slot->second.period = period;
+	slot->second.generation = ++_generation;
+
+	_queue.push(Deadline{ alignToPeriod(InternalClock::nowMicro(), period), effect, slot->second.generation });
+
+	armTimer();
+}
+
+void EffectScheduler::setPeriod(Effect* effect, int periodMs)
+{
+	auto slot = _slots.find(effect);
+
+	if (slot != _slots.end())
+	{
+		slot->second.period = static_cast<int64_t>(std::max(periodMs, 1)) * 1000;
+	}
+}
+
+void EffectScheduler::unschedule(Effect* effect)
+{
+	if (_slots.erase(effect) > 0)
+	{
+		armTimer();
+	}
+}
+
+bool EffectScheduler::isScheduled(Effect* effect) const
+{
+	return _slots.find(effect) != _slots.end();
+}
+
+EffectScheduler::TickStatistics EffectScheduler::getStatistics(Effect* effect) const
+{
+	auto slot = _slots.find(effect);
+
+	return (slot != _slots.end()) ? slot->second.stats : TickStatistics();
+}
+
+bool EffectScheduler::isShared() const
+{
+	return _shared;
+}
+
+void EffectScheduler::handleTimer()
+{
+	int64_t now = InternalClock::nowMicro();
+	const int64_t dispatchStart = now;
+
+	while (!_queue.empty() && _queue.top().time <= now && now - dispatchStart < DISPATCH_BUDGET)
+	{
+		Deadline deadline = _queue.top();
+		_queue.pop();
+
+		auto slot = _slots.find(deadline.effect);
+		if (slot == _slots.end() || slot->second.generation != deadline.generation)
+			continue;
+
+		const int64_t jitter = now - deadline.time;
+
+		deadline.effect->run();
+
+		const int64_t finished = InternalClock::nowMicro();
+
+		// the effect could stop or reschedule itself during the tick
+		slot = _slots.find(deadline.effect);
+		if (slot != _slots.end() && slot->second.generation == deadline.generation)
+		{
+			Slot& current = slot->second;
+			TickStatistics& stats = current.stats;
+
+			stats.ticks++;
+			stats.jitterSum += jitter;
+			stats.jitterMax = std::max(stats.jitterMax, jitter);
+			stats.busyMax = std::max(stats.busyMax, finished - now);
+
+			if (_shared && current.heavyTicks < HEAVY_TICK_LIMIT)
+			{
+				current.heavyTicks = (finished - now > HEAVY_TICK) ? current.heavyTicks + 1 : 0;
+
+				if (current.heavyTicks == HEAVY_TICK_LIMIT)
+				{
+					Warning(_log, "{:s} needs {:d}us per tick, its instance will get its own effect thread", deadline.effect->getDescription(), finished - now);
+					deadline.effect->requestIsolation();
+				}
+			}
+
+			int64_t next = alignToPeriod(deadline.time, current.period);
+			if (next <= finished)
+			{
+				const int64_t missed = (finished - next) / current.period + 1;
+				stats.overruns += missed;
+				next += missed * current.period;
+			}
+
+			_queue.push(Deadline{ next, deadline.effect, deadline.generation });
+		}
+
+		now = finished;
+	}
+
+	report(now);
+
+	armTimer();
+}
+
+void EffectScheduler::armTimer()
+{
+	// drop the deadlines of the removed or rescheduled effects
+	while (!_queue.empty())
+	{
+		const Deadline& deadline = _queue.top();
+		auto slot = _slots.find(deadline.effect);
+
+		if (slot != _slots.end() && slot->second.generation == deadline.generation)
+			break;
+
+		_queue.pop();
+	}
+
+	if (_queue.empty())
+	{
+		_timer->stop();
+		return;
+	}
+
+	// round up: QTimer has millisecond resolution and waking up before the deadline would only add a second wakeup
+	const int64_t delay = std::max(_queue.top().time - InternalClock::nowMicro(), int64_t(0));
+	_timer->start(static_cast<int>((delay + 999) / 1000));
+}
+
+void EffectScheduler::report(int64_t now)
+{
+	if (now - _lastReport < REPORT_INTERVAL)
+		return;
+
+	_lastReport = now;
+
+	for (auto& [effect, slot] : _slots)
+	{
+		const TickStatistics& stats = slot.stats;
+
+		if (stats.overruns > slot.reportedOverruns)
+		{
+			Warning(_log, "{:s} has missed {:d} tick(s) (total: {:d}), period: {:d}ms, average jitter: {:d}us, max jitter: {:d}us, longest tick: {:d}us",
+				effect->getDescription(), stats.overruns - slot.reportedOverruns, stats.overruns, slot.period / 1000,
+				(stats.ticks > 0) ? stats.jitterSum / static_cast<int64_t>(stats.ticks) : 0, stats.jitterMax, stats.busyMax);
+
+			slot.reportedOverruns = stats.overruns;
+		}
+	}
+}
@@ -39,7 +39,9 @@
 
 #include <base/HyperHdrInstance.h>
 #include <grabber/GrabberWorker.h>
+#include <image/FrameStatistics.h>
 #include <utils/GlobalSignals.h>
+#include <performance-counters/PerformanceTracer.h>
 
 GrabberWorker::GrabberWorker() :
 #ifndef __APPLE__
@@ -62,6 +64,7 @@ GrabberWorker::GrabberWorker() :
 	_hdrToneMappingEnabled(0),
 	_lutBuffer(nullptr),
 	_qframe(false),
+	_mjpegDecimation(1),
 	_directAccess(false),
 	_automaticToneMapping(nullptr)
 {
@@ -86,7 +89,7 @@ void GrabberWorker::setup(unsigned int __workerIndex, v4l2_buffer* __v4l2Buf, Pi
 	uint8_t* __sharedData, int __size, int __width, int __height, int __lineLength,
 	uint __cropLeft, uint  __cropTop, uint __cropBottom, uint __cropRight,
 	quint64 __currentFrame, qint64 __frameBegin,
-	int __hdrToneMappingEnabled, uint8_t* __lutBuffer, bool __qframe, bool __directAccess, QString __deviceName, AutomaticToneMapping* __automaticToneMapping)
+	int __hdrToneMappingEnabled, uint8_t* __lutBuffer, bool __qframe, int __mjpegDecimation, bool __directAccess, QString __deviceName, AutomaticToneMapping* __automaticToneMapping)
 {
 	_workerIndex = __workerIndex;
 	memcpy(&_v4l2Buf, __v4l2Buf, sizeof(v4l2_buffer));
@@ -105,6 +108,7 @@ void GrabberWorker::setup(unsigned int __workerIndex, v4l2_buffer* __v4l2Buf, Pi
 	_hdrToneMappingEnabled = __hdrToneMappingEnabled;
 	_lutBuffer = __lutBuffer;
 	_qframe = __qframe;
+	_mjpegDecimation = __mjpegDecimation;
 	_directAccess = __directAccess;
 	_deviceName = __deviceName;
 	_automaticToneMapping = __automaticToneMapping;
@@ -119,7 +123,7 @@ void GrabberWorker::setup(unsigned int __workerIndex, PixelFormat __pixelFormat,
 	uint8_t* __sharedData, int __size, int __width, int __height, int __lineLength,
 	uint __cropLeft, uint  __cropTop, uint __cropBottom, uint __cropRight,
 	quint64 __currentFrame, qint64 __frameBegin,
-	int __hdrToneMappingEnabled, uint8_t* __lutBuffer, bool __qframe, bool __directAccess, QString __deviceName, AutomaticToneMapping* __automaticToneMapping)
+	int __hdrToneMappingEnabled, uint8_t* __lutBuffer, bool __qframe, int __mjpegDecimation, bool __directAccess, QString __deviceName, AutomaticToneMapping* __automaticToneMapping)
 {
 	_workerIndex = __workerIndex;
 	_lineLength = __lineLength;
@@ -136,6 +140,7 @@ void GrabberWorker::setup(unsigned int __workerIndex, PixelFormat __pixelFormat,
 	_hdrToneMappingEnabled = __hdrToneMappingEnabled;
 	_lutBuffer = __lutBuffer;
 	_qframe = __qframe;
+	_mjpegDecimation = __mjpegDecimation;
 	_directAccess = __directAccess;
 	_deviceName = __deviceName;
 	_automaticToneMapping = __automaticToneMapping;
@@ -145,6 +150,12 @@ void GrabberWorker::setup(unsigned int __workerIndex, PixelFormat __pixelFormat,
 }
 #endif
 
+FrameTiming GrabberWorker::getFrameTiming() const
+{
+	// the frame was stamped with the millisecond clock when the grabber dequeued it
+	return FrameTiming::capture(InternalClock::nowMicro() - (InternalClock::nowPrecise() - _frameBegin) * 1000);
+}
+
 void GrabberWorker::run()
 {
 	runMe();
@@ -154,33 +165,57 @@ void GrabberWorker::runMe()
 {
 	if (_isActive && _width > 0 && _height > 0)
 	{
-		if (_pixelFormat == PixelFormat::MJPEG)
-		{			
-			process_image_jpg_mt();
-		}
-		else
+		Image<ColorRgb> image;
+		bool decoded;
+
 		{
-			Image<ColorRgb> image;
-
-			#ifdef __linux__
-				const uint8_t* frameData = _sharedData;
-			#else
-				const uint8_t* frameData = _localBuffer.data();
-			#endif
-
-			FrameDecoder::dispatchProcessImageVector[_qframe][static_cast<bool>(_hdrToneMappingEnabled)][_qframe && _automaticToneMapping != nullptr](
-				_cropLeft, _cropRight, _cropTop, _cropBottom,
-				frameData, nullptr, _width, _height, _lineLength, _pixelFormat, _lutBuffer, image, _automaticToneMapping);
-
-			image.setBufferCacheSize();
-			if (!_directAccess)
-				emit SignalNewFrame(_workerIndex, image, _currentFrame, _frameBegin);
-			else
-			{
-				emit GlobalSignals::getInstance()->SignalNewVideoImage(_deviceName, image);
-				emit SignalNewFrame(_workerIndex, Image<ColorRgb>(), _currentFrame, _frameBegin);
-			}
+			// only the decoding: with a single worker the signals below are direct calls into the processing
+			PerformanceTracer::Scope trace(PerformanceTracer::Stage::DECODE);
+
+			decoded = (_pixelFormat == PixelFormat::MJPEG) ? process_image_jpg_mt(image) : process_image(image);
 		}
+
+		if (decoded)
+			sendFrame(image);
+	}
+}
+
+bool GrabberWorker::process_image(Image<ColorRgb>& image)
+{
+	// the statistics are only consumed by the manual signal detection and the automatic tone mapping
+	const bool collectSourceRange = _qframe && _automaticToneMapping != nullptr;
+	auto statistics = (!_directAccess || collectSourceRange) ? std::make_shared<FrameStatistics>(collectSourceRange) : nullptr;
+
+	#ifdef __linux__
+		const uint8_t* frameData = _sharedData;
+	#else
+		const uint8_t* frameData = _localBuffer.data();
+	#endif
+
+	FrameDecoder::dispatchProcessImageVector[_qframe][static_cast<bool>(_hdrToneMappingEnabled)][statistics != nullptr](
+		_cropLeft, _cropRight, _cropTop, _cropBottom,
+		frameData, nullptr, _width, _height, _lineLength, _pixelFormat, _lutBuffer, image, statistics.get());
+
+	if (_automaticToneMapping != nullptr && statistics != nullptr && statistics->hasSourceRange())
+	{
+		_automaticToneMapping->scan(*statistics);
+		_automaticToneMapping->finilize();
+	}
+
+	image.setStatistics(statistics);
+	return true;
+}
+
+void GrabberWorker::sendFrame(Image<ColorRgb>& image)
+{
+	image.setFrameTiming(getFrameTiming());
+	image.setBufferCacheSize();
+	if (!_directAccess)
+		emit SignalNewFrame(_workerIndex, image, _currentFrame, _frameBegin);
+	else
+	{
+		emit GlobalSignals::getInstance()->SignalNewVideoImage(_deviceName, image);
+		emit SignalNewFrame(_workerIndex, Image<ColorRgb>(), _currentFrame, _frameBegin);
 	}
 }
 
@@ -204,7 +239,35 @@ void GrabberWorker::noBusy()
 	_isBusy = false;
 }
 
-void GrabberWorker::process_image_jpg_mt()
+#ifndef __APPLE__
+tjscalingfactor GrabberWorker::selectJpegScaling(bool yuvOutput) const
+{
+	const tjscalingfactor base{ 1, (_qframe) ? 2 : 1 };
+	const tjscalingfactor candidates[] = { { 1, 8 }, { 1, 4 } };
+
+	for (const auto& scaling : candidates)
+	{
+		if (scaling.denom > _mjpegDecimation)
+			continue;
+
+		const int width = TJSCALED(_width, scaling);
+		const int height = TJSCALED(_height, scaling);
+		const int cropWidth = TJSCALED(static_cast<int>(_cropLeft + _cropRight), scaling);
+		const int cropHeight = TJSCALED(static_cast<int>(_cropTop + _cropBottom), scaling);
+
+		// the YUV decoders process pixel pairs: odd sizes fall back to the next, larger scale
+		if (yuvOutput && ((width % 2) != 0 || (height % 2) != 0))
+			continue;
+
+		if (width > cropWidth && height > cropHeight)
+			return scaling;
+	}
+
+	return base;
+}
+#endif
+
+bool GrabberWorker::process_image_jpg_mt(Image<ColorRgb>& image)
 {
 	#ifndef __APPLE__
 
@@ -221,52 +284,68 @@ void GrabberWorker::process_image_jpg_mt()
 		tjGetErrorCode(_decompress) == TJERR_FATAL)
 	{
         emit SignalNewFrameError(_workerIndex, QString(tjGetErrorStr()), _currentFrame);
-		return;
+		return false;
 	}
 	
 	if ((_subsamp != TJSAMP_422 && _subsamp != TJSAMP_420) && _hdrToneMappingEnabled > 0)
 	{
 		emit SignalNewFrameError(_workerIndex, QString("%1: %2").arg(UNSUPPORTED_DECODER).arg(_subsamp), _currentFrame);
-		return;
+		return false;
 	}
 
-	tjscalingfactor sca{ 1, 2 };
+	const tjscalingfactor scaling = selectJpegScaling(_hdrToneMappingEnabled > 0);
+	uint cropLeft = _cropLeft, cropRight = _cropRight, cropTop = _cropTop, cropBottom = _cropBottom;
+
+	if (scaling.denom > 2)
+	{
+		// the crop is given in the source pixels, keep it even for the YUV decoders
+		auto scaleCrop = [&](uint crop) { return static_cast<uint>(TJSCALED(static_cast<int>(crop), scaling)) & ~1u; };
+		cropLeft = scaleCrop(_cropLeft);
+		cropRight = scaleCrop(_cropRight);
+		cropTop = scaleCrop(_cropTop);
+		cropBottom = scaleCrop(_cropBottom);
+	}
 
-	_width = (_qframe) ? TJSCALED(_width, sca) : _width;
-	_height = (_qframe) ? TJSCALED(_height, sca) : _height;
+	_width = TJSCALED(_width, scaling);
+	_height = TJSCALED(_height, scaling);
 
-	Image<ColorRgb> image(_width - _cropLeft - _cropRight, _height - _cropTop - _cropBottom);
+	image = Image<ColorRgb>(_width - cropLeft - cropRight, _height - cropTop - cropBottom);
+	auto statistics = (!_directAccess) ? std::make_shared<FrameStatistics>() : nullptr;
 
 	if (_hdrToneMappingEnabled > 0)
 	{
 		size_t yuvSize = tjBufSizeYUV2(_width, 2, _height, _subsamp);
-		MemoryBuffer<uint8_t> jpgBuffer(yuvSize);
+		if (_decodeBuffer.size() < yuvSize)
+			_decodeBuffer.resize(yuvSize);
 
-		if (tjDecompressToYUV2(_decompress, frameData, _size, jpgBuffer.data(), _width, 2, _height, TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE) != 0 &&
+		// tjDecompressToYUV2 scales in the IDCT when the requested size is smaller than the JPEG: at 1/8 only the DC coefficients are used
+		if (tjDecompressToYUV2(_decompress, frameData, _size, _decodeBuffer.data(), _width, 2, _height, TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE) != 0 &&
 			tjGetErrorCode(_decompress) == TJERR_FATAL)
 			{
 				emit SignalNewFrameError(_workerIndex, QString(tjGetErrorStr()), _currentFrame);
-				return;
+				return false;
 			}		
 
-		FrameDecoder::dispatchProcessImageVector[false][_hdrToneMappingEnabled][false](
-			_cropLeft, _cropRight, _cropTop, _cropBottom,
-			jpgBuffer.data(), nullptr, _width, _height, _width, (_subsamp == TJSAMP_422) ? PixelFormat::MJPEG : PixelFormat::I420, _lutBuffer, image, _automaticToneMapping);
+		FrameDecoder::dispatchProcessImageVector[false][_hdrToneMappingEnabled][statistics != nullptr](
+			cropLeft, cropRight, cropTop, cropBottom,
+			_decodeBuffer.data(), nullptr, _width, _height, _width, (_subsamp == TJSAMP_422) ? PixelFormat::MJPEG : PixelFormat::I420, _lutBuffer, image, statistics.get());
 	}
 	else if (image.width() != (uint)_width || image.height() != (uint)_height)
 	{
-		MemoryBuffer<uint8_t> jpgBuffer(_width * _height * 3);
+		size_t rgbSize = static_cast<size_t>(_width) * _height * 3;
+		if (_decodeBuffer.size() < rgbSize)
+			_decodeBuffer.resize(rgbSize);
 
-		if (tjDecompress2(_decompress, frameData, _size, jpgBuffer.data(), _width, 0, _height, TJPF_BGR, TJFLAG_BOTTOMUP | TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE) != 0 &&
+		if (tjDecompress2(_decompress, frameData, _size, _decodeBuffer.data(), _width, 0, _height, TJPF_BGR, TJFLAG_BOTTOMUP | TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE) != 0 &&
 			tjGetErrorCode(_decompress) == TJERR_FATAL)
 			{
 				emit SignalNewFrameError(_workerIndex, QString(tjGetErrorStr()), _currentFrame);
-				return;
+				return false;
 			}					
 
-		FrameDecoder::dispatchProcessImageVector[false][false][false](
-			_cropLeft, _cropRight, _cropTop, _cropBottom,
-			jpgBuffer.data(), nullptr, _width, _height, _width * 3, PixelFormat::RGB24, nullptr, image, nullptr);
+		FrameDecoder::dispatchProcessImageVector[false][false][statistics != nullptr](
+			cropLeft, cropRight, cropTop, cropBottom,
+			_decodeBuffer.data(), nullptr, _width, _height, _width * 3, PixelFormat::RGB24, nullptr, image, statistics.get());
 	}
 	else
 	{
@@ -274,18 +353,20 @@ void GrabberWorker::process_image_jpg_mt()
 			tjGetErrorCode(_decompress) == TJERR_FATAL)
 			{
 				emit SignalNewFrameError(_workerIndex, QString(tjGetErrorStr()), _currentFrame);
-				return;
-			}		
+				return false;
+			}
+
+		// libjpeg-turbo decoded straight into the image, so the statistics need their own pass here
+		if (statistics != nullptr)
+			statistics->scanImage(image);
 	}
 	
-	image.setBufferCacheSize();
-	if (!_directAccess)
-		emit SignalNewFrame(_workerIndex, image, _currentFrame, _frameBegin);
-	else
-	{
-		emit GlobalSignals::getInstance()->SignalNewVideoImage(_deviceName, image);
-        emit SignalNewFrame(_workerIndex, Image<ColorRgb>(), _currentFrame, _frameBegin);
-	}
+	image.setStatistics(statistics);
+	return true;
+
+	#else
+
+	return false;
 
 	#endif
 }
@@ -0,0 +1,376 @@
+/* FileGrabber.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QCoreApplication>
+	#include <QFileInfo>
+	#include <QTimer>
+	#include <algorithm>
+	#include <cstring>
+#endif
+
+#include <linux/videodev2.h>
+
+#include <grabber/linux/v4l2/FileGrabber.h>
+#include <utils/InternalClock.h>
+
+namespace
+{
+	const QString FILE_PREFIX = "file:";
+	const QString FILE_MAX_PREFIX = "file-max:";
+
+	// the workers expect a dequeued v4l2 buffer, the replay never queues it back
+	const v4l2_buffer replayBuffer = {};
+};
+
+FileGrabber::FileGrabber(const QString& device, const QString& configurationPath)
+	: Grabber(configurationPath, "FILE")
+	, _maximumSpeed(false)
+	, _timer(new QTimer(this))
+	, _pendingSize(0)
+	, _pendingTimestamp(0)
+	, _hasPending(false)
+	, _loopStart(0)
+	, _loopFrames(0)
+	, _loopDropped(0)
+{
+	_deviceName = device;
+
+	_timer->setSingleShot(true);
+	_timer->setTimerType(Qt::PreciseTimer);
+	connect(_timer, &QTimer::timeout, this, &FileGrabber::replayFrame);
+}
+
+FileGrabber::~FileGrabber()
+{
+	FileGrabber::uninit();
+}
+
+bool FileGrabber::isFileDevice(const QString& device)
+{
+	return device.startsWith(FILE_PREFIX, Qt::CaseInsensitive) || device.startsWith(FILE_MAX_PREFIX, Qt::CaseInsensitive);
+}
+
+void FileGrabber::loadLutFile(PixelFormat color, bool silent)
+{
+	QString fileName1 = QString("%1%2").arg(_configurationPath).arg("/lut_lin_tables.3d");
+	QString fileName2 = QString("%1%2").arg(QCoreApplication::applicationDirPath()).arg("/../lut/lut_lin_tables.3d");
+	QString fileName3 = QString("/usr/share/hyperhdr/lut/lut_lin_tables.3d");
+
+	Grabber::loadLutFile((!silent) ? _log : nullptr, color, QList<QString>{fileName1, fileName2, fileName3});
+}
+
+bool FileGrabber::isLutRequired() const
+{
+	return _actualVideoFormat != PixelFormat::RGB24 && _actualVideoFormat != PixelFormat::XRGB;
+}
+
+void FileGrabber::setHdrToneMappingEnabled(int mode)
+{
+	if (_hdrToneMappingEnabled != mode || _lut.data() == nullptr)
+	{
+		_hdrToneMappingEnabled = mode;
+		Debug(_log, "setHdrToneMappingMode to: {:s}", (mode == 0) ? "Disabled" : "Enabled");
+
+		if (_fileWorkerManager.isActive())
+		{
+			_fileWorkerManager.Stop();
+			loadLutFile((isLutRequired()) ? PixelFormat::YUYV : PixelFormat::RGB24);
+			_fileWorkerManager.Start();
+		}
+		emit SignalSetNewComponentStateToAllInstances(hyperhdr::Components::COMP_HDR, (mode != 0));
+	}
+	else
+		Debug(_log, "setHdrToneMappingMode nothing changed: {:s}", (mode == 0) ? "Disabled" : "Enabled");
+}
+
+bool FileGrabber::init()
+{
+	if (!_initialized)
+	{
+		// the device name may have been changed in the settings since the construction
+		if (!isFileDevice(_deviceName))
+		{
+			Error(_log, "Switching from a recording to the video device '{:s}' requires a restart of HyperHDR", (_deviceName));
+			return false;
+		}
+
+		_maximumSpeed = _deviceName.startsWith(FILE_MAX_PREFIX, Qt::CaseInsensitive);
+		_fileName = _deviceName.mid((_maximumSpeed) ? FILE_MAX_PREFIX.length() : FILE_PREFIX.length());
+
+		if (!_reader.open(_fileName))
+		{
+			Error(_log, "{:s}", _reader.getLastError());
+			return false;
+		}
+
+		_actualVideoFormat = _reader.format();
+		_actualWidth = _reader.width();
+		_actualHeight = _reader.height();
+		_lineLength = _reader.lineLength();
+		_frameByteSize = -1;
+		_actualDeviceName = QFileInfo(_fileName).fileName();
+
+		// the frame rate is not stored: estimate it from the first two timestamps
+		_actualFPS = 0;
+		if (readNextFrame())
+		{
+			const int64_t first = _pendingTimestamp;
+			if (readNextFrame() && _pendingTimestamp > first)
+				_actualFPS = static_cast<int>(1000000 / (_pendingTimestamp - first));
+		}
+		_hasPending = false;
+		_reader.rewind();
+
+		Info(_log, "*************************************************************************************************");
+		Info(_log, "Starting file grabber. Selected: {:s} {:d} x {:d} @ {:d} fps {:s} ({:s}, {:s})", (_fileName),
+			_actualWidth, _actualHeight, _actualFPS, (pixelFormatToString(_actualVideoFormat)),
+			(_reader.isCompressed()) ? "zstd" : "uncompressed", (_maximumSpeed) ? "maximum speed" : "original timing");
+		Info(_log, "*************************************************************************************************");
+
+		loadLutFile((isLutRequired()) ? PixelFormat::YUYV : PixelFormat::RGB24);
+
+		_initialized = true;
+	}
+
+	return _initialized;
+}
+
+void FileGrabber::uninit()
+{
+	if (_initialized)
+	{
+		Debug(_log, "Uninit grabber: {:s}", (_deviceName));
+		stop();
+	}
+}
+
+bool FileGrabber::start()
+{
+	resetCounter(InternalClock::now());
+	_fileWorkerManager.Start();
+
+	if (!init())
+		return false;
+
+	if (_fileWorkerManager.workers.empty())
+	{
+		_fileWorkerManager.InitWorkers();
+		Debug(_log, "Worker's thread count  = {:d}", _fileWorkerManager.workersCount);
+
+		for (unsigned int i = 0; i < _fileWorkerManager.workersCount && i < _fileWorkerManager.workers.size(); i++)
+		{
+			connect(_fileWorkerManager.workers[i].get(), &GrabberWorker::SignalNewFrameError, this, &FileGrabber::newWorkerFrameErrorHandler);
+			connect(_fileWorkerManager.workers[i].get(), &GrabberWorker::SignalNewFrame, this, &FileGrabber::newWorkerFrameHandler);
+		}
+	}
+	_workerFrames.resize(_fileWorkerManager.workers.size());
+
+	_hasPending = false;
+	_loopStart = InternalClock::nowMicro();
+	_loopFrames = 0;
+	_loopDropped = 0;
+	_timer->start(0);
+
+	Info(_log, "Started");
+	return true;
+}
+
+void FileGrabber::stop()
+{
+	if (_initialized)
+	{
+		_timer->stop();
+		_fileWorkerManager.Stop();
+		_reader.close();
+		_hasPending = false;
+		_initialized = false;
+		Info(_log, "Stopped");
+	}
+}
+
+bool FileGrabber::readNextFrame()
+{
+	if (_reader.readFrame(_pendingFrame, _pendingSize, _pendingTimestamp))
+	{
+		_hasPending = true;
+		return true;
+	}
+
+	const QString error = _reader.getLastError();
+	if (!error.isEmpty())
+	{
+		Error(_log, "{:s}", error);
+		return false;
+	}
+
+	// end of the recording: report the pace of the last pass and start over
+	if (_initialized && _loopFrames > 0)
+	{
+		const int64_t elapsed = std::max(InternalClock::nowMicro() - _loopStart, int64_t(1));
+		Info(_log, "Replayed {:d} frames in {:d} ms ({:.1f} fps), dropped: {:d}", _loopFrames, elapsed / 1000,
+			_loopFrames * 1000000.0 / elapsed, _loopDropped);
+	}
+
+	if (!_reader.rewind() || !_reader.readFrame(_pendingFrame, _pendingSize, _pendingTimestamp))
+	{
+		Error(_log, "The recording does not contain any frame: {:s}", _fileName);
+		return false;
+	}
+
+	_loopStart = InternalClock::nowMicro();
+	_loopFrames = 0;
+	_loopDropped = 0;
+	_hasPending = true;
+	return true;
+}
+
+void FileGrabber::replayFrame()
+{
+	if (!_initialized || !_fileWorkerManager.isActive())
+		return;
+
+	if (!_hasPending && !readNextFrame())
+	{
+		stop();
+		return;
+	}
+
+	if (!_maximumSpeed)
+	{
+		const int64_t wait = _loopStart + _pendingTimestamp - InternalClock::nowMicro();
+		if (wait >= 1000)
+		{
+			_timer->start(static_cast<int>(wait / 1000));
+			return;
+		}
+
+		// a capture device does not wait either: a frame that is late by a full period is lost
+		if (_actualFPS > 0 && -wait > 1000000 / _actualFPS)
+		{
+			_hasPending = false;
+			_loopDropped++;
+			frameStat.badFrame++;
+			_timer->start(0);
+			return;
+		}
+	}
+
+	uint64_t processFrameIndex = _currentFrame++;
+
+	if ((processFrameIndex % _fpsSoftwareDecimation != 0) && (_fpsSoftwareDecimation > 1))
+	{
+		_hasPending = false;
+		_timer->start(0);
+		return;
+	}
+
+	if (isLutRequired() && !_lutBufferInit)
+	{
+		loadLutFile(PixelFormat::YUYV, true);
+
+		if (!_lutBufferInit)
+		{
+			pleaseWaitForLut();
+			_hasPending = false;
+			_timer->start(40);
+			return;
+		}
+	}
+
+	for (unsigned int i = 0; i < _fileWorkerManager.workersCount && i < _fileWorkerManager.workers.size(); i++)
+	{
+		auto& worker = _fileWorkerManager.workers[i];
+
+		if ((worker->isFinished() || !worker->isRunning()) && worker->isBusy() == false)
+		{
+			// the worker decodes straight from its own buffer, the next frame is read into the released one
+			std::swap(_workerFrames[i], _pendingFrame);
+			_hasPending = false;
+			_loopFrames++;
+
+			bool directAccess = !(_signalAutoDetectionEnabled || _signalDetectionEnabled || isCalibrating());
+			worker->setup(
+				i,
+				const_cast<v4l2_buffer*>(&replayBuffer),
+				_actualVideoFormat,
+				_workerFrames[i].data(), static_cast<int>(_pendingSize), _actualWidth, _actualHeight, _lineLength,
+				_cropLeft, _cropTop, _cropBottom, _cropRight,
+				processFrameIndex, InternalClock::nowPrecise(), _hdrToneMappingEnabled,
+				(_lutBufferInit) ? _lut.data() : nullptr, _qframe, _mjpegDecimation, directAccess, _deviceName, _automaticToneMapping.prepare());
+
+			if (_fileWorkerManager.workersCount > 1)
+				worker->start();
+			else
+				worker->startOnThisThread();
+
+			_timer->start(0);
+			return;
+		}
+	}
+
+	// all the workers are busy: a capture device would overwrite the frame, the maximum speed mode waits for a worker instead
+	if (!_maximumSpeed)
+	{
+		_hasPending = false;
+		_loopDropped++;
+		frameStat.badFrame++;
+		_timer->start(0);
+	}
+}
+
+void FileGrabber::releaseWorker(unsigned int workerIndex, quint64 sourceCount)
+{
+	if (!(workerIndex < _fileWorkerManager.workersCount && workerIndex < _fileWorkerManager.workers.size()))
+	{
+		Error(_log, "Frame index = {:d}, index out of range", sourceCount);
+		return;
+	}
+
+	_fileWorkerManager.workers[workerIndex]->noBusy();
+
+	if (_maximumSpeed && _initialized && !_timer->isActive())
+		_timer->start(0);
+}
+
+void FileGrabber::newWorkerFrameErrorHandler(unsigned int workerIndex, QString error, quint64 sourceCount)
+{
+	frameStat.badFrame++;
+	if (error.indexOf(QString(UNSUPPORTED_DECODER)) == 0)
+	{
+		Error(_log, "Unsupported MJPEG/YUV format. Please contact HyperHDR developers! (info: {:s})", (error));
+	}
+
+	releaseWorker(workerIndex, sourceCount);
+}
+
+void FileGrabber::newWorkerFrameHandler(unsigned int workerIndex, Image<ColorRgb> image, quint64 sourceCount, qint64 _frameBegin)
+{
+	handleNewFrame(workerIndex, image, sourceCount, _frameBegin);
+
+	releaseWorker(workerIndex, sourceCount);
+}
@@ -1187,6 +1187,9 @@ bool V4L2Grabber::process_image(v4l2_buffer* buf, const void* frameImageBuffer,
 	bool		frameSend = false;
 	uint64_t	processFrameIndex = _currentFrame++;
 
+	// the raw buffer is recorded before the software decimation so the replay sees what the device delivered
+	recordFrame(frameImageBuffer, size);
+
 	// frame skipping
 	if ((processFrameIndex % _fpsSoftwareDecimation != 0) && (_fpsSoftwareDecimation > 1))
 		return frameSend;
@@ -1276,7 +1279,7 @@ bool V4L2Grabber::process_image(v4l2_buffer* buf, const void* frameImageBuffer,
 							(uint8_t*)frameImageBuffer, size, _actualWidth, _actualHeight, _lineLength,
 							_cropLeft, _cropTop, _cropBottom, _cropRight,
 							processFrameIndex, InternalClock::nowPrecise(), _hdrToneMappingEnabled,
-							(_lutBufferInit) ? _lut.data() : nullptr, _qframe, directAccess, _deviceName, _automaticToneMapping.prepare());
+							(_lutBufferInit) ? _lut.data() : nullptr, _qframe, _mjpegDecimation, directAccess, _deviceName, _automaticToneMapping.prepare());
 
 						if (_V4L2WorkerManager.workersCount > 1)
 							_V4L2WorkerManager.workers[i]->start();
@@ -27,14 +27,19 @@
 
 #include <QMetaType>
 #include <grabber/linux/v4l2/V4L2Wrapper.h>
+#include <grabber/linux/v4l2/FileGrabber.h>
 #include <base/HyperHdrManager.h>
 #include <utils/GlobalSignals.h>
 
 V4L2Wrapper::V4L2Wrapper(const QString& device,
 	const QString& configurationPath)
-	: GrabberWrapper("V4L2:" + device.left(14))
+	: GrabberWrapper((FileGrabber::isFileDevice(device)) ? QString("FILE") : "V4L2:" + device.left(14))
 {
-	_grabber = std::unique_ptr<Grabber>(new V4L2Grabber(device, configurationPath));
+	// "file:<recording>" replays a raw capture instead of opening a video device
+	if (FileGrabber::isFileDevice(device))
+		_grabber = std::unique_ptr<Grabber>(new FileGrabber(device, configurationPath));
+	else
+		_grabber = std::unique_ptr<Grabber>(new V4L2Grabber(device, configurationPath));
     connect(_grabber.get(), &Grabber::SignalCapturingException, this, &GrabberWrapper::capturingExceptionHandler);
 	connect(_grabber.get(), &Grabber::SignalSetNewComponentStateToAllInstances, this, &GrabberWrapper::SignalSetNewComponentStateToAllInstances);
 	connect(_grabber.get(), &Grabber::SignalSaveCalibration, this, &GrabberWrapper::SignalSaveCalibration);
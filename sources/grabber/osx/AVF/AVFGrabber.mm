@@ -837,7 +837,7 @@ bool AVFGrabber::process_image(const void* frameImageBuffer, int size)
 							(uint8_t*)frameImageBuffer, size, _actualWidth, _actualHeight, _lineLength,
 							_cropLeft, _cropTop, _cropBottom, _cropRight,
 							processFrameIndex, InternalClock::nowPrecise(), _hdrToneMappingEnabled,
-							(_lutBufferInit) ? _lut.data() : nullptr, _qframe, directAccess, _deviceName, _automaticToneMapping.prepare());
+							(_lutBufferInit) ? _lut.data() : nullptr, _qframe, _mjpegDecimation, directAccess, _deviceName, _automaticToneMapping.prepare());
 
 						if (_AVFWorkerManager.workersCount > 1)
 							_AVFWorkerManager.workers[i]->start();
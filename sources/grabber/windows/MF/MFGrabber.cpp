@@ -947,6 +947,9 @@ bool MFGrabber::process_image(const void* frameImageBuffer, int size)
 	bool		frameSend = false;
 	uint64_t	processFrameIndex = _currentFrame++;
 
+	// the raw buffer is recorded before the software decimation so the replay sees what the device delivered
+	recordFrame(frameImageBuffer, size);
+
 	// frame skipping
 	if ((processFrameIndex % _fpsSoftwareDecimation != 0) && (_fpsSoftwareDecimation > 1))
 		return frameSend;
@@ -1032,7 +1035,7 @@ bool MFGrabber::process_image(const void* frameImageBuffer, int size)
 							(uint8_t*)frameImageBuffer, size, _actualWidth, _actualHeight, _lineLength,
 							_cropLeft, _cropTop, _cropBottom, _cropRight,
 							processFrameIndex, InternalClock::nowPrecise(), _hdrToneMappingEnabled,
-							(_lutBufferInit) ? _lut.data() : nullptr, _qframe, directAccess, _deviceName, _automaticToneMapping.prepare());
+							(_lutBufferInit) ? _lut.data() : nullptr, _qframe, _mjpegDecimation, directAccess, _deviceName, _automaticToneMapping.prepare());
 
 						if (_MFWorkerManager.workersCount > 1)
 							_MFWorkerManager.workers[i]->start();
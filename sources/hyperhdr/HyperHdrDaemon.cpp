@@ -105,6 +105,7 @@ HyperHdrDaemon::HyperHdrDaemon(const QString& rootPath, QCoreApplication* parent
 	// Register metas for thread queued connection
 	qRegisterMetaType<ColorRgb>("ColorRgb");
 	qRegisterMetaType<SharedOutputColors>("SharedOutputColors");
+	qRegisterMetaType<FrameTiming>("FrameTiming");
 	qRegisterMetaType<Image<ColorRgb>>("Image<ColorRgb>");
 	qRegisterMetaType<hyperhdr::Components>("hyperhdr::Components");
 	qRegisterMetaType<settings::type>("settings::type");
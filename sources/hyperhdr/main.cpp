@@ -38,6 +38,7 @@
 #include <utils/Logger.h>
 #include <commandline/Parser.h>
 #include <utils/DefaultSignalHandler.h>
+#include <utils/SharedExecutor.h>
 #include <db/AuthTable.h>
 
 #include "detectProcess.h"
@@ -165,6 +166,7 @@ int main(int argc, char** argv)
 #ifdef WIN32
 	BooleanOption& consoleOption = parser.add<BooleanOption>('c', "console", "Open a console window to view log output");
 #endif
+	BooleanOption& sharedExecutorOption = parser.add<BooleanOption>(0x0, "shared-executor", "Run the instances and the LED devices on a shared pool of threads sized to the core count");
 	parser.add<BooleanOption>(0x0, "desktop", "Show systray on desktop");
 	parser.add<BooleanOption>(0x0, "service", "Force HyperHdr to start as console service");
 
@@ -245,6 +247,11 @@ int main(int argc, char** argv)
 	}
 #endif
 
+	if (parser.isSet(sharedExecutorOption))
+	{
+		SharedExecutor::setEnabled(true);
+	}
+
 	int rc = 1;
 	bool readonlyMode = false;
 
@@ -64,6 +64,11 @@ Image<ColorRgb> HyperImage::renderImage() const
 	return ret;
 }
 
+const Image<ColorRgb>& HyperImage::surface() const
+{
+	return _surface;
+}
+
 void HyperImage::resize(int sizeX, int sizeY)
 {
 	_surface.resize(sizeX, sizeY);
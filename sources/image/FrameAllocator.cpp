@@ -0,0 +1,340 @@
+/* FrameAllocator.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <cstdlib>
+	#include <sstream>
+	#include <iomanip>
+#endif
+
+#include <bit>
+
+#ifdef __linux__
+	#include <sys/mman.h>
+#endif
+
+#include <image/FrameAllocator.h>
+
+#define BUFFER_LOWER_LIMIT 1
+#define CACHE_LINE_ALIGNMENT 64
+#define HUGEPAGE_ALIGNMENT (2 * 1024 * 1024)
+
+FrameAllocator FrameAllocator::frameCache;
+
+namespace
+{
+	enum class ThreadCacheState : uint8_t { NOT_CREATED, ALIVE, DESTROYED };
+
+	// both flags are constant-initialized so they stay readable while the static and thread local objects
+	// are being destroyed: images released at that time bypass the caches
+	bool allocatorAlive = false;
+	thread_local ThreadCacheState threadCacheState = ThreadCacheState::NOT_CREATED;
+}
+
+struct FrameAllocator::ThreadCache
+{
+	std::array<std::array<Block, MAGAZINE_SIZE>, CLASS_COUNT> magazines{};
+	std::array<uint8_t, CLASS_COUNT> counts{};
+	uint32_t epoch = 0;
+
+	ThreadCache()
+	{
+		threadCacheState = ThreadCacheState::ALIVE;
+	}
+
+	~ThreadCache()
+	{
+		threadCacheState = ThreadCacheState::DESTROYED;
+
+		if (allocatorAlive)
+			FrameAllocator::frameCache.flushThreadCache(*this);
+		else
+			for (int sizeClass = 0; sizeClass < CLASS_COUNT; sizeClass++)
+				while (counts[sizeClass] > 0)
+					FrameAllocator::deallocate(magazines[sizeClass][--counts[sizeClass]]);
+	}
+};
+
+FrameAllocator::FrameAllocator() :
+	_frameClass(NO_CLASS),
+	_epoch(0)
+{
+	allocatorAlive = true;
+}
+
+FrameAllocator::~FrameAllocator()
+{
+	allocatorAlive = false;
+
+	for (auto& sizeClass : _classes)
+	{
+		std::lock_guard<std::mutex> locker(sizeClass.locker);
+
+		for (auto& block : sizeClass.depot)
+			deallocate(block);
+		sizeClass.depot.clear();
+	}
+}
+
+int FrameAllocator::classIndex(size_t size)
+{
+	if (size <= (size_t(1) << MIN_CLASS_SHIFT) || size > (size_t(1) << MAX_CLASS_SHIFT))
+		return NO_CLASS;
+
+	// 2^power < size <= 2^(power + 1), the range is split into CLASSES_PER_POWER equal steps
+	const int power = std::bit_width(size - 1) - 1;
+	const size_t step = (size_t(1) << power) / CLASSES_PER_POWER;
+	const int sub = static_cast<int>(((size - 1) - (size_t(1) << power)) / step);
+
+	return (power - MIN_CLASS_SHIFT) * CLASSES_PER_POWER + sub;
+}
+
+size_t FrameAllocator::classSize(int sizeClass)
+{
+	const int power = MIN_CLASS_SHIFT + sizeClass / CLASSES_PER_POWER;
+	const size_t step = (size_t(1) << power) / CLASSES_PER_POWER;
+
+	return (size_t(1) << power) + (sizeClass % CLASSES_PER_POWER + 1) * step;
+}
+
+FrameAllocator::Block FrameAllocator::allocate(size_t size, int sizeClass)
+{
+	const size_t alignment = (size >= HUGEPAGE_ALIGNMENT) ? HUGEPAGE_ALIGNMENT : CACHE_LINE_ALIGNMENT;
+	void* memory = nullptr;
+
+	#ifdef _WIN32
+		memory = _aligned_malloc(size, alignment);
+	#else
+		if (posix_memalign(&memory, alignment, size) != 0)
+			memory = nullptr;
+	#endif
+
+	#ifdef __linux__
+		if (memory != nullptr && alignment == HUGEPAGE_ALIGNMENT)
+			madvise(memory, size, MADV_HUGEPAGE);
+	#endif
+
+	Block block;
+	block.data = reinterpret_cast<uint8_t*>(memory);
+	block.size = (memory != nullptr) ? size : 0;
+	block.sizeClass = (memory != nullptr) ? sizeClass : NO_CLASS;
+	return block;
+}
+
+void FrameAllocator::deallocate(Block& block)
+{
+	if (block.data != nullptr)
+	{
+		#ifdef _WIN32
+			_aligned_free(block.data);
+		#else
+			free(block.data);
+		#endif
+	}
+
+	block = Block();
+}
+
+FrameAllocator::ThreadCache& FrameAllocator::threadCache()
+{
+	thread_local ThreadCache cache;
+
+	// adjustCache() advances the epoch: the magazines go back to the depots where unused buffers can be trimmed
+	const uint32_t epoch = _epoch.load(std::memory_order_relaxed);
+	if (cache.epoch != epoch)
+	{
+		flushThreadCache(cache);
+		cache.epoch = epoch;
+	}
+
+	return cache;
+}
+
+void FrameAllocator::flushThreadCache(ThreadCache& cache)
+{
+	for (int sizeClass = 0; sizeClass < CLASS_COUNT; sizeClass++)
+		while (cache.counts[sizeClass] > 0)
+			pushToDepot(cache.magazines[sizeClass][--cache.counts[sizeClass]]);
+}
+
+bool FrameAllocator::pushToDepot(Block& block)
+{
+	SizeClass& sizeClass = _classes[block.sizeClass];
+
+	{
+		std::lock_guard<std::mutex> locker(sizeClass.locker);
+
+		if (sizeClass.depot.size() < DEPOT_LIMIT)
+		{
+			sizeClass.depot.push_back(block);
+			block = Block();
+			return true;
+		}
+	}
+
+	sizeClass.dropped.fetch_add(1, std::memory_order_relaxed);
+	deallocate(block);
+	return false;
+}
+
+FrameAllocator::Block FrameAllocator::request(size_t size)
+{
+	const int index = classIndex(size);
+
+	if (index == NO_CLASS || !allocatorAlive)
+		return allocate(size, NO_CLASS);
+
+	SizeClass& sizeClass = _classes[index];
+
+	if (threadCacheState != ThreadCacheState::DESTROYED)
+	{
+		ThreadCache& cache = threadCache();
+
+		if (cache.counts[index] > 0)
+		{
+			sizeClass.hits.fetch_add(1, std::memory_order_relaxed);
+			return cache.magazines[index][--cache.counts[index]];
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> locker(sizeClass.locker);
+
+		if (!sizeClass.depot.empty())
+		{
+			Block block = sizeClass.depot.back();
+			sizeClass.depot.pop_back();
+
+			if (sizeClass.depot.size() <= BUFFER_LOWER_LIMIT)
+				sizeClass.needed.store(true, std::memory_order_relaxed);
+
+			sizeClass.hits.fetch_add(1, std::memory_order_relaxed);
+			return block;
+		}
+	}
+
+	sizeClass.needed.store(true, std::memory_order_relaxed);
+	sizeClass.misses.fetch_add(1, std::memory_order_relaxed);
+
+	return allocate(classSize(index), index);
+}
+
+void FrameAllocator::release(Block& block)
+{
+	if (block.data == nullptr)
+		return;
+
+	if (block.sizeClass == NO_CLASS || !allocatorAlive)
+	{
+		deallocate(block);
+		return;
+	}
+
+	if (threadCacheState != ThreadCacheState::DESTROYED)
+	{
+		ThreadCache& cache = threadCache();
+
+		if (cache.counts[block.sizeClass] < MAGAZINE_SIZE)
+		{
+			cache.magazines[block.sizeClass][cache.counts[block.sizeClass]++] = block;
+			block = Block();
+			return;
+		}
+	}
+
+	pushToDepot(block);
+}
+
+bool FrameAllocator::setFrameSize(size_t size)
+{
+	const int index = classIndex(size);
+
+	return _frameClass.exchange(index) != index;
+}
+
+std::string FrameAllocator::adjustCache()
+{
+	std::stringstream ss;
+	std::vector<Block> trimmed;
+	bool info = false;
+	const int frameClass = _frameClass.load();
+
+	_epoch.fetch_add(1);
+
+	for (int index = 0; index < CLASS_COUNT; index++)
+	{
+		SizeClass& sizeClass = _classes[index];
+		const uint32_t hits = sizeClass.hits.exchange(0);
+		const uint32_t misses = sizeClass.misses.exchange(0);
+		const uint32_t dropped = sizeClass.dropped.exchange(0);
+		const bool needed = sizeClass.needed.exchange(false);
+		bool cleanup = false;
+		size_t cached = 0;
+
+		{
+			std::lock_guard<std::mutex> locker(sizeClass.locker);
+
+			// clean up the depot if neccesery: an idle class is released at once, except for the current video frame size
+			if (!needed && !sizeClass.prevNeeded && !sizeClass.depot.empty())
+			{
+				do
+				{
+					trimmed.push_back(sizeClass.depot.back());
+					sizeClass.depot.pop_back();
+				} while (hits == 0 && misses == 0 && index != frameClass && !sizeClass.depot.empty());
+
+				cleanup = true;
+				sizeClass.prevNeeded = true;
+			}
+			else
+				sizeClass.prevNeeded = needed;
+
+			cached = sizeClass.depot.size();
+
+			if (cached != sizeClass.prevCached || misses > 0 || cleanup)
+				info = true;
+
+			sizeClass.prevCached = cached;
+		}
+
+		if (hits > 0 || misses > 0 || cached > 0 || cleanup)
+		{
+			ss << " [" << std::fixed << std::setprecision(2) << classSize(index) / (1024.0 * 1024.0) << "MB"
+				<< ((index == frameClass) ? "*" : "")
+				<< ": size: " << cached << ", hits: " << hits << ", misses: " << misses
+				<< ", dropped: " << dropped << ", cleanup: " << cleanup << "]";
+		}
+	}
+
+	for (auto& block : trimmed)
+		deallocate(block);
+
+	if (info)
+		return "Video cache (limit: " + std::to_string(DEPOT_LIMIT) + "):" + ss.str();
+	else
+		return "";
+}
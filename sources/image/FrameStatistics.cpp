@@ -0,0 +1,201 @@
+/* FrameStatistics.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <algorithm>
+	#include <cmath>
+	#include <cstring>
+#endif
+
+#include <image/FrameStatistics.h>
+#include <image/Image.h>
+
+FrameStatistics::FrameStatistics(bool collectSourceRange) :
+	_width(0),
+	_height(0),
+	_collectSourceRange(collectSourceRange),
+	_hasSourceRange(false),
+	_tileStart{},
+	_tiles{},
+	_sourceRange{}
+{
+}
+
+void FrameStatistics::prepare(int width, int height)
+{
+	_width = std::max(width, 0);
+	_height = std::max(height, 0);
+	_hasSourceRange = false;
+	_sourceRange = {};
+
+	_tiles.fill(ColorRgb{});
+
+	for (int t = 0; t <= REGION_GRID; t++)
+		_tileStart[t] = (t * _width) / REGION_GRID;
+}
+
+bool FrameStatistics::collectSourceRange() const
+{
+	return _collectSourceRange;
+}
+
+void FrameStatistics::scanRow(int y, const uint8_t* rgbRow)
+{
+	if (y < 0 || y >= _height)
+		return;
+
+	// tile row boundaries follow floor(t * height / REGION_GRID), the same rounding as the column boundaries
+	const int tileRow = std::min((REGION_GRID * (y + 1) - 1) / _height, REGION_GRID - 1);
+	ColorRgb* tiles = &_tiles[static_cast<size_t>(tileRow) * REGION_GRID];
+
+	for (int t = 0; t < REGION_GRID; t++)
+	{
+		uint8_t red = tiles[t].red, green = tiles[t].green, blue = tiles[t].blue;
+
+		for (int x = _tileStart[t], end = _tileStart[t + 1]; x < end; x++, rgbRow += 3)
+		{
+			red = std::max(red, rgbRow[0]);
+			green = std::max(green, rgbRow[1]);
+			blue = std::max(blue, rgbRow[2]);
+		}
+
+		tiles[t] = ColorRgb(red, green, blue);
+	}
+}
+
+void FrameStatistics::scanImage(const Image<ColorRgb>& image)
+{
+	prepare(image.width(), image.height());
+
+	const uint8_t* source = image.rawMem();
+	const size_t lineSize = static_cast<size_t>(_width) * 3;
+
+	for (int y = 0; y < _height; y++, source += lineSize)
+		scanRow(y, source);
+}
+
+void FrameStatistics::scanSource_YUYV(int width, const uint8_t* currentSource)
+{
+	SourceRange range = _sourceRange;
+
+	for (const uint8_t* end = currentSource + static_cast<size_t>(width) * 2; currentSource < end; currentSource += 4)
+	{
+		range.y = std::max(std::max(currentSource[0], currentSource[2]), range.y);
+		range.u = std::max(currentSource[1], range.u);
+		range.v = std::max(currentSource[3], range.v);
+	}
+
+	_sourceRange = range;
+	_hasSourceRange = true;
+}
+
+void FrameStatistics::scanSource_Y_UV_8(int width, const uint8_t* currentSourceY, const uint8_t* currentSourceUV)
+{
+	SourceRange range = _sourceRange;
+
+	for (const uint8_t* end = currentSourceY + width; currentSourceY < end; currentSourceY++)
+		range.y = std::max(*currentSourceY, range.y);
+
+	for (const uint8_t* end = currentSourceUV + width; currentSourceUV < end; currentSourceUV += 2)
+	{
+		range.u = std::max(currentSourceUV[0], range.u);
+		range.v = std::max(currentSourceUV[1], range.v);
+	}
+
+	_sourceRange = range;
+	_hasSourceRange = true;
+}
+
+void FrameStatistics::scanSource_Y_UV_16(int width, const uint8_t* currentSourceY, const uint8_t* currentSourceUV)
+{
+	SourceRange range = _sourceRange;
+
+	// little endian 16-bit samples: only the most significant byte is relevant for the thresholds
+	for (const uint8_t* end = currentSourceY + static_cast<size_t>(width) * 2; currentSourceY < end; currentSourceY += 2)
+		range.y = std::max(currentSourceY[1], range.y);
+
+	for (const uint8_t* end = currentSourceUV + static_cast<size_t>(width) * 2; currentSourceUV < end; currentSourceUV += 4)
+	{
+		range.u = std::max(currentSourceUV[1], range.u);
+		range.v = std::max(currentSourceUV[3], range.v);
+	}
+
+	_sourceRange = range;
+	_hasSourceRange = true;
+}
+
+bool FrameStatistics::matches(unsigned width, unsigned height) const
+{
+	return _width > 0 && _height > 0 && static_cast<unsigned>(_width) == width && static_cast<unsigned>(_height) == height;
+}
+
+int FrameStatistics::width() const
+{
+	return _width;
+}
+
+int FrameStatistics::height() const
+{
+	return _height;
+}
+
+bool FrameStatistics::regionMax(double xMin, double yMin, double xMax, double yMax, ColorRgb& result) const
+{
+	// the region must match the tile grid exactly, otherwise the caller has to scan the image by itself
+	auto toTile = [](double frac, int& tile) -> bool {
+		const double scaled = frac * REGION_GRID;
+		tile = static_cast<int>(std::lround(scaled));
+		return std::abs(scaled - tile) < 1e-6 && tile >= 0 && tile <= REGION_GRID;
+	};
+
+	int x1, y1, x2, y2;
+	if (!toTile(xMin, x1) || !toTile(yMin, y1) || !toTile(xMax, x2) || !toTile(yMax, y2) || x1 >= x2 || y1 >= y2)
+		return false;
+
+	ColorRgb maxColor{};
+	for (int ty = y1; ty < y2; ty++)
+		for (int tx = x1; tx < x2; tx++)
+		{
+			const ColorRgb& tile = _tiles[static_cast<size_t>(ty) * REGION_GRID + tx];
+			maxColor.red = std::max(maxColor.red, tile.red);
+			maxColor.green = std::max(maxColor.green, tile.green);
+			maxColor.blue = std::max(maxColor.blue, tile.blue);
+		}
+
+	result = maxColor;
+	return true;
+}
+
+bool FrameStatistics::hasSourceRange() const
+{
+	return _hasSourceRange;
+}
+
+FrameStatistics::SourceRange FrameStatistics::sourceRange() const
+{
+	return _sourceRange;
+}
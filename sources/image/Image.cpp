@@ -27,13 +27,15 @@
 
 
 #include <image/Image.h>
+#include <image/FrameStatistics.h>
 #include <cstring>
 #include <utils/PixelFormat.h>
 #include <fstream>
 
 template <typename ColorSpace>
 Image<ColorSpace>::Image() :
-	Image(1, 1)
+	_sharedData(sharedEmptyData()),
+	_pixelFormat(PixelFormat::NO_CHANGE)
 {
 }
 
@@ -47,7 +49,9 @@ Image<ColorSpace>::Image(unsigned width, unsigned height) :
 template <typename ColorSpace>
 Image<ColorSpace>::Image(const Image<ColorSpace>& other) :
 	_sharedData(other._sharedData),
-	_pixelFormat(other._pixelFormat)
+	_statistics(other._statistics),
+	_pixelFormat(other._pixelFormat),
+	_frameTiming(other._frameTiming)
 {
 }
 
@@ -55,7 +59,9 @@ template <typename ColorSpace>
 Image<ColorSpace>& Image<ColorSpace>::operator=(const Image<ColorSpace>& other)
 {
 	_sharedData = other._sharedData;
+	_statistics = other._statistics;
 	_pixelFormat = other._pixelFormat;
+	_frameTiming = other._frameTiming;
 	return *this;
 }
 
@@ -64,9 +70,34 @@ Image<ColorSpace>& Image<ColorSpace>::operator=(Image<ColorSpace>&& other) noexc
 {
 	_pixelFormat = other._pixelFormat;
 	_sharedData = std::move(other._sharedData);
+	_statistics = std::move(other._statistics);
+	_frameTiming = other._frameTiming;
 	return *this;
 }
 
+template <typename ColorSpace>
+const std::shared_ptr<ImageData<ColorSpace>>& Image<ColorSpace>::sharedEmptyData()
+{
+	// default constructed images share one black 1x1 frame instead of allocating their own
+	static const std::shared_ptr<ImageData<ColorSpace>> empty = []() {
+		std::shared_ptr<ImageData<ColorSpace>> data(new ImageData<ColorSpace>(1, 1));
+		data->clear();
+		return data;
+	}();
+
+	return empty;
+}
+
+template <typename ColorSpace>
+void Image<ColorSpace>::makeWritable()
+{
+	if (_sharedData == sharedEmptyData())
+	{
+		_sharedData.reset(new ImageData<ColorSpace>(1, 1));
+		_sharedData->clear();
+	}
+}
+
 template <typename ColorSpace>
 std::string Image<ColorSpace>::adjustCache()
 {
@@ -88,18 +119,24 @@ bool Image<ColorSpace>::checkSignal(int x, int y, int r, int g, int b, int toler
 template <typename ColorSpace>
 void Image<ColorSpace>::fastBox(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint8_t r, uint8_t g, uint8_t b)
 {
+	_statistics.reset();
+	makeWritable();
 	_sharedData->fastBox(x1, y1, x2, y2, r, g, b);
 }
 
 template <typename ColorSpace>
 void Image<ColorSpace>::gradientHBox(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint8_t r, uint8_t g, uint8_t b)
 {
+	_statistics.reset();
+	makeWritable();
 	_sharedData->gradientHBox(x1, y1, x2, y2, r, g, b);
 }
 
 template <typename ColorSpace>
 void Image<ColorSpace>::gradientVBox(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint8_t r, uint8_t g, uint8_t b)
 {
+	_statistics.reset();
+	makeWritable();
 	_sharedData->gradientVBox(x1, y1, x2, y2, r, g, b);
 }
 
@@ -107,6 +144,9 @@ void Image<ColorSpace>::gradientVBox(uint16_t x1, uint16_t y1, uint16_t x2, uint
 template <typename ColorSpace>
 void Image<ColorSpace>::insertHorizontal(int x, Image<ColorSpace>& source)
 {
+	_statistics.reset();
+	makeWritable();
+
 	int copyX = ((x + source.width()) > width()) ? width() - x : source.width();
 	int copyY = std::min(source.height(), height());
 	uint8_t* dest = rawMem() + sizeof(ColorSpace) * x;
@@ -143,18 +183,27 @@ const ColorSpace& Image<ColorSpace>::operator()(unsigned x, unsigned y) const
 template <typename ColorSpace>
 ColorSpace& Image<ColorSpace>::operator()(unsigned x, unsigned y)
 {
+	makeWritable();
 	return _sharedData->operator()(x, y);
 }
 
 template <typename ColorSpace>
 void Image<ColorSpace>::resize(unsigned width, unsigned height)
 {
+	if (_sharedData == sharedEmptyData())
+	{
+		if (width != 1 || height != 1)
+			_sharedData.reset(new ImageData<ColorSpace>(width, height));
+		return;
+	}
+
 	_sharedData->resize(width, height);
 }
 
 template <typename ColorSpace>
 uint8_t* Image<ColorSpace>::rawMem()
 {
+	makeWritable();
 	return _sharedData->rawMem();
 }
 
@@ -173,7 +222,10 @@ size_t Image<ColorSpace>::size() const
 template <typename ColorSpace>
 void Image<ColorSpace>::clear()
 {
-	_sharedData->clear();
+	_statistics.reset();
+
+	if (_sharedData != sharedEmptyData())
+		_sharedData->clear();
 }
 
 template <typename ColorSpace>
@@ -199,4 +251,31 @@ PixelFormat Image<ColorSpace>::getOriginFormat() const
 	return _pixelFormat;
 }
 
+template <typename ColorSpace>
+void Image<ColorSpace>::setStatistics(std::shared_ptr<const FrameStatistics> statistics)
+{
+	_statistics = std::move(statistics);
+}
+
+template <typename ColorSpace>
+const FrameStatistics* Image<ColorSpace>::getStatistics() const
+{
+	if (_statistics != nullptr && _statistics->matches(width(), height()))
+		return _statistics.get();
+
+	return nullptr;
+}
+
+template <typename ColorSpace>
+void Image<ColorSpace>::setFrameTiming(const FrameTiming& timing)
+{
+	_frameTiming = timing;
+}
+
+template <typename ColorSpace>
+const FrameTiming& Image<ColorSpace>::getFrameTiming() const
+{
+	return _frameTiming;
+}
+
 template class Image<ColorRgb>;
@@ -36,7 +36,7 @@
 #endif
 
 #include <image/ImageData.h>
-#include <image/VideoMemoryManager.h>
+#include <image/FrameAllocator.h>
 
 #define LOCAL_VID_ALIGN_SIZE       16
 
@@ -46,7 +46,6 @@ template <typename ColorSpace>
 ImageData<ColorSpace>::ImageData(unsigned width, unsigned height) :
 	_width(width),
 	_height(height),
-	_memoryBuffer(nullptr),
 	_pixels(nullptr)
 {
 	getMemory(width, height);
@@ -55,8 +54,8 @@ ImageData<ColorSpace>::ImageData(unsigned width, unsigned height) :
 template <typename ColorSpace>
 bool ImageData<ColorSpace>::setBufferCacheSize()
 {
-	if (_memoryBuffer != nullptr)
-		return VideoMemoryManager::videoCache.setFrameSize(_memoryBuffer->size());
+	if (_block.data != nullptr)
+		return FrameAllocator::frameCache.setFrameSize(_block.size);
 	else
 		return false;
 }
@@ -154,7 +153,7 @@ bool ImageData<ColorRgb>::checkSignal(int x, int y, int r, int g, int b, int tol
 template <typename ColorSpace>
 std::string ImageData<ColorSpace>::adjustCache()
 {
-	return VideoMemoryManager::videoCache.adjustCache();
+	return FrameAllocator::frameCache.adjustCache();
 }
 
 template <typename ColorSpace>
@@ -167,14 +166,14 @@ template <typename ColorSpace>
 inline void ImageData<ColorSpace>::getMemory(size_t width, size_t height)
 {
 	size_t neededSize = width * height * sizeof(ColorSpace) + LOCAL_VID_ALIGN_SIZE;
-	_memoryBuffer = VideoMemoryManager::videoCache.request(neededSize);
-	_pixels = _memoryBuffer->data();
+	_block = FrameAllocator::frameCache.request(neededSize);
+	_pixels = _block.data;
 }
 
 template <typename ColorSpace>
 inline void ImageData<ColorSpace>::freeMemory()
 {
-	VideoMemoryManager::videoCache.release(_memoryBuffer);
+	FrameAllocator::frameCache.release(_block);
 	_pixels = nullptr;
 }
 
@@ -28,6 +28,7 @@
 #include <infinite-color-engine/CoreInfiniteEngine.h>
 #include <infinite-color-engine/InfiniteSmoothing.h>
 #include <base/HyperHdrInstance.h>
+#include <performance-counters/PerformanceTracer.h>
 
 using namespace hyperhdr;
 using namespace ColorSpaceMath;
@@ -40,6 +41,7 @@ CoreInfiniteEngine::CoreInfiniteEngine(HyperHdrInstance* hyperhdr)
 	_log(QString("ENGINE%1").arg(hyperhdr->getInstanceIndex()))
 {
 	qRegisterMetaType<SharedOutputColors>("SharedOutputColors");
+	qRegisterMetaType<FrameTiming>("FrameTiming");
 	connect(hyperhdr, &HyperHdrInstance::SignalInstanceSettingsChanged, _smoothing.get(), &InfiniteSmoothing::handleSignalInstanceSettingsChanged);
 	connect(hyperhdr, &HyperHdrInstance::SignalRequestComponent, _smoothing.get(), &InfiniteSmoothing::handleSignalRequestComponent);
 	connect(hyperhdr, &HyperHdrInstance::SignalSmoothingClockTick, _smoothing.get(), &InfiniteSmoothing::SignalMasterClockTick, static_cast<Qt::ConnectionType>(Qt::DirectConnection | Qt::UniqueConnection));
@@ -67,10 +69,13 @@ void CoreInfiniteEngine::setCurrentSmoothingConfigParams(unsigned cfgID)
 	_smoothing->setCurrentSmoothingConfigParams(cfgID);
 }
 
-void CoreInfiniteEngine::incomingColors(std::vector<float3>&& _ledBuffer)
+void CoreInfiniteEngine::incomingColors(std::vector<float3>&& _ledBuffer, const FrameTiming& timing)
 {
-	_processing->applyyAllProcessingSteps(_ledBuffer);
-	_smoothing->incomingColors(std::move(_ledBuffer), _processing->getMinimalBacklight());
+	{
+		PerformanceTracer::Scope trace(PerformanceTracer::Stage::PROCESSING);
+		_processing->applyyAllProcessingSteps(_ledBuffer);
+	}
+	_smoothing->incomingColors(std::move(_ledBuffer), _processing->getMinimalBacklight(), timing);
 }
 
 void CoreInfiniteEngine::setProcessingEnabled(bool enabled)
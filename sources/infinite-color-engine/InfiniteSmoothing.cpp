@@ -51,6 +51,7 @@
 #include <infinite-color-engine/InfiniteHybridRgbInterpolator.h>
 #include <infinite-color-engine/InfiniteExponentialInterpolator.h>
 #include <base/HyperHdrInstance.h>
+#include <performance-counters/PerformanceTracer.h>
 
 using namespace hyperhdr;
 using namespace linalg::aliases;
@@ -217,7 +218,7 @@ void InfiniteSmoothing::handleSignalInstanceSettingsChanged(settings::type type,
 	}
 }
 
-void InfiniteSmoothing::incomingColors(std::vector<float3>&& nonlinearRgbColors, std::optional<float> minimalBacklight)
+void InfiniteSmoothing::incomingColors(std::vector<float3>&& nonlinearRgbColors, std::optional<float> minimalBacklight, const FrameTiming& timing)
 {
 	_minimalBacklight = (minimalBacklight.has_value()) ? minimalBacklight.value() : 0.f;
 
@@ -233,7 +234,7 @@ void InfiniteSmoothing::incomingColors(std::vector<float3>&& nonlinearRgbColors,
 
 	if (!isEnabled())
 	{
-		queueColors(std::make_shared<std::vector<float3>>(std::move(nonlinearRgbColors)));
+		queueColors(std::make_shared<std::vector<float3>>(std::move(nonlinearRgbColors)), timing);
 		return;
 	}	
 
@@ -243,12 +244,15 @@ void InfiniteSmoothing::incomingColors(std::vector<float3>&& nonlinearRgbColors,
 
 		auto nowTime = InternalClock::now();
 		_interpolator->setTargetColors(std::move(nonlinearRgbColors), nowTime, false);
+		_targetTiming = timing;
 	}
 }
 
 void InfiniteSmoothing::updateLeds()
 {	
+	PerformanceTracer::Scope trace(PerformanceTracer::Stage::SMOOTHING);
 	SharedOutputColors nonlinearRgbColors;
+	FrameTiming timing;
 	bool finished = false;
 	long long timeNow = 0;
 	// critical section
@@ -261,6 +265,7 @@ void InfiniteSmoothing::updateLeds()
 		_interpolator->updateCurrentColors(timeNow, _minimalBacklight);
 
 		nonlinearRgbColors = _interpolator->getCurrentColors(_minimalBacklight);
+		timing = _targetTiming;
 
 		if (!_interpolator->isAnimationComplete())
 		{
@@ -278,16 +283,16 @@ void InfiniteSmoothing::updateLeds()
 	if (!nonlinearRgbColors->empty() && !finished)
 	{
 		_lastSentFrame = timeNow;
-		queueColors(std::move(nonlinearRgbColors));
+		queueColors(std::move(nonlinearRgbColors), timing);
 	}
 }
 
-void InfiniteSmoothing::queueColors(SharedOutputColors&& nonlinearRgbLedColors)
+void InfiniteSmoothing::queueColors(SharedOutputColors&& nonlinearRgbLedColors, const FrameTiming& timing)
 {
 	if (nonlinearRgbLedColors->empty())
 		return;
 
-	emit SignalProcessedColors(nonlinearRgbLedColors);
+	emit SignalProcessedColors(nonlinearRgbLedColors, timing);
 }
 
 void InfiniteSmoothing::handleSignalRequestComponent(hyperhdr::Components component, bool state)
@@ -1,6 +1,7 @@
 // project includes
 #include <jsonserver/JsonClientConnection.h>
 #include <api/HyperAPI.h>
+#include <utils/NetIoPool.h>
 
 // qt inc
 #include <QTcpSocket>
@@ -25,6 +26,8 @@ JsonClientConnection::JsonClientConnection(QTcpSocket* socket, bool localConnect
 
 void JsonClientConnection::readRequest()
 {
+	NetIoPool::BusyScope busyScope;
+
 	_receiveBuffer += _socket->readAll();
 	// raw socket data, handling as usual
 	int bytes = _receiveBuffer.indexOf('\n') + 1;
@@ -7,9 +7,11 @@
 #include <jsonserver/JsonClientConnection.h>
 
 #include <utils/NetOrigin.h>
+#include <utils/NetIoPool.h>
 #include <api/HyperAPI.h>
 
 // qt includes
+#include <QCoreApplication>
 #include <QTcpServer>
 #include <QTcpSocket>
 #include <QJsonDocument>
@@ -21,6 +23,7 @@ JsonServer::JsonServer(std::shared_ptr<NetOrigin> netOrigin, const QJsonDocument
 	, _openConnections()
 	, _log("JSONSERVER")
 	, _netOrigin(netOrigin)
+	, _ioPool(NetIoPool::getInstance())
 	, _port(0)
 {
 	Debug(_log, "Created new instance");
@@ -35,7 +38,14 @@ JsonServer::JsonServer(std::shared_ptr<NetOrigin> netOrigin, const QJsonDocument
 JsonServer::~JsonServer()
 {
 	Debug(_log, "The instance is deleted");
-	qDeleteAll(_openConnections);
+	_server->close();
+
+	// the connections live in the I/O threads: wait for the pending ones and delete them there
+	_ioPool->synchronize();
+	QCoreApplication::sendPostedEvents(this);
+	for (JsonClientConnection* connection : _openConnections)
+		NetIoPool::execute(connection, [connection]() { delete connection; });
+	_openConnections.clear();
 }
 
 void JsonServer::start()
@@ -89,11 +99,17 @@ void JsonServer::newConnection()
 			if (_netOrigin->accessAllowed(socket->peerAddress(), socket->localAddress()))
 			{
 				Debug(_log, "New connection from: {:s} ", socket->localAddress().toString().toStdString().c_str());
-				JsonClientConnection* connection = new JsonClientConnection(socket, _netOrigin->isLocalAddress(socket->peerAddress(), socket->localAddress()));
-				_openConnections.insert(connection);
+				bool localConnection = _netOrigin->isLocalAddress(socket->peerAddress(), socket->localAddress());
+
+				// the client and its API are created in the I/O thread that owns the socket from now on
+				_ioPool->adopt(socket, [this, socket, localConnection]() {
+					JsonClientConnection* connection = new JsonClientConnection(socket, localConnection);
+					socket->setParent(connection);
 
-				// register slot for cleaning up after the connection closed
-				connect(connection, &JsonClientConnection::SignalClientConnectionClosed, this, &JsonServer::signalClientConnectionClosedHandler);
+					// register slot for cleaning up after the connection closed
+					connect(connection, &JsonClientConnection::SignalClientConnectionClosed, this, &JsonServer::signalClientConnectionClosedHandler);
+					QMetaObject::invokeMethod(this, [this, connection]() { signalClientConnectionOpenedHandler(connection); }, Qt::QueuedConnection);
+				});
 			}
 			else
 				socket->close();
@@ -101,6 +117,11 @@ void JsonServer::newConnection()
 	}
 }
 
+void JsonServer::signalClientConnectionOpenedHandler(JsonClientConnection* client)
+{
+	_openConnections.insert(client);
+}
+
 void JsonServer::signalClientConnectionClosedHandler(JsonClientConnection* client)
 {
 	if (client != nullptr)
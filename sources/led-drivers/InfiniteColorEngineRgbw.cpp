@@ -56,28 +56,55 @@ void InfiniteColorEngineRgbw::renderRgbwFrame(const std::vector<float3>& infinit
 	if (output.size() < wanted)
 		output.resize(wanted, 0x00);
 
+	if (tables.whiteMixerThreshold != whiteMixerThreshold || tables.whiteLedIntensity != whiteLedIntensity || tables.whitePointRgb != whitePointRgb)
+	{
+		compileOutputTables(whiteMixerThreshold, whiteLedIntensity, whitePointRgb);
+	}
+
 	auto colorIt = infiniteColors.cbegin();
 	auto stateIt = states.begin();
 
-	const float whiteMixerThreshold255 = whiteMixerThreshold * 255.0f;
 	constexpr double motionThreshold = 0.01 / 255.0;
 
 	float actualMotionThreshold = (currentInterval > 0 && currentInterval < 17) ? motionThreshold * (currentInterval / 17.0): motionThreshold;
-	bool customWhite = linalg::minelem(whitePointRgb) < 0.99999f || linalg::maxelem(whitePointRgb) > 1.00001f;
-	float invWhiteMixerMian255 = (255.0f - whiteMixerThreshold255);
-	invWhiteMixerMian255 = (invWhiteMixerMian255 > denom) ? 1.0f / invWhiteMixerMian255 : 0.0f;
 
 	for (; colorIt != infiniteColors.cend(); ++colorIt, ++stateIt)
 	{
-		byte4 led = (customWhite) ? encodeRgbwFrame<true>(*colorIt, *stateIt, actualMotionThreshold, invWhiteMixerMian255, whiteMixerThreshold255, whiteLedIntensity, whitePointRgb, colorOrder):
-									encodeRgbwFrame<false>(*colorIt, *stateIt, actualMotionThreshold, invWhiteMixerMian255, whiteMixerThreshold255, whiteLedIntensity, whitePointRgb, colorOrder);
+		byte4 led = (tables.customWhite) ? encodeRgbwFrame<true>(*colorIt, *stateIt, actualMotionThreshold, colorOrder):
+										encodeRgbwFrame<false>(*colorIt, *stateIt, actualMotionThreshold, colorOrder);
 		std::memcpy(output.data() + writeIndex, &led, sizeof(led));
 		writeIndex += sizeof(led);
 	}
 }
 
+void InfiniteColorEngineRgbw::compileOutputTables(const float whiteMixerThreshold, const float whiteLedIntensity, const float3& whitePointRgb)
+{
+	tables.whiteMixerThreshold = whiteMixerThreshold;
+	tables.whiteLedIntensity = whiteLedIntensity;
+	tables.whitePointRgb = whitePointRgb;
+
+	tables.whiteEnabled = whiteLedIntensity > denom;
+	tables.customWhite = linalg::minelem(whitePointRgb) < 0.99999f || linalg::maxelem(whitePointRgb) > 1.00001f;
+	tables.whiteStep = (tables.customWhite) ? whitePointRgb * whiteLedIntensity : float3{ whiteLedIntensity };
+	tables.whiteLevel.assign(OutputTables::WHITE_TABLE_SIZE, 0.0f);
+
+	if (!tables.whiteEnabled)
+		return;
+
+	const float whiteMixerThreshold255 = whiteMixerThreshold * 255.0f;
+	float invWhiteMixerMian255 = (255.0f - whiteMixerThreshold255);
+	invWhiteMixerMian255 = (invWhiteMixerMian255 > denom) ? 1.0f / invWhiteMixerMian255 : 0.0f;
+
+	for (int i = 0; i < OutputTables::WHITE_TABLE_SIZE; i++)
+	{
+		const float common = static_cast<float>(i) / OutputTables::WHITE_TABLE_SCALE;
+		const float w_factor = (invWhiteMixerMian255 > denom) ? std::clamp((common - whiteMixerThreshold255) * invWhiteMixerMian255, 0.0f, 1.0f) : 1.0f;
+		tables.whiteLevel[i] = std::round(common * w_factor / whiteLedIntensity);
+	}
+}
+
 template<bool CustomWhiteTemp>
-byte4 InfiniteColorEngineRgbw::encodeRgbwFrame(const float3& rgbCalibrated, LEDState& state, const float motionThreshold, const float invWhiteMixerMian255, const float whiteMixerThreshold255, const float whiteLedIntensity, const float3& whitePointRgb, LedString::ColorOrder colorOrder)
+byte4 InfiniteColorEngineRgbw::encodeRgbwFrame(const float3& rgbCalibrated, LEDState& state, const float motionThreshold, LedString::ColorOrder colorOrder)
 {
 	auto signFun = [](float x) noexcept {
 		return (x > 0) - (x < 0);
@@ -102,14 +129,12 @@ byte4 InfiniteColorEngineRgbw::encodeRgbwFrame(const float3& rgbCalibrated, LEDS
 
 	const float3 input255 = (enableDithering) ? rgbCalibrated * 255.0f + state.error : rgbCalibrated * 255.0f;
 	float4 target4;
-	if (whiteLedIntensity > denom)
+	if (tables.whiteEnabled)
 	{
-		const float common = (CustomWhiteTemp) ? linalg::minelem(input255 * whitePointRgb) : linalg::minelem(input255);		
-		const float w_factor = (invWhiteMixerMian255 > denom) ? std::clamp((common - whiteMixerThreshold255) * invWhiteMixerMian255, 0.0f, 1.0f) : 1.0f;
-		const float base_w_amount = common * w_factor;
-		const float w_output = std::round(base_w_amount / whiteLedIntensity);
-		const float3 rgbSub = (CustomWhiteTemp) ? (whitePointRgb * w_output * whiteLedIntensity) : float3{ w_output * whiteLedIntensity };
-		const float3 targetRgb = (w_output != 0.0f) ? input255 - rgbSub : input255;
+		const float common = (CustomWhiteTemp) ? linalg::minelem(input255 * tables.whitePointRgb) : linalg::minelem(input255);
+		const int whiteIndex = std::clamp(static_cast<int>(common * OutputTables::WHITE_TABLE_SCALE + 0.5f), 0, OutputTables::WHITE_TABLE_SIZE - 1);
+		const float w_output = tables.whiteLevel[whiteIndex];
+		const float3 targetRgb = (w_output != 0.0f) ? input255 - tables.whiteStep * w_output : input255;
 		target4 = float4(targetRgb.x, targetRgb.y, targetRgb.z, w_output);
 	}
 	else {
@@ -33,15 +33,24 @@
 
 	#include <sstream>
 	#include <iomanip>
+	#include <cmath>
 #endif
 
 #include <led-drivers/LedDevice.h>
 #include <base/HyperHdrInstance.h>
 #include <utils/GlobalSignals.h>
 #include <infinite-color-engine/ColorSpace.h>
+#include <performance-counters/PerformanceTracer.h>
 
 std::atomic<bool> LedDevice::_signalTerminate(false);
 
+namespace
+{
+	constexpr int PACER_UPDATE_PERIOD = 1000;
+	constexpr int PACER_MAX_INTERVAL = 1000;
+	constexpr double PACER_HEADROOM = 1.25;
+}
+
 LedDevice::LedDevice(const QJsonObject& deviceConfig, QObject* parent)
 	: QObject(parent)
 	, _devConfig(deviceConfig)
@@ -69,9 +78,15 @@ LedDevice::LedDevice(const QJsonObject& deviceConfig, QObject* parent)
 	, _isRefreshEnabled(false)
 	, _newFrame2Send(false)
 	, _lastFinityLedValues(std::make_shared<std::vector<linalg::aliases::float3>>())
+	, _outputSliceOffset(0)
+	, _outputSliceCount(0)
+	, _isAdditionalOutput(false)
+	, _lastWrittenSequence(0)
+	, _outputWritePending(false)
 	, _blinkIndex(-1)
 	, _blinkTime(0)
 	, _instanceIndex(-1)
+	, _outputIndex(0)
 	, _pauseRetryTimer(-1)
 {
 	std::shared_ptr<DiscoveryWrapper> discoveryWrapper = nullptr;
@@ -168,9 +183,10 @@ bool LedDevice::powerOn()
 	return rc;
 }
 
-void LedDevice::setInstanceIndex(int instanceIndex)
+void LedDevice::setInstanceIndex(int instanceIndex, int outputIndex)
 {
 	_instanceIndex = instanceIndex;
+	_outputIndex = outputIndex;
 	_log = QString("LEDDEVICE%1_%2").arg(_instanceIndex).arg(_activeDeviceType.toUpper());
 }
 
@@ -373,6 +389,15 @@ bool LedDevice::init(QJsonObject deviceConfig)
 	_smoothingInterval = deviceConfig["smoothingRefreshTime"].toInt(0);
 	_antiFlickeringFilter = deviceConfig["smoothingAntiFlickeringFilter"].toBool(false);
 	Debug(_log, "SetAntiFlickeringFilter: {:s}", ((_antiFlickeringFilter) ? "enabled" : "disabled"));
+	_pacer.enabled = deviceConfig["adaptivePacing"].toBool(false);
+	Debug(_log, "Adaptive pacing: {:s}", ((_pacer.enabled) ? "enabled" : "disabled"));
+
+	// properties injected when the device drives only a range of the LED layout of the instance
+	_outputSliceOffset = std::max(deviceConfig["outputSliceOffset"].toInt(0), 0);
+	_outputSliceCount = std::max(deviceConfig["outputSliceCount"].toInt(0), 0);
+	_isAdditionalOutput = deviceConfig["additionalOutput"].toBool(false);
+	if (_outputSliceCount > 0)
+		Debug(_log, "Output slice: LEDs {:d}-{:d}", _outputSliceOffset, _outputSliceOffset + _outputSliceCount - 1);
 
 	setLedCount(deviceConfig["currentLedCount"].toInt(1)); // property injected to reflect real led count
 	setRefreshTime(deviceConfig["refreshTime"].toInt(_currentInterval));
@@ -384,19 +409,26 @@ void LedDevice::startRefreshTimer()
 {
 	if (_isDeviceReady && _isEnabled && _currentInterval > 0)
 	{
+		// only the main device clocks the smoothing: an additional output writes the latest smoothed frame, paced by its own write time
+		if (isClockedByMainDevice())
+		{
+			Debug(_log, "The smoothing is clocked by the main device, the refresh timer is not needed");
+			return;
+		}
+
 		// setup refreshTimer
 		if (_refreshTimer == nullptr)
 		{
 			_refreshTimer = new QTimer(this);
 			_refreshTimer->setTimerType(Qt::PreciseTimer);
-			_refreshTimer->setInterval(_currentInterval);
+			_refreshTimer->setInterval(pacedInterval());
 			if (_smoothingInterval > 0)
 				connect(_refreshTimer, &QTimer::timeout, this, &LedDevice::SignalSmoothingClockTick, Qt::UniqueConnection);
 			else
 				connect(_refreshTimer, &QTimer::timeout, this, &LedDevice::rewriteLEDs, Qt::UniqueConnection);
 		}
 		else
-			_refreshTimer->setInterval(_currentInterval);
+			_refreshTimer->setInterval(pacedInterval());
 
 		Debug(_log, "Starting timer with interval = {:d}ms", _refreshTimer->interval());
 
@@ -452,6 +484,7 @@ void LedDevice::setRefreshTime(int userInterval)
 	}
 
 	_currentInterval = qMax(selectedInterval, 0);
+	_pacer.reset();
 
 	if (_currentInterval > 0)
 	{
@@ -476,6 +509,62 @@ int LedDevice::hasLedClock()
 	return _forcedInterval;
 }
 
+bool LedDevice::isClockedByMainDevice() const
+{
+	return _isAdditionalOutput && _smoothingInterval > 0;
+}
+
+int LedDevice::pacedInterval() const
+{
+	return std::max(_currentInterval, _pacer.interval);
+}
+
+void LedDevice::reportTransportWriteTime(qint64 writeTimeUs)
+{
+	_pacer.transportWriteTime = std::max(writeTimeUs, qint64(0));
+}
+
+void LedDevice::updatePacer(qint64 writeTimeUs)
+{
+	const double writeTime = writeTimeUs / 1000.0;
+	const int64_t now = InternalClock::now();
+
+	_pacer.writeTime = (_pacer.samples++ == 0) ? writeTime : _pacer.writeTime * 0.9 + writeTime * 0.1;
+
+	if (_refreshTimer == nullptr || _currentInterval <= 0 || now - _pacer.lastUpdate < PACER_UPDATE_PERIOD)
+		return;
+
+	_pacer.lastUpdate = now;
+
+	// the clock (and the smoothing) follows the rate the device can sustain, so the frames are skipped at the source
+	// instead of being computed and waiting for the device. Some headroom is left for the rest of the device thread.
+	const int sustainable = static_cast<int>(std::ceil(_pacer.writeTime * PACER_HEADROOM));
+	const int target = std::clamp(sustainable, _currentInterval, std::max(_currentInterval, PACER_MAX_INTERVAL));
+	const int current = _refreshTimer->interval();
+
+	if (std::abs(target - current) >= std::max(current / 10, 1))
+	{
+		_pacer.interval = target;
+		_refreshTimer->setInterval(target);
+		Info(_log, "Adaptive pacing: refresh rate set to {:.2f} Hz (write time = {:.1f}ms, configured = {:.2f} Hz)",
+			1000.0 / target, _pacer.writeTime, 1000.0 / _currentInterval);
+	}
+}
+
+QJsonObject LedDevice::getPacingInfo()
+{
+	QJsonObject info;
+	const int interval = (_isRefreshEnabled) ? pacedInterval() : 0;
+
+	info["enabled"] = _pacer.enabled;
+	info["configuredInterval"] = _currentInterval;
+	info["interval"] = interval;
+	info["refreshRate"] = (interval > 0) ? 1000.0 / interval : 0.0;
+	info["writeTime"] = _pacer.writeTime;
+
+	return info;
+}
+
 void LedDevice::smoothingRestarted(int newSmoothingInterval, bool antiflickeringfilter)
 {
 	if (_smoothingInterval != newSmoothingInterval)
@@ -493,7 +582,7 @@ void LedDevice::smoothingRestarted(int newSmoothingInterval, bool antiflickering
 	}
 }
 
-void LedDevice::handleSignalFinalOutputColorsReady(SharedOutputColors infinityLedColors)
+void LedDevice::handleSignalFinalOutputColorsReady(SharedOutputColors infinityLedColors, FrameTiming timing)
 {
 	if (infinityLedColors == nullptr || infinityLedColors->empty())
 		return;
@@ -512,7 +601,7 @@ void LedDevice::handleSignalFinalOutputColorsReady(SharedOutputColors infinityLe
 	{
 		if (_isRefreshEnabled && _currentInterval > 0)
 		{
-			qint64 wanted = (1000.0/_currentInterval) * 60.0 * diff / 60000.0;
+			qint64 wanted = (1000.0/pacedInterval()) * 60.0 * diff / 60000.0;
 			_computeStats.droppedFrames = std::max(wanted - _computeStats.frames - 1, 0ll);
 		}
 
@@ -532,9 +621,18 @@ void LedDevice::handleSignalFinalOutputColorsReady(SharedOutputColors infinityLe
 	}
 	else
 	{
-		_lastLedValues = infinityLedColors;
+		_lastLedValues = (_outputSliceCount > 0) ? sliceOutputColors(infinityLedColors) : infinityLedColors;
+		_lastLedTiming = timing;
 
-		if (!_isRefreshEnabled)
+		if (_isRefreshEnabled && isClockedByMainDevice())
+		{
+			// clocked by the main device: the latest frame wins, one write is pending at a time
+			if (_newFrame2Send)
+				_computeStats.droppedFrames++;
+			_newFrame2Send = true;
+			scheduleOutputWrite();
+		}
+		else if (!_isRefreshEnabled)
 		{
 			if (_newFrame2Send)
 				_computeStats.droppedFrames++;
@@ -546,6 +644,28 @@ void LedDevice::handleSignalFinalOutputColorsReady(SharedOutputColors infinityLe
 	}
 }
 
+void LedDevice::scheduleOutputWrite()
+{
+	if (_outputWritePending)
+		return;
+
+	_outputWritePending = true;
+
+	// the next write starts when the previous one, at the measured write time of this output, would have finished
+	const int64_t due = _pacer.lastWrite + static_cast<int64_t>(std::ceil(_pacer.writeTime * PACER_HEADROOM));
+	const int64_t wait = std::clamp(due - InternalClock::now(), int64_t(0), int64_t(PACER_MAX_INTERVAL));
+
+	QTimer::singleShot(static_cast<int>(wait), Qt::PreciseTimer, this, &LedDevice::writePendingOutputFrame);
+}
+
+void LedDevice::writePendingOutputFrame()
+{
+	_outputWritePending = false;
+
+	if (_newFrame2Send)
+		rewriteLEDs();
+}
+
 int LedDevice::rewriteLEDs()
 {
 	using namespace linalg::aliases;
@@ -558,11 +678,12 @@ int LedDevice::rewriteLEDs()
 	{
 		_newFrame2Send = false;
 
+		// the colors can be shared with the other outputs of the instance: they are never modified in place
 		auto copy = _lastLedValues;
 
 		if (_signalTerminate)
 		{			
-			std::fill(copy->begin(), copy->end(), float3{ 0.0f, 0.0f, 0.0f });
+			copy = std::make_shared<std::vector<float3>>(copy->size(), float3{ 0.0f, 0.0f, 0.0f });
 		}
 		else if (_blinkIndex >= 0)
 		{
@@ -571,14 +692,30 @@ int LedDevice::rewriteLEDs()
 				_blinkIndex = -1;
 			else
 			{
-				std::fill(copy->begin(), copy->end(), float3{ 0.0f, 0.0f, 0.0f });
+				copy = std::make_shared<std::vector<float3>>(copy->size(), float3{ 0.0f, 0.0f, 0.0f });
 				(*copy)[_blinkIndex] = (_blinkTime + 1500 > now) ? float3{ 1.0f, 0.0f, 0.0f } : (_blinkTime + 3000 > now) ? float3{ 0.0f, 1.0f, 0.0f } : float3{ 0.0f, 0.0f, 1.0f };
 			}
 		}		
 
 		if (!copy->empty())
+		{
+			const bool measured = _pacer.enabled || isClockedByMainDevice();
+			const int64_t writeBegin = (measured) ? InternalClock::nowMicro() : 0;
+
+			_pacer.lastWrite = InternalClock::now();
 			retval = write(copy);
 
+			if (measured && retval >= 0)
+				updatePacer(std::max(InternalClock::nowMicro() - writeBegin, _pacer.transportWriteTime));
+		}
+
+		// the latency is measured once per captured frame: at the first write that carries its colors
+		if (retval >= 0 && _lastLedTiming.isValid() && _lastLedTiming.sequence != _lastWrittenSequence)
+		{
+			_lastWrittenSequence = _lastLedTiming.sequence;
+			PerformanceTracer::record(PerformanceTracer::Stage::DEVICE_LATENCY, PerformanceTracer::deviceId(_instanceIndex, _outputIndex), _lastLedTiming.captureTime, InternalClock::nowMicro());
+		}
+
 		if (_signalTerminate)
 			disableDevice(false);
 
@@ -593,11 +730,12 @@ int LedDevice::writeBlack(int numberOfBlack)
 	using namespace linalg::aliases;
 	int rc = -1;	
 
-	if (auto blacks = _lastLedValues; blacks != nullptr)
+	if (_lastLedValues != nullptr)
 	{
 		Debug(_log, "Set LED strip to black/power off");
 
-		std::fill(blacks->begin(), blacks->end(), float3{ 0.0f, 0.0f, 0.0f });
+		auto blacks = std::make_shared<std::vector<float3>>(_lastLedValues->size(), float3{ 0.0f, 0.0f, 0.0f });
+		_lastLedValues = blacks;
 
 		for (int i = 0; i < numberOfBlack; i++)
 		{
@@ -622,13 +760,77 @@ int LedDevice::writeFiniteColors(const std::vector<ColorRgb>& /*ledValues*/)
 	return -1;
 }
 
+void LedDevice::preparePacket()
+{
+}
+
+int LedDevice::writePacket()
+{
+	return -1;
+}
+
+SharedOutputColors LedDevice::sliceOutputColors(const SharedOutputColors& nonlinearRgbColors) const
+{
+	using namespace linalg::aliases;
+
+	auto slice = std::make_shared<std::vector<float3>>(_outputSliceCount, float3{ 0.0f, 0.0f, 0.0f });
+	const size_t begin = std::min(static_cast<size_t>(_outputSliceOffset), nonlinearRgbColors->size());
+	const size_t end = std::min(begin + static_cast<size_t>(_outputSliceCount), nonlinearRgbColors->size());
+
+	std::copy(nonlinearRgbColors->cbegin() + begin, nonlinearRgbColors->cbegin() + end, slice->begin());
+
+	return slice;
+}
+
+int LedDevice::writeFinitePacket(const SharedOutputColors& nonlinearRgbColors)
+{
+	const std::vector<linalg::aliases::float3>* source = nonlinearRgbColors.get();
+
+	if (_antiFlickeringFilter)
+	{
+		if (nonlinearRgbColors->size() == _lastFinityLedValues->size())
+		{
+			for (size_t i = 0; i < nonlinearRgbColors->size(); ++i) {
+				auto& oldV = (*_lastFinityLedValues)[i];
+				const auto& newV = (*nonlinearRgbColors)[i];
+
+				if (linalg::maxelem(linalg::abs(newV - oldV) * 255.0f) > 0.49f)
+				{
+					oldV = newV;
+				}
+			}
+			source = _lastFinityLedValues.get();
+		}
+		else
+		{
+			*_lastFinityLedValues = *nonlinearRgbColors;
+		}
+	}
+
+	// the driver fills the static parts of its headers only when the layout of the wire buffer has changed
+	if (_packetWriter.resize(source->size()))
+		preparePacket();
+
+	_packetWriter.encode(*source);
+
+	return writePacket();
+}
+
 int LedDevice::write(SharedOutputColors nonlinearRgbColors)
 {
 	if (nonlinearRgbColors == nullptr || nonlinearRgbColors->empty())
 		return 0;
 
+	PerformanceTracer::Scope trace(PerformanceTracer::Stage::DEVICE_WRITE, PerformanceTracer::deviceId(_instanceIndex, _outputIndex));
+
 	if (auto res = writeInfiniteColors(nonlinearRgbColors); !res.first)
 	{
+		// finity output quantised directly into the wire buffer of the driver
+		if (_packetWriter.isEnabled())
+		{
+			return writeFinitePacket(nonlinearRgbColors);
+		}
+
 		// finity output using antiflickering filter
 		if (_antiFlickeringFilter)
 		{
@@ -836,6 +1038,16 @@ bool LedDevice::componentState() const {
 	return _isEnabled;
 }
 
+void LedDevice::Pacer::reset()
+{
+	interval = 0;
+	writeTime = 0;
+	transportWriteTime = 0;
+	samples = 0;
+	lastUpdate = 0;
+	lastWrite = 0;
+}
+
 void LedDevice::LedStats::reset(int64_t now)
 {
 	statBegin = now;
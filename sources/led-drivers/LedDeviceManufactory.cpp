@@ -36,10 +36,11 @@
 
 namespace hyperhdr::leds
 {
-	LedDeviceDefinition::LedDeviceDefinition(QString _name, QString _group, LedDeviceConstructor _constructor) :
+	LedDeviceDefinition::LedDeviceDefinition(QString _name, QString _group, LedDeviceConstructor _constructor, bool _blocking) :
 		name(_name),
 		group(_group),
-		constructor(_constructor)
+		constructor(_constructor),
+		blocking(_blocking)
 	{
 	};
 
@@ -57,9 +58,9 @@ namespace hyperhdr::leds
 		return list;
 	};
 
-	bool REGISTER_LED_DEVICE(QString name, QString group, LedDeviceConstructor constructor)
+	bool REGISTER_LED_DEVICE(QString name, QString group, LedDeviceConstructor constructor, bool blocking)
 	{
-		LedDeviceDefinition newLed(name, group, constructor);
+		LedDeviceDefinition newLed(name, group, constructor, blocking);
 		GET_ALL_LED_DEVICE(&newLed);
 		return true;
 	};
@@ -98,4 +99,20 @@ namespace hyperhdr::leds
 
 		return device;
 	};
+
+	bool IS_BLOCKING_LED_DEVICE(const QJsonObject& deviceConfig)
+	{
+		const std::list<LedDeviceDefinition>& drivers = GET_ALL_LED_DEVICE(nullptr);
+
+		QString type = deviceConfig["type"].toString("UNSPECIFIED").toLower();
+
+		auto findIter = std::find_if(drivers.begin(), drivers.end(),
+			[&type](const LedDeviceDefinition& a)
+			{
+				return a.name == type;
+			}
+		);
+
+		return (findIter != drivers.end() && (*findIter).blocking);
+	};
 };
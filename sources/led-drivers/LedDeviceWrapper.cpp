@@ -7,16 +7,19 @@
 #include <base/HyperHdrInstance.h>
 #include <json-utils/JsonUtils.h>
 #include <utils/Macros.h>
+#include <utils/SharedExecutor.h>
 
 // qt
 #include <future>
 #include <QMutexLocker>
 #include <QThread>
 #include <QDir>
+#include <QJsonArray>
 
 LedDeviceWrapper::LedDeviceWrapper(HyperHdrInstance* ownerInstance)
 	: QObject(ownerInstance)
 	, _ownerInstance(ownerInstance)
+	, _log(QString("LEDDEVICE_WRAPPER%1").arg(ownerInstance->getInstanceIndex()))
 	, _ledDevice(nullptr, nullptr)
 	, _enabled(false)
 {
@@ -25,42 +28,110 @@ LedDeviceWrapper::LedDeviceWrapper(HyperHdrInstance* ownerInstance)
 
 LedDeviceWrapper::~LedDeviceWrapper()
 {
+	_outputDevices.clear();
 	_ledDevice.reset();
 }
 
 void LedDeviceWrapper::createLedDevice(QJsonObject config, int smoothingInterval, bool antiFlickeringFilter, bool disableOnStartup)
 {
-	auto threadReadyPromisePtr = std::make_shared<std::promise<void>>();
 	const int instanceIndex = _ownerInstance->getInstanceIndex();
+	const QJsonArray outputDevices = config["outputDevices"].toArray();
+	const int layoutLedCount = config["currentLedCount"].toInt(1);
+	const int mainLedCount = config["outputMainLedCount"].toInt(0);
+	std::vector<std::pair<int, int>> ranges;
 
+	_outputDevices.clear();
 	_ledDevice.reset();
 
+	config.remove("outputDevices");
 	config["smoothingRefreshTime"] = smoothingInterval;
 	config["smoothingAntiFlickeringFilter"] = antiFlickeringFilter;
 
-	QThread* thread = new QThread();
-	thread->setObjectName(QString("LedDeviceThread%1").arg(instanceIndex));
+	// the main device may drive only the beginning of the layout, the rest is left to the additional devices
+	if (mainLedCount > 0 && mainLedCount < layoutLedCount)
+	{
+		config["currentLedCount"] = mainLedCount;
+		config["outputSliceOffset"] = 0;
+		config["outputSliceCount"] = mainLedCount;
+		Info(_log, "Main LED device: LEDs 0-{:d}", mainLedCount - 1);
+	}
+	ranges.emplace_back(0, config["currentLedCount"].toInt(1));
 
-	// start the thread
-	thread->start();
+	launchLedDevice(config, instanceIndex, disableOnStartup, 0);
 
-	QObject::connect(thread, &QThread::started, this, [this, threadReadyPromisePtr, config, instanceIndex, disableOnStartup]() {
-		_ledDevice = std::unique_ptr<LedDevice, void(*)(LedDevice*)>(
-			hyperhdr::leds::CONSTRUCT_LED_DEVICE(config),
-			[](LedDevice* oldLed) {
-				QUEUE_CALL_0(oldLed, stop);
-				hyperhdr::THREAD_REMOVER(QString("%1 [LedDevice]").arg(oldLed->thread()->objectName()), oldLed->thread(), oldLed);
+	// additional devices are fed with a slice of the same smoothing output, each one with its own thread
+	// and with its own refresh timer unless the smoothing (clocked by the main device) is enabled
+	for (int outputIndex = 1; const auto& item : outputDevices)
+	{
+		QJsonObject outputConfig = item.toObject();
+		const int ledOffset = std::max(outputConfig["ledOffset"].toInt(0), 0);
+		const int ledCount = outputConfig["ledCount"].toInt(0);
+
+		if (outputConfig["type"].toString().isEmpty() || ledCount <= 0)
+		{
+			Warning(_log, "Skipping the additional LED device #{:d}: the type and the LED count are required", outputIndex);
+			continue;
+		}
+
+		outputConfig["currentLedCount"] = ledCount;
+		outputConfig["outputSliceOffset"] = ledOffset;
+		outputConfig["outputSliceCount"] = ledCount;
+		outputConfig["additionalOutput"] = true;
+		outputConfig["smoothingRefreshTime"] = smoothingInterval;
+		outputConfig["smoothingAntiFlickeringFilter"] = antiFlickeringFilter;
+
+		Info(_log, "Additional LED device #{:d}: {:s}, LEDs {:d}-{:d}", outputIndex, outputConfig["type"].toString(), ledOffset, ledOffset + ledCount - 1);
+
+		// the devices do not know about each other: the same LEDs would be sent twice, the missing ones stay black
+		if (ledOffset + ledCount > layoutLedCount)
+			Warning(_log, "The additional LED device #{:d} reaches past the last LED of the layout ({:d}), the missing LEDs stay black", outputIndex, layoutLedCount - 1);
+
+		for (int rangeIndex = 0; const auto& [begin, count] : ranges)
+		{
+			if (ledOffset < begin + count && begin < ledOffset + ledCount)
+			{
+				if (rangeIndex == 0)
+					Warning(_log, "The additional LED device #{:d} overlaps the LEDs of the main device (0-{:d}). Set the LED count of the main device to leave them out", outputIndex, count - 1);
+				else
+					Warning(_log, "The additional LED device #{:d} overlaps the LEDs of the additional device #{:d}", outputIndex, rangeIndex);
 			}
-		);
-		_ledDevice->setInstanceIndex(instanceIndex);
+			rangeIndex++;
+		}
+		ranges.emplace_back(ledOffset, ledCount);
+
+		launchLedDevice(outputConfig, instanceIndex, disableOnStartup, outputIndex++);
+	}
+}
+
+void LedDeviceWrapper::launchLedDevice(const QJsonObject& config, int instanceIndex, bool disableOnStartup, int outputIndex)
+{
+	const QString suffix = (outputIndex > 0) ? QString("%1_%2").arg(instanceIndex).arg(outputIndex) : QString::number(instanceIndex);
+
+	if (SharedExecutor::isEnabled())
+	{
+		if (!hyperhdr::leds::IS_BLOCKING_LED_DEVICE(config))
+		{
+			if (_executor == nullptr)
+				_executor = SharedExecutor::getInstance();
 
-		// setup thread management
-		if (!disableOnStartup)
-			QUEUE_CALL_0(_ledDevice.get(), start);
+			_executor->run(QString("LedDevice%1").arg(suffix), [this, &config, instanceIndex, disableOnStartup, outputIndex]() -> QObject* {
+				return setupLedDevice(config, instanceIndex, disableOnStartup, outputIndex, true);
+			});
+			return;
+		}
+
+		Info(_log, "The '{:s}' driver waits on its device, it keeps a dedicated thread instead of the shared executor", config["type"].toString());
+	}
 
-		connect(_ownerInstance, &HyperHdrInstance::SignalSmoothingRestarted, _ledDevice.get(), &LedDevice::smoothingRestarted, Qt::QueuedConnection);
-		connect(_ledDevice.get(), &LedDevice::SignalEnableStateChanged, this, &LedDeviceWrapper::handleInternalEnableState, Qt::QueuedConnection);
+	auto threadReadyPromisePtr = std::make_shared<std::promise<void>>();
+	QThread* thread = new QThread();
+	thread->setObjectName(QString("LedDeviceThread%1").arg(suffix));
 
+	// start the thread
+	thread->start();
+
+	QObject::connect(thread, &QThread::started, this, [this, threadReadyPromisePtr, config, instanceIndex, disableOnStartup, outputIndex]() {
+		setupLedDevice(config, instanceIndex, disableOnStartup, outputIndex, false);
 		threadReadyPromisePtr->set_value();
 	},
 	#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
@@ -73,27 +144,72 @@ void LedDeviceWrapper::createLedDevice(QJsonObject config, int smoothingInterval
 	threadReadyPromisePtr->get_future().get();
 }
 
+LedDevice* LedDeviceWrapper::setupLedDevice(const QJsonObject& config, int instanceIndex, bool disableOnStartup, int outputIndex, bool shared)
+{
+	LedDevicePtr ledDevice = (shared) ?
+		LedDevicePtr(
+			hyperhdr::leds::CONSTRUCT_LED_DEVICE(config),
+			[](LedDevice* oldLed) {
+				QUEUE_CALL_0(oldLed, stop);
+				hyperhdr::SMARTPOINTER_MESSAGE(QString("%1 [LedDevice]").arg(oldLed->thread()->objectName()));
+				SharedExecutor::getInstance()->release(oldLed);
+			}
+		) :
+		LedDevicePtr(
+			hyperhdr::leds::CONSTRUCT_LED_DEVICE(config),
+			[](LedDevice* oldLed) {
+				QUEUE_CALL_0(oldLed, stop);
+				hyperhdr::THREAD_REMOVER(QString("%1 [LedDevice]").arg(oldLed->thread()->objectName()), oldLed->thread(), oldLed);
+			}
+		);
+
+	LedDevice* device = ledDevice.get();
+	device->setInstanceIndex(instanceIndex, outputIndex);
+
+	// setup thread management
+	if (!disableOnStartup)
+		QUEUE_CALL_0(device, start);
+
+	connect(_ownerInstance, &HyperHdrInstance::SignalSmoothingRestarted, device, &LedDevice::smoothingRestarted, Qt::QueuedConnection);
+
+	if (outputIndex == 0)
+	{
+		connect(device, &LedDevice::SignalEnableStateChanged, this, &LedDeviceWrapper::handleInternalEnableState, Qt::QueuedConnection);
+		_ledDevice = std::move(ledDevice);
+	}
+	else
+	{
+		connect(device, &LedDevice::SignalEnableStateChanged, this, [this, device](bool newState) { handleOutputEnableState(device, newState); }, Qt::QueuedConnection);
+		_outputDevices.push_back(std::move(ledDevice));
+	}
+
+	return device;
+}
+
 void LedDeviceWrapper::handleComponentState(hyperhdr::Components component, bool state)
 {
 	if (_ledDevice == nullptr)
 		return;
 
-	if (component == hyperhdr::COMP_LEDDEVICE)
+	for (LedDevice* device : allDevices())
 	{
-		if (state)
+		if (component == hyperhdr::COMP_LEDDEVICE)
 		{
-			QUEUE_CALL_0(_ledDevice.get(), enable);
+			if (state)
+			{
+				QUEUE_CALL_0(device, enable);
+			}
+			else
+			{
+				QUEUE_CALL_0(device, disable);
+			}
 		}
-		else
+
+		if (component == hyperhdr::COMP_ALL)
 		{
-			QUEUE_CALL_0(_ledDevice.get(), disable);
+			QUEUE_CALL_1(device, pauseRetryTimer, bool, (!state));
 		}
 	}
-
-	if (component == hyperhdr::COMP_ALL)
-	{
-		QUEUE_CALL_1(_ledDevice.get(), pauseRetryTimer, bool, (!state));
-	}
 }
 
 void LedDeviceWrapper::handleInternalEnableState(bool newState)
@@ -121,6 +237,28 @@ void LedDeviceWrapper::handleInternalEnableState(bool newState)
 	}
 }
 
+void LedDeviceWrapper::handleOutputEnableState(LedDevice* device, bool newState)
+{
+	// only the primary device drives the smoothing clock and the component state
+	if (newState)
+		connect(_ownerInstance, &HyperHdrInstance::SignalFinalOutputColorsReady, device, &LedDevice::handleSignalFinalOutputColorsReady, Qt::UniqueConnection);
+	else
+		disconnect(_ownerInstance, &HyperHdrInstance::SignalFinalOutputColorsReady, device, &LedDevice::handleSignalFinalOutputColorsReady);
+}
+
+std::vector<LedDevice*> LedDeviceWrapper::allDevices() const
+{
+	std::vector<LedDevice*> devices;
+
+	if (_ledDevice != nullptr)
+		devices.push_back(_ledDevice.get());
+
+	for (const auto& device : _outputDevices)
+		devices.push_back(device.get());
+
+	return devices;
+}
+
 
 unsigned int LedDeviceWrapper::getLedCount() const
 {
@@ -159,6 +297,30 @@ int LedDeviceWrapper::hasLedClock()
 	return hasLedClock;
 }
 
+QJsonObject LedDeviceWrapper::getPacingInfo()
+{
+	QJsonObject pacing;
+
+	if (_ledDevice != nullptr)
+		SAFE_CALL_0_RET(_ledDevice.get(), getPacingInfo, QJsonObject, pacing);
+
+	if (!_outputDevices.empty())
+	{
+		QJsonArray outputs;
+
+		for (const auto& device : _outputDevices)
+		{
+			QJsonObject outputPacing;
+			SAFE_CALL_0_RET(device.get(), getPacingInfo, QJsonObject, outputPacing);
+			outputs.append(outputPacing);
+		}
+
+		pacing["outputDevices"] = outputs;
+	}
+
+	return pacing;
+}
+
 QJsonObject LedDeviceWrapper::getLedDeviceSchemas()
 {
 	// make sure the resources are loaded (they may be left out after static linking)
@@ -0,0 +1,152 @@
+/* PacketWriter.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <algorithm>
+#endif
+
+#include <linalg.h>
+#include <led-drivers/PacketWriter.h>
+
+namespace
+{
+	// clamp and round half up, the same result as ColorSpaceMath::round_to_0_255 (std::lround):
+	// the float is widened before adding the half, so values just below x.5 are not rounded up
+	inline uint8_t quantize(float value)
+	{
+		return static_cast<uint8_t>(static_cast<double>(std::clamp(value * 255.0f, 0.0f, 255.0f)) + 0.5);
+	}
+}
+
+void PacketWriter::setLayout(const Layout& layout)
+{
+	_layout = layout;
+	_layout.stride = std::max<size_t>(_layout.stride, 3);
+	if (_layout.payloadSize > 0)
+		_layout.payloadSize = std::max(_layout.payloadSize, _layout.stride);
+	_enabled = true;
+	_ledCount = 0;
+	_streamSize = 0;
+	_segmentCount = 0;
+	_buffer.clear();
+}
+
+void PacketWriter::disable()
+{
+	_enabled = false;
+	_buffer.clear();
+}
+
+bool PacketWriter::isEnabled() const
+{
+	return _enabled;
+}
+
+const PacketWriter::Layout& PacketWriter::layout() const
+{
+	return _layout;
+}
+
+bool PacketWriter::resize(size_t ledCount)
+{
+	if (!_buffer.empty() && ledCount == _ledCount)
+		return false;
+
+	_ledCount = ledCount;
+	_streamSize = ledCount * _layout.stride;
+	_segmentCount = (_layout.payloadSize > 0 && _streamSize > 0) ? (_streamSize + _layout.payloadSize - 1) / _layout.payloadSize : 1;
+
+	_buffer.clear();
+	_buffer.resize(_segmentCount * _layout.headerSize + _streamSize, _layout.fill);
+
+	return true;
+}
+
+size_t PacketWriter::ledCount() const
+{
+	return _ledCount;
+}
+
+size_t PacketWriter::segmentCount() const
+{
+	return _segmentCount;
+}
+
+size_t PacketWriter::segmentPayload(size_t index) const
+{
+	if (_layout.payloadSize == 0)
+		return _streamSize;
+
+	return std::min(_layout.payloadSize, _streamSize - std::min(_streamSize, index * _layout.payloadSize));
+}
+
+uint8_t* PacketWriter::segment(size_t index)
+{
+	const size_t segmentSize = _layout.headerSize + _layout.payloadSize;
+	return _buffer.data() + index * segmentSize;
+}
+
+std::vector<uint8_t>& PacketWriter::buffer()
+{
+	return _buffer;
+}
+
+void PacketWriter::encode(const std::vector<linalg::aliases::float3>& colors)
+{
+	const size_t count = std::min(colors.size(), _ledCount);
+	const size_t payload = (_layout.payloadSize > 0) ? _layout.payloadSize : _streamSize;
+	const size_t segmentStep = _layout.headerSize + payload;
+	uint8_t* segment = _buffer.data() + _layout.headerSize;
+	size_t segmentBase = 0;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const auto& color = colors[i];
+		const uint8_t bytes[3] = { quantize(color.x), quantize(color.y), quantize(color.z) };
+		size_t position = i * _layout.stride + _layout.colorOffset - segmentBase;
+
+		if (position + 3 <= payload) [[likely]]
+		{
+			segment[position] = bytes[0];
+			segment[position + 1] = bytes[1];
+			segment[position + 2] = bytes[2];
+			continue;
+		}
+
+		// the color crosses the segment boundary (e.g. RGB over 512-channel DMX universes)
+		for (int channel = 0; channel < 3; channel++, position++)
+		{
+			if (position >= payload)
+			{
+				segment += segmentStep;
+				segmentBase += payload;
+				position -= payload;
+			}
+			segment[position] = bytes[channel];
+		}
+	}
+}
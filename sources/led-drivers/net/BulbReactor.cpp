@@ -0,0 +1,197 @@
+/* BulbReactor.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <algorithm>
+	#include <limits>
+	#include <utility>
+#endif
+
+#include <led-drivers/net/BulbReactor.h>
+#include <utils/InternalClock.h>
+
+namespace
+{
+	const qint64 REPORT_INTERVAL = 60000;
+}
+
+BulbReactor::BulbReactor(const LoggerName& log, SendFunction send) :
+	_log(log),
+	_send(std::move(send)),
+	_timer(std::make_unique<QTimer>()),
+	_lastReport(0),
+	_sendTime(0)
+{
+	_timer->setSingleShot(true);
+	_timer->setTimerType(Qt::PreciseTimer);
+	QObject::connect(_timer.get(), &QTimer::timeout, [this]() { dispatchAll(); });
+}
+
+BulbReactor::~BulbReactor()
+{
+	_timer->stop();
+}
+
+void BulbReactor::setBulbs(const QStringList& names, int minInterval)
+{
+	_timer->stop();
+	_bulbs.clear();
+	_bulbs.resize(names.size());
+
+	for (int i = 0; i < names.size(); i++)
+	{
+		_bulbs[i].name = names[i];
+		_bulbs[i].minInterval = std::max(minInterval, 0);
+	}
+
+	_lastReport = InternalClock::nowPrecise();
+}
+
+void BulbReactor::submit(int bulb)
+{
+	if (bulb < 0 || bulb >= static_cast<int>(_bulbs.size()))
+		return;
+
+	qint64 now = InternalClock::nowPrecise();
+	Bulb& target = _bulbs[bulb];
+
+	target.submitted++;
+	if (target.pending)
+		target.coalesced++;
+	else
+	{
+		target.pending = true;
+		target.pendingSince = now;
+	}
+
+	dispatch(bulb, now, false);
+	schedule(now);
+
+	if (now - _lastReport >= REPORT_INTERVAL)
+		report();
+}
+
+void BulbReactor::kick(int bulb)
+{
+	if (bulb < 0 || bulb >= static_cast<int>(_bulbs.size()))
+		return;
+
+	qint64 now = InternalClock::nowPrecise();
+
+	dispatch(bulb, now, false);
+	schedule(now);
+}
+
+void BulbReactor::flush()
+{
+	qint64 now = InternalClock::nowPrecise();
+
+	for (int i = 0; i < static_cast<int>(_bulbs.size()); i++)
+		dispatch(i, now, true);
+
+	schedule(now);
+}
+
+void BulbReactor::dispatchAll()
+{
+	qint64 now = InternalClock::nowPrecise();
+
+	for (int i = 0; i < static_cast<int>(_bulbs.size()); i++)
+		dispatch(i, now, false);
+
+	schedule(now);
+}
+
+void BulbReactor::dispatch(int bulb, qint64 now, bool force)
+{
+	Bulb& target = _bulbs[bulb];
+
+	if (!target.pending || (!force && now - target.lastSent < target.minInterval))
+		return;
+
+	const qint64 sendBegin = InternalClock::nowMicro();
+	const SendResult result = _send(bulb);
+	_sendTime += InternalClock::nowMicro() - sendBegin;
+
+	switch (result)
+	{
+		case SendResult::Sent:
+		{
+			qint64 latency = now - target.pendingSince;
+			target.pending = false;
+			target.lastSent = now;
+			target.sent++;
+			target.latencySum += latency;
+			target.latencyMax = std::max(target.latencyMax, latency);
+			break;
+		}
+		case SendResult::Failed:
+			target.pending = false;
+			target.failed++;
+			break;
+		case SendResult::Busy:
+			// the bulb calls kick() when it can accept the next state, the following submit() retries too
+			break;
+	}
+}
+
+void BulbReactor::schedule(qint64 now)
+{
+	qint64 nearest = std::numeric_limits<qint64>::max();
+
+	for (const Bulb& bulb : _bulbs)
+		if (bulb.pending && now - bulb.lastSent < bulb.minInterval)
+			nearest = std::min(nearest, bulb.lastSent + bulb.minInterval - now);
+
+	if (nearest == std::numeric_limits<qint64>::max())
+		_timer->stop();
+	else if (!_timer->isActive() || _timer->remainingTime() > nearest)
+		_timer->start(static_cast<int>(std::max(nearest, qint64(1))));
+}
+
+qint64 BulbReactor::takeSendTime()
+{
+	return std::exchange(_sendTime, 0);
+}
+
+void BulbReactor::report()
+{
+	_lastReport = InternalClock::nowPrecise();
+
+	for (Bulb& bulb : _bulbs)
+	{
+		if (bulb.submitted == 0)
+			continue;
+
+		Info(_log, "Bulb {:s}: latency avg = {:.1f}ms, max = {:d}ms, sent = {:d}, coalesced = {:d}, failed = {:d}",
+			(bulb.name), (bulb.sent > 0) ? bulb.latencySum / static_cast<double>(bulb.sent) : 0.0, bulb.latencyMax,
+			bulb.sent, bulb.coalesced, bulb.failed);
+
+		bulb.submitted = bulb.sent = bulb.coalesced = bulb.failed = 0;
+		bulb.latencySum = bulb.latencyMax = 0;
+	}
+}
@@ -379,4 +379,4 @@ LedDevice* DriverNetAtmoOrb::construct(const QJsonObject& deviceConfig)
 	return new DriverNetAtmoOrb(deviceConfig);
 }
 
-bool DriverNetAtmoOrb::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("atmoorb", "leds_group_2_network", DriverNetAtmoOrb::construct);
+bool DriverNetAtmoOrb::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("atmoorb", "leds_group_2_network", DriverNetAtmoOrb::construct, true);
@@ -738,4 +738,4 @@ LedDevice* DriverNetCololight::construct(const QJsonObject& deviceConfig)
 	return new DriverNetCololight(deviceConfig);
 }
 
-bool DriverNetCololight::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("cololight", "leds_group_2_network", DriverNetCololight::construct);
+bool DriverNetCololight::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("cololight", "leds_group_2_network", DriverNetCololight::construct, true);
@@ -32,6 +32,8 @@
 
 namespace {
 	constexpr ushort DDP_DEFAULT_PORT = 4048;
+	constexpr size_t DDP_HEADER_SIZE = 10;
+	constexpr size_t DDP_MAX_RGB_PAYLOAD = 480 * 3;
 }
 
 DriverNetDDP::DriverNetDDP(const QJsonObject& deviceConfig)
@@ -46,6 +48,7 @@ DriverNetDDP::DriverNetDDP(const QJsonObject& deviceConfig)
 	, _white_channel_red(255)
 	, _white_channel_green(255)
 	, _white_channel_blue(255)
+	, _sequenceNum(0)
 {
 }
 
@@ -109,6 +112,18 @@ bool DriverNetDDP::init(QJsonObject deviceConfig)
 		{
 			isInitOK = true;
 		}
+
+		if (_isRgbw)
+		{
+			_packetWriter.disable();
+		}
+		else
+		{
+			PacketWriter::Layout layout;
+			layout.headerSize = DDP_HEADER_SIZE;
+			layout.payloadSize = DDP_MAX_RGB_PAYLOAD;
+			_packetWriter.setLayout(layout);
+		}
 	}
 	return isInitOK;
 }
@@ -123,8 +138,6 @@ int DriverNetDDP::writeFiniteColors(const std::vector<ColorRgb>& ledValues)
 
 int DriverNetDDP::writeFiniteColors(bool isRgbw, const int ledsNumber, const std::vector<ColorRgb>& ledValues)
 {
-	static uint8_t sequenceNum = 0;
-
 	if (isRgbw && ledValues.size() == 0 && static_cast<int>(_rgbwBuffer.size()) != ledsNumber * 4) {
 		Error(_log, "RGBW colors were not provided");
 		return 0;
@@ -147,13 +160,13 @@ int DriverNetDDP::writeFiniteColors(bool isRgbw, const int ledsNumber, const std
 	const uint8_t* start = (isRgbw) ? _rgbwBuffer.data() : reinterpret_cast<const uint8_t*>(ledValues.data());
 	const uint8_t* end = start + ledsNumber * colorSize;
 	uint32_t colorOffset = 0;
-	constexpr size_t ddpHeaderOverhead = 10;
+	constexpr size_t ddpHeaderOverhead = DDP_HEADER_SIZE;
 	const size_t maxColorsInUdpFrame = maxLedsInFrame * colorSize;
 
 	size_t realRgbSize = std::min<size_t>(end - start, maxColorsInUdpFrame);
 	
 	_ddpFrame.reserve(realRgbSize + ddpHeaderOverhead);
-	sequenceNum = (sequenceNum % 0x0F) + 1;
+	_sequenceNum = (_sequenceNum % 0x0F) + 1;
 
 	while (start < end)
 	{		
@@ -165,7 +178,7 @@ int DriverNetDDP::writeFiniteColors(bool isRgbw, const int ledsNumber, const std
 		// Bajt 0: Flags (V1: 0x40 | Push: 0x01 = 0x41)
 		_ddpFrame[0] = (isLast) ? 0x41 : 0x40;
 		// Bajt 1: Sequence (0x00-0x0F)		
-		_ddpFrame[1] = sequenceNum;
+		_ddpFrame[1] = _sequenceNum;
 		// Bajt 2: Data Type (RGB = 0x0B, RGBW = 0x1B)
 		_ddpFrame[2] = (isRgbw) ? 0x1B : 0x0B;
 		// Bajt 3: Destination ID
@@ -188,6 +201,39 @@ int DriverNetDDP::writeFiniteColors(bool isRgbw, const int ledsNumber, const std
 	return static_cast<int>(ledsNumber);
 }
 
+void DriverNetDDP::preparePacket()
+{
+	if (_packetWriter.ledCount() != _ledCount)
+		setLedCount(static_cast<int>(_packetWriter.ledCount()));
+
+	for (size_t index = 0, segments = _packetWriter.segmentCount(); index < segments; index++)
+	{
+		uint8_t* frame = _packetWriter.segment(index);
+		const size_t realRgbSize = _packetWriter.segmentPayload(index);
+
+		frame[0] = (index + 1 == segments) ? 0x41 : 0x40;
+		frame[2] = 0x0B;
+		frame[3] = 0x01;
+		qToBigEndian<uint32_t>(static_cast<uint32_t>(index * DDP_MAX_RGB_PAYLOAD), &frame[4]);
+		qToBigEndian<uint16_t>(static_cast<uint16_t>(realRgbSize), &frame[8]);
+	}
+}
+
+int DriverNetDDP::writePacket()
+{
+	_sequenceNum = (_sequenceNum % 0x0F) + 1;
+
+	for (size_t index = 0; index < _packetWriter.segmentCount(); index++)
+	{
+		uint8_t* frame = _packetWriter.segment(index);
+
+		frame[1] = _sequenceNum;
+		writeBytes(static_cast<int>(DDP_HEADER_SIZE + _packetWriter.segmentPayload(index)), frame);
+	}
+
+	return static_cast<int>(_packetWriter.ledCount());
+}
+
 std::pair<bool, int> DriverNetDDP::writeInfiniteColors(SharedOutputColors nonlinearRgbColors)
 {
 	if (nonlinearRgbColors->empty() || !_enable_ice_rgbw)
@@ -227,4 +227,4 @@ LedDevice* DriverNetFadeCandy::construct(const QJsonObject& deviceConfig)
 	return new DriverNetFadeCandy(deviceConfig);
 }
 
-bool DriverNetFadeCandy::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("fadecandy", "leds_group_2_network", DriverNetFadeCandy::construct);
+bool DriverNetFadeCandy::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("fadecandy", "leds_group_2_network", DriverNetFadeCandy::construct, true);
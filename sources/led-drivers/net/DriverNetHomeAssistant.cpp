@@ -8,7 +8,8 @@
 
 DriverNetHomeAssistant::DriverNetHomeAssistant(const QJsonObject& deviceConfig)
 	: LedDevice(deviceConfig),
-	_lastUpdate(0)
+	_lastUpdate(0),
+	_lastStatsReport(0)
 {
 }
 
@@ -31,6 +32,13 @@ bool DriverNetHomeAssistant::init(QJsonObject deviceConfig)
 					? _haInstance.homeAssistantHost : "http://" + _haInstance.homeAssistantHost);
 		_restApi = std::make_unique<ProviderRestApi>(url.scheme(), url.host(), url.port(8123));
 		_restApi->addHeader("Authorization", QString("Bearer %1").arg(_haInstance.longLivedAccessToken));
+		_restApi->setAsyncErrorHandler(this, [this](const QString& reason) {
+			if (!_isDeviceInError)
+			{
+				this->setInError(reason);
+				setupRetry(5000);
+			}
+		});
 		
 		Debug(_log, "HomeAssistantHost     : {:s}", (_haInstance.homeAssistantHost));
 		Debug(_log, "RestoreOriginalState  : {:s}", (_haInstance.restoreOriginalState) ? "yes" : "no");
@@ -102,6 +110,8 @@ bool DriverNetHomeAssistant::powerOn()
 
 bool DriverNetHomeAssistant::powerOff()
 {
+	reportRoundTrip();
+
 	if (_haInstance.restoreOriginalState)
 	{
 		restoreStates();
@@ -166,19 +176,33 @@ int DriverNetHomeAssistant::writeFiniteColors(const std::vector<ColorRgb>& ledVa
 			doc.setObject(row);
 			QString message(doc.toJson(QJsonDocument::Compact));
 			_restApi->setBasePath("/api/services/light/turn_on");
-			auto response = _restApi->post(message);
-
-			if (response.error())
-			{
-				this->setInError(response.error() ? response.getErrorReason() : "Unknown");
-				setupRetry(5000);
-				return false;
-			}
+			_restApi->postAsync(lamp.name, message);
 		}
 
+	// the posts are asynchronous: the pacer follows the round-trip reported by the REST helper
+	reportTransportWriteTime(_restApi->getLastRoundTrip() * 1000);
+
+	if (start - _lastStatsReport >= 60000)
+	{
+		if (_lastStatsReport != 0)
+			reportRoundTrip();
+		_lastStatsReport = start;
+	}
+
 	return 0;
 }
 
+void DriverNetHomeAssistant::reportRoundTrip()
+{
+	if (_restApi == nullptr)
+		return;
+
+	auto stats = _restApi->getRoundTripStats(true);
+	if (stats.requests > 0)
+		Info(_log, "REST round-trip: avg = {:.1f}ms, max = {:.1f}ms, requests = {:d}, coalesced = {:d}, failed = {:d}",
+			stats.averageMs, stats.maxMs, stats.requests, stats.coalesced, stats.failed);
+}
+
 bool DriverNetHomeAssistant::saveStates()
 {
 	for (auto& lamp : _haInstance.lamps)
@@ -329,4 +353,4 @@ LedDevice* DriverNetHomeAssistant::construct(const QJsonObject& deviceConfig)
 	return new DriverNetHomeAssistant(deviceConfig);
 }
 
-bool DriverNetHomeAssistant::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("home_assistant", "leds_group_2_network", DriverNetHomeAssistant::construct);
+bool DriverNetHomeAssistant::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("home_assistant", "leds_group_2_network", DriverNetHomeAssistant::construct, true);
@@ -211,4 +211,4 @@ QJsonObject DriverNetHyperk::discover(const QJsonObject& /*params*/)
 	return devicesDiscovered;
 }
 
-bool DriverNetHyperk::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("hyperk", "leds_group_2_network", DriverNetHyperk::construct);
+bool DriverNetHyperk::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("hyperk", "leds_group_2_network", DriverNetHyperk::construct, true);
@@ -47,6 +47,7 @@ namespace
 {
 	constexpr uint16_t DEFAULT_FLIX_PORT = 56700;
 	constexpr uint16_t WHITE_COLOR_TEMPERATURE = 6500; //D65
+	constexpr int LAMP_MIN_INTERVAL_MS = 50; // LIFX LAN protocol: no more than 20 messages per second per device
 	constexpr uint16_t POWER_ON = 0xFFFF;
 	constexpr uint16_t POWER_OFF = 0x0;
 
@@ -183,20 +184,6 @@ namespace
 		}
 	}
 
-	int sendLifxColors(QUdpSocket& socket,
-		const std::vector<std::pair<DriverNetLifx::IpMacAddress, linalg::vec<float, 3>>>& lights,
-		uint16_t kelvin,
-		uint32_t duration_ms = 0)
-	{
-		int totalSize = 0;
-		for (const auto& [ipmac, color] : lights) {
-			QByteArray packet = buildLifxSetColorPacket(std::get<2>(ipmac), color, kelvin, duration_ms);
-			totalSize += packet.size();
-			socket.writeDatagram(packet, std::get<1>(ipmac), DEFAULT_FLIX_PORT);
-		}
-		return totalSize;
-	}
-
 	int sendLifxSetPower(QUdpSocket& socket,
 		const std::vector<DriverNetLifx::IpMacAddress>& lights,
 		uint16_t power)
@@ -231,6 +218,7 @@ namespace
 
 DriverNetLifx::DriverNetLifx(const QJsonObject& deviceConfig)
 	: ProviderUdp(deviceConfig),
+	bytesWritten(0),
 	transition(0)
 {
 }
@@ -356,6 +344,14 @@ bool DriverNetLifx::init(QJsonObject deviceConfig)
 		lamps.push_back(std::tuple<QString, QHostAddress, MacAddress>(lampName, address, mac.value()));
 	}
 
+	QStringList names;
+	for (const auto& lamp : lamps)
+		names.append(std::get<0>(lamp));
+
+	lampColors.assign(lamps.size(), linalg::vec<float, 3>{});
+	reactor = std::make_unique<BulbReactor>(_log, [this](int index) { return sendLamp(index); });
+	reactor->setBulbs(names, LAMP_MIN_INTERVAL_MS);
+
 	return isInitOK && (!lamps.empty());
 }
 
@@ -366,15 +362,33 @@ std::pair<bool, int> DriverNetLifx::writeInfiniteColors(SharedOutputColors nonli
 		return { true, 0 };
 	}
 
-	std::vector<std::pair<IpMacAddress, linalg::vec<float, 3>>> lights;
-
 	const size_t n = std::min(nonlinearRgbColors->size(), lamps.size());
 
+	bytesWritten = 0;
 	for (size_t i = 0; i < n; ++i) {
-		lights.push_back({lamps[i], (*nonlinearRgbColors)[i] });
+		lampColors[i] = (*nonlinearRgbColors)[i];
+		reactor->submit(static_cast<int>(i));
 	}
 
-	return { true, sendLifxColors(*_udpSocket, lights, WHITE_COLOR_TEMPERATURE, transition) };
+	// the reactor sends the due states now and the others later from its timer: the pacer follows the time spent sending
+	reportTransportWriteTime(reactor->takeSendTime());
+
+	return { true, bytesWritten };
+}
+
+BulbReactor::SendResult DriverNetLifx::sendLamp(int index)
+{
+	if (_udpSocket == nullptr)
+		return BulbReactor::SendResult::Failed;
+
+	const auto& lamp = lamps[index];
+	QByteArray packet = buildLifxSetColorPacket(std::get<2>(lamp), lampColors[index], WHITE_COLOR_TEMPERATURE, transition);
+
+	if (_udpSocket->writeDatagram(packet, std::get<1>(lamp), DEFAULT_FLIX_PORT) != packet.size())
+		return BulbReactor::SendResult::Failed;
+
+	bytesWritten += packet.size();
+	return BulbReactor::SendResult::Sent;
 }
 
 void DriverNetLifx::setPower(uint16_t power)
@@ -391,6 +405,11 @@ bool DriverNetLifx::powerOn()
 
 bool DriverNetLifx::powerOff()
 {
+	if (reactor != nullptr)
+	{
+		reactor->flush();
+		reactor->report();
+	}
 	setPower(POWER_OFF);
 	return true;
 }
@@ -450,4 +469,4 @@ LedDevice* DriverNetLifx::construct(const QJsonObject& deviceConfig)
 	return new DriverNetLifx(deviceConfig);
 }
 
-bool DriverNetLifx::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("lifx", "leds_group_2_network", DriverNetLifx::construct);
+bool DriverNetLifx::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("lifx", "leds_group_2_network", DriverNetLifx::construct, true);
@@ -596,4 +596,4 @@ LedDevice* DriverNetNanoleaf::construct(const QJsonObject& deviceConfig)
 	return new DriverNetNanoleaf(deviceConfig);
 }
 
-bool DriverNetNanoleaf::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("nanoleaf", "leds_group_2_network", DriverNetNanoleaf::construct);
+bool DriverNetNanoleaf::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("nanoleaf", "leds_group_2_network", DriverNetNanoleaf::construct, true);
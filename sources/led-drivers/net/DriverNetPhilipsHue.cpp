@@ -166,7 +166,12 @@ bool LedDevicePhilipsHueBridge::initRestAPI(const QString& hostname, int port, c
 		port = API_DEFAULT_PORT_V2;
 
 	if (_restApi == nullptr)
+	{
 		_restApi = std::make_unique<ProviderRestApi>(hostname, port);
+		_restApi->setAsyncErrorHandler(this, [this](const QString& reason) {
+			Warning(_log, "Light state update failed: {:s}", (reason));
+		});
+	}
 	else
 		_restApi->updateHost(hostname, port);
 
@@ -435,6 +440,12 @@ void LedDevicePhilipsHueBridge::setLightState(unsigned int lightId, const QStrin
 	post(QString("%1/%2/%3").arg(API_LIGHTS).arg(lightId).arg(API_STATE), state);
 }
 
+void LedDevicePhilipsHueBridge::setLightStateAsync(unsigned int lightId, const QString& state)
+{
+	DebugIf(verbose, _log, "SetLightStateAsync [{:d}]: {:s}", lightId, (state));
+	putAsync(QString("%1/%2/%3").arg(API_LIGHTS).arg(lightId).arg(API_STATE), state);
+}
+
 QJsonDocument LedDevicePhilipsHueBridge::getGroupState(unsigned int groupId)
 {
 	DebugIf(verbose, _log, "GetGroupState [{:d}]", groupId);
@@ -469,6 +480,16 @@ QJsonDocument LedDevicePhilipsHueBridge::post(const QString& route, const QStrin
 	return response.getBody();
 }
 
+void LedDevicePhilipsHueBridge::putAsync(const QString& route, const QString& content)
+{
+	if (_restApi == nullptr)
+		return;
+
+	// the writes for the same route are sent one after another, the latest state replaces the one still waiting
+	_restApi->setPath(route);
+	_restApi->putAsync(route, content);
+}
+
 bool LedDevicePhilipsHueBridge::isStreamOwner(const QString& streamOwner) const
 {
 	if (_apiV2)
@@ -1749,6 +1770,10 @@ int DriverNetPhilipsHue::writeSingleLightsGeneric(
 		idx++;
 	}
 
+	// the light states are put asynchronously: the pacer follows the round-trip reported by the REST helper
+	if (!_useHueEntertainmentAPI && _restApi != nullptr)
+		reportTransportWriteTime(_restApi->getLastRoundTrip() * 1000);
+
 	return 0;
 }
 
@@ -1906,14 +1931,12 @@ void DriverNetPhilipsHue::setState(PhilipsHueLight& light, bool on, const ColorX
 			_lastConfirm = _currentTime;
 		}
 
+		// the power off follows the color of the same light once the bridge has replied, the device thread does not wait
 		if (!stateCmd.isEmpty())
-			setLightState(light.getId(), "{" + stateCmd + "}");
+			setLightStateAsync(light.getId(), "{" + stateCmd + "}");
 
 		if (!powerCmd.isEmpty() && !on)
-		{
-			QThread::msleep(50);
-			setLightState(light.getId(), "{" + powerCmd + "}");
-		}
+			setLightStateAsync(light.getId(), "{" + powerCmd + "}");
 	}
 }
 
@@ -2210,4 +2233,4 @@ LedDevice* DriverNetPhilipsHue::construct(const QJsonObject& deviceConfig)
 	return new DriverNetPhilipsHue(deviceConfig);
 }
 
-bool DriverNetPhilipsHue::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("philipshue", "leds_group_2_network", DriverNetPhilipsHue::construct);
+bool DriverNetPhilipsHue::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("philipshue", "leds_group_2_network", DriverNetPhilipsHue::construct, true);
@@ -4,6 +4,8 @@
 	#include <arpa/inet.h>
 #endif
 
+#include <cstddef>
+
 #include <QHostInfo>
 #include <QUuid>
 
@@ -52,6 +54,7 @@ namespace
 	const uint8_t VECTOR_DMP_SET_PROPERTY = 0x02;
 	const uint32_t VECTOR_E131_DATA_PACKET = 0x00000002;
 	const int DMX_MAX = 512;
+	const size_t E131_SEQUENCE_OFFSET = offsetof(e131_packet_t, fields.sequence_number);
 }
 
 DriverNetUdpE131::DriverNetUdpE131(const QJsonObject& deviceConfig)
@@ -70,6 +73,12 @@ bool DriverNetUdpE131::init(QJsonObject deviceConfig)
 	if (ProviderUdp::init(deviceConfig))
 	{
 		_e131_universe = deviceConfig["universe"].toInt(1);
+
+		PacketWriter::Layout layout;
+		layout.headerSize = E131_DMP_DATA + 1;
+		layout.payloadSize = DMX_MAX;
+		_packetWriter.setLayout(layout);
+
 		_e131_source_name = deviceConfig["source-name"].toString("hyperhdr on " + QHostInfo::localHostName());
 		QString _json_cid = deviceConfig["cid"].toString("");
 
@@ -132,42 +141,33 @@ void DriverNetUdpE131::prepare(unsigned this_universe, unsigned this_dmxChannelC
 	e131_packet->fields.property_values[0] = 0;	// start code
 }
 
-int DriverNetUdpE131::writeFiniteColors(const std::vector<ColorRgb>& ledValues)
+void DriverNetUdpE131::preparePacket()
+{
+	for (size_t index = 0; index < _packetWriter.segmentCount(); index++)
+	{
+		prepare(_e131_universe + static_cast<unsigned>(index), static_cast<unsigned>(_packetWriter.segmentPayload(index)));
+		memcpy(_packetWriter.segment(index), e131_packet->raw, E131_DMP_DATA + 1);
+	}
+}
+
+int DriverNetUdpE131::writePacket()
 {
 	int retVal = 0;
-	int thisChannelCount = 0;
-	int dmxChannelCount = _ledRGBCount;
-	const uint8_t* rawdata = reinterpret_cast<const uint8_t*>(ledValues.data());
 
 	_e131_seq++;
 
-	for (int rawIdx = 0; rawIdx < dmxChannelCount; rawIdx++)
+	for (size_t index = 0; index < _packetWriter.segmentCount(); index++)
 	{
-		if (rawIdx % DMX_MAX == 0) // start of new packet
-		{
-			thisChannelCount = (dmxChannelCount - rawIdx < DMX_MAX) ? dmxChannelCount % DMX_MAX : DMX_MAX;
-			//			                       is this the last packet?         ?       ^^ last packet      : ^^ earlier packets
-
-			prepare(_e131_universe + rawIdx / DMX_MAX, thisChannelCount);
-			e131_packet->fields.sequence_number = _e131_seq;
-		}
+		uint8_t* packet = _packetWriter.segment(index);
+		const size_t thisChannelCount = _packetWriter.segmentPayload(index);
 
-		e131_packet->fields.property_values[1 + rawIdx % DMX_MAX] = rawdata[rawIdx];
+		packet[E131_SEQUENCE_OFFSET] = _e131_seq;
 
-		//     is this the      last byte of last packet    ||   last byte of other packets
-		if ((rawIdx == dmxChannelCount - 1) || (rawIdx % DMX_MAX == DMX_MAX - 1))
-		{
 #undef e131debug
 #if e131debug
-			Debug(_log, "send packet: rawidx {:d} dmxchannelcount {:d} universe: {:d}, packetsz {:d}"
-				, rawIdx
-				, dmxChannelCount
-				, _e131_universe + rawIdx / DMX_MAX
-				, E131_DMP_DATA + 1 + thisChannelCount
-			);
+		Debug(_log, "send packet: universe: {:d}, packetsz {:d}", _e131_universe + index, E131_DMP_DATA + 1 + thisChannelCount);
 #endif
-			retVal &= writeBytes(E131_DMP_DATA + 1 + thisChannelCount, e131_packet->raw);
-		}
+		retVal &= writeBytes(static_cast<unsigned>(E131_DMP_DATA + 1 + thisChannelCount), packet);
 	}
 
 	return retVal;
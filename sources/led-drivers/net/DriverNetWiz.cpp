@@ -41,11 +41,15 @@ namespace
 	constexpr int DEFAULT_WIZ_PORT = 38899;
 	constexpr int DISCOVERY_TIME_MS = 2000;
 	constexpr int DISCOVERY_POLL_MS = 50;
+
+	// the bulbs drop commands when flooded: keep every bulb below 20 updates per second
+	constexpr int LAMP_MIN_INTERVAL_MS = 50;
 }
 
 DriverNetWiz::DriverNetWiz(const QJsonObject& deviceConfig)
 	: ProviderUdp(deviceConfig)
 	, _dimming(100)
+	, _bytesWritten(0)
 {
 }
 
@@ -202,37 +206,57 @@ bool DriverNetWiz::init(QJsonObject deviceConfig)
 		_lamps.push_back(std::move(lamp));
 	}
 
+	QStringList names;
+	for (const auto& lamp : _lamps)
+		names.append(lamp.name.isEmpty() ? lamp.ipAddress.toString() : lamp.name);
+
+	_reactor = std::make_unique<BulbReactor>(_log, [this](int index) { return sendLamp(index); });
+	_reactor->setBulbs(names, LAMP_MIN_INTERVAL_MS);
+
 	return isInitOK && (!_lamps.empty());
 }
 
 int DriverNetWiz::writeFiniteColors(const std::vector<ColorRgb>& ledValues)
 {
-	if (ledValues.empty() || _lamps.empty() || _udpSocket == nullptr)
+	if (ledValues.empty() || _lamps.empty() || _udpSocket == nullptr || _reactor == nullptr)
 		return 0;
 
 	const size_t n = std::min(ledValues.size(), _lamps.size());
-	int totalSize = 0;
-	int rc = 0;
 
+	_bytesWritten = 0;
 	for (size_t i = 0; i < n; ++i)
 	{
-		const auto& c = ledValues[i];
-		const QByteArray packet = buildSetPilotPacket(static_cast<int>(c.red), static_cast<int>(c.green), static_cast<int>(c.blue));
-		totalSize += packet.size();
+		_lamps[i].color = ledValues[i];
+		_reactor->submit(static_cast<int>(i));
+	}
 
-		const qint64 written = _udpSocket->writeDatagram(packet, _lamps[i].ipAddress, _port);
-		if (written != packet.size())
-		{
-			rc = -1;
-			Warning(_log, "({:s}:{:d}) Write Error: ({:d}) {:s}",
-				(_lamps[i].ipAddress.toString()),
-				static_cast<int>(_port),
-				static_cast<int>(_udpSocket->error()),
-				(_udpSocket->errorString()));
-		}
+	// the reactor sends the due states now and the others later from its timer: the pacer follows the time spent sending
+	reportTransportWriteTime(_reactor->takeSendTime());
+
+	return _bytesWritten;
+}
+
+BulbReactor::SendResult DriverNetWiz::sendLamp(int index)
+{
+	if (_udpSocket == nullptr)
+		return BulbReactor::SendResult::Failed;
+
+	const auto& lamp = _lamps[index];
+	const QByteArray packet = buildSetPilotPacket(static_cast<int>(lamp.color.red), static_cast<int>(lamp.color.green), static_cast<int>(lamp.color.blue));
+
+	const qint64 written = _udpSocket->writeDatagram(packet, lamp.ipAddress, _port);
+	if (written != packet.size())
+	{
+		Warning(_log, "({:s}:{:d}) Write Error: ({:d}) {:s}",
+			(lamp.ipAddress.toString()),
+			static_cast<int>(_port),
+			static_cast<int>(_udpSocket->error()),
+			(_udpSocket->errorString()));
+		return BulbReactor::SendResult::Failed;
 	}
 
-	return (rc == 0) ? totalSize : -1;
+	_bytesWritten += packet.size();
+	return BulbReactor::SendResult::Sent;
 }
 
 bool DriverNetWiz::powerOn()
@@ -252,6 +276,9 @@ bool DriverNetWiz::powerOff()
 	if (_udpSocket == nullptr || _lamps.empty())
 		return true;
 
+	_reactor->flush();
+	_reactor->report();
+
 	const QByteArray packet = buildPowerPacket(false);
 	for (const auto& lamp : _lamps)
 		_udpSocket->writeDatagram(packet, lamp.ipAddress, _port);
@@ -310,4 +337,4 @@ LedDevice* DriverNetWiz::construct(const QJsonObject& deviceConfig)
 	return new DriverNetWiz(deviceConfig);
 }
 
-bool DriverNetWiz::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("wiz", "leds_group_2_network", DriverNetWiz::construct);
+bool DriverNetWiz::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("wiz", "leds_group_2_network", DriverNetWiz::construct, true);
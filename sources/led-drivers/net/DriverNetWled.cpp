@@ -284,4 +284,4 @@ LedDevice* DriverNetWled::construct(const QJsonObject& deviceConfig)
 	return new DriverNetWled(deviceConfig);
 }
 
-bool DriverNetWled::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("wled", "leds_group_2_network", DriverNetWled::construct);
+bool DriverNetWled::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("wled", "leds_group_2_network", DriverNetWled::construct, true);
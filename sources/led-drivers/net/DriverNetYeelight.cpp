@@ -92,6 +92,7 @@ YeelightLight::YeelightLight(const LoggerName& log, const QString& hostname, qui
 	, _tcpSocket(nullptr)
 	, _tcpStreamSocket(nullptr)
 	, _correlationID(0)
+	, _pendingReplyId(0)
 	, _lastWriteTime(InternalClock::now())
 	, _lastColorRgbValue(0)
 	, _transitionEffect(YeelightLight::API_EFFECT_SMOOTH)
@@ -126,9 +127,17 @@ void YeelightLight::setHostname(const QString& hostname, quint16 port = API_DEFA
 
 void YeelightLight::setStreamSocket(QTcpSocket* socket)
 {
+	if (_tcpStreamSocket != nullptr && _tcpStreamSocket != socket)
+		_tcpStreamSocket->deleteLater();
+
 	_tcpStreamSocket = socket;
 }
 
+bool YeelightLight::isStreamBusy() const
+{
+	return _tcpStreamSocket != nullptr && _tcpStreamSocket->bytesToWrite() > 0;
+}
+
 bool YeelightLight::open()
 {
 	_isInError = false;
@@ -203,6 +212,11 @@ int YeelightLight::writeCommand(const QJsonDocument& command, QJsonArray& result
 {
 	int rc = -1;
 
+	// a reply to a request sent without waiting must not be taken as the result of this command
+	if (_pendingReplyId != 0)
+		pollReply();
+	_pendingReplyId = 0;
+
 	if (!_isInError && _tcpSocket->isOpen())
 	{
 		qint64 bytesWritten = _tcpSocket->write(command.toJson(QJsonDocument::Compact) + "\r\n");
@@ -277,39 +291,99 @@ int YeelightLight::writeCommand(const QJsonDocument& command, QJsonArray& result
 	return rc;
 }
 
+bool YeelightLight::requestMusicMode(const QHostAddress& hostAddress, int port)
+{
+	if (_isInError || _tcpSocket == nullptr || !_tcpSocket->isOpen())
+		return false;
+
+	if (_pendingReplyId != 0)
+		pollReply();
+
+	QJsonArray paramlist = { API_METHOD_MUSIC_MODE_ON, hostAddress.toString(), port };
+	QJsonDocument command = getCommand(API_METHOD_MUSIC_MODE, paramlist);
+
+	// queued by the socket: the bulb confirms the request by connecting to the music mode server
+	if (_tcpSocket->write(command.toJson(QJsonDocument::Compact) + "\r\n") == -1)
+	{
+		this->setInError(QString("Write Error: %1").arg(_tcpSocket->errorString()));
+		return false;
+	}
+
+	_pendingReplyId = _correlationID;
+	_lastWriteTime = InternalClock::now();
+
+	return true;
+}
+
+int YeelightLight::pollReply()
+{
+	int rc = 1;
+
+	if (_pendingReplyId == 0)
+		return 0;
+
+	while (_tcpSocket != nullptr && _tcpSocket->canReadLine())
+	{
+		YeelightResponse yeeResponse = handleResponse(_pendingReplyId, _tcpSocket->readLine());
+
+		if (yeeResponse.error() == YeelightResponse::API_NOTIFICATION)
+			continue;
+
+		if (yeeResponse.error() == YeelightResponse::API_ERROR)
+		{
+			if (yeeResponse.getErrorCode() != -1)
+			{
+				this->setInError(QString("(%1) %2").arg(yeeResponse.getErrorCode()).arg(yeeResponse.getErrorReason()));
+				rc = -1;
+			}
+			else
+			{
+				//(-1) client quota exceeded
+				rc = -2;
+			}
+		}
+		else
+		{
+			rc = 0;
+		}
+
+		_pendingReplyId = 0;
+	}
+
+	return rc;
+}
+
 bool YeelightLight::streamCommand(const QJsonDocument& command)
 {
 	bool rc = false;
 
 	if (!_isInError && _tcpStreamSocket->isOpen())
 	{
-		qint64 bytesWritten = _tcpStreamSocket->write(command.toJson(QJsonDocument::Compact) + "\r\n");
-		if (bytesWritten == -1)
+		// the write is queued by the socket: the reactor waits for bytesWritten before it sends the next state
+		if (_tcpStreamSocket->state() != QAbstractSocket::ConnectedState)
 		{
-			this->setInError(QString("Streaming Error %1").arg(_tcpStreamSocket->errorString()));
+			_isInMusicMode = false;
+			rc = true;
 		}
-		else
+		else if (_tcpStreamSocket->write(command.toJson(QJsonDocument::Compact) + "\r\n") == -1)
 		{
-			if (!_tcpStreamSocket->waitForBytesWritten(WRITE_TIMEOUT.count()))
-			{
-				int error = _tcpStreamSocket->error();
-				QString errorReason = QString("(%1) %2").arg(error).arg(_tcpStreamSocket->errorString());
+			int error = _tcpStreamSocket->error();
+			QString errorReason = QString("(%1) %2").arg(error).arg(_tcpStreamSocket->errorString());
 
-				if (error == QAbstractSocket::RemoteHostClosedError)
-				{
-					_isInMusicMode = false;
-					rc = true;
-				}
-				else
-				{
-					this->setInError(errorReason);
-				}
+			if (error == QAbstractSocket::RemoteHostClosedError)
+			{
+				_isInMusicMode = false;
+				rc = true;
 			}
 			else
 			{
-				rc = true;
+				this->setInError(QString("Streaming Error %1").arg(errorReason));
 			}
 		}
+		else
+		{
+			rc = true;
+		}
 	}
 
 	//log (2,"streamCommand() rc","%d, isON[%d], isInMusicMode[%d]", rc, _isOn, _isInMusicMode );
@@ -970,6 +1044,7 @@ bool DriverNetYeelight::startMusicModeServer()
 	if (_tcpMusicModeServer == nullptr)
 	{
 		_tcpMusicModeServer = new QTcpServer(this);
+		connect(_tcpMusicModeServer, &QTcpServer::newConnection, this, [this]() { handleStreamConnection(); });
 	}
 
 	if (!_tcpMusicModeServer->isListening())
@@ -1109,6 +1184,9 @@ int DriverNetYeelight::close()
 
 	// LedDevice specific closing activities
 
+	if (_reactor != nullptr)
+		_reactor->report();
+
 	//Close all Yeelight lights
 	for (YeelightLight& light : _lights)
 	{
@@ -1150,6 +1228,15 @@ bool DriverNetYeelight::updateLights(const QVector<yeelightAddress>& list)
 			}
 		}
 		setLightsCount(static_cast<uint>(_lights.size()));
+
+		QStringList names;
+		for (const YeelightLight& light : _lights)
+			names.append(light.getName());
+
+		// music mode has no command quota: the stream socket backpressure is the only limit
+		_lightStates.assign(_lights.size(), LightState{});
+		_reactor = std::make_unique<BulbReactor>(_log, [this](int index) { return sendLight(index); });
+		_reactor->setBulbs(names, 0);
 		rc = true;
 	}
 	return rc;
@@ -1177,6 +1264,9 @@ bool DriverNetYeelight::powerOff()
 	{
 		writeBlack();
 
+		if (_reactor != nullptr)
+			_reactor->flush();
+
 		//Power-off all Yeelights
 		for (YeelightLight& light : _lights)
 		{
@@ -1283,73 +1373,125 @@ void DriverNetYeelight::identify(const QJsonObject& params)
 	}
 }
 
-int DriverNetYeelight::writeFiniteColors(const std::vector<ColorRgb>& ledValues)
+void DriverNetYeelight::handleStreamConnection()
 {
-	//DebugIf(verbose, _log, "enabled [{:d}], _isDeviceReady [{:d}]", _isEnabled, _isDeviceReady);
-	int rc = -1;
-
-	//Update on all Yeelights by iterating through lights and set colors.
-	unsigned int idx = 0;
-	int lightsInError = 0;
-	for (YeelightLight& light : _lights)
+	while (_tcpMusicModeServer != nullptr && _tcpMusicModeServer->hasPendingConnections())
 	{
-		// Get color
-		ColorRgb color = ledValues.at(idx);
+		QTcpSocket* socket = _tcpMusicModeServer->nextPendingConnection();
+		int index = -1, awaiting = 0, lastAwaiting = -1;
 
-		if (light.isReady())
-		{
-			bool skipWrite = false;
-			if (!light.isInMusicMode())
+		for (int i = 0; i < static_cast<int>(_lights.size()); i++)
+			if (_lightStates[i].streamRequested != 0)
 			{
-				if (light.setMusicMode(true, _musicModeServerAddress, _musicModeServerPort))
-				{
-					// Wait for callback of the device to establish streaming socket
-					if (_tcpMusicModeServer->waitForNewConnection(CONNECT_STREAM_TIMEOUT.count()))
-					{
-						light.setStreamSocket(_tcpMusicModeServer->nextPendingConnection());
-					}
-					else
-					{
-						QString errorReason = QString("(%1) %2").arg(_tcpMusicModeServer->serverError()).arg(_tcpMusicModeServer->errorString());
-						if (_tcpMusicModeServer->serverError() == QAbstractSocket::TemporaryError)
-						{
-							Info(_log, "Ignore write Error [{:s}]: _tcpMusicModeServer: {:s}", (light.getName()), (errorReason));
-							skipWrite = true;
-						}
-						else
-						{
-							Warning(_log, "write Error [{:s}]: _tcpMusicModeServer: {:s}", (light.getName()), (errorReason));
-							light.setInError("Failed to get stream socket");
-						}
-					}
-				}
-				else
-				{
-					DebugIf(verbose, _log, "setMusicMode failed due to command quota issue, skip write and try with next");
-					skipWrite = true;
-				}
+				awaiting++;
+				lastAwaiting = i;
+				if (QHostAddress(_lights[i].getHost()).isEqual(socket->peerAddress(), QHostAddress::TolerantConversion))
+					index = i;
 			}
 
-			if (!skipWrite)
+		if (index < 0 && awaiting == 1)
+			index = lastAwaiting;
+
+		if (index < 0)
+		{
+			Warning(_log, "Unexpected stream connection from {:s}", (socket->peerAddress().toString()));
+			socket->abort();
+			socket->deleteLater();
+			continue;
+		}
+
+		_lightStates[index].streamRequested = 0;
+		_lights[index].setStreamSocket(socket);
+
+		connect(socket, &QTcpSocket::bytesWritten, this, [this, socket, index]() {
+			if (socket->bytesToWrite() == 0 && _reactor != nullptr)
+				_reactor->kick(index);
+		});
+
+		_reactor->kick(index);
+	}
+}
+
+BulbReactor::SendResult DriverNetYeelight::sendLight(int index)
+{
+	YeelightLight& light = _lights[index];
+	LightState& state = _lightStates[index];
+
+	if (!light.isReady())
+		return BulbReactor::SendResult::Failed;
+
+	if (!light.isInMusicMode())
+	{
+		qint64 now = InternalClock::now();
+
+		// waiting for the callback of the device to establish the streaming socket
+		if (state.streamRequested != 0)
+		{
+			// the reply only matters when the bulb refused the request, the success is the incoming connection
+			int reply = light.pollReply();
+
+			if (reply < 0)
 			{
-				// Update light with given color
-				if (_outputColorModel == MODEL_RGB)
-				{
-					light.setColorRGB(color);
-				}
-				else
-				{
-					light.setColorHSV(color);
-				}
+				state.streamRequested = 0;
+				DebugIf(verbose, _log, "Music mode request refused by [{:s}] ({:s}), skip write and try with next", light.getName(), (reply == -2) ? "quota" : "error");
+				return BulbReactor::SendResult::Failed;
 			}
+
+			if (now - state.streamRequested < CONNECT_STREAM_TIMEOUT.count())
+				return BulbReactor::SendResult::Busy;
+
+			Info(_log, "Ignore write Error [{:s}]: no stream connection, will retry", (light.getName()));
+			state.streamRequested = 0;
+		}
+
+		// music mode negotiation counts against the command quota of the bulb
+		if (now < state.nextStreamAttempt)
+			return BulbReactor::SendResult::Failed;
+
+		state.nextStreamAttempt = now + std::max(_waitTimeQuota, static_cast<int>(CONNECT_STREAM_TIMEOUT.count()));
+
+		if (light.requestMusicMode(_musicModeServerAddress, _musicModeServerPort))
+		{
+			state.streamRequested = now;
+			return BulbReactor::SendResult::Busy;
+		}
+
+		DebugIf(verbose, _log, "The music mode request could not be sent, skip write and try with next");
+		return BulbReactor::SendResult::Failed;
+	}
+
+	if (light.isStreamBusy())
+		return BulbReactor::SendResult::Busy;
+
+	// Update light with given color
+	bool writeOK = (_outputColorModel == MODEL_RGB) ? light.setColorRGB(state.color) : light.setColorHSV(state.color);
+
+	return (writeOK) ? BulbReactor::SendResult::Sent : BulbReactor::SendResult::Failed;
+}
+
+int DriverNetYeelight::writeFiniteColors(const std::vector<ColorRgb>& ledValues)
+{
+	//DebugIf(verbose, _log, "enabled [{:d}], _isDeviceReady [{:d}]", _isEnabled, _isDeviceReady);
+	int rc = -1;
+
+	//Update on all Yeelights: every light is written independently by the reactor, a slow one only delays itself
+	int lightsInError = 0;
+	for (int idx = 0; idx < static_cast<int>(_lights.size()); ++idx)
+	{
+		if (_lights[idx].isReady())
+		{
+			_lightStates[idx].color = ledValues.at(idx);
+			_reactor->submit(idx);
 		}
 		else
 		{
 			++lightsInError;
 		}
-		++idx;
 	}
 
+	// the reactor sends the due states now and the others later from its timer: the pacer follows the time spent sending
+	reportTransportWriteTime(_reactor->takeSendTime());
+
 	if (!(lightsInError < static_cast<int>(_lights.size())))
 	{
 		this->setInError("All Yeelights in error - stopping device!");
@@ -1375,4 +1517,4 @@ LedDevice* DriverNetYeelight::construct(const QJsonObject& deviceConfig)
 	return new DriverNetYeelight(deviceConfig);
 }
 
-bool DriverNetYeelight::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("yeelight", "leds_group_2_network", DriverNetYeelight::construct);
+bool DriverNetYeelight::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("yeelight", "leds_group_2_network", DriverNetYeelight::construct, true);
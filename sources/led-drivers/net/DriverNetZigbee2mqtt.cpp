@@ -336,4 +336,4 @@ LedDevice* DriverNetZigbee2mqtt::construct(const QJsonObject& deviceConfig)
 	return new DriverNetZigbee2mqtt(deviceConfig);
 }
 
-bool DriverNetZigbee2mqtt::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("zigbee2mqtt", "leds_group_2_network", DriverNetZigbee2mqtt::construct);
+bool DriverNetZigbee2mqtt::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("zigbee2mqtt", "leds_group_2_network", DriverNetZigbee2mqtt::construct, true);
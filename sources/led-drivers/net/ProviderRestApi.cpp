@@ -58,6 +58,14 @@ ProviderRestApi::ProviderRestApi(const QString& host, int port, const QString& b
 	_basePath = basePath;
 
 	_workerThread = NetworkHelper::threadFactory();
+
+	_networkHelper = new NetworkHelper();
+	_networkHelper->moveToThread(_workerThread.get());
+}
+
+ProviderRestApi::~ProviderRestApi()
+{
+	_networkHelper->deleteLater();
 }
 
 ProviderRestApi::ProviderRestApi(QString scheme, QString host, int port, QString basePath)
@@ -160,6 +168,43 @@ const QMap<QString, QString>& ProviderRestApi::getHeaders() {
 	return _headers;
 }
 
+void ProviderRestApi::putAsync(const QString& key, const QString& body)
+{
+	executeAsync(QNetworkAccessManager::PutOperation, key, body);
+}
+
+void ProviderRestApi::postAsync(const QString& key, const QString& body)
+{
+	executeAsync(QNetworkAccessManager::PostOperation, key, body);
+}
+
+void ProviderRestApi::setAsyncErrorHandler(QObject* context, std::function<void(const QString&)> handler)
+{
+	QObject::connect(_networkHelper, &NetworkHelper::SignalAsyncError, context, [handler](QString reason) { handler(reason); }, Qt::QueuedConnection);
+}
+
+ProviderRestApi::RoundTripStats ProviderRestApi::getRoundTripStats(bool reset)
+{
+	return _networkHelper->getRoundTripStats(reset);
+}
+
+qint64 ProviderRestApi::getLastRoundTrip() const
+{
+	return _networkHelper->getLastRoundTrip();
+}
+
+void ProviderRestApi::executeAsync(QNetworkAccessManager::Operation op, const QString& key, const QString& body)
+{
+	// the caller does not wait for the reply: requests for the same key are coalesced by the helper, the latest body wins
+	NetworkHelper* networkHelper = _networkHelper;
+	QUrl url = getUrl();
+	QMap<QString, QString> headers = _headers;
+
+	QMetaObject::invokeMethod(networkHelper, [=]() {
+		networkHelper->executeAsync(op, key, url, body, headers);
+	}, Qt::QueuedConnection);
+}
+
 httpResponse ProviderRestApi::executeOperation(QNetworkAccessManager::Operation op, const QUrl& url, const QString& body)
 {
 	auto response = std::make_shared<httpResponse>();
@@ -177,9 +222,7 @@ httpResponse ProviderRestApi::executeOperation(QNetworkAccessManager::Operation
 	Debug(_log, "{:s} begin: [{:s}] [{:s}]", (opCode), (url.toString()), (body));
 
 	// Perform request
-	NetworkHelper* networkHelper(new NetworkHelper());
-
-	networkHelper->moveToThread(_workerThread.get());
+	NetworkHelper* networkHelper = _networkHelper;
 
 	_resultLocker.lock();
 
@@ -205,8 +248,6 @@ httpResponse ProviderRestApi::executeOperation(QNetworkAccessManager::Operation
 	else
 		Debug(_log, "Reply OK [{:d}]", response->getHttpStatusCode());
 
-	networkHelper->deleteLater();
-
 	return *response;
 }
 
@@ -246,62 +287,196 @@ void NetworkHelper::abortOperation()
 NetworkHelper::NetworkHelper() :
 	_networkManager(nullptr),
 	_networkReply(nullptr),
-	_timeout(false)
+	_timeout(false),
+	_requests(0),
+	_coalesced(0),
+	_failed(0),
+	_roundTripSum(0),
+	_roundTripMax(0),
+	_lastRoundTrip(0)
 {
 }
 
 NetworkHelper::~NetworkHelper()
 {
+	_asyncSlots.clear();
 	delete _networkReply;
 	delete _networkManager;
 }
 
-void NetworkHelper::executeOperation(ProviderRestApi* parent, QNetworkAccessManager::Operation op, QUrl url, QString body, std::shared_ptr<httpResponse> response)
+QNetworkAccessManager* NetworkHelper::getNetworkManager()
+{
+	// one long-lived manager per device: it keeps the connections (and the TLS sessions) alive between requests
+	if (_networkManager == nullptr)
+	{
+		_networkManager = new QNetworkAccessManager(this);
+
+		connect(_networkManager, &QNetworkAccessManager::sslErrors, this, [](QNetworkReply* reply, const QList<QSslError>& errors) {
+			reply->ignoreSslErrors(errors);
+		});
+	}
+
+	return _networkManager;
+}
+
+QNetworkReply* NetworkHelper::sendRequest(QNetworkAccessManager::Operation op, const QUrl& url, const QString& body, const QMap<QString, QString>& headers)
 {
 	QNetworkRequest request(url);
 
-	QMapIterator<QString, QString> i = parent->getHeaders();
+	QMapIterator<QString, QString> i = headers;
 	while (i.hasNext())
 	{
 		i.next();
 		request.setRawHeader(i.key().toUtf8(), i.value().toUtf8());
 	}
 
-	_networkManager = new QNetworkAccessManager();
+	request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+
+	QNetworkAccessManager* manager = getNetworkManager();
+
+	return (op == QNetworkAccessManager::PutOperation) ? manager->put(request, body.toUtf8()) :
+		(op == QNetworkAccessManager::PostOperation) ? manager->post(request, body.toUtf8()) : manager->get(request);
+}
+
+void NetworkHelper::registerRoundTrip(qint64 begin)
+{
+	qint64 roundTrip = InternalClock::nowPrecise() - begin;
 
-	connect(_networkManager, &QNetworkAccessManager::sslErrors, this, [](QNetworkReply* reply, const QList<QSslError>& errors) {
-		reply->ignoreSslErrors(errors);
+	_requests++;
+	_lastRoundTrip = roundTrip;
+	_roundTripSum += roundTrip;
+	if (roundTrip > _roundTripMax)
+		_roundTripMax = roundTrip;
+}
+
+ProviderRestApi::RoundTripStats NetworkHelper::getRoundTripStats(bool reset)
+{
+	ProviderRestApi::RoundTripStats stats;
+
+	stats.requests = (reset) ? _requests.exchange(0) : _requests.load();
+	stats.coalesced = (reset) ? _coalesced.exchange(0) : _coalesced.load();
+	stats.failed = (reset) ? _failed.exchange(0) : _failed.load();
+	qint64 sum = (reset) ? _roundTripSum.exchange(0) : _roundTripSum.load();
+	stats.maxMs = (reset) ? _roundTripMax.exchange(0) : _roundTripMax.load();
+	stats.averageMs = (stats.requests > 0) ? sum / static_cast<double>(stats.requests) : 0;
+
+	return stats;
+}
+
+qint64 NetworkHelper::getLastRoundTrip() const
+{
+	return _lastRoundTrip;
+}
+
+void NetworkHelper::executeOperation(ProviderRestApi* parent, QNetworkAccessManager::Operation op, QUrl url, QString body, std::shared_ptr<httpResponse> response)
+{
+	// a synchronous request (power on/off, state restore) supersedes the coalesced writes that are still waiting
+	for (auto& slot : _asyncSlots)
+		if (slot.hasPending)
+		{
+			slot.hasPending = false;
+			_coalesced++;
+		}
+
+	qint64 begin = InternalClock::nowPrecise();
+
+	_timeout = false;
+	_networkReply = sendRequest(op, url, body, parent->getHeaders());
+
+	connect(_networkReply, &QNetworkReply::finished, this, [this, response, parent, begin]() {
+		registerRoundTrip(begin);
+		getResponse(_networkReply, _timeout, response.get());
+		_networkReply = nullptr;
+		parent->releaseResultLock();
+	}, Qt::DirectConnection);
+}
+
+void NetworkHelper::executeAsync(QNetworkAccessManager::Operation op, QString key, QUrl url, QString body, QMap<QString, QString> headers)
+{
+	AsyncSlot& slot = _asyncSlots[key];
+
+	if (slot.hasPending)
+		_coalesced++;
+
+	slot.hasPending = true;
+	slot.op = op;
+	slot.url = url;
+	slot.body = body;
+	slot.headers = headers;
+
+	if (!slot.inFlight)
+		sendAsync(key);
+}
+
+void NetworkHelper::sendAsync(const QString& key)
+{
+	auto found = _asyncSlots.find(key);
+	if (found == _asyncSlots.end())
+		return;
+
+	AsyncSlot& slot = found.value();
+	if (!slot.hasPending)
+	{
+		_asyncSlots.erase(found);
+		return;
+	}
+
+	qint64 begin = InternalClock::nowPrecise();
+	QNetworkReply* reply = sendRequest(slot.op, slot.url, slot.body, slot.headers);
+
+	slot.inFlight = true;
+	slot.hasPending = false;
+	slot.body.clear();
+
+	QTimer::singleShot(TIMEOUT, reply, [reply]() {
+		reply->setProperty("timeout", true);
+		reply->abort();
 	});
 
-	_networkReply = (op == QNetworkAccessManager::PutOperation) ? _networkManager->put(request, body.toUtf8()) :
-		(op == QNetworkAccessManager::PostOperation) ? _networkManager->post(request, body.toUtf8()) : _networkManager->get(request);
+	connect(reply, &QNetworkReply::finished, this, [this, reply, key, begin]() {
+		registerRoundTrip(begin);
+
+		httpResponse response;
+		getResponse(reply, reply->property("timeout").toBool(), &response);
+
+		if (response.error())
+		{
+			_failed++;
+			emit SignalAsyncError(response.getErrorReason());
+		}
 
-	connect(_networkReply, &QNetworkReply::finished, this, [this, response, parent]() {getResponse(response.get());  parent->releaseResultLock(); }, Qt::DirectConnection);
+		auto current = _asyncSlots.find(key);
+		if (current != _asyncSlots.end())
+		{
+			current.value().inFlight = false;
+			sendAsync(key);
+		}
+	});
 }
 
-void NetworkHelper::getResponse(httpResponse* response)
+void NetworkHelper::getResponse(QNetworkReply* reply, bool timeout, httpResponse* response)
 {
-	if (_networkReply != nullptr)
+	if (reply != nullptr)
 	{
-		int httpStatusCode = (_timeout) ? 408 : _networkReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+		int httpStatusCode = (timeout) ? 408 : reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
 		response->setHttpStatusCode(httpStatusCode);
 
 		QMap<QString, QString> headers;
-		for (const auto& item: _networkReply->rawHeaderPairs())
+		for (const auto& item: reply->rawHeaderPairs())
 		{
 			headers[item.first] = item.second;
 		}
 		response->setHeaders(headers);
 
-		if (_timeout)
+		if (timeout)
 			response->setNetworkReplyError(QNetworkReply::TimeoutError);
 		else
-			response->setNetworkReplyError(_networkReply->error());
+			response->setNetworkReplyError(reply->error());
 
-		if (_networkReply->error() == QNetworkReply::NoError)
+		if (reply->error() == QNetworkReply::NoError)
 		{
 			if (httpStatusCode != 204) {
-				QByteArray replyData = _networkReply->readAll();
+				QByteArray replyData = reply->readAll();
 
 				if (!replyData.isEmpty())
 				{
@@ -324,7 +499,7 @@ void NetworkHelper::getResponse(httpResponse* response)
 		{
 			if (httpStatusCode > 0)
 			{
-				QString httpReason = _networkReply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString();
+				QString httpReason = reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString();
 				QString advise;
 				switch (httpStatusCode) {
 					case 400:
@@ -347,16 +522,13 @@ void NetworkHelper::getResponse(httpResponse* response)
 			}
 			else
 			{
-				response->setErrorReason(_networkReply->errorString());
+				response->setErrorReason(reply->errorString());
 			}
 			response->setError(true);
 		}
 
-		// clean up
-		_networkReply->deleteLater();
-		_networkReply = nullptr;
-		_networkManager->deleteLater();
-		_networkManager = nullptr;
+		// clean up: the network manager stays alive so the connection can be reused
+		reply->deleteLater();
 	}
 }
 
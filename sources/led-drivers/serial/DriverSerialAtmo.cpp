@@ -44,4 +44,4 @@ LedDevice* DriverSerialAtmo::construct(const QJsonObject& deviceConfig)
 	return new DriverSerialAtmo(deviceConfig);
 }
 
-bool DriverSerialAtmo::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("atmo", "leds_group_3_serial", DriverSerialAtmo::construct);
+bool DriverSerialAtmo::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("atmo", "leds_group_3_serial", DriverSerialAtmo::construct, true);
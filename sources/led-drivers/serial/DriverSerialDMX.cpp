@@ -109,4 +109,4 @@ LedDevice* DriverSerialDMX::construct(const QJsonObject& deviceConfig)
 	return new DriverSerialDMX(deviceConfig);
 }
 
-bool DriverSerialDMX::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("dmx", "leds_group_3_serial", DriverSerialDMX::construct);
+bool DriverSerialDMX::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("dmx", "leds_group_3_serial", DriverSerialDMX::construct, true);
@@ -60,4 +60,4 @@ LedDevice* DriverSerialKarate::construct(const QJsonObject& deviceConfig)
 	return new DriverSerialKarate(deviceConfig);
 }
 
-bool DriverSerialKarate::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("karate", "leds_group_3_serial", DriverSerialKarate::construct);
+bool DriverSerialKarate::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("karate", "leds_group_3_serial", DriverSerialKarate::construct, true);
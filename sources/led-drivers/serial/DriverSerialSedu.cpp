@@ -58,4 +58,4 @@ LedDevice* DriverSerialSedu::construct(const QJsonObject& deviceConfig)
 	return new DriverSerialSedu(deviceConfig);
 }
 
-bool DriverSerialSedu::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("sedu", "leds_group_3_serial", DriverSerialSedu::construct);
+bool DriverSerialSedu::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("sedu", "leds_group_3_serial", DriverSerialSedu::construct, true);
@@ -37,4 +37,4 @@ LedDevice* DriverSerialTpm2::construct(const QJsonObject& deviceConfig)
 	return new DriverSerialTpm2(deviceConfig);
 }
 
-bool DriverSerialTpm2::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("tpm2", "leds_group_3_serial", DriverSerialTpm2::construct);
+bool DriverSerialTpm2::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("tpm2", "leds_group_3_serial", DriverSerialTpm2::construct, true);
@@ -18,6 +18,7 @@
 #include <utils/GlobalSignals.h>
 
 #include <led-drivers/serial/EspTools.h>
+#include <led-drivers/serial/SerialAsyncWriter.h>
 
 // Constants
 constexpr std::chrono::milliseconds WRITE_TIMEOUT{ 1000 };	// device write timeout in ms
@@ -34,6 +35,8 @@ ProviderSerial::ProviderSerial(const QJsonObject& deviceConfig)
 	, _frameDropCounter(0)
 	, _espHandshake(true)
 	, _forceSerialDetection(false)
+	, _asyncWrite(false)
+	, _asyncBackpressure(false)
 {
 }
 
@@ -63,6 +66,14 @@ bool ProviderSerial::init(QJsonObject deviceConfig)
 		_espHandshake = deviceConfig["espHandshake"].toBool(false);
 		_maxRetry = _devConfig["maxRetry"].toInt(60);
 		_forceSerialDetection = deviceConfig["forceSerialDetection"].toBool(false);
+		_asyncWrite = deviceConfig["asyncWrite"].toBool(false);
+		_asyncBackpressure = deviceConfig["asyncBackpressure"].toBool(false);
+
+		if (_asyncWrite && !SerialAsyncWriter::isSupported())
+		{
+			Warning(_log, "The asynchronous serial writer is not supported on this platform");
+			_asyncWrite = false;
+		}
 
 		Debug(_log, "Device name   : {:s}", (_deviceName));
 		Debug(_log, "Auto selection: {:d}", _isAutoDeviceName);
@@ -70,6 +81,7 @@ bool ProviderSerial::init(QJsonObject deviceConfig)
 		Debug(_log, "ESP handshake : {:s}", (_espHandshake) ? "ON" : "OFF");
 		Debug(_log, "Force ESP/Pico Detection : {:s}", (_forceSerialDetection) ? "ON" : "OFF");
 		Debug(_log, "Delayed open  : {:d}", _delayAfterConnect_ms);
+		Debug(_log, "Async writer  : {:s}", (_asyncWrite) ? ((_asyncBackpressure) ? "ON (backpressure)" : "ON") : "OFF");
 		Debug(_log, "Retry limit   : {:d}", _maxRetry);
 
 		if (_defaultInterval > 0)
@@ -82,6 +94,8 @@ bool ProviderSerial::init(QJsonObject deviceConfig)
 
 ProviderSerial::~ProviderSerial()
 {
+	stopAsyncWriter();
+
 	if (_serialPort != nullptr && _serialPort->isOpen())
 		_serialPort->close();
 
@@ -102,6 +116,8 @@ int ProviderSerial::open()
 	// open device physically
 	if (tryOpen(_delayAfterConnect_ms))
 	{
+		startAsyncWriter();
+
 		// Everything is OK, device is ready
 		_isDeviceReady = true;
 		retval = 0;
@@ -139,6 +155,8 @@ int ProviderSerial::close()
 
 	_isDeviceReady = false;
 
+	stopAsyncWriter();
+
 	if (_serialPort != nullptr && _serialPort->isOpen())
 	{
 		if (_serialPort->flush())
@@ -266,6 +284,27 @@ void ProviderSerial::setInError(const QString& errorMsg)
 	LedDevice::setInError(errorMsg);
 }
 
+void ProviderSerial::startAsyncWriter()
+{
+	if (!_asyncWrite || _serialPort == nullptr || !_serialPort->isOpen())
+		return;
+
+	if (_asyncWriter == nullptr)
+		_asyncWriter = std::make_unique<SerialAsyncWriter>(_log);
+
+	if (!_asyncWriter->isRunning() && !_asyncWriter->start(_serialPort->handle(), _asyncBackpressure, _baudRate_Hz))
+	{
+		Warning(_log, "Could not start the asynchronous serial writer, falling back to the synchronous mode");
+		_asyncWriter.reset();
+	}
+}
+
+void ProviderSerial::stopAsyncWriter()
+{
+	if (_asyncWriter != nullptr)
+		_asyncWriter->stop();
+}
+
 int ProviderSerial::writeBytes(const qint64 size, const uint8_t* data)
 {
 	int rc = 0;
@@ -277,7 +316,27 @@ int ProviderSerial::writeBytes(const qint64 size, const uint8_t* data)
 		{
 			return -1;
 		}
+
+		startAsyncWriter();
+	}
+
+	// the writer thread owns the port now: only hand over the newest frame
+	if (_asyncWriter != nullptr && _asyncWriter->isRunning())
+	{
+		QString errorMessage;
+		if (_asyncWriter->hasError(errorMessage))
+		{
+			this->setInError(errorMessage);
+			if (_maxRetry > 0 && !_signalTerminate)
+				QTimer::singleShot(2000, this, [this]() { if (!_signalTerminate) enable(); });
+			return -1;
+		}
+
+		_asyncWriter->submit(data, static_cast<size_t>(size));
+		reportTransportWriteTime(_asyncWriter->getCompletionTime());
+		return static_cast<int>(size);
 	}
+
 	qint64 bytesWritten = _serialPort->write(reinterpret_cast<const char*>(data), size);
 	if (bytesWritten == -1 || bytesWritten != size)
 	{
@@ -0,0 +1,334 @@
+/* SerialAsyncWriter.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <algorithm>
+	#include <chrono>
+	#include <cstring>
+#endif
+
+#ifndef _WIN32
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <sys/ioctl.h>
+	#include <termios.h>
+	#include <unistd.h>
+#endif
+
+#include <led-drivers/serial/SerialAsyncWriter.h>
+#include <utils/InternalClock.h>
+
+namespace
+{
+	constexpr int WRITE_TIMEOUT_MS = 1000;
+	constexpr int POLL_TIMEOUT_MS = 100;
+}
+
+SerialAsyncWriter::SerialAsyncWriter(const LoggerName& log) :
+	_log(log),
+	_fd(-1),
+	_backpressure(false),
+	_baudRate(115200),
+	_hasPending(false),
+	_running(false),
+	_error(false),
+	_frames(0),
+	_replaced(0),
+	_bytes(0),
+	_writeTime(0),
+	_completionTime(0)
+{
+}
+
+SerialAsyncWriter::~SerialAsyncWriter()
+{
+	stop();
+}
+
+bool SerialAsyncWriter::isSupported()
+{
+#ifndef _WIN32
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool SerialAsyncWriter::start(qintptr handle, bool backpressure, int baudRate)
+{
+	stop();
+
+#ifndef _WIN32
+	int fd = static_cast<int>(handle);
+	if (fd < 0)
+		return false;
+
+	// QSerialPort opens the tty as non-blocking already, but the writer must not depend on it
+	int flags = fcntl(fd, F_GETFL, 0);
+	if (flags < 0 || ((flags & O_NONBLOCK) == 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0))
+	{
+		Error(_log, "Could not switch the serial port to the non-blocking mode: {:s}", std::strerror(errno));
+		return false;
+	}
+
+	_fd = fd;
+	_backpressure = backpressure;
+	_baudRate = std::max(baudRate, 1);
+	_hasPending = false;
+	_running = true;
+	_error = false;
+	_errorMessage.clear();
+	_thread = std::thread(&SerialAsyncWriter::run, this);
+
+	Info(_log, "Asynchronous serial writer started (backpressure: {:s})", (_backpressure) ? "enabled" : "disabled");
+	return true;
+#else
+	Q_UNUSED(handle);
+	Q_UNUSED(backpressure);
+	Q_UNUSED(baudRate);
+	return false;
+#endif
+}
+
+void SerialAsyncWriter::stop()
+{
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+		if (!_running)
+			return;
+		_running = false;
+	}
+	_signal.notify_all();
+
+	// the pending frame (usually the final black one) is still written before the thread exits
+	if (_thread.joinable())
+		_thread.join();
+
+	_fd = -1;
+
+	auto stats = getStats(true);
+	Info(_log, "Asynchronous serial writer stopped: frames = {:d}, replaced = {:d}, bytes = {:d}, avg write = {:.2f}ms",
+		stats.frames, stats.replaced, stats.bytes, stats.averageWriteMs);
+}
+
+bool SerialAsyncWriter::isRunning() const
+{
+	return _thread.joinable();
+}
+
+void SerialAsyncWriter::submit(const uint8_t* data, size_t size)
+{
+	{
+		std::lock_guard<std::mutex> guard(_lock);
+
+		if (_hasPending)
+			_replaced++;
+
+		_pending.assign(data, data + size);
+		_hasPending = true;
+	}
+	_signal.notify_one();
+}
+
+bool SerialAsyncWriter::hasError(QString& errorMessage)
+{
+	if (!_error)
+		return false;
+
+	std::lock_guard<std::mutex> guard(_lock);
+	errorMessage = _errorMessage;
+	return true;
+}
+
+SerialAsyncWriter::Stats SerialAsyncWriter::getStats(bool reset)
+{
+	Stats stats;
+
+	stats.frames = (reset) ? _frames.exchange(0) : _frames.load();
+	stats.replaced = (reset) ? _replaced.exchange(0) : _replaced.load();
+	stats.bytes = (reset) ? _bytes.exchange(0) : _bytes.load();
+	qint64 writeTime = (reset) ? _writeTime.exchange(0) : _writeTime.load();
+	stats.averageWriteMs = (stats.frames > 0) ? writeTime / (1000.0 * stats.frames) : 0;
+
+	return stats;
+}
+
+qint64 SerialAsyncWriter::getCompletionTime() const
+{
+	return _completionTime;
+}
+
+void SerialAsyncWriter::run()
+{
+	std::unique_lock<std::mutex> guard(_lock);
+
+	while (true)
+	{
+		_signal.wait(guard, [this]() { return _hasPending || !_running; });
+
+		if (!_hasPending)
+			break;
+
+		if (_error)
+		{
+			_hasPending = false;
+			continue;
+		}
+
+		std::swap(_pending, _sending);
+		_hasPending = false;
+		guard.unlock();
+
+		qint64 taken = InternalClock::nowMicro();
+
+		bool ok = true;
+		if (_backpressure && !waitForQueue(_sending.size()))
+			ok = false;
+
+		// a newer frame may have arrived while waiting for the line: send that one instead
+		guard.lock();
+		if (ok && _hasPending && _running)
+		{
+			_replaced++;
+			continue;
+		}
+		guard.unlock();
+
+		if (ok)
+		{
+			qint64 begin = InternalClock::nowMicro();
+
+			ok = writeFrame(_sending);
+
+			qint64 end = InternalClock::nowMicro();
+			_writeTime += end - begin;
+			_completionTime = end - taken;
+			_frames++;
+			_bytes += static_cast<qint64>(_sending.size());
+		}
+
+		guard.lock();
+	}
+}
+
+bool SerialAsyncWriter::waitForQueue(size_t frameSize)
+{
+#if !defined(_WIN32) && defined(TIOCOUTQ)
+	const qint64 deadline = InternalClock::now() + WRITE_TIMEOUT_MS;
+	const int threshold = static_cast<int>(frameSize / 4);
+
+	while (true)
+	{
+		int queued = 0;
+		if (ioctl(_fd, TIOCOUTQ, &queued) < 0 || queued <= threshold)
+			return true;
+
+		if (InternalClock::now() > deadline)
+			break;
+
+		// 10 bits per byte on the line (8N1): sleep until the queue is expected to drain to the threshold
+		int drainUs = static_cast<int>((static_cast<int64_t>(queued - threshold) * 10 * 1000000) / _baudRate);
+		std::this_thread::sleep_for(std::chrono::microseconds(std::clamp(drainUs, 100, 5000)));
+	}
+
+	std::lock_guard<std::mutex> guard(_lock);
+	_errorMessage = QString("Timeout waiting for the serial output queue to drain");
+	_error = true;
+	return false;
+#else
+	Q_UNUSED(frameSize);
+	return true;
+#endif
+}
+
+bool SerialAsyncWriter::writeFrame(const std::vector<uint8_t>& frame)
+{
+#ifndef _WIN32
+	const uint8_t* data = frame.data();
+	size_t remaining = frame.size();
+	int waited = 0;
+
+	while (remaining > 0)
+	{
+		ssize_t written = ::write(_fd, data, remaining);
+
+		if (written > 0)
+		{
+			data += written;
+			remaining -= static_cast<size_t>(written);
+			continue;
+		}
+
+		if (written < 0 && errno == EINTR)
+			continue;
+
+		if (written < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+		{
+			std::lock_guard<std::mutex> guard(_lock);
+			_errorMessage = QString("Serial port write error: %1").arg(std::strerror(errno));
+			_error = true;
+			return false;
+		}
+
+		if (waited >= WRITE_TIMEOUT_MS)
+		{
+			std::lock_guard<std::mutex> guard(_lock);
+			_errorMessage = QString("Timeout writing data to the serial port");
+			_error = true;
+			return false;
+		}
+
+		pollfd pfd{};
+		pfd.fd = _fd;
+		pfd.events = POLLOUT;
+
+		int result = poll(&pfd, 1, POLL_TIMEOUT_MS);
+		if (result == 0)
+			waited += POLL_TIMEOUT_MS;
+		else if (result < 0 && errno != EINTR)
+		{
+			std::lock_guard<std::mutex> guard(_lock);
+			_errorMessage = QString("Serial port poll error: %1").arg(std::strerror(errno));
+			_error = true;
+			return false;
+		}
+		else if (result > 0 && (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)))
+		{
+			std::lock_guard<std::mutex> guard(_lock);
+			_errorMessage = QString("The serial port was disconnected");
+			_error = true;
+			return false;
+		}
+	}
+
+	return true;
+#else
+	Q_UNUSED(frame);
+	return false;
+#endif
+}
@@ -12,47 +12,40 @@ bool DriverSpiAPA102::init(QJsonObject deviceConfig)
 	// Initialise sub-class
 	if (ProviderSpi::init(deviceConfig))
 	{
-		createHeader();
+		PacketWriter::Layout layout;
+		layout.headerSize = 4;
+		layout.stride = 4;
+		layout.colorOffset = 1;
+		layout.fill = 0xFF;
+		_packetWriter.setLayout(layout);
+
 		isInitOK = true;
 	}
 	return isInitOK;
 }
 
-void DriverSpiAPA102::createHeader()
+void DriverSpiAPA102::preparePacket()
 {
-	const unsigned int startFrameSize = 4;
+	if (_ledCount != _packetWriter.ledCount())
+	{
+		Warning(_log, "APA102 led's number has changed (old: {:d}, new: {:d}). Rebuilding buffer.", _ledCount, _packetWriter.ledCount());
+		_ledCount = static_cast<uint>(_packetWriter.ledCount());
+	}
+
 	const unsigned int endFrameSize = qMax<unsigned int>(((_ledCount + 15) / 16), 4);
-	const unsigned int APAbufferSize = (_ledCount * 4) + startFrameSize + endFrameSize;
+	std::vector<uint8_t>& buffer = _packetWriter.buffer();
 
-	_ledBuffer.resize(0, 0xFF);
-	_ledBuffer.resize(APAbufferSize, 0xFF);
-	_ledBuffer[0] = 0x00;
-	_ledBuffer[1] = 0x00;
-	_ledBuffer[2] = 0x00;
-	_ledBuffer[3] = 0x00;
+	std::fill_n(buffer.begin(), 4, 0x00);
+	buffer.resize(buffer.size() + endFrameSize, 0xFF);
 
 	Debug(_log, "APA102 buffer created. Led's number: {:d}", _ledCount);
 }
 
-int DriverSpiAPA102::writeFiniteColors(const std::vector<ColorRgb>& ledValues)
+int DriverSpiAPA102::writePacket()
 {
-	if (_ledCount != ledValues.size())
-	{
-		Warning(_log, "APA102 led's number has changed (old: {:d}, new: {:d}). Rebuilding buffer.", _ledCount, ledValues.size());
-		_ledCount = static_cast<uint>(ledValues.size());
-
-		createHeader();
-	}
-
-	for (signed iLed = 0; iLed < static_cast<int>(_ledCount); ++iLed) {
-		const ColorRgb& rgb = ledValues[iLed];
-		_ledBuffer[4 + iLed * 4] = 0xFF;
-		_ledBuffer[4 + iLed * 4 + 1] = rgb.red;
-		_ledBuffer[4 + iLed * 4 + 2] = rgb.green;
-		_ledBuffer[4 + iLed * 4 + 3] = rgb.blue;
-	}
+	const std::vector<uint8_t>& buffer = _packetWriter.buffer();
 
-	return writeBytes(static_cast<unsigned int>(_ledBuffer.size()), _ledBuffer.data());
+	return writeBytes(static_cast<unsigned int>(buffer.size()), buffer.data());
 }
 
 LedDevice* DriverSpiAPA102::construct(const QJsonObject& deviceConfig)
@@ -60,4 +53,4 @@ LedDevice* DriverSpiAPA102::construct(const QJsonObject& deviceConfig)
 	return new DriverSpiAPA102(deviceConfig);
 }
 
-bool DriverSpiAPA102::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("apa102", "leds_group_0_SPI", DriverSpiAPA102::construct);
+bool DriverSpiAPA102::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("apa102", "leds_group_0_SPI", DriverSpiAPA102::construct, true);
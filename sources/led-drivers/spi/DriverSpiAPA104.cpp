@@ -108,4 +108,4 @@ LedDevice* DriverSpiAPA104::construct(const QJsonObject& deviceConfig)
 	return new DriverSpiAPA104(deviceConfig);
 }
 
-bool DriverSpiAPA104::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("apa104", "leds_group_0_SPI", DriverSpiAPA104::construct);
+bool DriverSpiAPA104::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("apa104", "leds_group_0_SPI", DriverSpiAPA104::construct, true);
@@ -123,4 +123,4 @@ LedDevice* DriverSpiHD108::construct(const QJsonObject& deviceConfig)
 	return new DriverSpiHD108(deviceConfig);
 }
 
-bool DriverSpiHD108::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("hd108", "leds_group_0_SPI", DriverSpiHD108::construct);
+bool DriverSpiHD108::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("hd108", "leds_group_0_SPI", DriverSpiHD108::construct, true);
@@ -254,4 +254,4 @@ LedDevice* DriverSpiHyperSPI::construct(const QJsonObject& deviceConfig)
 	return new DriverSpiHyperSPI(deviceConfig);
 }
 
-bool DriverSpiHyperSPI::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("hyperspi", "leds_group_0_SPI", DriverSpiHyperSPI::construct);//awa_spi
+bool DriverSpiHyperSPI::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("hyperspi", "leds_group_0_SPI", DriverSpiHyperSPI::construct, true);//awa_spi
@@ -64,4 +64,4 @@ LedDevice* DriverSpiLpd6803::construct(const QJsonObject& deviceConfig)
 	return new DriverSpiLpd6803(deviceConfig);
 }
 
-bool DriverSpiLpd6803::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("lpd6803", "leds_group_0_SPI", DriverSpiLpd6803::construct);
+bool DriverSpiLpd6803::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("lpd6803", "leds_group_0_SPI", DriverSpiLpd6803::construct, true);
@@ -129,4 +129,4 @@ LedDevice* DriverSpiLpd8806::construct(const QJsonObject& deviceConfig)
 	return new DriverSpiLpd8806(deviceConfig);
 }
 
-bool DriverSpiLpd8806::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("lpd8806", "leds_group_0_SPI", DriverSpiLpd8806::construct);
+bool DriverSpiLpd8806::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("lpd8806", "leds_group_0_SPI", DriverSpiLpd8806::construct, true);
@@ -58,4 +58,4 @@ LedDevice* DriverSpiP9813::construct(const QJsonObject& deviceConfig)
 	return new DriverSpiP9813(deviceConfig);
 }
 
-bool DriverSpiP9813::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("p9813", "leds_group_0_SPI", DriverSpiP9813::construct);
+bool DriverSpiP9813::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("p9813", "leds_group_0_SPI", DriverSpiP9813::construct, true);
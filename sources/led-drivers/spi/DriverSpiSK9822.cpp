@@ -160,4 +160,4 @@ LedDevice* DriverSpiSK9822::construct(const QJsonObject& deviceConfig)
 	return new DriverSpiSK9822(deviceConfig);
 }
 
-bool DriverSpiSK9822::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("sk9822", "leds_group_0_SPI", DriverSpiSK9822::construct);
+bool DriverSpiSK9822::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("sk9822", "leds_group_0_SPI", DriverSpiSK9822::construct, true);
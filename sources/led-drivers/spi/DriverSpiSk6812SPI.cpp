@@ -199,4 +199,4 @@ LedDevice* DriverSpiSk6812SPI::construct(const QJsonObject& deviceConfig)
 	return new DriverSpiSk6812SPI(deviceConfig);
 }
 
-bool DriverSpiSk6812SPI::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("sk6812spi", "leds_group_0_SPI", DriverSpiSk6812SPI::construct);
+bool DriverSpiSk6812SPI::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("sk6812spi", "leds_group_0_SPI", DriverSpiSk6812SPI::construct, true);
@@ -128,4 +128,4 @@ LedDevice* DriverSpiSk6822SPI::construct(const QJsonObject& deviceConfig)
 	return new DriverSpiSk6822SPI(deviceConfig);
 }
 
-bool DriverSpiSk6822SPI::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("sk6822spi", "leds_group_0_SPI", DriverSpiSk6822SPI::construct);
+bool DriverSpiSk6822SPI::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("sk6822spi", "leds_group_0_SPI", DriverSpiSk6822SPI::construct, true);
@@ -24,4 +24,4 @@ LedDevice* DriverSpiWs2801::construct(const QJsonObject& deviceConfig)
 	return new DriverSpiWs2801(deviceConfig);
 }
 
-bool DriverSpiWs2801::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("ws2801", "leds_group_0_SPI", DriverSpiWs2801::construct);
+bool DriverSpiWs2801::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("ws2801", "leds_group_0_SPI", DriverSpiWs2801::construct, true);
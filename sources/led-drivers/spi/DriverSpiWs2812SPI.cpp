@@ -99,4 +99,4 @@ LedDevice* DriverSpiWs2812SPI::construct(const QJsonObject& deviceConfig)
 	return new DriverSpiWs2812SPI(deviceConfig);
 }
 
-bool DriverSpiWs2812SPI::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("ws2812spi", "leds_group_0_SPI", DriverSpiWs2812SPI::construct);
+bool DriverSpiWs2812SPI::isRegistered = hyperhdr::leds::REGISTER_LED_DEVICE("ws2812spi", "leds_group_0_SPI", DriverSpiWs2812SPI::construct, true);
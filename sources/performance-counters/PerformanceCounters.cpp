@@ -69,6 +69,8 @@ PerformanceReport::PerformanceReport(int _type, qint64 _token, QString _name, do
 		case static_cast<int>(PerformanceReportType::RAM_USAGE):
 		case static_cast<int>(PerformanceReportType::CPU_TEMPERATURE):
 		case static_cast<int>(PerformanceReportType::SYSTEM_UNDERVOLTAGE):
+		case static_cast<int>(PerformanceReportType::NETWORK_IO):
+		case static_cast<int>(PerformanceReportType::EXECUTOR):
 			_testType = static_cast<PerformanceReportType>(_type);
 			break;
 	}
@@ -273,6 +275,16 @@ void PerformanceCounters::consoleReport(int type, int token)
 			if (del.token > 0)
 				list.append(QString("[LED%1: FPS = %2, send = %3, processed = %4, dropped = %5]").arg(del.id).arg(del.param1, 0, 'f', 2).arg(del.param2).arg(del.param3).arg(del.param4));
 		}
+		else if (del.type == static_cast<int>(PerformanceReportType::NETWORK_IO))
+		{
+			if (del.token > 0)
+				list.append(QString("[NET%1: load = %2%, connections = %3, events = %4, longest = %5ms]").arg(del.id).arg(del.param1, 0, 'f', 2).arg(del.param2).arg(del.param3).arg(del.param4));
+		}
+		else if (del.type == static_cast<int>(PerformanceReportType::EXECUTOR))
+		{
+			if (del.token > 0)
+				list.append(QString("[STRAND%1 %2: delay = %3ms, longest = %4ms, probes = %5, thread = %6]").arg(del.id).arg(del.name).arg(del.param1, 0, 'f', 2).arg(del.param2 / 1000.0, 0, 'f', 2).arg(del.param3).arg(del.param4));
+		}
 	}
 
 	if (list.count() > 0)
@@ -0,0 +1,318 @@
+/* PerformanceTracer.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QJsonArray>
+	#include <QThread>
+
+	#include <algorithm>
+	#include <array>
+	#include <atomic>
+	#include <cmath>
+	#include <map>
+	#include <memory>
+	#include <mutex>
+	#include <vector>
+#endif
+
+#include <performance-counters/PerformanceTracer.h>
+
+namespace
+{
+	constexpr size_t MAX_FINISHED_RINGS = 16;
+
+	struct TraceRing
+	{
+		// 'writing' is moved before a slot is overwritten and 'written' after, so a reader can tell which
+		// of the copied slots could have changed under it
+		std::array<std::atomic<int64_t>, PerformanceTracer::RING_SIZE>	begin;
+		std::array<std::atomic<uint64_t>, PerformanceTracer::RING_SIZE>	info;
+		std::atomic<uint64_t>	writing{ 0 };
+		std::atomic<uint64_t>	written{ 0 };
+		std::atomic<bool>		finished{ false };
+		QString					threadName;
+		int						threadIndex = 0;
+	};
+
+	struct Sample
+	{
+		int64_t	begin;
+		int64_t	duration;
+		int		id;
+		int		stage;
+		int		threadIndex;
+	};
+
+	struct Registry
+	{
+		std::mutex								mutex;
+		std::vector<std::shared_ptr<TraceRing>>	rings;
+		int										threadCounter = 0;
+	};
+
+	Registry& getRegistry()
+	{
+		static Registry registry;
+		return registry;
+	}
+
+	struct RingOwner
+	{
+		std::shared_ptr<TraceRing> ring;
+
+		~RingOwner()
+		{
+			if (ring != nullptr)
+				ring->finished.store(true, std::memory_order_release);
+		}
+	};
+
+	thread_local RingOwner currentRing;
+
+	TraceRing* createRing()
+	{
+		auto ring = std::make_shared<TraceRing>();
+		Registry& registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+
+		ring->threadIndex = ++registry.threadCounter;
+		ring->threadName = QThread::currentThread()->objectName();
+		if (ring->threadName.isEmpty())
+			ring->threadName = QString("Thread%1").arg(ring->threadIndex);
+
+		// rings of the threads that have finished are kept for a while, but not forever
+		size_t finished = std::count_if(registry.rings.begin(), registry.rings.end(), [](const auto& r) { return r->finished.load(std::memory_order_acquire); });
+		for (auto it = registry.rings.begin(); finished > MAX_FINISHED_RINGS && it != registry.rings.end();)
+		{
+			if ((*it)->finished.load(std::memory_order_acquire))
+			{
+				it = registry.rings.erase(it);
+				finished--;
+			}
+			else
+				++it;
+		}
+
+		registry.rings.push_back(ring);
+		currentRing.ring = std::move(ring);
+		return currentRing.ring.get();
+	}
+
+	std::vector<Sample> collectSamples(std::vector<std::pair<int, QString>>* threads = nullptr)
+	{
+		std::vector<std::shared_ptr<TraceRing>> rings;
+		std::vector<Sample> samples;
+
+		{
+			Registry& registry = getRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			rings = registry.rings;
+		}
+
+		for (const auto& ring : rings)
+		{
+			uint64_t written = ring->written.load(std::memory_order_acquire);
+			uint64_t first = (written > PerformanceTracer::RING_SIZE) ? written - PerformanceTracer::RING_SIZE : 0;
+			size_t start = samples.size();
+
+			for (uint64_t i = first; i < written; i++)
+			{
+				size_t slot = i % PerformanceTracer::RING_SIZE;
+				int64_t begin = ring->begin[slot].load(std::memory_order_relaxed);
+				uint64_t info = ring->info[slot].load(std::memory_order_relaxed);
+
+				samples.push_back(Sample{ begin, static_cast<int64_t>(info >> 32), static_cast<int16_t>((info >> 16) & 0xffff), static_cast<int>(info & 0xff), ring->threadIndex });
+			}
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			// drop the slots that the writer could have reused while they were copied
+			uint64_t writing = ring->writing.load(std::memory_order_relaxed);
+			uint64_t valid = (writing > PerformanceTracer::RING_SIZE) ? writing - PerformanceTracer::RING_SIZE : 0;
+			if (valid > first)
+				samples.erase(samples.begin() + start, samples.begin() + start + std::min<uint64_t>(valid - first, samples.size() - start));
+
+			if (threads != nullptr)
+				threads->emplace_back(ring->threadIndex, ring->threadName);
+		}
+
+		return samples;
+	}
+}
+
+void PerformanceTracer::record(Stage stage, int id, int64_t begin, int64_t end)
+{
+	TraceRing* ring = currentRing.ring.get();
+	if (ring == nullptr)
+		ring = createRing();
+
+	const uint64_t index = ring->written.load(std::memory_order_relaxed);
+	const size_t slot = index % RING_SIZE;
+	const uint64_t duration = static_cast<uint64_t>(std::clamp<int64_t>(end - begin, 0, INT32_MAX));
+	const uint64_t info = (duration << 32) | (static_cast<uint64_t>(static_cast<uint16_t>(id)) << 16) | static_cast<uint64_t>(stage);
+
+	ring->writing.store(index + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	ring->begin[slot].store(begin, std::memory_order_relaxed);
+	ring->info[slot].store(info, std::memory_order_relaxed);
+
+	ring->written.store(index + 1, std::memory_order_release);
+}
+
+const char* PerformanceTracer::stageToString(Stage stage)
+{
+	switch (stage)
+	{
+		case Stage::DECODE: return "decode";
+		case Stage::BORDER_DETECTION: return "border-detection";
+		case Stage::AVERAGING: return "averaging";
+		case Stage::PROCESSING: return "processing";
+		case Stage::SMOOTHING: return "smoothing";
+		case Stage::DEVICE_WRITE: return "device-write";
+		case Stage::INSTANCE_LATENCY: return "instance-latency";
+		case Stage::DEVICE_LATENCY: return "device-latency";
+		default: return "unknown";
+	}
+}
+
+int PerformanceTracer::deviceId(int instance, int output)
+{
+	return instance * OUTPUTS_PER_INSTANCE + output;
+}
+
+namespace
+{
+	void setId(QJsonObject& target, int stage, int id)
+	{
+		if (id < 0)
+			return;
+
+		if (stage == static_cast<int>(PerformanceTracer::Stage::DEVICE_WRITE) || stage == static_cast<int>(PerformanceTracer::Stage::DEVICE_LATENCY))
+		{
+			target["id"] = id / PerformanceTracer::OUTPUTS_PER_INSTANCE;
+			target["output"] = id % PerformanceTracer::OUTPUTS_PER_INSTANCE;
+		}
+		else
+			target["id"] = id;
+	}
+}
+
+QJsonObject PerformanceTracer::getStatistics()
+{
+	std::map<std::pair<int, int>, std::vector<int64_t>> durations;
+	int64_t windowBegin = INT64_MAX, windowEnd = 0;
+
+	for (const auto& sample : collectSamples())
+	{
+		if (sample.stage >= static_cast<int>(Stage::COUNT))
+			continue;
+
+		durations[{ sample.stage, sample.id }].push_back(sample.duration);
+		windowBegin = std::min(windowBegin, sample.begin);
+		windowEnd = std::max(windowEnd, sample.begin + sample.duration);
+	}
+
+	QJsonArray stages;
+	for (auto& [key, values] : durations)
+	{
+		QJsonObject item;
+
+		std::sort(values.begin(), values.end());
+
+		auto percentile = [&values](double p) {
+			size_t index = static_cast<size_t>(std::ceil(p * values.size()));
+			return static_cast<qint64>(values[std::clamp<size_t>(index, 1, values.size()) - 1]);
+		};
+
+		int64_t sum = 0;
+		for (int64_t value : values)
+			sum += value;
+
+		item["stage"] = stageToString(static_cast<Stage>(key.first));
+		setId(item, key.first, key.second);
+		item["count"] = static_cast<qint64>(values.size());
+		item["avg_us"] = static_cast<qint64>(sum / static_cast<int64_t>(values.size()));
+		item["p50_us"] = percentile(0.50);
+		item["p95_us"] = percentile(0.95);
+		item["p99_us"] = percentile(0.99);
+		item["max_us"] = static_cast<qint64>(values.back());
+
+		stages.append(item);
+	}
+
+	QJsonObject report;
+	report["stages"] = stages;
+	report["window_ms"] = (windowEnd > windowBegin) ? static_cast<qint64>((windowEnd - windowBegin) / 1000) : 0;
+	return report;
+}
+
+QJsonObject PerformanceTracer::getChromeTrace()
+{
+	std::vector<std::pair<int, QString>> threads;
+	QJsonArray events;
+
+	for (const auto& sample : collectSamples(&threads))
+	{
+		QJsonObject event;
+		event["name"] = stageToString(static_cast<Stage>(sample.stage));
+		event["cat"] = "hyperhdr";
+		event["ph"] = "X";
+		event["ts"] = static_cast<qint64>(sample.begin);
+		event["dur"] = static_cast<qint64>(sample.duration);
+		event["pid"] = 1;
+		event["tid"] = sample.threadIndex;
+
+		if (sample.id >= 0)
+		{
+			QJsonObject args;
+			setId(args, sample.stage, sample.id);
+			event["args"] = args;
+		}
+
+		events.append(event);
+	}
+
+	for (const auto& [index, name] : threads)
+	{
+		QJsonObject args;
+		args["name"] = name;
+
+		QJsonObject event;
+		event["name"] = "thread_name";
+		event["ph"] = "M";
+		event["pid"] = 1;
+		event["tid"] = index;
+		event["args"] = args;
+		events.append(event);
+	}
+
+	QJsonObject trace;
+	trace["traceEvents"] = events;
+	trace["displayTimeUnit"] = "ms";
+	return trace;
+}
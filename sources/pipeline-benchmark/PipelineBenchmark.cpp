@@ -0,0 +1,801 @@
+/* PipelineBenchmark.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QFile>
+	#include <QJsonDocument>
+
+	#include <algorithm>
+	#include <array>
+	#include <chrono>
+	#include <cmath>
+	#include <memory>
+	#include <optional>
+#endif
+
+#include <HyperhdrConfig.h>
+#include "PipelineBenchmark.h"
+#include <image/Image.h>
+#include <image/FrameStatistics.h>
+#include <utils/FrameDecoder.h>
+#include <utils/FrameRecording.h>
+#include <base/LedString.h>
+#include <base/ImageColorAveraging.h>
+#include <base/ImageToLedManager.h>
+#include <blackborder/BlackBorderDetector.h>
+#include <infinite-color-engine/InfiniteProcessing.h>
+#include <infinite-color-engine/InfiniteStepperInterpolator.h>
+#include <infinite-color-engine/InfiniteRgbInterpolator.h>
+#include <infinite-color-engine/InfiniteYuvInterpolator.h>
+#include <infinite-color-engine/InfiniteHybridInterpolator.h>
+#include <infinite-color-engine/InfiniteHybridRgbInterpolator.h>
+#include <infinite-color-engine/InfiniteExponentialInterpolator.h>
+#include <infinite-color-engine/YuvConverter.h>
+#include <performance-counters/PerformanceTracer.h>
+#include <led-drivers/net/DriverNetUdpE131.h>
+#if defined(ENABLE_SPIDEV) || defined(ENABLE_SPI_FTDI)
+	#include <led-drivers/spi/DriverSpiWs2812SPI.h>
+#endif
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	const int LUT_TABLE_SIZE = 256 * 256 * 256 * 3;
+	const int LUT_MEMORY_ALIGN = 64;
+
+	enum BenchmarkStage { DECODE = 0, BORDER_DETECTION, AVERAGING, PROCESSING, SMOOTHING, ENCODE_E131, ENCODE_WS2812SPI, TOTAL, STAGE_COUNT };
+
+	QString stageName(int stage)
+	{
+		switch (stage)
+		{
+			case DECODE: return PerformanceTracer::stageToString(PerformanceTracer::Stage::DECODE);
+			case BORDER_DETECTION: return PerformanceTracer::stageToString(PerformanceTracer::Stage::BORDER_DETECTION);
+			case AVERAGING: return PerformanceTracer::stageToString(PerformanceTracer::Stage::AVERAGING);
+			case PROCESSING: return PerformanceTracer::stageToString(PerformanceTracer::Stage::PROCESSING);
+			case SMOOTHING: return PerformanceTracer::stageToString(PerformanceTracer::Stage::SMOOTHING);
+			case ENCODE_E131: return "encode-e131";
+			case ENCODE_WS2812SPI: return "encode-ws2812spi";
+			default: return "total";
+		}
+	}
+
+	// the driver does all of its packet building, only the transport is replaced
+	class E131Sink : public DriverNetUdpE131
+	{
+	public:
+		explicit E131Sink(const QJsonObject& deviceConfig) : DriverNetUdpE131(deviceConfig) {}
+
+		int encode(const SharedOutputColors& colors) { return write(colors); }
+		uint64_t writtenBytes() const { return _writtenBytes; }
+
+	protected:
+		int open() override { _isDeviceReady = true; return 0; }
+		int close() override { _isDeviceReady = false; return 0; }
+
+		int writeBytes(const unsigned size, const uint8_t* data) override
+		{
+			_writtenBytes += size;
+			_checksum += (size > 0) ? data[size - 1] : 0;
+			return 0;
+		}
+
+		int writeBytes(const QByteArray& bytes) override
+		{
+			return writeBytes(static_cast<unsigned>(bytes.size()), reinterpret_cast<const uint8_t*>(bytes.constData()));
+		}
+
+	private:
+		uint64_t _writtenBytes = 0;
+		uint64_t _checksum = 0;
+	};
+
+#if defined(ENABLE_SPIDEV) || defined(ENABLE_SPI_FTDI)
+	class Ws2812SpiSink : public DriverSpiWs2812SPI
+	{
+	public:
+		explicit Ws2812SpiSink(const QJsonObject& deviceConfig) : DriverSpiWs2812SPI(deviceConfig) {}
+
+		int encode(const SharedOutputColors& colors) { return write(colors); }
+		uint64_t writtenBytes() const { return _writtenBytes; }
+
+		int open() override { _isDeviceReady = true; return 0; }
+		int close() override { _isDeviceReady = false; return 0; }
+
+	protected:
+		int writeBytes(unsigned size, const uint8_t* data) override
+		{
+			_writtenBytes += size;
+			_checksum += (size > 0) ? data[size - 1] : 0;
+			return 0;
+		}
+
+	private:
+		uint64_t _writtenBytes = 0;
+		uint64_t _checksum = 0;
+	};
+#endif
+
+	std::unique_ptr<InfiniteInterpolator> createInterpolator(const QString& type)
+	{
+		if (type == "RgbInterpolator")
+			return std::make_unique<InfiniteRgbInterpolator>();
+		else if (type == "YuvInterpolator")
+			return std::make_unique<InfiniteYuvInterpolator>();
+		else if (type == "HybridInterpolator")
+			return std::make_unique<InfiniteHybridInterpolator>();
+		else if (type == "ExponentialInterpolator")
+			return std::make_unique<InfiniteExponentialInterpolator>();
+		else if (type == "HybridRgbInterpolator")
+			return std::make_unique<InfiniteHybridRgbInterpolator>();
+
+		return std::make_unique<InfiniteStepperInterpolator>();
+	}
+
+	QJsonDocument createColorConfig()
+	{
+		QJsonObject channel;
+		channel["red"] = QJsonArray{ 255, 0, 0 };
+		channel["green"] = QJsonArray{ 0, 255, 0 };
+		channel["blue"] = QJsonArray{ 0, 0, 255 };
+		channel["cyan"] = QJsonArray{ 0, 255, 255 };
+		channel["magenta"] = QJsonArray{ 255, 0, 255 };
+		channel["yellow"] = QJsonArray{ 255, 255, 0 };
+		channel["white"] = QJsonArray{ 255, 255, 255 };
+		channel["black"] = QJsonArray{ 0, 0, 0 };
+
+		QJsonObject config;
+		config["channelAdjustment"] = QJsonArray{ channel };
+		return QJsonDocument(config);
+	}
+
+	QJsonObject summarize(std::vector<int64_t>& values)
+	{
+		QJsonObject item;
+
+		if (values.empty())
+			return item;
+
+		std::sort(values.begin(), values.end());
+
+		auto toMicro = [](int64_t ns) {
+			return std::round(static_cast<double>(ns) / 10.0) / 100.0;
+		};
+
+		auto percentile = [&values](double p) {
+			size_t index = static_cast<size_t>(std::ceil(p * values.size()));
+			return values[std::clamp<size_t>(index, 1, values.size()) - 1];
+		};
+
+		int64_t sum = 0;
+		for (int64_t value : values)
+			sum += value;
+
+		item["count"] = static_cast<qint64>(values.size());
+		item["avg_us"] = toMicro(sum / static_cast<int64_t>(values.size()));
+		item["p50_us"] = toMicro(percentile(0.50));
+		item["p95_us"] = toMicro(percentile(0.95));
+		item["p99_us"] = toMicro(percentile(0.99));
+		item["max_us"] = toMicro(values.back());
+		return item;
+	}
+
+	void rgbToYuv(const uint8_t* rgb, uint8_t& y, uint8_t& u, uint8_t& v)
+	{
+		// BT.709 limited range, fixed point
+		const int r = rgb[0], g = rgb[1], b = rgb[2];
+		y = static_cast<uint8_t>(16 + ((47 * r + 157 * g + 16 * b) >> 8));
+		u = static_cast<uint8_t>(128 + ((-26 * r - 87 * g + 112 * b) >> 8));
+		v = static_cast<uint8_t>(128 + ((112 * r - 102 * g - 10 * b) >> 8));
+	}
+}
+
+PipelineBenchmark::PipelineBenchmark(const Settings& settings) :
+	_settings(settings),
+	_log("BENCHMARK"),
+	_preparedFormat(PixelFormat::NO_CHANGE)
+{
+	// the decoders work on pixel pairs and on 2x2 chroma blocks
+	_settings.width = std::max((_settings.width >> 1) << 1, 2);
+	_settings.height = std::max((_settings.height >> 1) << 1, 2);
+	_settings.fps = std::max(_settings.fps, 1);
+	_settings.frames = std::max(_settings.frames, 1);
+	_settings.warmup = std::max(_settings.warmup, 0);
+	_settings.samples = std::max(_settings.samples, 1);
+}
+
+bool PipelineBenchmark::isSupportedFormat(PixelFormat format)
+{
+	return format == PixelFormat::YUYV || format == PixelFormat::UYVY || format == PixelFormat::NV12 || format == PixelFormat::I420 ||
+		format == PixelFormat::P010 || format == PixelFormat::RGB24 || format == PixelFormat::XRGB;
+}
+
+QString PipelineBenchmark::getLastError() const
+{
+	return _lastError;
+}
+
+QJsonObject PipelineBenchmark::getSettingsInfo() const
+{
+	QJsonObject info;
+	info["width"] = _settings.width;
+	info["height"] = _settings.height;
+	info["quarter"] = _settings.quarter;
+	info["statistics"] = _settings.statistics;
+	info["source"] = (_settings.input.isEmpty()) ? "synthetic" : _settings.input;
+	info["letterbox"] = _settings.input.isEmpty() && _settings.letterbox;
+	info["layout"] = _settings.layout;
+	info["blackBorderMode"] = _settings.blackBorderMode;
+	info["imageToLedMappingType"] = ImageToLedManager::mappingTypeToStr(ImageToLedManager::mappingTypeToInt(_settings.mapping));
+	info["sparse_processing"] = _settings.sparse;
+	info["smoothing"] = _settings.smoothing;
+	info["settlingTime"] = _settings.settlingTime;
+	info["fps"] = _settings.fps;
+	info["frames"] = _settings.frames;
+	info["warmup"] = _settings.warmup;
+	info["lut"] = (_settings.lutFile.isEmpty()) ? "synthetic BT.709" : _settings.lutFile;
+	return info;
+}
+
+PipelineBenchmark::FrameLayout PipelineBenchmark::getFrameLayout(PixelFormat format) const
+{
+	const size_t pixels = static_cast<size_t>(_settings.width) * _settings.height;
+
+	switch (format)
+	{
+		case PixelFormat::YUYV:
+		case PixelFormat::UYVY: return { pixels * 2, _settings.width * 2 };
+		case PixelFormat::NV12:
+		case PixelFormat::I420: return { (pixels * 3) / 2, _settings.width };
+		case PixelFormat::P010: return { pixels * 3, _settings.width * 2 };
+		case PixelFormat::RGB24: return { pixels * 3, _settings.width * 3 };
+		default: return { pixels * 4, _settings.width * 4 };
+	}
+}
+
+bool PipelineBenchmark::prepare(PixelFormat format)
+{
+	_lastError.clear();
+
+	if (!isSupportedFormat(format))
+	{
+		_lastError = QString("Unsupported pixel format: %1").arg(pixelFormatToString(format));
+		return false;
+	}
+
+	if (!prepareLut(format))
+		return false;
+
+	if (_preparedFormat == format && !_frames.empty())
+		return true;
+
+	_frames.clear();
+	_preparedFormat = PixelFormat::NO_CHANGE;
+
+	if (!_settings.input.isEmpty())
+	{
+		if (!loadRecordedFrames(format))
+			return false;
+	}
+	else
+		generateSyntheticFrames(format);
+
+	_preparedFormat = format;
+	return true;
+}
+
+bool PipelineBenchmark::prepareLut(PixelFormat format)
+{
+	if (format == PixelFormat::RGB24 || format == PixelFormat::XRGB || _lutLoader._lutBufferInit)
+		return true;
+
+	if (!_settings.lutFile.isEmpty())
+	{
+		_lutLoader._hdrToneMappingEnabled = 0;
+		_lutLoader.loadLutFile(_log, PixelFormat::YUYV, { _settings.lutFile });
+
+		if (!_lutLoader._lutBufferInit)
+		{
+			_lastError = QString("Could not load the LUT file: %1").arg(_settings.lutFile);
+			return false;
+		}
+		return true;
+	}
+
+	// no LUT file is needed: build the same YUV to RGB table as the default one the grabbers download
+	Info(_log, "Generating the synthetic BT.709 YUV LUT");
+
+	YuvConverter converter;
+	_lutLoader._lut.resize(LUT_TABLE_SIZE + LUT_MEMORY_ALIGN);
+	uint8_t* lut = _lutLoader._lut.data();
+
+	for (int v = 0; v < 256; v++)
+		for (int u = 0; u < 256; u++)
+			for (int y = 0; y < 256; y++, lut += 3)
+			{
+				byte3 rgb = converter.yuv_to_rgb(YuvConverter::BT709, YuvConverter::LIMITED, byte3(y, u, v));
+				lut[0] = rgb.x;
+				lut[1] = rgb.y;
+				lut[2] = rgb.z;
+			}
+
+	_lutLoader._lutBufferInit = true;
+	return true;
+}
+
+bool PipelineBenchmark::loadRecordedFrames(PixelFormat format)
+{
+	if (FrameRecording::isRecording(_settings.input))
+		return loadRecording(format);
+
+	const FrameLayout layout = getFrameLayout(format);
+	QFile file(_settings.input);
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		_lastError = QString("Could not open the recorded frames: %1").arg(_settings.input);
+		return false;
+	}
+
+	const qint64 fileSize = file.size();
+	if (fileSize < static_cast<qint64>(layout.frameSize) || fileSize % static_cast<qint64>(layout.frameSize) != 0)
+	{
+		_lastError = QString("The size of %1 (%2 bytes) is not a multiple of a %3x%4 %5 frame (%6 bytes)")
+			.arg(_settings.input).arg(fileSize).arg(_settings.width).arg(_settings.height)
+			.arg(pixelFormatToString(format)).arg(layout.frameSize);
+		return false;
+	}
+
+	for (qint64 left = fileSize; left > 0; left -= static_cast<qint64>(layout.frameSize))
+	{
+		std::vector<uint8_t> frame(layout.frameSize);
+		if (file.read(reinterpret_cast<char*>(frame.data()), layout.frameSize) != static_cast<qint64>(layout.frameSize))
+		{
+			_lastError = QString("Could not read the recorded frames: %1").arg(_settings.input);
+			return false;
+		}
+		_frames.push_back(std::move(frame));
+	}
+
+	Info(_log, "Loaded {:d} recorded {:s} frames", static_cast<int>(_frames.size()), pixelFormatToString(format));
+	return true;
+}
+
+bool PipelineBenchmark::loadRecording(PixelFormat format)
+{
+	const FrameLayout layout = getFrameLayout(format);
+	FrameRecordingReader reader;
+
+	if (!reader.open(_settings.input))
+	{
+		_lastError = reader.getLastError();
+		return false;
+	}
+
+	if (reader.format() != format || reader.width() != _settings.width || reader.height() != _settings.height ||
+		(reader.lineLength() > 0 && reader.lineLength() != layout.lineLength))
+	{
+		_lastError = QString("The recording contains %1x%2 %3 frames with a line length of %4 bytes")
+			.arg(reader.width()).arg(reader.height()).arg(pixelFormatToString(reader.format())).arg(reader.lineLength());
+		return false;
+	}
+
+	std::vector<uint8_t> frame;
+	size_t size = 0;
+	int64_t timestamp = 0;
+
+	while (reader.readFrame(frame, size, timestamp))
+	{
+		if (size < layout.frameSize)
+		{
+			_lastError = QString("The recorded frame is too small: %1 < %2 bytes").arg(size).arg(layout.frameSize);
+			return false;
+		}
+
+		frame.resize(layout.frameSize);
+		_frames.push_back(std::move(frame));
+		frame = std::vector<uint8_t>();
+	}
+
+	if (!reader.getLastError().isEmpty() || _frames.empty())
+	{
+		_lastError = (_frames.empty()) ? QString("The recording does not contain any frame: %1").arg(_settings.input) : reader.getLastError();
+		return false;
+	}
+
+	Info(_log, "Loaded {:d} {:s} frames from the recording", static_cast<int>(_frames.size()), pixelFormatToString(format));
+	return true;
+}
+
+void PipelineBenchmark::generateSyntheticFrames(PixelFormat format)
+{
+	const FrameLayout layout = getFrameLayout(format);
+	std::vector<uint8_t> rgb;
+
+	for (int i = 0; i < _settings.samples; i++)
+	{
+		std::vector<uint8_t> frame(layout.frameSize, 0);
+
+		renderSyntheticFrame(i, rgb);
+		encodeFrame(format, rgb, frame.data());
+		_frames.push_back(std::move(frame));
+	}
+}
+
+void PipelineBenchmark::renderSyntheticFrame(int index, std::vector<uint8_t>& rgb) const
+{
+	const int width = _settings.width;
+	const int height = _settings.height;
+	const int bar = (_settings.letterbox) ? height / 8 : 0;
+	const int blockBegin = (index * width) / _settings.samples;
+	const int blockEnd = blockBegin + width / 8;
+
+	rgb.assign(static_cast<size_t>(width) * height * 3, 0);
+
+	// gradients shifted for every sample plus a moving bright block, framed by cinema bars
+	for (int y = bar; y < height - bar; y++)
+	{
+		uint8_t* row = rgb.data() + static_cast<size_t>(y) * width * 3;
+
+		for (int x = 0; x < width; x++, row += 3)
+		{
+			if (x >= blockBegin && x < blockEnd)
+			{
+				row[0] = row[1] = row[2] = 235;
+				continue;
+			}
+
+			row[0] = static_cast<uint8_t>((x * 255) / width + index * 16);
+			row[1] = static_cast<uint8_t>((y * 255) / height + index * 32);
+			row[2] = static_cast<uint8_t>(((x + y) * 255) / (width + height) + index * 8);
+		}
+	}
+}
+
+void PipelineBenchmark::encodeFrame(PixelFormat format, const std::vector<uint8_t>& rgb, uint8_t* target) const
+{
+	const int width = _settings.width;
+	const int height = _settings.height;
+	const int lineLength = getFrameLayout(format).lineLength;
+	const size_t planeSize = static_cast<size_t>(width) * height;
+	uint8_t y, u, v;
+
+	for (int row = 0; row < height; row++)
+	{
+		const uint8_t* source = rgb.data() + static_cast<size_t>(row) * width * 3;
+
+		for (int x = 0; x < width; x++, source += 3)
+		{
+			rgbToYuv(source, y, u, v);
+
+			switch (format)
+			{
+				case PixelFormat::YUYV:
+				{
+					uint8_t* dest = target + static_cast<size_t>(row) * lineLength + x * 2;
+					dest[0] = y;
+					dest[1] = (x & 1) ? v : u;
+					break;
+				}
+				case PixelFormat::UYVY:
+				{
+					uint8_t* dest = target + static_cast<size_t>(row) * lineLength + x * 2;
+					dest[0] = (x & 1) ? v : u;
+					dest[1] = y;
+					break;
+				}
+				case PixelFormat::NV12:
+				{
+					target[static_cast<size_t>(row) * width + x] = y;
+					if (((row | x) & 1) == 0)
+					{
+						uint8_t* uv = target + planeSize + static_cast<size_t>(row / 2) * width + x;
+						uv[0] = u;
+						uv[1] = v;
+					}
+					break;
+				}
+				case PixelFormat::I420:
+				{
+					target[static_cast<size_t>(row) * width + x] = y;
+					if (((row | x) & 1) == 0)
+					{
+						const size_t chroma = static_cast<size_t>(row / 2) * (width / 2) + x / 2;
+						target[planeSize + chroma] = u;
+						target[planeSize + planeSize / 4 + chroma] = v;
+					}
+					break;
+				}
+				case PixelFormat::P010:
+				{
+					// 10-bit samples in the most significant bits of little endian words
+					uint8_t* dest = target + static_cast<size_t>(row) * lineLength + x * 2;
+					dest[0] = 0;
+					dest[1] = y;
+					if (((row | x) & 1) == 0)
+					{
+						uint8_t* uv = target + static_cast<size_t>(lineLength) * height + static_cast<size_t>(row / 2) * lineLength + x * 2;
+						uv[0] = 0;
+						uv[1] = u;
+						uv[2] = 0;
+						uv[3] = v;
+					}
+					break;
+				}
+				default:
+				{
+					// RGB24 and XRGB are delivered bottom-up in BGR(X) order
+					const int bytesPerPixel = (format == PixelFormat::RGB24) ? 3 : 4;
+					uint8_t* dest = target + static_cast<size_t>(height - 1 - row) * lineLength + x * bytesPerPixel;
+					dest[0] = source[2];
+					dest[1] = source[1];
+					dest[2] = source[0];
+					if (bytesPerPixel == 4)
+						dest[3] = 0xff;
+				}
+			}
+		}
+	}
+}
+
+QJsonArray PipelineBenchmark::createLayout(int ledCount) const
+{
+	QJsonArray leds;
+
+	auto addLed = [&leds](double hmin, double hmax, double vmin, double vmax) {
+		QJsonObject led;
+		led["hmin"] = hmin;
+		led["hmax"] = hmax;
+		led["vmin"] = vmin;
+		led["vmax"] = vmax;
+		leds.append(led);
+	};
+
+	if (_settings.layout == "matrix")
+	{
+		const int columns = std::max(static_cast<int>(std::lround(std::sqrt(ledCount * static_cast<double>(_settings.width) / _settings.height))), 1);
+		const int rows = (ledCount + columns - 1) / columns;
+
+		for (int i = 0; i < ledCount; i++)
+		{
+			const int column = i % columns;
+			const int row = i / columns;
+			addLed(column / double(columns), (column + 1) / double(columns), row / double(rows), (row + 1) / double(rows));
+		}
+	}
+	else
+	{
+		// classic frame around the screen, clockwise from the top left corner
+		const double depth = 0.08;
+		const int horizontal = std::max(static_cast<int>((ledCount * static_cast<int64_t>(_settings.width)) / (2 * (_settings.width + _settings.height))), 1);
+		const int vertical = std::max((ledCount - 2 * horizontal) / 2, 0);
+		const int top = ledCount - horizontal - 2 * vertical;
+
+		for (int i = 0; i < top; i++)
+			addLed(i / double(top), (i + 1) / double(top), 0, depth);
+		for (int i = 0; i < vertical; i++)
+			addLed(1 - depth, 1, i / double(vertical), (i + 1) / double(vertical));
+		for (int i = horizontal - 1; i >= 0; i--)
+			addLed(i / double(horizontal), (i + 1) / double(horizontal), 1 - depth, 1);
+		for (int i = vertical - 1; i >= 0; i--)
+			addLed(0, depth, i / double(vertical), (i + 1) / double(vertical));
+	}
+
+	return leds;
+}
+
+QJsonObject PipelineBenchmark::run(PixelFormat format, int ledCount)
+{
+	QJsonObject result;
+	result["format"] = pixelFormatToString(format);
+	result["leds"] = ledCount;
+
+	if (!prepare(format))
+	{
+		result["error"] = _lastError;
+		return result;
+	}
+
+	const LedString ledString = LedString::createLedString(createLayout(ledCount), LedString::ColorOrder::ORDER_RGB);
+	const int mappingType = ImageToLedManager::mappingTypeToInt(_settings.mapping);
+	const bool useBorderDetector = _settings.blackBorderMode != "off";
+	const uint8_t* lutBuffer = (format == PixelFormat::RGB24 || format == PixelFormat::XRGB) ? nullptr : _lutLoader._lut.data();
+	const int lineLength = getFrameLayout(format).lineLength;
+	const float frameInterval = 1000.0f / _settings.fps;
+
+	hyperhdr::BlackBorderDetector borderDetector(0.05);
+	hyperhdr::BlackBorder currentBorder{ true, -1, -1 };
+	std::unique_ptr<hyperhdr::ImageColorAveraging> colorAveraging;
+
+	QJsonObject deviceConfig;
+	deviceConfig["colorOrder"] = "rgb";
+	deviceConfig["currentLedCount"] = ledCount;
+
+	InfiniteProcessing processing(createColorConfig(), QJsonDocument(deviceConfig), _log);
+
+	std::unique_ptr<InfiniteInterpolator> interpolator = createInterpolator(_settings.smoothing);
+	interpolator->setTransitionDuration(_settings.settlingTime);
+	interpolator->setSmoothingFactor(0.1f);
+	interpolator->setSpringiness(200.0f, 26.0f);
+	interpolator->setMaxLuminanceChangePerFrame(0.0f);
+
+	QJsonObject e131Config = deviceConfig;
+	e131Config["type"] = "udpe131";
+	e131Config["host"] = "127.0.0.1";
+	e131Config["universe"] = 1;
+	e131Config["cid"] = "0b4c0ba2-6a3e-4d9f-a3cf-7a2e0b1c9e41";
+	E131Sink e131(e131Config);
+	e131.start();
+	const bool e131Ready = e131.isInitialised() && e131.isReady();
+
+#if defined(ENABLE_SPIDEV) || defined(ENABLE_SPI_FTDI)
+	QJsonObject ws2812Config = deviceConfig;
+	ws2812Config["type"] = "ws2812spi";
+	ws2812Config["output"] = "/dev/spidev0.0";
+	ws2812Config["rate"] = 3200000;
+	Ws2812SpiSink ws2812(ws2812Config);
+	ws2812.start();
+	const bool ws2812Ready = ws2812.isInitialised() && ws2812.isReady();
+#else
+	const bool ws2812Ready = false;
+#endif
+
+	std::array<std::vector<int64_t>, STAGE_COUNT> samples;
+	for (auto& stage : samples)
+		stage.reserve(_settings.frames);
+
+	Image<ColorRgb> image;
+	float currentTime = 1000.0f;
+	const int totalFrames = _settings.warmup + _settings.frames;
+
+	for (int i = 0; i < totalFrames; i++, currentTime += frameInterval)
+	{
+		const bool measured = i >= _settings.warmup;
+		const std::vector<uint8_t>& frame = _frames[static_cast<size_t>(i) % _frames.size()];
+		std::array<int64_t, STAGE_COUNT> elapsed{};
+		std::vector<linalg::aliases::float3> ledColors;
+		ledColors.reserve(ledCount);
+
+		auto measure = [&elapsed](int stage, auto&& function) {
+			const auto begin = Clock::now();
+			function();
+			elapsed[stage] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+		};
+
+		measure(DECODE, [&]() {
+			std::shared_ptr<FrameStatistics> statistics = (_settings.statistics) ? std::make_shared<FrameStatistics>() : nullptr;
+			FrameDecoder::dispatchProcessImageVector[_settings.quarter][false][_settings.statistics](
+				0, 0, 0, 0,
+				frame.data(), nullptr, _settings.width, _settings.height, lineLength, format, lutBuffer, image, statistics.get());
+			image.setStatistics(statistics);
+		});
+
+		if (image.width() <= 1 || image.height() <= 1)
+		{
+			result["error"] = "The frame decoder did not produce an image";
+			return result;
+		}
+
+		measure(BORDER_DETECTION, [&]() {
+			hyperhdr::BlackBorder border{ true, -1, -1 };
+
+			if (useBorderDetector)
+			{
+				if (_settings.blackBorderMode == "classic")
+					border = borderDetector.process_classic(image);
+				else if (_settings.blackBorderMode == "osd")
+					border = borderDetector.process_osd(image);
+				else if (_settings.blackBorderMode == "letterbox")
+					border = borderDetector.process_letterbox(image);
+				else
+					border = borderDetector.process(image);
+			}
+
+			if (colorAveraging == nullptr || colorAveraging->width() != image.width() || colorAveraging->height() != image.height() || !(border == currentBorder))
+			{
+				currentBorder = border;
+				colorAveraging = std::make_unique<hyperhdr::ImageColorAveraging>(_log, mappingType, _settings.sparse, image.width(), image.height(),
+					(border.unknown) ? 0 : border.horizontalSize, (border.unknown) ? 0 : border.verticalSize, 0, ledString.leds());
+			}
+		});
+
+		measure(AVERAGING, [&]() {
+			colorAveraging->process(ledColors, image);
+		});
+
+		std::optional<float> minimalBacklight;
+		measure(PROCESSING, [&]() {
+			processing.applyyAllProcessingSteps(ledColors);
+			minimalBacklight = processing.getMinimalBacklight();
+		});
+
+		SharedOutputColors outputColors;
+		measure(SMOOTHING, [&]() {
+			const float minBrightness = minimalBacklight.value_or(0.0f);
+			interpolator->setTargetColors(std::move(ledColors), currentTime, false);
+			interpolator->updateCurrentColors(currentTime + frameInterval, minBrightness);
+			outputColors = interpolator->getCurrentColors(minBrightness);
+		});
+
+		if (e131Ready)
+			measure(ENCODE_E131, [&]() { e131.encode(outputColors); });
+
+#if defined(ENABLE_SPIDEV) || defined(ENABLE_SPI_FTDI)
+		if (ws2812Ready)
+			measure(ENCODE_WS2812SPI, [&]() { ws2812.encode(outputColors); });
+#endif
+
+		if (measured)
+		{
+			for (int stage = DECODE; stage < TOTAL; stage++)
+			{
+				if ((stage == BORDER_DETECTION && !useBorderDetector) || (stage == ENCODE_E131 && !e131Ready) || (stage == ENCODE_WS2812SPI && !ws2812Ready))
+					continue;
+
+				samples[stage].push_back(elapsed[stage]);
+				elapsed[TOTAL] += elapsed[stage];
+			}
+			samples[TOTAL].push_back(elapsed[TOTAL]);
+		}
+	}
+
+	QJsonArray stages;
+	for (int stage = DECODE; stage < STAGE_COUNT; stage++)
+	{
+		if (samples[stage].empty())
+			continue;
+
+		QJsonObject item = summarize(samples[stage]);
+		item["stage"] = stageName(stage);
+		stages.append(item);
+	}
+
+	result["output_width"] = static_cast<int>(image.width());
+	result["output_height"] = static_cast<int>(image.height());
+	result["border"] = QJsonObject{
+		{ "unknown", currentBorder.unknown },
+		{ "horizontal", currentBorder.horizontalSize },
+		{ "vertical", currentBorder.verticalSize } };
+	result["stages"] = stages;
+
+	if (e131Ready)
+		result["e131_bytes_per_frame"] = static_cast<qint64>(e131.writtenBytes() / totalFrames);
+	else
+		result["e131_skipped"] = "the E1.31 driver could not be initialized";
+
+#if defined(ENABLE_SPIDEV) || defined(ENABLE_SPI_FTDI)
+	if (ws2812Ready)
+		result["ws2812spi_bytes_per_frame"] = static_cast<qint64>(ws2812.writtenBytes() / totalFrames);
+	else
+		result["ws2812spi_skipped"] = "the WS2812SPI driver could not be initialized on this platform";
+#else
+	result["ws2812spi_skipped"] = "SPI LED drivers are disabled in this build";
+#endif
+
+	return result;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+/* PipelineBenchmark.h
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QJsonArray>
+	#include <QJsonObject>
+	#include <QString>
+
+	#include <cstdint>
+	#include <vector>
+#endif
+
+#include <utils/PixelFormat.h>
+#include <utils/LutLoader.h>
+#include <utils/Logger.h>
+
+///
+/// Replays synthetic or recorded frames through the per-instance processing chain: frame decoding,
+/// black border detection, LED averaging, color processing, smoothing and the E1.31 / WS2812SPI encoders.
+/// No capture device, LED hardware or network is touched: the drivers write into null sinks.
+///
+class PipelineBenchmark
+{
+public:
+	struct Settings
+	{
+		int width = 1920;
+		int height = 1080;
+		bool quarter = false;
+		bool statistics = true;
+		bool letterbox = true;
+		QString layout = "border";
+		QString blackBorderMode = "default";
+		QString mapping = "advanced";
+		bool sparse = false;
+		QString smoothing = "YuvInterpolator";
+		int settlingTime = 150;
+		int fps = 60;
+		int frames = 600;
+		int warmup = 60;
+		int samples = 8;
+		QString input;
+		QString lutFile;
+	};
+
+	PipelineBenchmark(const Settings& settings);
+
+	bool prepare(PixelFormat format);
+	QJsonObject run(PixelFormat format, int ledCount);
+	QJsonObject getSettingsInfo() const;
+	QString getLastError() const;
+
+	static bool isSupportedFormat(PixelFormat format);
+
+private:
+	struct FrameLayout
+	{
+		size_t frameSize;
+		int lineLength;
+	};
+
+	FrameLayout getFrameLayout(PixelFormat format) const;
+	bool loadRecordedFrames(PixelFormat format);
+	bool loadRecording(PixelFormat format);
+	void generateSyntheticFrames(PixelFormat format);
+	void renderSyntheticFrame(int index, std::vector<uint8_t>& rgb) const;
+	void encodeFrame(PixelFormat format, const std::vector<uint8_t>& rgb, uint8_t* target) const;
+	bool prepareLut(PixelFormat format);
+	QJsonArray createLayout(int ledCount) const;
+
+	Settings _settings;
+	LoggerName _log;
+	QString _lastError;
+	PixelFormat _preparedFormat;
+	std::vector<std::vector<uint8_t>> _frames;
+	LutLoader _lutLoader;
+};
@@ -0,0 +1,194 @@
+/* main.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QCoreApplication>
+	#include <QFile>
+	#include <QJsonArray>
+	#include <QJsonDocument>
+	#include <QJsonObject>
+	#include <QLocale>
+	#include <QSysInfo>
+
+	#include <clocale>
+	#include <iostream>
+#endif
+
+#include <HyperhdrConfig.h>
+#include <commandline/Parser.h>
+#include <utils/Logger.h>
+#include <utils/FrameRecording.h>
+#include "PipelineBenchmark.h"
+
+using namespace commandline;
+
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+
+	setlocale(LC_ALL, "C");
+	QLocale::setDefault(QLocale::c());
+
+	Parser parser("HyperHDR headless pipeline benchmark: decode, black border detection, averaging, processing, smoothing and LED encoding");
+	parser.addHelpOption();
+
+	PipelineBenchmark::Settings settings;
+
+	Option& formatsOption = parser.add<Option>('f', "formats", "Comma separated pixel formats: yuyv, uyvy, nv12, i420, p010, rgb24, xrgb", "yuyv,nv12,rgb24");
+	Option& ledsOption = parser.add<Option>('l', "leds", "Comma separated LED counts (1-10000)", "100,500,1000,2500,5000");
+	Option& layoutOption = parser.add<Option>(0x0, "layout", "LED layout: border or matrix", settings.layout);
+	Option& widthOption = parser.add<Option>(0x0, "width", "Frame width", QString::number(settings.width));
+	Option& heightOption = parser.add<Option>(0x0, "height", "Frame height", QString::number(settings.height));
+	BooleanOption& quarterOption = parser.add<BooleanOption>(0x0, "quarter", "Decode frames at a quarter of their size");
+	BooleanOption& noStatisticsOption = parser.add<BooleanOption>(0x0, "no-statistics", "Do not collect frame statistics while decoding");
+	BooleanOption& noLetterboxOption = parser.add<BooleanOption>(0x0, "no-letterbox", "Synthetic frames without the black cinema bars");
+	Option& blackBorderOption = parser.add<Option>(0x0, "blackborder", "Black border detection mode: default, classic, osd, letterbox or off", settings.blackBorderMode);
+	Option& mappingOption = parser.add<Option>(0x0, "mapping", "Image to LED mapping: advanced or unicolor_mean", settings.mapping);
+	BooleanOption& sparseOption = parser.add<BooleanOption>(0x0, "sparse", "Use sparse processing for the LED averaging");
+	Option& smoothingOption = parser.add<Option>(0x0, "smoothing", "Interpolator: Stepper, RgbInterpolator, YuvInterpolator, HybridInterpolator, HybridRgbInterpolator or ExponentialInterpolator", settings.smoothing);
+	Option& fpsOption = parser.add<Option>(0x0, "fps", "Simulated frame rate for the smoothing clock", QString::number(settings.fps));
+	Option& framesOption = parser.add<Option>('n', "frames", "Number of measured frames for every run", QString::number(settings.frames));
+	Option& warmupOption = parser.add<Option>(0x0, "warmup", "Number of frames processed before measuring", QString::number(settings.warmup));
+	Option& inputOption = parser.add<Option>('i', "input", "Replay a HyperHDR capture recording or raw frames from this file instead of synthetic ones (raw frames require exactly one format)");
+	Option& lutOption = parser.add<Option>(0x0, "lut", "Use this LUT file for the YUV formats instead of a generated BT.709 table");
+	Option& outputOption = parser.add<Option>('o', "output", "Write the JSON report to this file instead of the standard output");
+	BooleanOption& debugOption = parser.add<BooleanOption>('d', "debug", "Show debug messages");
+
+	parser.process(app);
+
+	Logger::getInstance()->setLogLevel((parser.isSet(debugOption)) ? Logger::DEBUG : Logger::WARNING);
+
+	settings.layout = layoutOption.value(parser);
+	settings.width = widthOption.value(parser).toInt();
+	settings.height = heightOption.value(parser).toInt();
+	settings.quarter = parser.isSet(quarterOption);
+	settings.statistics = !parser.isSet(noStatisticsOption);
+	settings.letterbox = !parser.isSet(noLetterboxOption);
+	settings.blackBorderMode = blackBorderOption.value(parser);
+	settings.mapping = mappingOption.value(parser);
+	settings.sparse = parser.isSet(sparseOption);
+	settings.smoothing = smoothingOption.value(parser);
+	settings.fps = fpsOption.value(parser).toInt();
+	settings.frames = framesOption.value(parser).toInt();
+	settings.warmup = warmupOption.value(parser).toInt();
+	settings.input = inputOption.value(parser);
+	settings.lutFile = lutOption.value(parser);
+
+	std::vector<PixelFormat> formats;
+	for (const QString& name : formatsOption.value(parser).split(',', Qt::SkipEmptyParts))
+	{
+		PixelFormat format = parsePixelFormat(name.trimmed());
+		if (!PipelineBenchmark::isSupportedFormat(format))
+		{
+			std::cerr << "Unsupported pixel format: " << name.toStdString() << std::endl;
+			return 1;
+		}
+		formats.push_back(format);
+	}
+
+	std::vector<int> ledCounts;
+	for (const QString& count : ledsOption.value(parser).split(',', Qt::SkipEmptyParts))
+	{
+		bool isInt = false;
+		int leds = count.trimmed().toInt(&isInt);
+		if (!isInt || leds < 1 || leds > 10000)
+		{
+			std::cerr << "Invalid LED count: " << count.toStdString() << std::endl;
+			return 1;
+		}
+		ledCounts.push_back(leds);
+	}
+
+	if (formats.empty() || ledCounts.empty())
+	{
+		std::cerr << "At least one pixel format and one LED count are required" << std::endl;
+		return 1;
+	}
+
+	// a HyperHDR capture recording describes its frames by itself
+	if (FrameRecording::isRecording(settings.input))
+	{
+		FrameRecordingReader reader;
+		if (!reader.open(settings.input) || !PipelineBenchmark::isSupportedFormat(reader.format()))
+		{
+			std::cerr << "Unsupported recording: " << ((reader.getLastError().isEmpty()) ? pixelFormatToString(reader.format()) : reader.getLastError()).toStdString() << std::endl;
+			return 1;
+		}
+
+		settings.width = reader.width();
+		settings.height = reader.height();
+		formats = { reader.format() };
+	}
+
+	if (!settings.input.isEmpty() && formats.size() != 1)
+	{
+		std::cerr << "Recorded frames can be replayed only with a single pixel format" << std::endl;
+		return 1;
+	}
+
+	PipelineBenchmark benchmark(settings);
+	QJsonArray runs;
+	int failures = 0;
+
+	for (PixelFormat format : formats)
+		for (int leds : ledCounts)
+		{
+			QJsonObject run = benchmark.run(format, leds);
+			if (run.contains("error"))
+			{
+				std::cerr << run["error"].toString().toStdString() << std::endl;
+				failures++;
+			}
+			runs.append(run);
+		}
+
+	QJsonObject report;
+	report["benchmark"] = "pipeline";
+	report["version"] = QString(HYPERHDR_VERSION);
+	report["platform"] = QSysInfo::prettyProductName();
+	report["architecture"] = QSysInfo::currentCpuArchitecture();
+	report["settings"] = benchmark.getSettingsInfo();
+	report["runs"] = runs;
+
+	QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+	if (outputOption.value(parser).isEmpty())
+	{
+		std::cout << json.toStdString();
+	}
+	else
+	{
+		QFile file(outputOption.value(parser));
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size())
+		{
+			std::cerr << "Could not write the report to: " << outputOption.value(parser).toStdString() << std::endl;
+			return 1;
+		}
+	}
+
+	return (failures > 0) ? 1 : 0;
+}
@@ -53,10 +53,13 @@
 }
 
 #define SOUNDCAPLINUX_BUF_LENP 10
+#define SOUNDCAPLINUX_LOWLATENCY_PERIOD 256
+#define SOUNDCAPLINUX_RATE 22050
 
-AlsaWorkerThread::AlsaWorkerThread(const LoggerName& logger, QString device, SoundCapture* parent) :
+AlsaWorkerThread::AlsaWorkerThread(const LoggerName& logger, QString device, bool lowLatency, SoundCapture* parent) :
 	_logger(logger),
 	_device(device),
+	_lowLatency(lowLatency),
 	_parent(parent)
 {
 }
@@ -108,6 +111,8 @@ bool AlsaWorkerThread::initAlsaLib()
 		GET_FUN_HOOK(snd_config_update_free_global);
 		GET_FUN_HOOK(snd_strerror);
 		GET_FUN_HOOK(snd_pcm_avail_update);
+		GET_FUN_HOOK(snd_pcm_mmap_begin);
+		GET_FUN_HOOK(snd_pcm_mmap_commit);
 	}
 	catch (std::exception& ex)
 	{
@@ -119,15 +124,55 @@ bool AlsaWorkerThread::initAlsaLib()
 	return true;
 }
 
+snd_pcm_sframes_t AlsaWorkerThread::readMmap(snd_pcm_t* handle)
+{
+	snd_pcm_sframes_t avail = this->snd_pcm_avail_update(handle);
+
+	if (avail <= 0)
+		return avail;
+
+	// the newest sample has just been captured, every older one is a sample period older
+	const int64_t now = InternalClock::nowMicro();
+	snd_pcm_uframes_t remaining = static_cast<snd_pcm_uframes_t>(avail);
+
+	while (remaining > 0)
+	{
+		const snd_pcm_channel_area_t* areas = nullptr;
+		snd_pcm_uframes_t offset = 0;
+		snd_pcm_uframes_t frames = remaining;
+
+		int status = this->snd_pcm_mmap_begin(handle, &areas, &offset, &frames);
+		if (status < 0)
+			return status;
+
+		if (frames == 0)
+			break;
+
+		remaining -= frames;
+
+		const int16_t* samples = reinterpret_cast<const int16_t*>(static_cast<const uint8_t*>(areas[0].addr) + (areas[0].first + offset * areas[0].step) / 8);
+		_parent->analyzeSamples(samples, static_cast<int>(frames), now - static_cast<int64_t>((remaining * 1000000) / SOUNDCAPLINUX_RATE));
+
+		snd_pcm_sframes_t committed = this->snd_pcm_mmap_commit(handle, offset, frames);
+		if (committed < 0)
+			return committed;
+		else if (static_cast<snd_pcm_uframes_t>(committed) != frames)
+			return -EPIPE;
+	}
+
+	return avail;
+}
+
 void AlsaWorkerThread::run(){
-	snd_pcm_sframes_t workingSizeSample = (1 << SOUNDCAPLINUX_BUF_LENP);
+	snd_pcm_sframes_t workingSizeSample = (_lowLatency) ? SOUNDCAPLINUX_LOWLATENCY_PERIOD : (1 << SOUNDCAPLINUX_BUF_LENP);
 	snd_pcm_uframes_t periodSize = workingSizeSample;
 	snd_pcm_uframes_t bufferSizeInBytes = periodSize * 2;
 	bool			initialMessage = false;
 	snd_pcm_t*		handle;
 	int				status = 0;
 	bool    		error = false;
-	unsigned int 	exactRate = 22050;
+	bool			mmapAccess = false;
+	unsigned int 	exactRate = SOUNDCAPLINUX_RATE;
 
 	if (!initAlsaLib())
 		return;
@@ -160,10 +205,19 @@ void AlsaWorkerThread::run(){
 			throw 1;
 		}
 
-		if ((status = this->snd_pcm_hw_params_set_access(handle, selected_hw_params, SND_PCM_ACCESS_RW_INTERLEAVED)) < 0) {
+		if (_lowLatency && (status = this->snd_pcm_hw_params_set_access(handle, selected_hw_params, SND_PCM_ACCESS_MMAP_INTERLEAVED)) >= 0)
+		{
+			mmapAccess = true;
+			Info(_logger, "Low latency mode: using mmap access");
+		}
+		else if ((status = this->snd_pcm_hw_params_set_access(handle, selected_hw_params, SND_PCM_ACCESS_RW_INTERLEAVED)) < 0) {
 			Error(_logger, "Cannot set snd_pcm_hw_params_set_access: '{:s}'", this->snd_strerror(status));
 			throw 2;
 		}
+		else if (_lowLatency)
+		{
+			Warning(_logger, "Low latency mode: the device doesn't support mmap access, falling back to read access with short periods");
+		}
 
 		if ((status = this->snd_pcm_hw_params_set_format(handle, selected_hw_params, SND_PCM_FORMAT_S16_LE)) < 0) {
 			Error(_logger, "Cannot set snd_pcm_hw_params_set_format: '{:s}'", this->snd_strerror(status));
@@ -174,9 +228,9 @@ void AlsaWorkerThread::run(){
 			Error(_logger, "Cannot set snd_pcm_hw_params_set_rate_near: '{:s}'", this->snd_strerror(status));
 			throw 4;
 		}
-		else if (exactRate != 22050)
+		else if (exactRate != SOUNDCAPLINUX_RATE)
 		{
-			Error(_logger, "Cannot set rate to 22050");
+			Error(_logger, "Cannot set rate to {:d}", SOUNDCAPLINUX_RATE);
 			throw 5;
 		}
 
@@ -193,7 +247,10 @@ void AlsaWorkerThread::run(){
 		else
 			Info(_logger, "Sound period size = %lu", (unsigned long)periodSize);
 
-		bufferSizeInBytes = periodSize * 2;	
+		// low latency: a few short periods so the device can't accumulate much data
+		bufferSizeInBytes = periodSize * ((_lowLatency) ? 4 : 2);
+		if (_lowLatency)
+			workingSizeSample = periodSize;
 
 		if ((status = this->snd_pcm_hw_params_set_buffer_size_near(handle, selected_hw_params, &bufferSizeInBytes)) < 0)
 		{
@@ -232,12 +289,25 @@ void AlsaWorkerThread::run(){
 	{
 		snd_pcm_sframes_t retVal = this->snd_pcm_wait(handle, 100);
 
-		if (retVal > 0 && !_exitNow)
+		if (retVal > 0 && !_exitNow && mmapAccess)
+		{
+			retVal = readMmap(handle);
+
+			if (retVal > 0 && !initialMessage)
+			{
+				Debug(_logger, "Got new audio frame: {:d} samples (mmap)", retVal);
+				initialMessage = true;
+			}
+		}
+		else if (retVal > 0 && !_exitNow)
 		{
 			retVal = this->snd_pcm_readi(handle, soundBuffer.data(), soundBuffer.size());
 			if (retVal >= workingSizeSample && !_exitNow)
 			{
-				_parent->analyzeSpectrum(soundBuffer.data(), SOUNDCAPLINUX_BUF_LENP);
+				if (_lowLatency)
+					_parent->analyzeSamples(soundBuffer.data(), static_cast<int>(retVal), InternalClock::nowMicro());
+				else
+					_parent->analyzeSpectrum(soundBuffer.data(), SOUNDCAPLINUX_BUF_LENP);
 
 				if (!initialMessage)
 					Debug(_logger, "Got new audio frame: {:d} bytes. Remains: {:d} bytes", workingSizeSample, this->snd_pcm_avail_update(handle));
@@ -393,7 +463,7 @@ void SoundCaptureLinux::start()
 
 		_isRunning = true;
 
-		_thread = new AlsaWorkerThread(_logger, device, this);
+		_thread = new AlsaWorkerThread(_logger, device, _lowLatency, this);
 		_thread->setObjectName("SoundCapturing");
 		connect(_thread, &AlsaWorkerThread::finished, this, [this]() {stop(); });		
 		_thread->start();		
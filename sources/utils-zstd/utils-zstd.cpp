@@ -107,3 +107,15 @@ _ZSTD_SHARED_API const char* DecompressZSTD(size_t downloadedDataSize, const uin
 	
 	return error;
 }
+
+_ZSTD_SHARED_API size_t CompressBoundZSTD(size_t sourceSize)
+{
+	return ZSTD_compressBound(sourceSize);
+}
+
+_ZSTD_SHARED_API size_t CompressZSTD(const uint8_t* source, size_t sourceSize, uint8_t* dest, size_t destCapacity, int level)
+{
+	size_t const ret = ZSTD_compress(dest, destCapacity, source, sourceSize, level);
+
+	return (ZSTD_isError(ret)) ? 0 : ret;
+}
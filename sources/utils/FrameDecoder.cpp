@@ -29,19 +29,19 @@
 #include <utils/FrameDecoder.h>
 #include <utils/VectorizedDecoders.h>
 #include <utils/FrameDecoderUtils.h>
-#include <base/AutomaticToneMapping.h>
+#include <image/FrameStatistics.h>
 #include <utils/Logger.h>
 
 #include <atomic>
 #include <mutex>
 #include <numbers>
 
-template<bool Quarter, bool UseToneMapping, bool UseAutomaticToneMapping>
+template<bool Quarter, bool UseToneMapping, bool CollectStatistics>
 void FrameDecoder::processImageVector(
 	int _cropLeft, int _cropRight, int _cropTop, int _cropBottom,
 	const uint8_t* data, const uint8_t* dataUV, int width, int height, int lineLength,
 	const PixelFormat pixelFormat, const uint8_t* lutBuffer,
-	Image<ColorRgb>& outputImage, AutomaticToneMapping* automaticToneMapping)
+	Image<ColorRgb>& outputImage, FrameStatistics* statistics)
 {
 	LoggerName logger("FrameDecoder");
 
@@ -80,6 +80,12 @@ void FrameDecoder::processImageVector(
 	uint8_t* destMemory = outputImage.rawMem();
 	int      destLineSize = outputImage.width() * 3;
 
+	if constexpr (CollectStatistics)
+		statistics->prepare(outputWidth, outputHeight);
+
+	const bool collectSourceRange = CollectStatistics && statistics->collectSourceRange();
+	const int  sourceWidth = width - _cropLeft - _cropRight;
+
 	// ---- P010 ----
 	if (pixelFormat == PixelFormat::P010)
 	{
@@ -97,9 +103,9 @@ void FrameDecoder::processImageVector(
 			uint8_t* currentSource = (uint8_t*)data + (uint64_t)lineLength * ySource + (uint64_t)_cropLeft;
 			uint8_t* currentSourceUV = deltaUV + ((uint64_t)ySource / 2) * lineLength + (uint64_t)_cropLeft;
 
-			if constexpr (UseAutomaticToneMapping) if (yDest % 4 == 0)
+			if (collectSourceRange && yDest % 4 == 0)
 			{
-				automaticToneMapping->scan_Y_UV_16(width, currentSource, currentSourceUV);
+				statistics->scanSource_Y_UV_16(sourceWidth, currentSource, currentSourceUV);
 			};
 
 			if constexpr (!UseToneMapping)
@@ -116,11 +122,9 @@ void FrameDecoder::processImageVector(
 					reinterpret_cast<uint64_t*>(currentSourceUV),
 					lutBuffer, currentDest, endDest, lutP010_y, lutP010_uv);
 			}
-		}
 
-		if constexpr (UseAutomaticToneMapping)
-		{
-			automaticToneMapping->finilize();
+			if constexpr (CollectStatistics)
+				statistics->scanRow(yDest, currentDest);
 		}
 		return;
 	}
@@ -143,6 +147,9 @@ void FrameDecoder::processImageVector(
 				reinterpret_cast<uint16_t*>(currentSourceU),
 				reinterpret_cast<uint16_t*>(currentSourceV),
 				lutBuffer, currentDest, endDest);
+
+			if constexpr (CollectStatistics)
+				statistics->scanRow(yDest, currentDest);
 		}
 		return;
 	}
@@ -160,20 +167,18 @@ void FrameDecoder::processImageVector(
 			uint8_t* currentSource = (uint8_t*)data + (uint64_t)lineLength * ySource + (uint64_t)_cropLeft;
 			uint8_t* currentSourceUV = deltaUV + ((uint64_t)ySource / 2) * lineLength + (uint64_t)_cropLeft;
 
-			if constexpr (UseAutomaticToneMapping) if (yDest % 4 == 0)
+			if (collectSourceRange && yDest % 4 == 0)
 			{
-				automaticToneMapping->scan_Y_UV_8(width, currentSource, currentSourceUV);
+				statistics->scanSource_Y_UV_8(sourceWidth, currentSource, currentSourceUV);
 			};
 
 			VECTOR_NV12::process<Quarter>(
 				reinterpret_cast<uint32_t*>(currentSource),
 				reinterpret_cast<uint32_t*>(currentSourceUV),
 				lutBuffer, currentDest, endDest);
-		}
 
-		if constexpr (UseAutomaticToneMapping)
-		{
-			automaticToneMapping->finilize();
+			if constexpr (CollectStatistics)
+				statistics->scanRow(yDest, currentDest);
 		}
 
 		return;
@@ -188,19 +193,17 @@ void FrameDecoder::processImageVector(
 			uint8_t* endDest = currentDest + destLineSize;
 			uint8_t* currentSource = (uint8_t*)data + (((uint64_t)lineLength * ySource) + (((uint64_t)_cropLeft) << 1));
 
-			if constexpr (UseAutomaticToneMapping) if (yDest % 4 == 0)
+			if (collectSourceRange && yDest % 4 == 0)
 			{
-				automaticToneMapping->scan_YUYV(width, currentSource);
+				statistics->scanSource_YUYV(sourceWidth, currentSource);
 			};
 
 			VECTOR_YUYV::process<Quarter>(
 				reinterpret_cast<uint32_t*>(currentSource),
 				lutBuffer, currentDest, endDest);
-		}
 
-		if constexpr (UseAutomaticToneMapping)
-		{
-			automaticToneMapping->finilize();
+			if constexpr (CollectStatistics)
+				statistics->scanRow(yDest, currentDest);
 		}
 
 		return;
@@ -218,6 +221,9 @@ void FrameDecoder::processImageVector(
 			VECTOR_UYVY::process<Quarter>(
 				reinterpret_cast<uint32_t*>(currentSource),
 				lutBuffer, currentDest, endDest);
+
+			if constexpr (CollectStatistics)
+				statistics->scanRow(yDest, currentDest);
 		}
 
 		return;
@@ -243,6 +249,9 @@ void FrameDecoder::processImageVector(
 				VECTOR_RGB::decode<false, Quarter, UseToneMapping>(
 					currentSource, lutBuffer, currentDest, endDest);
 			}
+
+			if constexpr (CollectStatistics)
+				statistics->scanRow(yDest, currentDest);
 		}
 
 		return;
@@ -266,6 +275,9 @@ void FrameDecoder::processImageVector(
 				reinterpret_cast<uint16_t*>(currentSourceU),
 				reinterpret_cast<uint16_t*>(currentSourceV),
 				lutBuffer, currentDest, endDest);
+
+			if constexpr (CollectStatistics)
+				statistics->scanRow(yDest, currentDest);
 		}
 		return;
 	}
@@ -273,28 +285,28 @@ void FrameDecoder::processImageVector(
 
 // Explicitly instantiate the template specializations that are used in GrabberWorker.
 template void FrameDecoder::processImageVector<false, false, false>(
-	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, AutomaticToneMapping*);
+	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, FrameStatistics*);
 
 template void FrameDecoder::processImageVector<false, true, false>(
-	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, AutomaticToneMapping*);
+	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, FrameStatistics*);
 
 template void FrameDecoder::processImageVector<true, false, false>(
-	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, AutomaticToneMapping*);
+	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, FrameStatistics*);
 
 template void FrameDecoder::processImageVector<true, true, false>(
-	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, AutomaticToneMapping*);
+	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, FrameStatistics*);
 
 template void FrameDecoder::processImageVector<false, false, true>(
-	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, AutomaticToneMapping*);
+	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, FrameStatistics*);
 
 template void FrameDecoder::processImageVector<false, true, true>(
-	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, AutomaticToneMapping*);
+	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, FrameStatistics*);
 
 template void FrameDecoder::processImageVector<true, false, true>(
-	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, AutomaticToneMapping*);
+	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, FrameStatistics*);
 
 template void FrameDecoder::processImageVector<true, true, true>(
-	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, AutomaticToneMapping*);
+	int, int, int, int, const uint8_t*, const uint8_t*, int, int, int, PixelFormat, const uint8_t*, Image<ColorRgb>&, FrameStatistics*);
 
 void FrameDecoder::applyLUT(uint8_t* _source, unsigned int width, unsigned int height, const uint8_t* lutBuffer, const int _hdrToneMappingEnabled)
 {
@@ -341,7 +353,7 @@ void FrameDecoder::applyLUT(uint8_t* _source, unsigned int width, unsigned int h
 void FrameDecoder::processSystemImageBGRA(Image<ColorRgb>& image, int targetSizeX, int targetSizeY,
 	int startX, int startY,
 	uint8_t* source, int _actualWidth, int _actualHeight,
-	int division, uint8_t* _lutBuffer, int lineSize)
+	int division, uint8_t* _lutBuffer, int lineSize, FrameStatistics* statistics)
 {
 	uint32_t	ind_lutd;
 	uint8_t		buffer[8];
@@ -350,6 +362,9 @@ void FrameDecoder::processSystemImageBGRA(Image<ColorRgb>& image, int targetSize
 	if (lineSize == 0)
 		lineSize = _actualWidth * 4;
 
+	if (statistics != nullptr)
+		statistics->prepare(targetSizeX, targetSizeY);
+
 	for (int j = 0; j < targetSizeY; j++)
 	{
 		size_t lineSource = std::min(startY + j * division, _actualHeight - 1);
@@ -376,13 +391,16 @@ void FrameDecoder::processSystemImageBGRA(Image<ColorRgb>& image, int targetSize
 			*((uint32_t*)dLine) = *((uint32_t*)(&_lutBuffer[ind_lutd]));
 			dLine += 3;
 		}
+
+		if (statistics != nullptr)
+			statistics->scanRow(j, image.rawMem() + (size_t)j * targetSizeX * 3);
 	}
 }
 
 void FrameDecoder::processSystemImageBGR(Image<ColorRgb>& image, int targetSizeX, int targetSizeY,
 	int startX, int startY,
 	uint8_t* source, int _actualWidth, int _actualHeight,
-	int division, uint8_t* _lutBuffer, int lineSize)
+	int division, uint8_t* _lutBuffer, int lineSize, FrameStatistics* statistics)
 {
 	uint32_t	ind_lutd;
 	uint8_t		buffer[8];
@@ -391,6 +409,9 @@ void FrameDecoder::processSystemImageBGR(Image<ColorRgb>& image, int targetSizeX
 	if (lineSize == 0)
 		lineSize = _actualWidth * 3;
 
+	if (statistics != nullptr)
+		statistics->prepare(targetSizeX, targetSizeY);
+
 	for (int j = 0; j < targetSizeY; j++)
 	{
 		size_t lineSource = std::min(startY + j * division, _actualHeight - 1);
@@ -417,6 +438,9 @@ void FrameDecoder::processSystemImageBGR(Image<ColorRgb>& image, int targetSizeX
 			*((uint32_t*)dLine) = *((uint32_t*)(&_lutBuffer[ind_lutd]));
 			dLine += 3;
 		}
+
+		if (statistics != nullptr)
+			statistics->scanRow(j, image.rawMem() + (size_t)j * targetSizeX * 3);
 	}
 }
 
@@ -424,7 +448,7 @@ void FrameDecoder::processSystemImageBGR(Image<ColorRgb>& image, int targetSizeX
 void FrameDecoder::processSystemImageBGR16(Image<ColorRgb>& image, int targetSizeX, int targetSizeY,
 	int startX, int startY,
 	uint8_t* source, int _actualWidth, int _actualHeight,
-	int division, uint8_t* _lutBuffer, int lineSize)
+	int division, uint8_t* _lutBuffer, int lineSize, FrameStatistics* statistics)
 {
 	uint32_t	ind_lutd;
 	uint8_t		buffer[8];
@@ -433,6 +457,9 @@ void FrameDecoder::processSystemImageBGR16(Image<ColorRgb>& image, int targetSiz
 	if (lineSize == 0)
 		lineSize = _actualWidth * 2;
 
+	if (statistics != nullptr)
+		statistics->prepare(targetSizeX, targetSizeY);
+
 	for (int j = 0; j < targetSizeY; j++)
 	{
 		size_t lineSource = std::min(startY + j * division, _actualHeight - 1);
@@ -467,6 +494,9 @@ void FrameDecoder::processSystemImageBGR16(Image<ColorRgb>& image, int targetSiz
 			*((uint32_t*)dLine) = *((uint32_t*)(&_lutBuffer[ind_lutd]));
 			dLine += 3;
 		}
+
+		if (statistics != nullptr)
+			statistics->scanRow(j, image.rawMem() + (size_t)j * targetSizeX * 3);
 	}
 }
 
@@ -475,7 +505,7 @@ void FrameDecoder::processSystemImageBGR16(Image<ColorRgb>& image, int targetSiz
 void FrameDecoder::processSystemImageRGBA(Image<ColorRgb>& image, int targetSizeX, int targetSizeY,
 											int startX, int startY,
 											uint8_t* source, int _actualWidth, int _actualHeight,
-											int division, uint8_t* _lutBuffer, int lineSize)
+											int division, uint8_t* _lutBuffer, int lineSize, FrameStatistics* statistics)
 {
 	uint32_t	ind_lutd;
 	uint8_t		buffer[8];
@@ -484,6 +514,9 @@ void FrameDecoder::processSystemImageRGBA(Image<ColorRgb>& image, int targetSize
 	if (lineSize == 0)
 		lineSize = _actualWidth * 4;
 
+	if (statistics != nullptr)
+		statistics->prepare(targetSizeX, targetSizeY);
+
 	for (int j = 0; j < targetSizeY; j++)
 	{
 		size_t lineSource = std::min(startY + j * division, _actualHeight - 1);
@@ -509,13 +542,16 @@ void FrameDecoder::processSystemImageRGBA(Image<ColorRgb>& image, int targetSize
 			*((uint32_t*)dLine) = *((uint32_t*)(&_lutBuffer[ind_lutd]));
 			dLine += 3;
 		}
+
+		if (statistics != nullptr)
+			statistics->scanRow(j, image.rawMem() + (size_t)j * targetSizeX * 3);
 	}
 }
 
 void FrameDecoder::processSystemImagePQ10(Image<ColorRgb>& image, int targetSizeX, int targetSizeY,
 	int startX, int startY,
 	uint8_t* source, int _actualWidth, int _actualHeight,
-	int division, uint8_t* _lutBuffer, int lineSize)
+	int division, uint8_t* _lutBuffer, int lineSize, FrameStatistics* statistics)
 {
 	uint32_t	ind_lutd;
 	size_t		divisionX = (size_t)division * 4;
@@ -523,6 +559,9 @@ void FrameDecoder::processSystemImagePQ10(Image<ColorRgb>& image, int targetSize
 	if (lineSize == 0)
 		lineSize = _actualWidth * 4;
 
+	if (statistics != nullptr)
+		statistics->prepare(targetSizeX, targetSizeY);
+
 	for (int j = 0; j < targetSizeY; j++)
 	{
 		size_t lineSource = std::min(startY + j * division, _actualHeight - 1);
@@ -549,6 +588,9 @@ void FrameDecoder::processSystemImagePQ10(Image<ColorRgb>& image, int targetSize
 			sLine += divisionX;
 			dLine += 3;
 		}
+
+		if (statistics != nullptr)
+			statistics->scanRow(j, image.rawMem() + (size_t)j * targetSizeX * 3);
 	}
 }
 
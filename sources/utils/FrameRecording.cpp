@@ -0,0 +1,509 @@
+/* FrameRecording.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QFile>
+	#include <QFileInfo>
+	#include <QtEndian>
+	#include <cstring>
+#endif
+
+#include <HyperhdrConfig.h>
+#include <utils/FrameRecording.h>
+#include <utils/InternalClock.h>
+
+#ifdef ENABLE_ZSTD
+	#include <utils-zstd/utils-zstd.h>
+#endif
+
+namespace
+{
+	const char RECORDING_MAGIC[8] = { 'H', 'H', 'D', 'R', 'R', 'E', 'C', '1' };
+
+	// fast level: the recorder must keep up with 60fps 4K YUYV on a single core
+	constexpr int COMPRESSION_LEVEL = 1;
+
+	// the vectorized decoders may read a few bytes past the end of the frame like they do from the mmap'ed v4l2 buffers
+	constexpr size_t FRAME_PADDING = 64;
+
+	constexpr uint32_t MAX_FRAME_SIZE = 256 * 1024 * 1024;
+
+	template<typename T>
+	void put(uint8_t*& destination, T value)
+	{
+		qToLittleEndian<T>(value, destination);
+		destination += sizeof(T);
+	}
+
+	template<typename T>
+	T get(const uint8_t*& source)
+	{
+		T value = qFromLittleEndian<T>(source);
+		source += sizeof(T);
+		return value;
+	}
+};
+
+bool FrameRecording::isRecording(const QString& fileName)
+{
+	QFile file(fileName);
+	char magic[sizeof(RECORDING_MAGIC)];
+
+	return file.open(QIODevice::ReadOnly) &&
+		file.read(magic, sizeof(magic)) == static_cast<qint64>(sizeof(magic)) &&
+		memcmp(magic, RECORDING_MAGIC, sizeof(magic)) == 0;
+}
+
+FrameRecorder::FrameRecorder() :
+	_format(PixelFormat::NO_CHANGE),
+	_width(0),
+	_height(0),
+	_compress(false),
+	_frameLimit(0),
+	_firstTimestamp(-1),
+	_running(false),
+	_accepted(0),
+	_written(0),
+	_dropped(0),
+	_rawBytes(0),
+	_storedBytes(0)
+{
+}
+
+FrameRecorder::~FrameRecorder()
+{
+	stop();
+}
+
+bool FrameRecorder::start(const QString& fileName, PixelFormat format, int width, int height, int lineLength, bool compress, quint64 frameLimit)
+{
+	stop();
+
+	#ifndef ENABLE_ZSTD
+		compress = false;
+	#endif
+
+	_lastError.clear();
+	_file.setFileName(fileName);
+
+	if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		_lastError = QString("Could not create the recording file: %1").arg(fileName);
+		return false;
+	}
+
+	uint8_t header[FrameRecording::HEADER_SIZE] = {};
+	uint8_t* position = header;
+	const QByteArray formatName = pixelFormatToString(format).toLatin1().left(8);
+
+	memcpy(position, RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+	position += sizeof(RECORDING_MAGIC);
+	put<uint32_t>(position, FrameRecording::VERSION);
+	memcpy(position, formatName.constData(), formatName.size());
+	position += 8;
+	put<uint32_t>(position, static_cast<uint32_t>(width));
+	put<uint32_t>(position, static_cast<uint32_t>(height));
+	put<uint32_t>(position, static_cast<uint32_t>(lineLength));
+	put<uint32_t>(position, (compress) ? FrameRecording::FLAG_ZSTD : 0);
+
+	if (_file.write(reinterpret_cast<const char*>(header), sizeof(header)) != static_cast<qint64>(sizeof(header)))
+	{
+		_lastError = QString("Could not write the recording header: %1").arg(fileName);
+		_file.close();
+		return false;
+	}
+
+	_fileName = QFileInfo(fileName).absoluteFilePath();
+	_format = format;
+	_width = width;
+	_height = height;
+	_compress = compress;
+	_frameLimit = frameLimit;
+	_firstTimestamp = -1;
+	_accepted = 0;
+	_written = 0;
+	_dropped = 0;
+	_rawBytes = 0;
+	_storedBytes = sizeof(header);
+	_running = true;
+	_writer = std::thread(&FrameRecorder::writerLoop, this);
+
+	return true;
+}
+
+void FrameRecorder::record(const uint8_t* data, size_t size)
+{
+	if (data == nullptr || size == 0 || size > MAX_FRAME_SIZE)
+		return;
+
+	const int64_t now = InternalClock::nowMicro();
+	Frame frame;
+
+	{
+		std::lock_guard<std::mutex> locker(_locker);
+
+		if (!_running || (_frameLimit > 0 && _accepted >= _frameLimit))
+			return;
+
+		if (_queue.size() >= MAX_QUEUED_FRAMES)
+		{
+			_dropped++;
+			return;
+		}
+
+		if (_firstTimestamp < 0)
+			_firstTimestamp = now;
+
+		frame.timestamp = now - _firstTimestamp;
+
+		if (!_pool.empty())
+		{
+			frame.data = std::move(_pool.back());
+			_pool.pop_back();
+		}
+
+		_accepted++;
+	}
+
+	frame.data.resize(size);
+	memcpy(frame.data.data(), data, size);
+
+	{
+		std::lock_guard<std::mutex> locker(_locker);
+		_queue.push_back(std::move(frame));
+
+		// the last frame of the limit: the writer flushes the queue and finishes
+		if (_frameLimit > 0 && _accepted >= _frameLimit)
+			_running = false;
+	}
+
+	_signal.notify_one();
+}
+
+void FrameRecorder::writerLoop()
+{
+	for (;;)
+	{
+		Frame frame;
+
+		{
+			std::unique_lock<std::mutex> locker(_locker);
+			_signal.wait(locker, [this]() { return !_running || !_queue.empty(); });
+
+			// the pending frames are still flushed after stop() was requested
+			if (_queue.empty())
+				break;
+
+			frame = std::move(_queue.front());
+			_queue.pop_front();
+		}
+
+		bool result = writeFrame(frame);
+
+		{
+			std::lock_guard<std::mutex> locker(_locker);
+			_pool.push_back(std::move(frame.data));
+
+			if (!result)
+			{
+				_lastError = QString("Could not write to the recording file: %1").arg(_fileName);
+				_running = false;
+				_queue.clear();
+				break;
+			}
+		}
+	}
+}
+
+bool FrameRecorder::writeFrame(const Frame& frame)
+{
+	const uint8_t* payload = frame.data.data();
+	size_t stored = frame.data.size();
+
+	#ifdef ENABLE_ZSTD
+		if (_compress)
+		{
+			_compressed.resize(CompressBoundZSTD(frame.data.size()));
+
+			size_t packed = CompressZSTD(frame.data.data(), frame.data.size(), _compressed.data(), _compressed.size(), COMPRESSION_LEVEL);
+			if (packed > 0 && packed < stored)
+			{
+				payload = _compressed.data();
+				stored = packed;
+			}
+		}
+	#endif
+
+	uint8_t header[FrameRecording::FRAME_HEADER_SIZE];
+	uint8_t* position = header;
+
+	put<int64_t>(position, frame.timestamp);
+	put<uint32_t>(position, static_cast<uint32_t>(frame.data.size()));
+	put<uint32_t>(position, static_cast<uint32_t>(stored));
+
+	if (_file.write(reinterpret_cast<const char*>(header), sizeof(header)) != static_cast<qint64>(sizeof(header)) ||
+		_file.write(reinterpret_cast<const char*>(payload), stored) != static_cast<qint64>(stored))
+		return false;
+
+	_written++;
+	_rawBytes += frame.data.size();
+	_storedBytes += sizeof(header) + stored;
+
+	return true;
+}
+
+void FrameRecorder::stop()
+{
+	{
+		std::lock_guard<std::mutex> locker(_locker);
+		_running = false;
+	}
+
+	_signal.notify_all();
+
+	if (_writer.joinable())
+		_writer.join();
+
+	std::lock_guard<std::mutex> locker(_locker);
+
+	_queue.clear();
+	_pool.clear();
+	_compressed.clear();
+	_compressed.shrink_to_fit();
+
+	if (_file.isOpen())
+		_file.close();
+}
+
+bool FrameRecorder::isRecording() const
+{
+	std::lock_guard<std::mutex> locker(_locker);
+	return _running;
+}
+
+bool FrameRecorder::matches(PixelFormat format, int width, int height) const
+{
+	return _format == format && _width == width && _height == height;
+}
+
+QJsonObject FrameRecorder::getInfo() const
+{
+	QJsonObject info;
+	const quint64 rawBytes = _rawBytes;
+	const quint64 storedBytes = _storedBytes;
+
+	info["running"] = isRecording();
+	info["file"] = _fileName;
+	info["format"] = pixelFormatToString(_format);
+	info["width"] = _width;
+	info["height"] = _height;
+	info["compressed"] = _compress;
+	info["frameLimit"] = static_cast<qint64>(_frameLimit);
+	info["frames"] = static_cast<qint64>(_written.load());
+	info["dropped"] = static_cast<qint64>(_dropped.load());
+	info["rawBytes"] = static_cast<qint64>(rawBytes);
+	info["fileBytes"] = static_cast<qint64>(storedBytes);
+	info["ratio"] = (storedBytes > 0) ? static_cast<double>(rawBytes) / storedBytes : 0.0;
+
+	const QString error = getLastError();
+	if (!error.isEmpty())
+		info["error"] = error;
+
+	return info;
+}
+
+QString FrameRecorder::getLastError() const
+{
+	std::lock_guard<std::mutex> locker(_locker);
+	return _lastError;
+}
+
+FrameRecordingReader::FrameRecordingReader() :
+	_format(PixelFormat::NO_CHANGE),
+	_width(0),
+	_height(0),
+	_lineLength(0),
+	_flags(0)
+{
+}
+
+bool FrameRecordingReader::open(const QString& fileName)
+{
+	close();
+
+	_file.setFileName(fileName);
+
+	if (!_file.open(QIODevice::ReadOnly))
+	{
+		_lastError = QString("Could not open the recording: %1").arg(fileName);
+		return false;
+	}
+
+	uint8_t header[FrameRecording::HEADER_SIZE];
+
+	if (_file.read(reinterpret_cast<char*>(header), sizeof(header)) != static_cast<qint64>(sizeof(header)) ||
+		memcmp(header, RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0)
+	{
+		_lastError = QString("Not a HyperHDR frame recording: %1").arg(fileName);
+		close();
+		return false;
+	}
+
+	const uint8_t* position = header + sizeof(RECORDING_MAGIC);
+	const uint32_t version = get<uint32_t>(position);
+	const char* formatName = reinterpret_cast<const char*>(position);
+
+	_format = parsePixelFormat(QString::fromLatin1(formatName, static_cast<int>(qstrnlen(formatName, 8))));
+	position += 8;
+	_width = static_cast<int>(get<uint32_t>(position));
+	_height = static_cast<int>(get<uint32_t>(position));
+	_lineLength = static_cast<int>(get<uint32_t>(position));
+	_flags = get<uint32_t>(position);
+
+	if (version != FrameRecording::VERSION || _format == PixelFormat::NO_CHANGE || _width <= 0 || _height <= 0)
+	{
+		_lastError = QString("Unsupported frame recording (version: %1, format: %2, size: %3x%4)")
+			.arg(version).arg(pixelFormatToString(_format)).arg(_width).arg(_height);
+		close();
+		return false;
+	}
+
+	#ifndef ENABLE_ZSTD
+		if (_flags & FrameRecording::FLAG_ZSTD)
+		{
+			_lastError = "The recording is compressed but HyperHDR was built without a support for ZSTD decoder";
+			close();
+			return false;
+		}
+	#endif
+
+	_lastError.clear();
+	return true;
+}
+
+void FrameRecordingReader::close()
+{
+	if (_file.isOpen())
+		_file.close();
+
+	_compressed.clear();
+}
+
+bool FrameRecordingReader::rewind()
+{
+	return _file.isOpen() && _file.seek(FrameRecording::HEADER_SIZE);
+}
+
+bool FrameRecordingReader::atEnd() const
+{
+	return !_file.isOpen() || _file.atEnd();
+}
+
+bool FrameRecordingReader::readFrame(std::vector<uint8_t>& frame, size_t& size, int64_t& timestamp)
+{
+	uint8_t header[FrameRecording::FRAME_HEADER_SIZE];
+
+	if (!_file.isOpen() || _file.read(reinterpret_cast<char*>(header), sizeof(header)) != static_cast<qint64>(sizeof(header)))
+		return false;
+
+	const uint8_t* position = header;
+	timestamp = get<int64_t>(position);
+	const uint32_t raw = get<uint32_t>(position);
+	const uint32_t stored = get<uint32_t>(position);
+
+	if (raw == 0 || raw > MAX_FRAME_SIZE || stored == 0 || stored > raw)
+	{
+		_lastError = QString("Corrupted frame header at offset %1").arg(_file.pos() - static_cast<qint64>(sizeof(header)));
+		return false;
+	}
+
+	if (frame.size() < raw + FRAME_PADDING)
+		frame.resize(raw + FRAME_PADDING);
+
+	if (stored == raw)
+	{
+		if (_file.read(reinterpret_cast<char*>(frame.data()), raw) != static_cast<qint64>(raw))
+		{
+			_lastError = "The recording is truncated";
+			return false;
+		}
+	}
+	else
+	{
+		_compressed.resize(stored);
+
+		if (_file.read(reinterpret_cast<char*>(_compressed.data()), stored) != static_cast<qint64>(stored))
+		{
+			_lastError = "The recording is truncated";
+			return false;
+		}
+
+		[[maybe_unused]] const char* error = "HyperHDR was built without a support for ZSTD decoder";
+		#ifdef ENABLE_ZSTD
+			error = DecompressZSTD(stored, _compressed.data(), frame.data(), 0, static_cast<int>(raw));
+		#endif
+
+		if (error != nullptr)
+		{
+			_lastError = QString("Error while decompressing the frame: %1").arg(error);
+			return false;
+		}
+	}
+
+	size = raw;
+	return true;
+}
+
+PixelFormat FrameRecordingReader::format() const
+{
+	return _format;
+}
+
+int FrameRecordingReader::width() const
+{
+	return _width;
+}
+
+int FrameRecordingReader::height() const
+{
+	return _height;
+}
+
+int FrameRecordingReader::lineLength() const
+{
+	return _lineLength;
+}
+
+bool FrameRecordingReader::isCompressed() const
+{
+	return (_flags & FrameRecording::FLAG_ZSTD) != 0;
+}
+
+QString FrameRecordingReader::getLastError() const
+{
+	return _lastError;
+}
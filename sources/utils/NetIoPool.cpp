@@ -0,0 +1,177 @@
+/* NetIoPool.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QTcpSocket>
+	#include <QTimer>
+
+	#include <algorithm>
+#endif
+
+#include <utils/NetIoPool.h>
+#include <utils/InternalClock.h>
+#include <utils/GlobalSignals.h>
+#include <utils/Macros.h>
+#include <performance-counters/PerformanceCounters.h>
+
+thread_local NetIoPool::Slot* NetIoPool::_currentSlot = nullptr;
+std::mutex NetIoPool::_instanceMutex;
+std::weak_ptr<NetIoPool> NetIoPool::_instance;
+
+NetIoPool::BusyScope::BusyScope() :
+	_start((_currentSlot != nullptr) ? InternalClock::nowMicro() : 0)
+{
+}
+
+NetIoPool::BusyScope::~BusyScope()
+{
+	if (Slot* slot = _currentSlot; slot != nullptr)
+	{
+		const int64_t busy = InternalClock::nowMicro() - _start;
+
+		slot->busyTime += busy;
+		slot->busyMax = std::max(slot->busyMax, busy);
+		slot->events++;
+	}
+}
+
+std::shared_ptr<NetIoPool> NetIoPool::getInstance()
+{
+	std::lock_guard<std::mutex> lockGuard(_instanceMutex);
+
+	auto pool = _instance.lock();
+	if (pool == nullptr)
+	{
+		pool = std::shared_ptr<NetIoPool>(new NetIoPool());
+		_instance = pool;
+	}
+
+	return pool;
+}
+
+NetIoPool::NetIoPool() :
+	_log("NET_IO")
+{
+	const int threads = std::clamp(QThread::idealThreadCount() / 2, 1, MAX_THREADS);
+
+	for (int i = 0; i < threads; i++)
+	{
+		auto slot = std::make_shared<Slot>();
+		Slot* rawSlot = slot.get();
+
+		slot->index = i;
+		slot->thread = new QThread();
+		slot->thread->setObjectName(QString("NetIoThread%1").arg(i));
+		slot->context = new QObject();
+
+		QTimer* timer = new QTimer(slot->context);
+		timer->setInterval(1000);
+		QObject::connect(timer, &QTimer::timeout, slot->context, [rawSlot]() { report(rawSlot); });
+
+		slot->context->moveToThread(slot->thread);
+		QObject::connect(slot->thread, &QThread::started, slot->context, [rawSlot, timer]() {
+			_currentSlot = rawSlot;
+			timer->start();
+		});
+		slot->thread->start();
+
+		_slots.push_back(slot);
+	}
+
+	Info(_log, "Started {:d} network I/O thread(s)", threads);
+}
+
+NetIoPool::~NetIoPool()
+{
+	for (auto& slot : _slots)
+	{
+		hyperhdr::THREAD_REMOVER(QString("NetIoPool thread %1").arg(slot->index), slot->thread, slot->context);
+		emit GlobalSignals::getInstance()->SignalPerformanceStateChanged(false, hyperhdr::PerformanceReportType::NETWORK_IO, slot->index);
+	}
+
+	Info(_log, "Network I/O threads are stopped");
+}
+
+int NetIoPool::threadCount() const
+{
+	return static_cast<int>(_slots.size());
+}
+
+void NetIoPool::adopt(QTcpSocket* socket, std::function<void()> setup)
+{
+	auto slot = *std::min_element(_slots.begin(), _slots.end(), [](const auto& a, const auto& b) {
+		return a->connections.load() < b->connections.load();
+	});
+
+	slot->connections++;
+	QObject::connect(socket, &QObject::destroyed, [slot]() { slot->connections--; });
+
+	socket->setParent(nullptr);
+	socket->moveToThread(slot->thread);
+
+	QMetaObject::invokeMethod(slot->context, std::move(setup), Qt::QueuedConnection);
+}
+
+void NetIoPool::synchronize()
+{
+	for (auto& slot : _slots)
+		if (slot->thread != QThread::currentThread() && slot->thread->isRunning())
+			QMetaObject::invokeMethod(slot->context, []() {}, Qt::BlockingQueuedConnection);
+}
+
+void NetIoPool::execute(QObject* target, const std::function<void()>& function)
+{
+	if (target->thread() == QThread::currentThread() || !target->thread()->isRunning())
+		function();
+	else
+		QMetaObject::invokeMethod(target, [&function]() { function(); }, Qt::BlockingQueuedConnection);
+}
+
+void NetIoPool::report(Slot* slot)
+{
+	const int64_t now = InternalClock::now();
+	const int64_t token = PerformanceCounters::currentToken();
+
+	if (slot->token > 0 && slot->token != token)
+	{
+		const int64_t diff = now - slot->statBegin;
+
+		if (diff >= 59000 && diff <= 65000)
+			emit GlobalSignals::getInstance()->SignalPerformanceNewReport(
+				PerformanceReport(hyperhdr::PerformanceReportType::NETWORK_IO, token, QString("NetIoThread%1").arg(slot->index),
+					(slot->busyTime / 10.0) / diff, slot->connections.load(), slot->events, slot->busyMax / 1000, slot->index));
+	}
+
+	if (slot->token != token)
+	{
+		slot->token = token;
+		slot->statBegin = now;
+		slot->busyTime = 0;
+		slot->busyMax = 0;
+		slot->events = 0;
+	}
+}
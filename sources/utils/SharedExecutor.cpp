@@ -0,0 +1,266 @@
+/* SharedExecutor.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QTimer>
+
+	#include <algorithm>
+#endif
+
+#include <utils/SharedExecutor.h>
+#include <utils/InternalClock.h>
+#include <utils/GlobalSignals.h>
+#include <utils/Macros.h>
+#include <performance-counters/PerformanceCounters.h>
+
+namespace
+{
+	constexpr int PROBE_INTERVAL = 250;
+};
+
+std::atomic<bool> SharedExecutor::_enabled{ false };
+std::mutex SharedExecutor::_instanceMutex;
+std::weak_ptr<SharedExecutor> SharedExecutor::_instance;
+
+void SharedExecutor::setEnabled(bool enabled)
+{
+	_enabled = enabled;
+}
+
+bool SharedExecutor::isEnabled()
+{
+	return _enabled;
+}
+
+std::shared_ptr<SharedExecutor> SharedExecutor::getInstance()
+{
+	std::lock_guard<std::mutex> lockGuard(_instanceMutex);
+
+	auto executor = _instance.lock();
+	if (executor == nullptr)
+	{
+		executor = std::shared_ptr<SharedExecutor>(new SharedExecutor());
+		_instance = executor;
+	}
+
+	return executor;
+}
+
+SharedExecutor::SharedExecutor() :
+	_log("EXECUTOR"),
+	_nextStrandId(0)
+{
+	const int threads = std::clamp(QThread::idealThreadCount(), 2, MAX_THREADS);
+
+	for (int i = 0; i < threads; i++)
+	{
+		auto worker = std::make_shared<Worker>();
+
+		worker->index = i;
+		worker->thread = new QThread();
+		worker->thread->setObjectName(QString("ExecutorThread%1").arg(i));
+		worker->context = new QObject();
+		worker->context->moveToThread(worker->thread);
+		worker->thread->start();
+
+		_workers.push_back(worker);
+	}
+
+	// the probes are posted from the first pool thread, the delay is measured in the thread serving the strand
+	QObject* monitor = _workers.front()->context;
+	QMetaObject::invokeMethod(monitor, [this, monitor]() {
+		QTimer* timer = new QTimer(monitor);
+		timer->setInterval(PROBE_INTERVAL);
+		QObject::connect(timer, &QTimer::timeout, monitor, [this]() { probe(); });
+		timer->start();
+	}, Qt::BlockingQueuedConnection);
+
+	Info(_log, "Started {:d} shared executor thread(s)", threads);
+}
+
+SharedExecutor::~SharedExecutor()
+{
+	{
+		std::lock_guard<std::mutex> lockGuard(_strandsMutex);
+
+		for (auto& strand : _strands)
+			emit GlobalSignals::getInstance()->SignalPerformanceStateChanged(false, hyperhdr::PerformanceReportType::EXECUTOR, strand->id);
+		_strands.clear();
+	}
+
+	for (auto& worker : _workers)
+		hyperhdr::THREAD_REMOVER(QString("SharedExecutor thread %1").arg(worker->index), worker->thread, worker->context);
+
+	Info(_log, "Shared executor threads are stopped");
+}
+
+int SharedExecutor::threadCount() const
+{
+	return static_cast<int>(_workers.size());
+}
+
+std::shared_ptr<SharedExecutor::Worker> SharedExecutor::selectWorker() const
+{
+	// the strands can not migrate once they have live timers and sockets, so the balancing happens at placement:
+	// the thread with the fewest strands wins, the measured scheduling delay breaks the ties
+	return *std::min_element(_workers.begin(), _workers.end(), [](const auto& a, const auto& b) {
+		const int strandsA = a->strands.load(), strandsB = b->strands.load();
+		return (strandsA != strandsB) ? strandsA < strandsB : a->delay.load() < b->delay.load();
+	});
+}
+
+void SharedExecutor::run(const QString& strandName, const std::function<QObject*()>& setup)
+{
+	auto worker = selectWorker();
+	QObject* object = nullptr;
+
+	worker->strands++;
+
+	if (worker->thread == QThread::currentThread())
+		object = setup();
+	else
+		QMetaObject::invokeMethod(worker->context, [&object, &setup]() { object = setup(); }, Qt::BlockingQueuedConnection);
+
+	if (object != nullptr)
+		addStrand(object, strandName, worker);
+	else
+		worker->strands--;
+}
+
+void SharedExecutor::attach(QObject* object, const QString& strandName)
+{
+	auto worker = selectWorker();
+
+	worker->strands++;
+	object->moveToThread(worker->thread);
+	addStrand(object, strandName, worker);
+}
+
+void SharedExecutor::addStrand(QObject* object, const QString& strandName, const std::shared_ptr<Worker>& worker)
+{
+	auto strand = std::make_shared<Strand>();
+	Worker* rawWorker = worker.get();
+
+	strand->name = strandName;
+	strand->object = object;
+	strand->worker = rawWorker;
+
+	{
+		std::lock_guard<std::mutex> lockGuard(_strandsMutex);
+		strand->id = _nextStrandId++;
+		_strands.push_back(strand);
+	}
+
+	QObject::connect(object, &QObject::destroyed, [this, rawWorker, id = strand->id]() {
+		rawWorker->strands--;
+
+		std::lock_guard<std::mutex> lockGuard(_strandsMutex);
+		_strands.erase(std::remove_if(_strands.begin(), _strands.end(), [id](const auto& s) { return s->id == id; }), _strands.end());
+		emit GlobalSignals::getInstance()->SignalPerformanceStateChanged(false, hyperhdr::PerformanceReportType::EXECUTOR, id);
+	});
+
+	Info(_log, "{:s} runs as strand {:d} on {:s}", (strandName), strand->id, (rawWorker->thread->objectName()));
+}
+
+void SharedExecutor::release(QObject* object)
+{
+	if (object == nullptr)
+		return;
+
+	QThread* thread = object->thread();
+	auto worker = std::find_if(_workers.begin(), _workers.end(), [thread](const auto& w) { return w->thread == thread; });
+
+	if (thread == QThread::currentThread() || worker == _workers.end() || !thread->isRunning())
+	{
+		delete object;
+		return;
+	}
+
+	// posted to the same event queue as the strand calls, so everything queued before is still delivered
+	QMetaObject::invokeMethod((*worker)->context, [object]() { delete object; }, Qt::BlockingQueuedConnection);
+}
+
+void SharedExecutor::probe()
+{
+	std::vector<std::shared_ptr<Strand>> strands;
+
+	{
+		std::lock_guard<std::mutex> lockGuard(_strandsMutex);
+		strands = _strands;
+	}
+
+	for (auto& strand : strands)
+	{
+		QObject* object = strand->object.data();
+
+		// a probe that is still waiting already tells that the strand is late, do not stack them
+		if (object == nullptr || strand->probePending.exchange(true))
+			continue;
+
+		const int64_t posted = InternalClock::nowMicro();
+
+		QMetaObject::invokeMethod(object, [strand, posted]() {
+			const int64_t delay = InternalClock::nowMicro() - posted;
+			Worker* worker = strand->worker;
+
+			strand->delaySum += delay;
+			strand->delayMax = std::max(strand->delayMax, delay);
+			strand->samples++;
+			strand->probePending = false;
+
+			// moving average used for the placement of the new strands
+			worker->delay = (worker->delay.load() * 7 + delay) / 8;
+
+			report(strand.get());
+		}, Qt::QueuedConnection);
+	}
+}
+
+void SharedExecutor::report(Strand* strand)
+{
+	const int64_t now = InternalClock::now();
+	const int64_t token = PerformanceCounters::currentToken();
+
+	if (strand->token > 0 && strand->token != token)
+	{
+		const int64_t diff = now - strand->statBegin;
+
+		if (diff >= 59000 && diff <= 65000 && strand->samples > 0)
+			emit GlobalSignals::getInstance()->SignalPerformanceNewReport(
+				PerformanceReport(hyperhdr::PerformanceReportType::EXECUTOR, token, strand->name,
+					(strand->delaySum / 1000.0) / strand->samples, strand->delayMax, strand->samples, strand->worker->index, strand->id));
+	}
+
+	if (strand->token != token)
+	{
+		strand->token = token;
+		strand->statBegin = now;
+		strand->delaySum = 0;
+		strand->delayMax = 0;
+		strand->samples = 0;
+	}
+}
@@ -31,7 +31,6 @@
 #include <QFileInfo>
 #include <QHash>
 #include <QList>
-#include <QMimeDatabase>
 #include <QPair>
 #include <QResource>
 #include <QSslCertificate>
@@ -53,6 +52,7 @@
 #include <webserver/FileServer.h>
 #include "HyperhdrConfig.h"
 
+std::mutex      FileServer::_staticMutex;
 QString         FileServer::_baseUrl;
 QString         FileServer::_ssdpXmlDesc;
 
@@ -85,20 +85,18 @@ FileServer::FileServer():
 	}
 #endif
 
-	_mimeDb["js"] = "application/javascript";
-	_mimeDb["html"] = "text/html";
-	_mimeDb["json"] = "application/json";
-	_mimeDb["css"] = "text/css";
-	_mimeDb["png"] = "image/png";
-	_mimeDb["woff"] = "font/woff";
-	_mimeDb["svg"] = "image/svg+xml";
-	_mimeDb["jpg"] = "image/jpeg";
-	_mimeDb["jpeg"] = "image/jpeg";
-	_mimeDb["woff2"] = "font/woff2";	
+	std::unique_lock<std::mutex> lock(_staticMutex);
+	QString baseUrl = _baseUrl;
+	lock.unlock();
+
+	_cache.buildInBackground(baseUrl);
 }
 
 FileServer::~FileServer()
 {
+	// the cache may point directly to the resource data
+	_cache.clear();
+
 	#if !defined(USE_EMBEDDED_WEB_RESOURCES)
 	if (!_resourcePath.isEmpty())
 	{
@@ -110,11 +108,13 @@ FileServer::~FileServer()
 
 void FileServer::setBaseUrl(const QString& url)
 {
+	std::lock_guard<std::mutex> lock(_staticMutex);
 	_baseUrl = url;
 }
 
 void FileServer::setSsdpXmlDesc(const QString& desc)
 {
+	std::lock_guard<std::mutex> lock(_staticMutex);
 	if (desc.isEmpty())
 	{
 		_ssdpXmlDesc.clear();
@@ -132,18 +132,14 @@ void FileServer::printErrorToReply(QtHttpReply* reply, QtHttpReply::StatusCode c
 	reply->appendRawData(QString(QString::number(code) + " - " + errorMessage).toLocal8Bit());	
 }
 
-QString FileServer::getMimeName(QString filename)
-{
-	QString extension = QFileInfo(filename).suffix();
-
-	if (extension.isEmpty() || !_mimeDb.contains(extension))
-		return QMimeDatabase().mimeTypeForFile(filename).name();
-		
-	return _mimeDb[extension];
-}
-
 void FileServer::onRequestNeedsReply(QtHttpRequest* request, QtHttpReply* reply)
 {
+	// the requests come from all network I/O threads
+	std::unique_lock<std::mutex> lock(_staticMutex);
+	const QString baseUrl = _baseUrl;
+	const QString ssdpXmlDesc = _ssdpXmlDesc;
+	lock.unlock();
+
 	QString command = request->getCommand();
 	if (command == QStringLiteral("GET"))
 	{
@@ -158,15 +154,15 @@ void FileServer::onRequestNeedsReply(QtHttpRequest* request, QtHttpReply* reply)
 				reply->appendRawData("alive");
 				return;
 			}
-			else if (uri_parts.at(0) == "description.xml" && !_ssdpXmlDesc.isEmpty())
+			else if (uri_parts.at(0) == "description.xml" && !ssdpXmlDesc.isEmpty())
 			{
 				reply->addHeader("Content-Type", "text/xml");
-				reply->appendRawData(_ssdpXmlDesc.toLocal8Bit());
+				reply->appendRawData(ssdpXmlDesc.toLocal8Bit());
 				return;
 			}
 		}
 
-		QFileInfo info(_baseUrl % "/" % path);
+		QFileInfo info(baseUrl % "/" % path);
 		if (path == "/" || path.isEmpty())
 		{
 			path = "index.html";
@@ -181,21 +177,33 @@ void FileServer::onRequestNeedsReply(QtHttpRequest* request, QtHttpReply* reply)
 		}
 
 		// get static files
-		QFile file(_baseUrl % "/" % path);
-		if (file.exists())
+		QString fileName = baseUrl % "/" % path;
+		auto file = _cache.get(fileName);
+		if (file != nullptr)
 		{
-			QString mimeName = getMimeName(file.fileName());
-			if (file.open(QFile::ReadOnly)) {
-				QByteArray data = file.readAll();
-				reply->addHeader("Content-Type", mimeName.toLocal8Bit());
-				reply->addHeader(QtHttpHeader::AccessControlAllow, "*");
-				reply->appendRawData(data);
-				file.close();
-			}
-			else
+			auto encoding = StaticFileCache::selectEncoding(request->getHeader(QtHttpHeader::AcceptEncoding), *file);
+
+			reply->addHeader("Content-Type", file->mimeName);
+			reply->addHeader(QtHttpHeader::AccessControlAllow, "*");
+			reply->addHeader(QtHttpHeader::CacheControl, "no-cache");
+			reply->addHeader(QtHttpHeader::ETag, file->etag(encoding));
+			reply->addHeader(QtHttpHeader::LastModified, file->lastModified);
+			if (file->isCompressed())
+				reply->addHeader(QtHttpHeader::Vary, QtHttpHeader::AcceptEncoding);
+
+			if (StaticFileCache::isNotModified(request->getHeader(QtHttpHeader::IfNoneMatch), request->getHeader(QtHttpHeader::IfModifiedSince), *file))
 			{
-				printErrorToReply(reply, QtHttpReply::Forbidden, "Requested file: " % path);
+				reply->setStatusCode(QtHttpReply::NotModified);
+				return;
 			}
+
+			if (encoding != StaticFileCache::Encoding::Identity)
+				reply->addHeader(QtHttpHeader::ContentEncoding, StaticFileCache::encodingName(encoding));
+			reply->appendRawData(file->body(encoding));
+		}
+		else if (QFile::exists(fileName))
+		{
+			printErrorToReply(reply, QtHttpReply::Forbidden, "Requested file: " % path);
 		}
 		else
 		{
@@ -17,6 +17,7 @@
 #include <webserver/QtHttpHeader.h>
 #include <webserver/WebSocketClient.h>
 #include <webserver/WebJsonRpc.h>
+#include <utils/NetIoPool.h>
 
 #define REQ "request="
 #define RPC "json-rpc"
@@ -24,13 +25,13 @@
 const QByteArray& QtHttpClientWrapper::CRLF = QByteArrayLiteral("\r\n");
 
 QtHttpClientWrapper::QtHttpClientWrapper(
-	QTcpSocket* sock, const bool& localConnection, QtHttpServer* parent)
-	: QObject(parent)
+	QTcpSocket* sock, const bool& localConnection, QtHttpServer* server)
+	: QObject(nullptr)
 	, m_guid("")
 	, m_parsingStatus(AwaitingRequest)
 	, m_sockClient(sock)
 	, m_currentRequest(Q_NULLPTR)
-	, m_serverHandle(parent)
+	, m_serverHandle(server)
 	, m_localConnection(localConnection)
 	, m_websocketClient(nullptr)
 	, m_webJsonRpc(nullptr)
@@ -78,6 +79,8 @@ void QtHttpClientWrapper::onReplySendDataRequested()
 
 void QtHttpClientWrapper::onClientDataReceived()
 {
+	NetIoPool::BusyScope busyScope;
+
 	if (m_sockClient != Q_NULLPTR)
 	{
 		while (m_sockClient->bytesAvailable())
@@ -317,7 +320,7 @@ void QtHttpClientWrapper::onReplySendHeadersRequested()
 			static const QByteArray& CHUNKED = QByteArrayLiteral("chunked");
 			reply->addHeader(QtHttpHeader::TransferEncoding, CHUNKED);
 		}
-		else
+		else if (reply->getStatusCode() != QtHttpReply::NotModified)
 		{
 			reply->addHeader(QtHttpHeader::ContentLength, QByteArray::number(reply->getRawDataSize()));
 		}
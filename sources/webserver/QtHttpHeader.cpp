@@ -30,6 +30,10 @@ const QByteArray & QtHttpHeader::SetCookie            = QByteArrayLiteral ("Set-
 const QByteArray & QtHttpHeader::TransferEncoding     = QByteArrayLiteral ("Transfer-Encoding");
 const QByteArray & QtHttpHeader::ContentDisposition   = QByteArrayLiteral ("Content-Disposition");
 const QByteArray & QtHttpHeader::AccessControlAllow   = QByteArrayLiteral ("Access-Control-Allow-Origin");
+const QByteArray & QtHttpHeader::ETag                 = QByteArrayLiteral ("ETag");
+const QByteArray & QtHttpHeader::IfNoneMatch          = QByteArrayLiteral ("If-None-Match");
+const QByteArray & QtHttpHeader::IfModifiedSince      = QByteArrayLiteral ("If-Modified-Since");
+const QByteArray & QtHttpHeader::Vary                 = QByteArrayLiteral ("Vary");
 const QByteArray & QtHttpHeader::Upgrade              = QByteArrayLiteral ("Upgrade");
 const QByteArray & QtHttpHeader::SecWebSocketKey      = QByteArrayLiteral ("Sec-WebSocket-Key");
 const QByteArray & QtHttpHeader::SecWebSocketProtocol = QByteArrayLiteral ("Sec-WebSocket-Protocol");
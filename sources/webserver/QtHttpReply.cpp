@@ -11,7 +11,7 @@
 
 
 QtHttpReply::QtHttpReply(QtHttpServer* parent)
-	: QObject(parent)
+	: QObject()
 	, m_useChunked(false)
 	, m_statusCode(Ok)
 	, m_data(QByteArray())
@@ -37,6 +37,7 @@ const QByteArray QtHttpReply::getStatusTextForCode(QtHttpReply::StatusCode statu
 	switch (statusCode)
 	{
 	case Ok:         return QByteArrayLiteral("OK");
+	case NotModified: return QByteArrayLiteral("Not Modified");
 	case BadRequest: return QByteArrayLiteral("Bad Request");
 	case Forbidden:  return QByteArrayLiteral("Forbidden");
 	case NotFound:   return QByteArrayLiteral("Not Found");
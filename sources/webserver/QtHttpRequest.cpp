@@ -9,7 +9,7 @@
 #include <webserver/QtHttpServer.h>
 
 QtHttpRequest::QtHttpRequest(QtHttpClientWrapper* client, QtHttpServer* parent)
-	: QObject(parent)
+	: QObject(client)
 	, m_url(QUrl())
 	, m_command(QString())
 	, m_data(QByteArray())
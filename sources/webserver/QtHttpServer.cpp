@@ -6,6 +6,7 @@
 #include <QUrlQuery>
 
 #include <utils/NetOrigin.h>
+#include <utils/NetIoPool.h>
 
 #include <webserver/QtHttpServer.h>
 #include <webserver/QtHttpRequest.h>
@@ -40,11 +41,30 @@ QtHttpServer::QtHttpServer(std::shared_ptr<NetOrigin> netOrigin, QObject* parent
 	, m_useSsl(false)
 	, m_serverName(QStringLiteral("The Qt5 HTTP Server"))
 	, m_netOrigin(netOrigin)
+	, m_ioPool(NetIoPool::getInstance())
 {
 	m_sockServer = new QtHttpServerWrapper(this);
 	connect(m_sockServer, &QtHttpServerWrapper::newConnection, this, &QtHttpServer::onClientConnected);
 }
 
+QtHttpServer::~QtHttpServer()
+{
+	m_sockServer->close();
+
+	// the clients live in the I/O threads and refer to this server: remove them there before it's gone
+	m_ioPool->synchronize();
+
+	QMutexLocker locker(&m_clientsMutex);
+	const QList<QtHttpClientWrapper*> wrappers = m_socksClientsHash.values();
+	m_socksClientsHash.clear();
+	locker.unlock();
+
+	for (auto wrapper : wrappers)
+	{
+		NetIoPool::execute(wrapper, [wrapper]() { delete wrapper; });
+	}
+}
+
 void QtHttpServer::start(quint16 port)
 {
 	if (!m_sockServer->isListening())
@@ -61,11 +81,13 @@ void QtHttpServer::stop()
 	{
 		m_sockServer->close();
 		// disconnect clients
+		QMutexLocker locker(&m_clientsMutex);
 		const QList<QTcpSocket*> socks = m_socksClientsHash.keys();
 		for (auto sock : socks)
 		{
-			sock->close();
+			QMetaObject::invokeMethod(sock, [sock]() { sock->close(); }, Qt::QueuedConnection);
 		}
+		locker.unlock();
 
 		emit stopped();
 	}
@@ -79,27 +101,10 @@ void QtHttpServer::onClientConnected()
 		{
 			if (m_netOrigin->accessAllowed(sock->peerAddress(), sock->localAddress()))
 			{
-				connect(sock, &QTcpSocket::disconnected, this, &QtHttpServer::onClientDisconnected);
-
-				if (m_useSsl)
-				{
-					if (QSslSocket* ssl = qobject_cast<QSslSocket*> (sock))
-					{
-						connect(ssl, QOverload<const QList<QSslError>&>::of(&QSslSocket::sslErrors), this, &QtHttpServer::onClientSslErrors);
-						connect(ssl, &QSslSocket::encrypted, this, &QtHttpServer::onClientSslEncrypted);
-						connect(ssl, &QSslSocket::peerVerifyError, this, &QtHttpServer::onClientSslPeerVerifyError);
-						connect(ssl, &QSslSocket::modeChanged, this, &QtHttpServer::onClientSslModeChanged);
-						ssl->setLocalCertificateChain(m_sslCerts);
-						ssl->setPrivateKey(m_sslKey);
-						ssl->setPeerVerifyMode(QSslSocket::AutoVerifyPeer);
-						ssl->startServerEncryption();
-					}
-				}
-
-				QtHttpClientWrapper* wrapper = new QtHttpClientWrapper(
-					sock, m_netOrigin->isLocalAddress(sock->peerAddress(), sock->localAddress()), this);
-				m_socksClientsHash.insert(sock, wrapper);
-				emit clientConnected(wrapper->getGuid());
+				bool localConnection = m_netOrigin->isLocalAddress(sock->peerAddress(), sock->localAddress());
+				m_ioPool->adopt(sock, [this, sock, localConnection, certs = m_sslCerts, key = m_sslKey]() {
+					setupClient(sock, localConnection, certs, key);
+				});
 			}
 			else
 			{
@@ -109,17 +114,42 @@ void QtHttpServer::onClientConnected()
 	}
 }
 
-void QtHttpServer::onClientDisconnected()
+void QtHttpServer::setupClient(QTcpSocket* sock, bool localConnection, const QList<QSslCertificate>& certs, const QSslKey& key)
 {
-	if (QTcpSocket* sockClient = qobject_cast<QTcpSocket*> (sender()))
+	if (m_useSsl)
 	{
-		if (QtHttpClientWrapper* wrapper = m_socksClientsHash.value(sockClient, Q_NULLPTR))
+		if (QSslSocket* ssl = qobject_cast<QSslSocket*> (sock))
 		{
-			emit clientDisconnected(wrapper->getGuid());
-			wrapper->deleteLater();
-			m_socksClientsHash.remove(sockClient);
+			ssl->setLocalCertificateChain(certs);
+			ssl->setPrivateKey(key);
+			ssl->setPeerVerifyMode(QSslSocket::AutoVerifyPeer);
+			ssl->startServerEncryption();
 		}
 	}
+
+	// no parent: the wrapper lives in the I/O thread, it's released by onClientDisconnected or the server destructor
+	QtHttpClientWrapper* wrapper = new QtHttpClientWrapper(sock, localConnection, this);
+	sock->setParent(wrapper);
+	connect(sock, &QTcpSocket::disconnected, wrapper, [this, sock, wrapper]() { onClientDisconnected(sock, wrapper); });
+
+	QMutexLocker locker(&m_clientsMutex);
+	m_socksClientsHash.insert(sock, wrapper);
+	locker.unlock();
+
+	emit clientConnected(wrapper->getGuid());
+}
+
+void QtHttpServer::onClientDisconnected(QTcpSocket* sock, QtHttpClientWrapper* wrapper)
+{
+	QMutexLocker locker(&m_clientsMutex);
+	bool found = m_socksClientsHash.remove(sock) > 0;
+	locker.unlock();
+
+	if (found)
+	{
+		emit clientDisconnected(wrapper->getGuid());
+		wrapper->deleteLater();
+	}
 }
 
 void QtHttpServer::setUseSecure(const bool ssl)
@@ -173,22 +203,3 @@ QList<QSslCertificate> QtHttpServer::getCertificates()
 {
 	return m_sslCerts;
 };
-
-void QtHttpServer::onClientSslEncrypted()
-{
-};
-
-void QtHttpServer::onClientSslPeerVerifyError(const QSslError& err)
-{
-	Q_UNUSED(err)
-};
-
-void QtHttpServer::onClientSslErrors(const QList<QSslError>& errors)
-{
-	Q_UNUSED(errors)
-};
-
-void QtHttpServer::onClientSslModeChanged(QSslSocket::SslMode mode)
-{
-	Q_UNUSED(mode)
-};
@@ -0,0 +1,389 @@
+/* StaticFileCache.cpp
+*
+*  MIT License
+*
+*  Copyright (c) 2020-2026 awawa-dev
+*
+*  Project homesite: https://github.com/awawa-dev/HyperHDR
+*
+*  Permission is hereby granted, free of charge, to any person obtaining a copy
+*  of this software and associated documentation files (the "Software"), to deal
+*  in the Software without restriction, including without limitation the rights
+*  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*  copies of the Software, and to permit persons to whom the Software is
+*  furnished to do so, subject to the following conditions:
+*
+*  The above copyright notice and this permission notice shall be included in all
+*  copies or substantial portions of the Software.
+
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*  SOFTWARE.
+*/
+
+#ifndef PCH_ENABLED
+	#include <QDir>
+	#include <QFile>
+	#include <QFileInfo>
+	#include <array>
+#endif
+
+#include <QCryptographicHash>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QLocale>
+#include <QMimeDatabase>
+#include <QResource>
+
+#include <webserver/StaticFileCache.h>
+#include "HyperhdrConfig.h"
+
+#ifdef ENABLE_ZSTD
+	#include <utils-zstd/utils-zstd.h>
+#endif
+
+#define CACHE_MAX_FILE_SIZE (16 * 1024 * 1024)
+#define CACHE_MIN_COMPRESS_SIZE 256
+#define CACHE_ZSTD_LEVEL 9
+
+namespace
+{
+	uint32_t crc32(const QByteArray& data)
+	{
+		static const std::array<uint32_t, 256> table = []() {
+			std::array<uint32_t, 256> result{};
+			for (uint32_t i = 0; i < 256; i++)
+			{
+				uint32_t c = i;
+				for (int k = 0; k < 8; k++)
+					c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+				result[i] = c;
+			}
+			return result;
+		}();
+
+		uint32_t crc = 0xFFFFFFFFu;
+		for (const char c : data)
+			crc = table[(crc ^ static_cast<uint8_t>(c)) & 0xFF] ^ (crc >> 8);
+		return crc ^ 0xFFFFFFFFu;
+	}
+
+	void appendLE32(QByteArray& data, uint32_t value)
+	{
+		for (int i = 0; i < 4; i++)
+			data.append(static_cast<char>((value >> (8 * i)) & 0xFF));
+	}
+
+	QByteArray gzipCompress(const QByteArray& data)
+	{
+		// qCompress returns a 4-byte length followed by a zlib stream (2-byte header, raw deflate, adler32):
+		// the raw deflate part is wrapped with the gzip header and trailer instead
+		const QByteArray zlib = qCompress(data, 9);
+		if (zlib.size() <= 4 + 2 + 4)
+			return QByteArray();
+
+		QByteArray result;
+		result.reserve(zlib.size() + 8);
+		result.append("\x1f\x8b\x08\x00\x00\x00\x00\x00\x02\xff", 10);
+		result.append(zlib.constData() + 6, zlib.size() - 6 - 4);
+		appendLE32(result, crc32(data));
+		appendLE32(result, static_cast<uint32_t>(data.size()));
+		return result;
+	}
+
+	bool isCompressible(const QByteArray& mimeName)
+	{
+		return mimeName.startsWith("text/") || mimeName.contains("javascript") || mimeName.contains("json") || mimeName.contains("xml");
+	}
+
+	QByteArray toHttpDate(const QDateTime& time)
+	{
+		return QLocale::c().toString(time.toUTC(), QStringLiteral("ddd, dd MMM yyyy hh:mm:ss 'GMT'")).toLatin1();
+	}
+}
+
+const QByteArray& StaticFileCache::Entry::body(Encoding encoding) const
+{
+	if (encoding == Encoding::Zstd)
+		return zstd;
+	else if (encoding == Encoding::Gzip)
+		return gzip;
+	else
+		return identity;
+}
+
+QByteArray StaticFileCache::Entry::etag(Encoding encoding) const
+{
+	// strong validators must differ between the encodings of the same file
+	if (encoding == Encoding::Zstd)
+		return '"' + hash + "-zst\"";
+	else if (encoding == Encoding::Gzip)
+		return '"' + hash + "-gz\"";
+	else
+		return '"' + hash + '"';
+}
+
+bool StaticFileCache::Entry::isCompressed() const
+{
+	return !gzip.isEmpty() || !zstd.isEmpty();
+}
+
+StaticFileCache::StaticFileCache() :
+	_log("WEBSERVER"),
+	_building(false),
+	_cancelled(false)
+{
+	_mimeDb["js"] = "application/javascript";
+	_mimeDb["html"] = "text/html";
+	_mimeDb["json"] = "application/json";
+	_mimeDb["css"] = "text/css";
+	_mimeDb["png"] = "image/png";
+	_mimeDb["woff"] = "font/woff";
+	_mimeDb["svg"] = "image/svg+xml";
+	_mimeDb["jpg"] = "image/jpeg";
+	_mimeDb["jpeg"] = "image/jpeg";
+	_mimeDb["woff2"] = "font/woff2";
+}
+
+StaticFileCache::~StaticFileCache()
+{
+	clear();
+}
+
+void StaticFileCache::clear()
+{
+	_cancelled = true;
+	if (_builder.joinable())
+		_builder.join();
+	_building = false;
+	_cancelled = false;
+
+	std::lock_guard<std::mutex> locker(_locker);
+	_entries.clear();
+}
+
+bool StaticFileCache::isImmutable(const QString& fileName)
+{
+	return fileName.startsWith(QStringLiteral(":/"));
+}
+
+void StaticFileCache::buildInBackground(const QString& root)
+{
+	if (!isImmutable(root) || _builder.joinable())
+		return;
+
+	_building = true;
+	_builder = std::thread([this, root = QDir::cleanPath(root)]() {
+		QElapsedTimer timer;
+		qint64 identitySize = 0, gzipSize = 0, zstdSize = 0;
+		int files = 0;
+
+		timer.start();
+
+		for (QDirIterator it(root, QDir::Files, QDirIterator::Subdirectories); it.hasNext() && !_cancelled; )
+		{
+			const QString fileName = it.next();
+			auto entry = load(fileName, true);
+
+			if (entry == nullptr || entry->fileSize > CACHE_MAX_FILE_SIZE)
+				continue;
+
+			identitySize += entry->identity.size();
+			gzipSize += entry->gzip.size();
+			zstdSize += entry->zstd.size();
+			files++;
+
+			std::lock_guard<std::mutex> locker(_locker);
+			_entries[fileName] = std::move(entry);
+		}
+
+		_building = false;
+
+		if (!_cancelled)
+			Info(_log, "Web resources cache is ready: {:d} files, {:d} KB (gzip: {:d} KB, zstd: {:d} KB) in {:d} ms",
+				files, identitySize / 1024, gzipSize / 1024, zstdSize / 1024, timer.elapsed());
+	});
+}
+
+std::shared_ptr<const StaticFileCache::Entry> StaticFileCache::get(const QString& requestedFile)
+{
+	// the same key as the paths of the background build
+	const QString fileName = QDir::cleanPath(requestedFile);
+	const bool immutable = isImmutable(fileName);
+	QFileInfo info;
+
+	{
+		std::lock_guard<std::mutex> locker(_locker);
+		auto found = _entries.find(fileName);
+
+		if (found != _entries.end())
+		{
+			if (immutable)
+				return found.value();
+
+			info = QFileInfo(fileName);
+			if (info.exists() && info.lastModified() == found.value()->modified && info.size() == found.value()->fileSize)
+				return found.value();
+		}
+	}
+
+	// the background build will provide the compressed forms of the embedded resources soon
+	auto entry = load(fileName, !(immutable && _building));
+	if (entry == nullptr || entry->fileSize > CACHE_MAX_FILE_SIZE)
+		return entry;
+
+	std::lock_guard<std::mutex> locker(_locker);
+	auto found = _entries.find(fileName);
+	if (immutable && found != _entries.end())
+		return found.value();
+
+	_entries[fileName] = entry;
+	return entry;
+}
+
+std::shared_ptr<StaticFileCache::Entry> StaticFileCache::load(const QString& fileName, bool compressIt) const
+{
+	QFileInfo info(fileName);
+
+	if (!info.exists() || !info.isFile())
+		return nullptr;
+
+	auto entry = std::make_shared<Entry>();
+
+	QResource resource(fileName);
+	if (isImmutable(fileName) && resource.isValid() && resource.compressionAlgorithm() == QResource::NoCompression)
+	{
+		// uncompressed resources are already in memory
+		entry->identity = QByteArray::fromRawData(reinterpret_cast<const char*>(resource.data()), resource.size());
+	}
+	else
+	{
+		QFile file(fileName);
+		if (!file.open(QFile::ReadOnly))
+			return nullptr;
+		entry->identity = file.readAll();
+	}
+
+	entry->mimeName = getMimeName(fileName);
+	entry->modified = info.lastModified();
+	entry->fileSize = info.size();
+	entry->lastModified = toHttpDate(entry->modified.isValid() ? entry->modified : QDateTime::currentDateTimeUtc());
+	entry->hash = QCryptographicHash::hash(entry->identity, QCryptographicHash::Sha1).toHex().left(20);
+
+	if (compressIt)
+		compress(*entry);
+
+	return entry;
+}
+
+void StaticFileCache::compress(Entry& entry) const
+{
+	if (entry.identity.size() < CACHE_MIN_COMPRESS_SIZE || entry.fileSize > CACHE_MAX_FILE_SIZE || !isCompressible(entry.mimeName))
+		return;
+
+	// keep a compressed form only if it really saves something
+	const qsizetype limit = entry.identity.size() - entry.identity.size() / 10;
+
+	QByteArray gzip = gzipCompress(entry.identity);
+	if (!gzip.isEmpty() && gzip.size() < limit)
+		entry.gzip = gzip;
+
+	#ifdef ENABLE_ZSTD
+		QByteArray zstd(static_cast<qsizetype>(CompressBoundZSTD(entry.identity.size())), Qt::Uninitialized);
+		size_t zstdSize = CompressZSTD(reinterpret_cast<const uint8_t*>(entry.identity.constData()), entry.identity.size(),
+										reinterpret_cast<uint8_t*>(zstd.data()), zstd.size(), CACHE_ZSTD_LEVEL);
+		if (zstdSize > 0 && static_cast<qsizetype>(zstdSize) < limit)
+		{
+			zstd.resize(static_cast<qsizetype>(zstdSize));
+			zstd.squeeze();
+			entry.zstd = zstd;
+		}
+	#endif
+}
+
+QByteArray StaticFileCache::getMimeName(const QString& fileName) const
+{
+	QString extension = QFileInfo(fileName).suffix();
+
+	if (extension.isEmpty() || !_mimeDb.contains(extension))
+		return QMimeDatabase().mimeTypeForFile(fileName).name().toLocal8Bit();
+
+	return _mimeDb[extension];
+}
+
+StaticFileCache::Encoding StaticFileCache::selectEncoding(const QByteArray& acceptEncoding, const Entry& entry)
+{
+	bool gzip = false, zstd = false;
+
+	for (const QByteArray& item : acceptEncoding.split(','))
+	{
+		QList<QByteArray> parts = item.split(';');
+		const QByteArray coding = parts.first().trimmed().toLower();
+		bool allowed = true;
+
+		for (int i = 1; i < parts.size(); i++)
+		{
+			const QByteArray param = parts[i].trimmed();
+			if (param.startsWith("q="))
+				allowed = param.mid(2).toDouble() > 0.0;
+		}
+
+		if (coding == "gzip")
+			gzip = allowed;
+		else if (coding == "zstd")
+			zstd = allowed;
+	}
+
+	if (zstd && !entry.zstd.isEmpty())
+		return Encoding::Zstd;
+	else if (gzip && !entry.gzip.isEmpty())
+		return Encoding::Gzip;
+	else
+		return Encoding::Identity;
+}
+
+bool StaticFileCache::isNotModified(const QByteArray& ifNoneMatch, const QByteArray& ifModifiedSince, const Entry& entry)
+{
+	// If-None-Match takes precedence: any encoding of the same content is still valid for the client
+	if (!ifNoneMatch.isEmpty())
+	{
+		for (const QByteArray& item : ifNoneMatch.split(','))
+		{
+			QByteArray tag = item.trimmed();
+
+			if (tag == "*")
+				return true;
+
+			if (tag.startsWith("W/"))
+				tag = tag.mid(2);
+
+			if (tag.size() >= 2 && tag.startsWith('"') && tag.endsWith('"'))
+				tag = tag.mid(1, tag.size() - 2);
+
+			const int suffix = tag.indexOf('-');
+			if (suffix >= 0)
+				tag.truncate(suffix);
+
+			if (tag == entry.hash)
+				return true;
+		}
+
+		return false;
+	}
+
+	return !ifModifiedSince.isEmpty() && ifModifiedSince.trimmed() == entry.lastModified;
+}
+
+const char* StaticFileCache::encodingName(Encoding encoding)
+{
+	if (encoding == Encoding::Zstd)
+		return "zstd";
+	else if (encoding == Encoding::Gzip)
+		return "gzip";
+	else
+		return "identity";
+}
@@ -77,8 +77,8 @@ void WebServer::initServer()
 	connect(_server, &QtHttpServer::stopped, this, &WebServer::onServerStopped);
 	connect(_server, &QtHttpServer::error, this, &WebServer::onServerError);
 
-	// create StaticFileServing
-	connect(_server, &QtHttpServer::requestNeedsReply, this, &WebServer::onInitRequestNeedsReply);
+	// the requests are handled directly in the network I/O threads
+	connect(_server, &QtHttpServer::requestNeedsReply, this, &WebServer::onInitRequestNeedsReply, Qt::DirectConnection);
 
 	// init
 	handleSettingsUpdate(settings::type::WEBSERVER, _config);
@@ -86,16 +86,6 @@ void WebServer::initServer()
 
 void WebServer::onInitRequestNeedsReply(QtHttpRequest* request, QtHttpReply* reply)
 {
-	if (_staticFileServing == nullptr)
-	{
-		_staticFileServing = globalStaticFileServing.lock();
-		if (_staticFileServing == nullptr)
-		{
-			_staticFileServing = std::make_shared<FileServer>();
-			globalStaticFileServing = _staticFileServing;
-		}
-	}
-
 	_staticFileServing->onRequestNeedsReply(request, reply);
 }
 
@@ -148,6 +138,17 @@ void WebServer::handleSettingsUpdate(settings::type type, QJsonDocument config)
 		Info(_log, "Set document root to: {:s}", (_baseUrl));
 		FileServer::setBaseUrl(_baseUrl);
 
+		// create StaticFileServing before the server starts listening
+		if (_staticFileServing == nullptr)
+		{
+			_staticFileServing = globalStaticFileServing.lock();
+			if (_staticFileServing == nullptr)
+			{
+				_staticFileServing = std::make_shared<FileServer>();
+				globalStaticFileServing = _staticFileServing;
+			}
+		}
+
 		// ssl different port
 		quint16 newPort = _useSsl ? obj["sslPort"].toInt(WEBSERVER_DEFAULT_PORT) : obj["port"].toInt(WEBSERVER_DEFAULT_PORT);
 		if (_port != newPort)
@@ -11,6 +11,7 @@
 #include <api/HyperAPI.h>
 #include <utils/FrameDecoder.h>
 #include <utils-image/utils-image.h>
+#include <utils/NetIoPool.h>
 
 #include <webserver/WebSocketClient.h>
 #include <webserver/QtHttpRequest.h>
@@ -76,6 +77,8 @@ void WebSocketClient::handleBinaryMessage(QByteArray& data)
 
 void WebSocketClient::handleWebSocketFrame()
 {
+	NetIoPool::BusyScope busyScope;
+
 	while (_socket->bytesAvailable())
 	{
 		// we are on no continious reading from socket from call before
@@ -38,9 +38,7 @@ namespace FrameDecoder
 void AutomaticToneMapping::finilize(){};
 AutomaticToneMapping::AutomaticToneMapping() = default;
 AutomaticToneMapping* AutomaticToneMapping::prepare() { return nullptr; }
-void AutomaticToneMapping::scan_YUYV(int /*width*/, uint8_t* /*currentSourceY*/) {}
-void AutomaticToneMapping::scan_Y_UV_8(int /*width*/, uint8_t* /*currentSourceY*/, uint8_t* /*currentSourceUV*/) {}
-void AutomaticToneMapping::scan_Y_UV_16(int /*width*/, uint8_t* /*currentSourceY*/, uint8_t* /*currentSourceUV*/) {}
+void AutomaticToneMapping::scan(const FrameStatistics& /*statistics*/) {}
 
 
 #define INPUT_X 1920
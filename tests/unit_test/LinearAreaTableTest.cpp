@@ -0,0 +1,132 @@
+#include <QCoreApplication>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include <base/FrameAnalysisCache.h>
+#include <infinite-color-engine/InfiniteProcessing.h>
+
+using namespace hyperhdr;
+using linalg::aliases::byte3;
+
+namespace
+{
+	int failures = 0;
+
+	#define CHECK(condition) \
+		if (!(condition)) { std::cout << "  FAILED: " << #condition << " (line " << __LINE__ << ")" << std::endl; failures++; }
+
+	using Sum = linalg::vec<uint_fast64_t, 3>;
+
+	// the pixels visited like ImageColorAveraging does for the area of a LED
+	Sum bruteForce(const Image<ColorRgb>& image, unsigned x1, unsigned y1, unsigned x2, unsigned y2, unsigned step)
+	{
+		Sum result(0, 0, 0);
+		const uint8_t* imgData = image.rawMem();
+
+		for (unsigned y = y1; y < std::min(y2, image.height()); y += step)
+			for (unsigned x = x1; x < std::min(x2, image.width()); x += step)
+			{
+				const uint8_t* pixel = imgData + (static_cast<size_t>(y) * image.width() + x) * 3;
+				result += Sum(InfiniteProcessing::srgbNonlinearToLinear(byte3(pixel[0], pixel[1], pixel[2])));
+			}
+
+		return result;
+	}
+
+	Image<ColorRgb> randomImage(unsigned width, unsigned height, std::mt19937& generator)
+	{
+		std::uniform_int_distribution<int> distribution(0, 255);
+		Image<ColorRgb> image(width, height);
+		uint8_t* imgData = image.rawMem();
+
+		for (size_t i = 0; i < static_cast<size_t>(width) * height * 3; i++)
+			imgData[i] = static_cast<uint8_t>(distribution(generator));
+
+		return image;
+	}
+
+	void testRandomAreas()
+	{
+		std::cout << "Random areas, full and sparse" << std::endl;
+
+		std::mt19937 generator(2026);
+
+		for (auto [width, height] : { std::pair<unsigned, unsigned>{ 1, 1 }, { 1, 7 }, { 7, 1 }, { 2, 2 }, { 33, 17 }, { 160, 90 }, { 641, 359 } })
+		{
+			Image<ColorRgb> image = randomImage(width, height, generator);
+			LinearAreaTable table;
+			table.build(image);
+
+			CHECK(table.width() == width && table.height() == height);
+
+			std::uniform_int_distribution<unsigned> xs(0, width + 1), ys(0, height + 1);
+			for (int i = 0; i < 200; i++)
+			{
+				unsigned x1 = xs(generator), x2 = xs(generator), y1 = ys(generator), y2 = ys(generator);
+				if (x1 > x2)
+					std::swap(x1, x2);
+				if (y1 > y2)
+					std::swap(y1, y2);
+
+				for (unsigned step : { 1u, 2u })
+					CHECK(table.sum(x1, y1, x2, y2, step) == bruteForce(image, x1, y1, x2, y2, step));
+			}
+
+			for (unsigned step : { 1u, 2u })
+				CHECK(table.sum(0, 0, width, height, step) == bruteForce(image, 0, 0, width, height, step));
+		}
+	}
+
+	void testBandSplit()
+	{
+		std::cout << "Areas above 65537 pixels are split into exact bands" << std::endl;
+
+		// white pixels: every linear value is 65535, the 32-bit table wraps around many times
+		Image<ColorRgb> white(1920, 1080);
+		std::fill_n(white.rawMem(), white.size(), 255);
+
+		LinearAreaTable table;
+		table.build(white);
+
+		const uint_fast64_t maxValue = InfiniteProcessing::srgbNonlinearToLinear(byte3(255, 255, 255)).x;
+		CHECK(table.sum(0, 0, 1920, 1080).x == uint_fast64_t(1920) * 1080 * maxValue);
+		CHECK(table.sum(0, 0, 1920, 1080, 2).x == uint_fast64_t(960) * 540 * maxValue);
+		CHECK(table.sum(1, 1, 1920, 1080, 2).x == uint_fast64_t(960) * 540 * maxValue);
+		CHECK(table.sum(3, 5, 1918, 1001) == bruteForce(white, 3, 5, 1918, 1001, 1));
+
+		// a single column and a single row of the full frame, no band may be wider than the limit
+		CHECK(table.sum(7, 0, 8, 1080) == bruteForce(white, 7, 0, 8, 1080, 1));
+		CHECK(table.sum(0, 9, 1920, 10, 2) == bruteForce(white, 0, 9, 1920, 10, 2));
+
+		std::mt19937 generator(1080);
+		Image<ColorRgb> image = randomImage(1920, 1080, generator);
+		table.build(image);
+
+		std::uniform_int_distribution<unsigned> xs(0, 1920), ys(0, 1080);
+		for (int i = 0; i < 40; i++)
+		{
+			unsigned x1 = xs(generator), x2 = xs(generator), y1 = ys(generator), y2 = ys(generator);
+			if (x1 > x2)
+				std::swap(x1, x2);
+			if (y1 > y2)
+				std::swap(y1, y2);
+
+			for (unsigned step : { 1u, 2u })
+				CHECK(table.sum(x1, y1, x2, y2, step) == bruteForce(image, x1, y1, x2, y2, step));
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	testRandomAreas();
+	testBandSplit();
+
+	std::cout << ((failures == 0) ? "All tests passed" : "Some tests failed") << std::endl;
+
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+#include <QCoreApplication>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <linalg.h>
+#include <infinite-color-engine/ColorSpace.h>
+#include <led-drivers/PacketWriter.h>
+
+using linalg::aliases::float3;
+using linalg::aliases::byte3;
+
+namespace
+{
+	int failures = 0;
+
+	#define CHECK(condition) \
+		if (!(condition)) { std::cout << "  FAILED: " << #condition << " (line " << __LINE__ << ")" << std::endl; failures++; }
+
+	constexpr size_t DMX_MAX = 512;
+	constexpr size_t E131_HEADER_SIZE = 126;
+	constexpr size_t DDP_HEADER_SIZE = 10;
+	constexpr size_t DDP_MAX_RGB_PAYLOAD = 480 * 3;
+	constexpr size_t APA102_START_FRAME = 4;
+
+	using Packets = std::vector<std::vector<uint8_t>>;
+
+	// LedDevice::write before the packet writer: the anti-flickering filter keeps the previous color
+	// unless a channel moved by at least half of a step, then the colors are rounded to ColorRgb
+	struct AntiFlickering
+	{
+		bool enabled = false;
+		std::vector<float3> last;
+
+		std::vector<float3> apply(const std::vector<float3>& colors)
+		{
+			if (!enabled)
+				return colors;
+
+			if (colors.size() != last.size())
+			{
+				last = colors;
+				return colors;
+			}
+
+			for (size_t i = 0; i < colors.size(); ++i)
+				if (linalg::maxelem(linalg::abs(colors[i] - last[i]) * 255.0f) > 0.49f)
+					last[i] = colors[i];
+
+			return last;
+		}
+	};
+
+	std::vector<uint8_t> oldRgbStream(const std::vector<float3>& colors)
+	{
+		std::vector<uint8_t> stream;
+		for (const auto& color : colors)
+		{
+			auto b = ColorSpaceMath::round_to_0_255<byte3>(color * 255.0f);
+			stream.insert(stream.end(), { b.x, b.y, b.z });
+		}
+		return stream;
+	}
+
+	// the payloads of DriverNetUdpE131::writeFiniteColors: the RGB stream split into 512-channel universes
+	Packets oldE131(const std::vector<uint8_t>& stream)
+	{
+		Packets packets;
+		for (size_t rawIdx = 0; rawIdx < stream.size(); rawIdx++)
+		{
+			if (rawIdx % DMX_MAX == 0)
+				packets.emplace_back();
+			packets.back().push_back(stream[rawIdx]);
+		}
+		return packets;
+	}
+
+	// the payloads of DriverNetDDP::writeFiniteColors in the RGB mode: up to 480 LEDs per frame
+	Packets oldDdp(const std::vector<uint8_t>& stream)
+	{
+		Packets packets;
+		for (size_t start = 0; start < stream.size(); start += DDP_MAX_RGB_PAYLOAD)
+			packets.emplace_back(stream.begin() + start, stream.begin() + std::min(stream.size(), start + DDP_MAX_RGB_PAYLOAD));
+		return packets;
+	}
+
+	// the buffer of DriverSpiAPA102::writeFiniteColors: start frame, 0xFF + RGB per LED, end frame
+	std::vector<uint8_t> oldApa102(const std::vector<uint8_t>& stream)
+	{
+		const size_t ledCount = stream.size() / 3;
+		const size_t endFrameSize = std::max<size_t>((ledCount + 15) / 16, 4);
+		std::vector<uint8_t> buffer(ledCount * 4 + APA102_START_FRAME + endFrameSize, 0xFF);
+
+		std::fill_n(buffer.begin(), APA102_START_FRAME, 0x00);
+		for (size_t i = 0; i < ledCount; i++)
+			std::copy_n(stream.begin() + i * 3, 3, buffer.begin() + APA102_START_FRAME + i * 4 + 1);
+
+		return buffer;
+	}
+
+	Packets newPayloads(PacketWriter& writer)
+	{
+		Packets packets;
+		for (size_t index = 0; index < writer.segmentCount(); index++)
+		{
+			const uint8_t* payload = writer.segment(index) + writer.layout().headerSize;
+			packets.emplace_back(payload, payload + writer.segmentPayload(index));
+		}
+		return packets;
+	}
+
+	std::vector<float3> randomFrame(size_t ledCount, std::mt19937& generator)
+	{
+		std::uniform_real_distribution<float> distribution(-0.1f, 1.1f);
+		std::vector<float3> colors(ledCount);
+
+		for (auto& color : colors)
+			color = float3{ distribution(generator), distribution(generator), distribution(generator) };
+
+		// values that sit on and right next to the rounding threshold of every step
+		for (size_t i = 0; i < std::min<size_t>(ledCount, 256); i++)
+		{
+			const float half = (i + 0.5f) / 255.0f;
+			colors[i] = float3{ half, std::nextafter(half, 0.0f), std::nextafter(half, 1.0f) };
+		}
+
+		return colors;
+	}
+
+	// the next frame moves some LEDs by less than the anti-flickering threshold and the others by more
+	std::vector<float3> nextFrame(const std::vector<float3>& previous, std::mt19937& generator)
+	{
+		std::uniform_real_distribution<float> small(-0.4f / 255.0f, 0.4f / 255.0f);
+		std::uniform_real_distribution<float> large(-0.2f, 0.2f);
+		std::vector<float3> colors = previous;
+
+		for (size_t i = 0; i < colors.size(); i++)
+		{
+			auto& distribution = (i % 2 == 0) ? small : large;
+			colors[i] += float3{ distribution(generator), distribution(generator), distribution(generator) };
+		}
+
+		return colors;
+	}
+
+	template<typename Check>
+	void runSequence(size_t ledCount, bool antiFlickering, Check check)
+	{
+		std::mt19937 generator(static_cast<unsigned>(ledCount * 2 + antiFlickering));
+		AntiFlickering oldFilter{ antiFlickering }, newFilter{ antiFlickering };
+		std::vector<float3> frame = randomFrame(ledCount, generator);
+
+		for (int i = 0; i < 4; i++, frame = nextFrame(frame, generator))
+			check(oldRgbStream(oldFilter.apply(frame)), newFilter.apply(frame));
+	}
+
+	void testE131()
+	{
+		std::cout << "E1.31 universes" << std::endl;
+
+		for (size_t ledCount : { 1, 170, 171, 342, 500, 1024 })
+			for (bool antiFlickering : { false, true })
+			{
+				PacketWriter writer;
+				PacketWriter::Layout layout;
+				layout.headerSize = E131_HEADER_SIZE;
+				layout.payloadSize = DMX_MAX;
+				writer.setLayout(layout);
+
+				runSequence(ledCount, antiFlickering, [&](const std::vector<uint8_t>& stream, const std::vector<float3>& colors) {
+					writer.resize(colors.size());
+					writer.encode(colors);
+					CHECK(newPayloads(writer) == oldE131(stream));
+				});
+			}
+	}
+
+	void testDdp()
+	{
+		std::cout << "DDP frames" << std::endl;
+
+		for (size_t ledCount : { 1, 479, 480, 481, 1000 })
+			for (bool antiFlickering : { false, true })
+			{
+				PacketWriter writer;
+				PacketWriter::Layout layout;
+				layout.headerSize = DDP_HEADER_SIZE;
+				layout.payloadSize = DDP_MAX_RGB_PAYLOAD;
+				writer.setLayout(layout);
+
+				runSequence(ledCount, antiFlickering, [&](const std::vector<uint8_t>& stream, const std::vector<float3>& colors) {
+					writer.resize(colors.size());
+					writer.encode(colors);
+					CHECK(newPayloads(writer) == oldDdp(stream));
+				});
+			}
+	}
+
+	void testApa102()
+	{
+		std::cout << "APA102 buffer" << std::endl;
+
+		for (size_t ledCount : { 1, 16, 17, 100 })
+			for (bool antiFlickering : { false, true })
+			{
+				PacketWriter writer;
+				PacketWriter::Layout layout;
+				layout.headerSize = APA102_START_FRAME;
+				layout.stride = 4;
+				layout.colorOffset = 1;
+				layout.fill = 0xFF;
+				writer.setLayout(layout);
+
+				runSequence(ledCount, antiFlickering, [&](const std::vector<uint8_t>& stream, const std::vector<float3>& colors) {
+					// DriverSpiAPA102::preparePacket: zeroed start frame and the end frame appended once
+					if (writer.resize(colors.size()))
+					{
+						std::fill_n(writer.buffer().begin(), APA102_START_FRAME, 0x00);
+						writer.buffer().resize(writer.buffer().size() + std::max<size_t>((colors.size() + 15) / 16, 4), 0xFF);
+					}
+					writer.encode(colors);
+					CHECK(writer.buffer() == oldApa102(stream));
+				});
+			}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	testE131();
+	testDdp();
+	testApa102();
+
+	std::cout << ((failures == 0) ? "All tests passed" : "Some tests failed") << std::endl;
+
+	return (failures == 0) ? 0 : 1;
+}
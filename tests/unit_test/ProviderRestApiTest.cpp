@@ -0,0 +1,217 @@
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <led-drivers/net/ProviderRestApi.h>
+
+namespace
+{
+	int failures = 0;
+
+	#define CHECK(condition) \
+		if (!(condition)) { std::cout << "  FAILED: " << #condition << " (line " << __LINE__ << ")" << std::endl; failures++; }
+
+	struct Request
+	{
+		QByteArray method;
+		QByteArray path;
+		QByteArray body;
+	};
+
+	// a minimal HTTP/1.1 server in the test thread: keep-alive replies, optionally held back for replyDelay ms
+	class HttpStandIn
+	{
+	public:
+		int replyDelay = 0;
+		int connections = 0;
+		std::vector<Request> requests;
+
+		HttpStandIn()
+		{
+			QObject::connect(&_server, &QTcpServer::newConnection, [this]() {
+				while (QTcpSocket* socket = _server.nextPendingConnection())
+				{
+					connections++;
+					auto buffer = std::make_shared<QByteArray>();
+					QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket, buffer]() {
+						buffer->append(socket->readAll());
+						parse(socket, *buffer);
+					});
+					QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+				}
+			});
+			_server.listen(QHostAddress::LocalHost);
+		}
+
+		int port() const
+		{
+			return _server.serverPort();
+		}
+
+	private:
+		void parse(QTcpSocket* socket, QByteArray& buffer)
+		{
+			for (;;)
+			{
+				const int headerEnd = buffer.indexOf("\r\n\r\n");
+				if (headerEnd < 0)
+					return;
+
+				const QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+				const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+				int contentLength = 0;
+
+				for (const auto& line : lines)
+					if (line.toLower().startsWith("content-length:"))
+						contentLength = line.mid(15).trimmed().toInt();
+
+				if (buffer.size() < headerEnd + 4 + contentLength)
+					return;
+
+				requests.push_back({ requestLine.value(0), requestLine.value(1), buffer.mid(headerEnd + 4, contentLength) });
+				buffer.remove(0, headerEnd + 4 + contentLength);
+
+				QTimer::singleShot(replyDelay, socket, [socket]() {
+					socket->write("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 2\r\nConnection: keep-alive\r\n\r\n{}");
+				});
+			}
+		}
+
+		QTcpServer _server;
+	};
+
+	bool waitFor(const std::function<bool()>& condition, int timeout = 3000)
+	{
+		QElapsedTimer timer;
+		timer.start();
+
+		while (!condition() && timer.elapsed() < timeout)
+			QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+
+		return condition();
+	}
+
+	void testKeepAlive()
+	{
+		std::cout << "Sequential requests reuse one connection" << std::endl;
+
+		HttpStandIn server;
+		ProviderRestApi api("127.0.0.1", server.port());
+
+		for (int i = 0; i < 5; i++)
+		{
+			api.setPath(QString("/light/%1").arg(i));
+			api.putAsync(QString("light%1").arg(i), QString("{\"value\":%1}").arg(i));
+			CHECK(waitFor([&]() { return api.getRoundTripStats().requests == i + 1; }));
+		}
+
+		CHECK(server.requests.size() == 5);
+		CHECK(server.connections == 1);
+		CHECK(server.requests.back().method == "PUT");
+		CHECK(server.requests.back().path == "/light/4");
+		CHECK(server.requests.back().body == "{\"value\":4}");
+	}
+
+	void testCoalescing()
+	{
+		std::cout << "Writes for the same key are coalesced, the latest value wins" << std::endl;
+
+		HttpStandIn server;
+		server.replyDelay = 100;
+		ProviderRestApi api("127.0.0.1", server.port());
+
+		api.setPath("/state");
+		for (int i = 1; i <= 4; i++)
+			api.putAsync("state", QString::number(i));
+
+		CHECK(waitFor([&]() { return api.getRoundTripStats().requests == 2; }));
+
+		// nothing else may follow the latest value
+		waitFor([]() { return false; }, 300);
+
+		CHECK(server.requests.size() == 2);
+		if (server.requests.size() == 2)
+		{
+			CHECK(server.requests[0].body == "1");
+			CHECK(server.requests[1].body == "4");
+		}
+
+		auto stats = api.getRoundTripStats();
+		CHECK(stats.requests == 2);
+		CHECK(stats.coalesced == 2);
+		CHECK(stats.failed == 0);
+
+		// another key is not held back by the pending one
+		api.putAsync("other", "5");
+		CHECK(waitFor([&]() { return server.requests.size() == 3; }));
+		CHECK(server.requests.back().body == "5");
+	}
+
+	void testRoundTripStatistics()
+	{
+		std::cout << "Round-trip statistics" << std::endl;
+
+		HttpStandIn server;
+		server.replyDelay = 50;
+		ProviderRestApi api("127.0.0.1", server.port());
+
+		api.setPath("/state");
+		for (int i = 0; i < 3; i++)
+		{
+			api.postAsync("state", QString::number(i));
+			CHECK(waitFor([&]() { return api.getRoundTripStats().requests == i + 1; }));
+		}
+
+		CHECK(server.requests.size() == 3 && server.requests.front().method == "POST");
+		CHECK(api.getLastRoundTrip() >= 45);
+
+		auto stats = api.getRoundTripStats(true);
+		CHECK(stats.requests == 3);
+		CHECK(stats.failed == 0);
+		CHECK(stats.averageMs >= 45 && stats.averageMs < 450);
+		CHECK(stats.maxMs >= stats.averageMs);
+
+		auto cleared = api.getRoundTripStats();
+		CHECK(cleared.requests == 0 && cleared.coalesced == 0 && cleared.maxMs == 0);
+	}
+
+	void testFailure()
+	{
+		std::cout << "A reply that never comes is counted as failed" << std::endl;
+
+		HttpStandIn server;
+		server.replyDelay = 2000;
+		ProviderRestApi api("127.0.0.1", server.port());
+
+		QString reason;
+		QObject context;
+		api.setAsyncErrorHandler(&context, [&](const QString& error) { reason = error; });
+
+		api.setPath("/state");
+		api.putAsync("state", "1");
+
+		CHECK(waitFor([&]() { return !reason.isEmpty(); }));
+		CHECK(api.getRoundTripStats().failed == 1);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	testKeepAlive();
+	testCoalescing();
+	testRoundTripStatistics();
+	testFailure();
+
+	std::cout << ((failures == 0) ? "All tests passed" : "Some tests failed") << std::endl;
+
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+#include <QCoreApplication>
+#include <QString>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+	#include <util.h>
+#else
+	#include <pty.h>
+#endif
+
+#include <led-drivers/serial/SerialAsyncWriter.h>
+#include <utils/InternalClock.h>
+
+namespace
+{
+	int failures = 0;
+
+	#define CHECK(condition) \
+		if (!(condition)) { std::cout << "  FAILED: " << #condition << " (line " << __LINE__ << ")" << std::endl; failures++; }
+
+	// the large frame can not fit into the terminal buffers: the writer stays in poll() until the test reads it
+	constexpr size_t LARGE_FRAME = 256 * 1024;
+	constexpr size_t SMALL_FRAME = 64;
+
+	struct PseudoTerminal
+	{
+		int master = -1;
+		int slave = -1;
+
+		PseudoTerminal()
+		{
+			if (openpty(&master, &slave, nullptr, nullptr, nullptr) < 0)
+				return;
+
+			termios tio{};
+			tcgetattr(slave, &tio);
+			cfmakeraw(&tio);
+			tcsetattr(slave, TCSANOW, &tio);
+		}
+
+		~PseudoTerminal()
+		{
+			closeMaster();
+			if (slave >= 0)
+				close(slave);
+		}
+
+		void closeMaster()
+		{
+			if (master >= 0)
+				close(master);
+			master = -1;
+		}
+
+		std::vector<uint8_t> read(size_t expected, int timeoutMs)
+		{
+			std::vector<uint8_t> result;
+			std::vector<uint8_t> buffer(16384);
+			const qint64 deadline = InternalClock::now() + timeoutMs;
+
+			while (result.size() < expected && InternalClock::now() < deadline)
+			{
+				pollfd pfd{};
+				pfd.fd = master;
+				pfd.events = POLLIN;
+
+				if (poll(&pfd, 1, 50) <= 0)
+					continue;
+
+				ssize_t got = ::read(master, buffer.data(), buffer.size());
+				if (got > 0)
+					result.insert(result.end(), buffer.begin(), buffer.begin() + got);
+			}
+
+			return result;
+		}
+	};
+
+	std::vector<uint8_t> frame(size_t size, uint8_t value)
+	{
+		return std::vector<uint8_t>(size, value);
+	}
+
+	bool filledWith(const std::vector<uint8_t>& data, size_t begin, size_t end, uint8_t value)
+	{
+		return data.size() >= end && std::all_of(data.begin() + begin, data.begin() + end, [value](uint8_t v) { return v == value; });
+	}
+
+	template<typename Predicate>
+	bool waitFor(Predicate predicate, int timeoutMs)
+	{
+		const qint64 deadline = InternalClock::now() + timeoutMs;
+		while (!predicate())
+		{
+			if (InternalClock::now() > deadline)
+				return false;
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+		return true;
+	}
+
+	void testNewestFrameReplacesPending()
+	{
+		std::cout << "Newest frame replaces the pending one" << std::endl;
+
+		PseudoTerminal pty;
+		SerialAsyncWriter writer("SERIAL_TEST");
+		CHECK(writer.start(pty.slave, false, 115200));
+
+		auto large = frame(LARGE_FRAME, 0x11);
+		writer.submit(large.data(), large.size());
+
+		// the writer is blocked on the full terminal now: only the last of these frames may go out
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		for (uint8_t value : { 0x22, 0x33, 0x44 })
+		{
+			auto small = frame(SMALL_FRAME, value);
+			writer.submit(small.data(), small.size());
+		}
+
+		auto received = pty.read(LARGE_FRAME + SMALL_FRAME, 5000);
+		CHECK(received.size() == LARGE_FRAME + SMALL_FRAME);
+		CHECK(filledWith(received, 0, LARGE_FRAME, 0x11));
+		CHECK(filledWith(received, LARGE_FRAME, LARGE_FRAME + SMALL_FRAME, 0x44));
+
+		CHECK(waitFor([&]() { return writer.getStats(false).frames == 2; }, 1000));
+		auto stats = writer.getStats(false);
+		CHECK(stats.replaced == 2);
+		CHECK(stats.bytes == static_cast<qint64>(LARGE_FRAME + SMALL_FRAME));
+
+		QString error;
+		CHECK(!writer.hasError(error));
+
+		writer.stop();
+	}
+
+	void testStopFlushesFinalFrame()
+	{
+		std::cout << "Stop flushes the final frame" << std::endl;
+
+		PseudoTerminal pty;
+		SerialAsyncWriter writer("SERIAL_TEST");
+		CHECK(writer.start(pty.slave, false, 115200));
+
+		auto large = frame(LARGE_FRAME, 0x11);
+		writer.submit(large.data(), large.size());
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+		// the final (black) frame is submitted right before the device is stopped
+		auto black = frame(SMALL_FRAME, 0x00);
+		writer.submit(black.data(), black.size());
+
+		std::thread stopper([&writer]() { writer.stop(); });
+		auto received = pty.read(LARGE_FRAME + SMALL_FRAME, 5000);
+		stopper.join();
+
+		CHECK(received.size() == LARGE_FRAME + SMALL_FRAME);
+		CHECK(filledWith(received, LARGE_FRAME, LARGE_FRAME + SMALL_FRAME, 0x00));
+		CHECK(!writer.isRunning());
+	}
+
+	void testPeerClosed()
+	{
+		std::cout << "Error when the peer closes" << std::endl;
+
+		PseudoTerminal pty;
+		SerialAsyncWriter writer("SERIAL_TEST");
+		CHECK(writer.start(pty.slave, false, 115200));
+
+		pty.closeMaster();
+
+		auto data = frame(SMALL_FRAME, 0x55);
+		writer.submit(data.data(), data.size());
+
+		QString error;
+		CHECK(waitFor([&]() { return writer.hasError(error); }, 3000));
+		CHECK(!error.isEmpty());
+
+		// the writer drops the frames after an error instead of retrying on a dead descriptor
+		const qint64 attempted = writer.getStats(false).frames;
+		writer.submit(data.data(), data.size());
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		CHECK(writer.getStats(false).frames == attempted);
+
+		writer.stop();
+		CHECK(!writer.isRunning());
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	testNewestFrameReplacesPending();
+	testStopFlushesFinalFrame();
+	testPeerClosed();
+
+	std::cout << ((failures == 0) ? "All tests passed" : "Some tests failed") << std::endl;
+
+	return (failures == 0) ? 0 : 1;
+}
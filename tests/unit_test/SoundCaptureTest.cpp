@@ -0,0 +1,183 @@
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <base/SoundCapture.h>
+#include <effects/AnimationBaseMusic.h>
+#include <utils/InternalClock.h>
+
+namespace
+{
+	int failures = 0;
+
+	#define CHECK(condition) \
+		if (!(condition)) { std::cout << "  FAILED: " << #condition << " (line " << __LINE__ << ")" << std::endl; failures++; }
+
+	constexpr int FFT_SIZE = 512;
+	constexpr int64_t CAPTURE_AGE = 40000;
+
+	// the null capture backend: no device, the test delivers the blocks like a capture thread would
+	class NullSoundCapture : public SoundCapture
+	{
+	public:
+		NullSoundCapture(const QJsonDocument& config) :
+			SoundCapture(config)
+		{
+			_availableDevices.append("null");
+			_latencyReportInterval = 0;
+		}
+
+		void start() override
+		{
+			_isRunning = _isActive;
+		}
+
+		void stop() override
+		{
+			_isRunning = false;
+		}
+	};
+
+	class NullMusicEffect : public AnimationBaseMusic
+	{
+	public:
+		bool Play(HyperImage& /*painter*/) override
+		{
+			return false;
+		}
+	};
+
+	QJsonDocument config()
+	{
+		QJsonObject sndEffect;
+		sndEffect["enable"] = true;
+		sndEffect["device"] = "null";
+		sndEffect["enable_smoothing"] = false;
+		sndEffect["fft_size"] = FFT_SIZE;
+		sndEffect["fft_overlap"] = 0;
+		return QJsonDocument(sndEffect);
+	}
+
+	std::vector<int16_t> sine(int count, double frequency)
+	{
+		std::vector<int16_t> samples(count);
+		for (int i = 0; i < count; i++)
+			samples[i] = static_cast<int16_t>(16000 * std::sin(2 * 3.14159265358979323846 * frequency * i / SoundAnalyzer::SAMPLE_RATE));
+		return samples;
+	}
+
+	void testStopped()
+	{
+		std::cout << "Samples are ignored while the device is stopped" << std::endl;
+
+		NullSoundCapture capture(config());
+		auto samples = sine(FFT_SIZE, 440);
+
+		CHECK(!capture.analyzeSamples(samples.data(), FFT_SIZE, InternalClock::nowMicro()));
+
+		uint32_t handle = capture.open();
+		CHECK(capture.analyzeSamples(samples.data(), FFT_SIZE, InternalClock::nowMicro()));
+
+		capture.close(handle);
+		CHECK(!capture.analyzeSamples(samples.data(), FFT_SIZE, InternalClock::nowMicro()));
+	}
+
+	// the first loud frame only sets the levels of the bands, the analyzer publishes the frames after it
+	void warmUp(NullSoundCapture& capture, NullMusicEffect& effect, uint32_t& lastIndex, const std::vector<int16_t>& samples)
+	{
+		int isMulti = 0;
+		for (int i = 0; i < 4 && capture.hasResult(&effect, lastIndex, nullptr, nullptr, nullptr, &isMulti) == nullptr; i++)
+			capture.analyzeSamples(samples.data(), FFT_SIZE, InternalClock::nowMicro());
+	}
+
+	void testCaptureTime()
+	{
+		std::cout << "The capture time of the frame reaches the effect" << std::endl;
+
+		NullSoundCapture capture(config());
+		NullMusicEffect effect;
+		uint32_t handle = capture.open();
+		uint32_t lastIndex = 0;
+		bool newAverage = false;
+		int isMulti = 0;
+
+		auto samples = sine(FFT_SIZE * 2, 440);
+		warmUp(capture, effect, lastIndex, samples);
+		CHECK(lastIndex != 0);
+
+		// half a frame: nothing new to analyse
+		CHECK(capture.analyzeSamples(samples.data(), FFT_SIZE / 2, InternalClock::nowMicro()));
+		CHECK(capture.hasResult(&effect, lastIndex, &newAverage, nullptr, nullptr, &isMulti) == nullptr);
+
+		// the block completes the frame and holds a quarter of the next one
+		const int64_t captureTime = InternalClock::nowMicro() - CAPTURE_AGE;
+		CHECK(capture.analyzeSamples(samples.data() + FFT_SIZE / 2, FFT_SIZE / 2 + FFT_SIZE / 4, captureTime));
+
+		SoundCaptureResult* result = capture.hasResult(&effect, lastIndex, &newAverage, nullptr, nullptr, &isMulti);
+		CHECK(result != nullptr && result == effect.soundResult());
+		CHECK(newAverage);
+		if (result != nullptr)
+		{
+			const int64_t frameEnd = captureTime - (static_cast<int64_t>(FFT_SIZE / 4) * 1000000) / SoundAnalyzer::SAMPLE_RATE;
+			CHECK(result->getCaptureTime() == frameEnd);
+			CHECK(lastIndex == result->getResultIndex());
+		}
+
+		// the same result is not taken twice
+		CHECK(capture.hasResult(&effect, lastIndex, &newAverage, nullptr, nullptr, &isMulti) == nullptr);
+
+		capture.close(handle);
+	}
+
+	void testLatency()
+	{
+		std::cout << "Capture to analysis and capture to render latency" << std::endl;
+
+		NullSoundCapture capture(config());
+		NullMusicEffect effect;
+		uint32_t handle = capture.open();
+		uint32_t lastIndex = 0;
+		int isMulti = 0;
+
+		auto samples = sine(FFT_SIZE, 1000);
+		warmUp(capture, effect, lastIndex, samples);
+
+		// every analysed frame reports what was measured before it: the render stage of a frame comes with the next one
+		int taken = 0;
+		for (int i = 0; i < 3; i++)
+		{
+			CHECK(capture.analyzeSamples(samples.data(), FFT_SIZE, InternalClock::nowMicro() - CAPTURE_AGE));
+			if (capture.hasResult(&effect, lastIndex, nullptr, nullptr, nullptr, &isMulti) != nullptr)
+				taken++;
+		}
+		CHECK(taken == 3);
+
+		QJsonObject latency = capture.getJsonInfo()["latency"].toObject();
+		const double ageMs = CAPTURE_AGE / 1000.0;
+
+		CHECK(latency["analysis_avg_ms"].toDouble() >= ageMs && latency["analysis_avg_ms"].toDouble() < ageMs + 500);
+		CHECK(latency["analysis_max_ms"].toDouble() >= latency["analysis_avg_ms"].toDouble());
+		CHECK(latency["render_avg_ms"].toDouble() >= ageMs && latency["render_avg_ms"].toDouble() < ageMs + 500);
+		CHECK(latency["render_max_ms"].toDouble() >= latency["render_avg_ms"].toDouble());
+		CHECK(!latency.contains("effect_avg_ms"));
+
+		capture.close(handle);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	testStopped();
+	testCaptureTime();
+	testLatency();
+
+	std::cout << ((failures == 0) ? "All tests passed" : "Some tests failed") << std::endl;
+
+	return (failures == 0) ? 0 : 1;
+}